@@ -6,11 +6,23 @@ layout (location = 2) in vec2 aTexCoord;
 out vec2 TexCoord;
 out vec4 Colour;
 
+uniform mat4 viewProjection;
 uniform mat4 transform;
 
+// The sprite sheet layout as (columns, rows), and the frame to draw from it.
+// A plain texture is a 1 x 1 sheet with only frame 0
+uniform vec2 spriteGrid;
+uniform int spriteFrame;
+
 void main()
 {
-	gl_Position = transform * vec4(aPos, 1.0);
+	gl_Position = viewProjection * transform * vec4(aPos, 1.0);
 	Colour = aColour;
-	TexCoord = aTexCoord;
+
+	// Frames are counted from the top left of the sprite sheet
+	vec2 grid = max(spriteGrid, vec2(1.0));
+	int column = spriteFrame % int(grid.x);
+	int row = spriteFrame / int(grid.x);
+	TexCoord = vec2((float(column) + aTexCoord.x) / grid.x,
+					1.0 - (float(row) + 1.0 - aTexCoord.y) / grid.y);
 }
\ No newline at end of file
@@ -6,7 +6,6 @@
  */
 #include "Application.h"
 
-#include <Windows.h>
 //Include the standard C++ headers
 #include <stdio.h>
 #include <stdlib.h>
@@ -21,14 +20,44 @@
 #include "GameControl\Settings.h"
 // Include CShaderManager which manages the shaders used in this App
 #include "RenderControl\ShaderManager.h"
+// Include CRenderState which drops redundant GL state changes
+#include "RenderControl\RenderState.h"
+// Include CFrameTimer which times the parts of a frame on the CPU and GPU
+#include "TimeControl\FrameTimer.h"
+// Include CFixedTimeStep which runs the simulation ticks
+#include "TimeControl\FixedTimeStep.h"
+// Include CMetricsRegistry which keeps the counters of the subsystems
+#include "System\MetricsRegistry.h"
+// Include CRenderQueue which sorts the draw commands
+#include "RenderControl\RenderQueue.h"
+// Include CMeshManager which owns the shared meshes
+#include "Primitives\MeshManager.h"
+// Include CAnimationSetManager which owns the shared animation clips
+#include "Primitives\AnimationSetManager.h"
+// Include CImageLoader which decodes images in the background
+#include "System\ImageLoader.h"
+// Include CAssetPack which maps the cooked digital assets
+#include "System\AssetPack.h"
+// Include CAssetPacker to check if the asset pack is stale
+#include "System\AssetPacker.h"
+// Include CPlatform which sets the timer resolution of the operating system
+#include "System\Platform.h"
+// Include CJobSystem which runs the jobs on the worker threads
+#include "System\JobSystem.h"
+// Include CRandomService which owns the random streams
+#include "System\RandomService.h"
 
 // Inputs
 #include "Inputs\KeyboardController.h"
 #include "Inputs\MouseController.h"
+#include "Inputs\InputRecorder.h"
 
 #include <iostream>
 using namespace std;
 
+// Include Filesystem
+#include "System\filesystem.h"
+
 // Include GLFW
 #include <GLFW/glfw3.h>
 
@@ -59,7 +88,7 @@ using namespace std;
 static void error_callback(int error, const char* description)
 {
 	fputs(description, stderr);
-	_fgetchar();
+	getchar();
 }
 
 /**
@@ -87,7 +116,7 @@ void repos_callback(GLFWwindow* window, int xpos, int ypos)
 	CSettings::GetInstance()->iWindowPosX = xpos;
 	CSettings::GetInstance()->iWindowPosY = ypos;
 	// Update the glViewPort
-	glViewport(0, 0, CSettings::GetInstance()->iWindowWidth, CSettings::GetInstance()->iWindowHeight);
+	CRenderState::GetInstance()->Viewport(0, 0, CSettings::GetInstance()->iWindowWidth, CSettings::GetInstance()->iWindowHeight);
 }
 
 /**
@@ -102,7 +131,7 @@ void resize_callback(GLFWwindow* window, int width, int height)
 	CSettings::GetInstance()->iWindowWidth = width;
 	CSettings::GetInstance()->iWindowHeight = height;
 	// Update the glViewPort
-	glViewport(0, 0, width, height);
+	CRenderState::GetInstance()->Viewport(0, 0, width, height);
 }
 
 /**
@@ -144,6 +173,15 @@ Application::~Application(void)
  */
 bool Application::Init(void)
 {
+	// Raise the timer resolution, so that the frame pacer wakes up close to the start of a frame
+	CPlatform::Init();
+
+	// Start the job workers, one for each core but the main thread's
+	CJobSystem::GetInstance()->Init();
+
+	// Start timing the startup, for comparing the asset pack with the loose files
+	cStartupStopWatch.StartTimer();
+
 	// glfw: initialize and configure
 	// ------------------------------
 	//Initialize GLFW
@@ -160,6 +198,27 @@ bool Application::Init(void)
 	// This is backup, in case filesystem cannot find the current directory
 	cSettings->logl_root = "C:/Users/tohdj/Documents/2022_2023_SEM1/DM2213 2D Game Creation/Teaching Materials/";
 
+	// Map the asset pack if it was cooked. The loose files are used for any asset which is not in it
+	if (cSettings->bUseAssetPack == true)
+	{
+		if (CAssetPack::GetInstance()->Open(FileSystem::getPath(cSettings->sAssetPackFile)) == false)
+		{
+			cout << "Application::Init(): No asset pack was found. Loading the loose files." << endl;
+		}
+		else if (cSettings->bCheckAssetPack == true)
+		{
+			// The assets come from the pack even if a loose file was changed after it was cooked.
+			// Every loose file is checked, so this is left out of the startup time
+			dStartupTime += cStartupStopWatch.GetElapsedTime();
+			std::string sRootPath = FileSystem::getPath("");
+			sRootPath.erase(sRootPath.size() - 1);
+			if (CAssetPacker::GetNewestSourceTime(sRootPath) > CAssetPack::GetInstance()->GetSourceTime())
+				cout << "Application::Init(): The asset pack is older than the loose files, which are not loaded. "
+					<< "Run with \"--cook\" to cook it again." << endl;
+			cout << "Application::Init(): Checked the asset pack in " << cStartupStopWatch.GetElapsedTime() * 1000.0 << " ms" << endl;
+		}
+	}
+
 	//Set the GLFW window creation hints - these are optional
 	if (cSettings->bUse4XAntiliasing == true)
 		glfwWindowHint(GLFW_SAMPLES, 4); //Request 4x antialiasing
@@ -188,6 +247,8 @@ bool Application::Init(void)
 
 	//This function makes the context of the specified window current on the calling thread. 
 	glfwMakeContextCurrent(cSettings->pWindow);
+	// Let the buffer swaps wait for the vertical sync, or let the frame pacer pace the frames
+	glfwSwapInterval(cSettings->bVSync ? 1 : 0);
 
 	//Sets the callback functions for GLFW
 	//Set the window position callback function
@@ -229,6 +290,9 @@ bool Application::Init(void)
 	// For https://docs.gl/
 	std::cout << glGetString(GL_VERSION) << std::endl;
 
+	// Set the viewport through CRenderState, so that it knows the viewport of the window
+	CRenderState::GetInstance()->Viewport(0, 0, cSettings->iWindowWidth, cSettings->iWindowHeight);
+
 	// Initialise the CSoundController singleton
 	CSoundController::GetInstance()->Init();
 
@@ -249,6 +313,17 @@ bool Application::Init(void)
 	cFPSCounter = CFPSCounter::GetInstance();
 	cFPSCounter->Init();
 
+	// Add the metrics of the rendering and the frame time
+	CMetricsRegistry* cMetricsRegistry = CMetricsRegistry::GetInstance();
+	uiMetricDrawCalls = cMetricsRegistry->AddCounter("Draw Calls");
+	uiMetricClears = cMetricsRegistry->AddCounter("Clears");
+	uiMetricStateChanges = cMetricsRegistry->AddCounter("State Changes");
+	uiMetricUniformUploads = cMetricsRegistry->AddCounter("Uniform Uploads");
+	uiMetricTextureBinds = cMetricsRegistry->AddCounter("Texture Binds");
+	uiMetricBytesUploaded = cMetricsRegistry->AddCounter("Bytes Uploaded");
+	uiMetricTextures = cMetricsRegistry->AddGauge("Textures Resident");
+	uiMetricFrameTime = cMetricsRegistry->AddHistogram("Frame Time (us)");
+
 	// Create the Game States
 	CGameStateManager::GetInstance()->AddGameState("IntroState", new CIntroState());
 	CGameStateManager::GetInstance()->AddGameState("MenuState", new CMenuState());
@@ -261,6 +336,9 @@ bool Application::Init(void)
 	// Set the active scene
 	CGameStateManager::GetInstance()->SetActiveGameState("MenuState");
 
+	dStartupTime += cStartupStopWatch.GetElapsedTime();
+	cout << "Application::Init(): Initialised in " << dStartupTime * 1000.0 << " ms" << endl;
+
 	return true;
 }
 
@@ -269,21 +347,49 @@ bool Application::Init(void)
 */ 
 void Application::Run(void)
 {
-	// Start timer to calculate how long it takes to render this frame
-	cStopWatch.StartTimer();
+	// Pace the frames at the target frame rate, or only measure them against the refresh rate with vsync.
+	// A replay runs the frames as fast as possible, as the game is passed the recorded frame times
+	CInputRecorder* cInputRecorder = CInputRecorder::GetInstance();
+	if (cInputRecorder->IsReplaying())
+	{
+		cFramePacer.SetTargetRate(CFramePacer::PACING_UNCAPPED, 0.0);
+	}
+	else if (cSettings->bVSync)
+	{
+		const GLFWvidmode* pVideoMode = glfwGetVideoMode(glfwGetPrimaryMonitor());
+		cFramePacer.SetTargetRate(CFramePacer::PACING_VSYNC, (pVideoMode != NULL) ? pVideoMode->refreshRate : 0.0);
+	}
+	else
+	{
+		cFramePacer.SetTargetRate(CFramePacer::PACING_TARGET_RATE, cSettings->dTargetFrameRate);
+	}
+
+	// Flag the frames which take much longer than the target frame time as hitches
+	double dTargetFrameTime = cFramePacer.GetTargetFrameTime() * 1000.0;
+	cFPSCounter->SetHitchThreshold((dTargetFrameTime > 0.0) ? dTargetFrameTime : cSettings->frameTime, cSettings->dHitchMultiplier);
+
+	// Update the simulation in ticks of a fixed time, whatever the frame rate
+	CFixedTimeStep* cFixedTimeStep = CFixedTimeStep::GetInstance();
+	cFixedTimeStep->Init(cSettings->dFixedTimeStep, cSettings->uiMaxFixedSteps);
+	cFixedTimeStep->SetTimeScale(cSettings->dTimeScale);
+	cFixedTimeStep->SetMaxScaleBudget(cSettings->dMaxTimeScaleBudget);
 
 	double dElapsedTime = 0.0;
-	double dDelayTime = 0.0;
-	double dTotalFrameTime = 0.0;
+	unsigned long long ullNumTicks = 0;
+	CStopWatch cRunStopWatch;
+	cRunStopWatch.StartTimer();
 
 	// Render loop
 	while (!glfwWindowShouldClose(cSettings->pWindow)
 		/*&& (!CKeyboardController::GetInstance()->IsKeyReleased(GLFW_KEY_ESCAPE))*/)
 	{
-		// This is to prevent the program from crashing due to long dElapsedTime
-		// Causing Physics to calculate a large jump/fall for the player
-		if (dElapsedTime > 0.0166666666666667)
-			dElapsedTime = 0.0166666666666667;
+		// Start counting the GL state changes for this frame
+		CRenderState::GetInstance()->BeginFrame();
+		// Store the times of the last frame and read back its GPU times when they are ready
+		CFrameTimer::GetInstance()->BeginFrame();
+
+		// Upload the images which were decoded in the background, within this frame's budget
+		CImageLoader::GetInstance()->Update(cSettings->dTextureUploadBudget);
 
 		// Call the active Game State's Update method
 		if (CGameStateManager::GetInstance()->Update(dElapsedTime) == false)
@@ -291,9 +397,46 @@ void Application::Run(void)
 			break;
 		}
 
-		// Call the active Game State's Render method
+		// Run the simulation ticks which are due. A long frame is not passed to the simulation
+		// in one step, which would make the physics calculate a large jump/fall for the player
+		bool bQuit = false;
+		cFixedTimeStep->AddTime(dElapsedTime);
+		while ((bQuit == false) && (cFixedTimeStep->Step()))
+		{
+			CKeyboardController::GetInstance()->PreFixedUpdate();
+			bQuit = (CGameStateManager::GetInstance()->FixedUpdate(cSettings->dTickElapsedTime) == false);
+			CKeyboardController::GetInstance()->PostFixedUpdate();
+			ullNumTicks++;
+		}
+		if (bQuit)
+		{
+			break;
+		}
+
+		// Call the active Game State's Render method. The entities are drawn between their
+		// positions of the last two ticks
 		CGameStateManager::GetInstance()->Render();
 
+		// Add the calls of this frame to the metrics
+		CMetricsRegistry* cMetricsRegistry = CMetricsRegistry::GetInstance();
+		const CRenderState::SStats& sRenderStats = CRenderState::GetInstance()->GetCurrentFrameStats();
+		cMetricsRegistry->Add(uiMetricDrawCalls, sRenderStats.uiDrawCalls);
+		cMetricsRegistry->Add(uiMetricClears, sRenderStats.uiClears);
+		cMetricsRegistry->Add(uiMetricStateChanges, sRenderStats.uiIssued);
+		cMetricsRegistry->Add(uiMetricUniformUploads, sRenderStats.uiUniformUploads);
+		cMetricsRegistry->Add(uiMetricTextureBinds, sRenderStats.uiTextureBinds);
+		cMetricsRegistry->Add(uiMetricBytesUploaded, sRenderStats.ullBufferBytes + sRenderStats.ullTextureBytes);
+		cMetricsRegistry->Set(uiMetricTextures, CRenderState::GetInstance()->GetNumTextures());
+
+		// Report the startup time once the images of the first game state are all loaded
+		if ((bStartupReported == false) && (CImageLoader::GetInstance()->GetNumPendingLoads() == 0))
+		{
+			dStartupTime += cStartupStopWatch.GetElapsedTime();
+			cout << "Application::Run(): Started up in " << dStartupTime * 1000.0 << " ms from "
+				<< (CAssetPack::GetInstance()->IsOpen() ? "the asset pack" : "the loose files") << endl;
+			bStartupReported = true;
+		}
+
 		// glfw: swap buffers and poll IO events (keys pressed/released, mouse moved etc.)
 		// -------------------------------------------------------------------------------
 		glfwSwapBuffers(cSettings->pWindow);
@@ -304,19 +447,47 @@ void Application::Run(void)
 		// Poll events
 		glfwPollEvents();
 
-		// Update Input Devices
-		UpdateInputDevices();
-
-		// Calculate the elapsed time since the last frame
-		dElapsedTime = cStopWatch.GetElapsedTime();
+		// Update Input Devices, or replace the inputs of the player with the recorded inputs
+		// of the next frame. The replay is over when there are no more frames in the log
+		if (cInputRecorder->IsReplaying())
+		{
+			if (cInputRecorder->ReplayFrame(dElapsedTime) == false)
+			{
+				break;
+			}
+		}
+		else
+		{
+			UpdateInputDevices();
+		}
 
-		// Frame rate limiter. Limits each frame to a specified time in ms by sleeping.  
-		dDelayTime = cSettings->frameTime - dElapsedTime * 1000;
-		cStopWatch.WaitUntil((const long long)dDelayTime);
+		// Wait until the next frame is due, and get the time since the last frame started.
+		// The game is passed the recorded frame time in a replay, but the metrics measure the real one
+		double dFrameTime = cFramePacer.WaitForNextFrame();
+		if (cInputRecorder->IsReplaying() == false)
+		{
+			dElapsedTime = dFrameTime;
+			cInputRecorder->RecordFrame(dElapsedTime);
+		}
 
 		// Update the FPS Counter
-		dTotalFrameTime = dElapsedTime + dDelayTime * 0.001;
-		cFPSCounter->Update(dTotalFrameTime);
+		cFPSCounter->Update(dFrameTime);
+
+		// End the frame of the metrics, which writes them to the metrics file once an interval is over
+		cMetricsRegistry->Observe(uiMetricFrameTime, (unsigned long long)(dFrameTime * 1000000.0));
+		cMetricsRegistry->EndFrame(dFrameTime);
+	}
+
+	if (cInputRecorder->IsReplaying())
+	{
+		double dRunTime = cRunStopWatch.GetElapsedTime();
+		unsigned int uiNumFrames = cInputRecorder->GetNumFrames();
+		cout << "Application::Run(): Replayed " << uiNumFrames << " frames and " << ullNumTicks << " ticks in "
+			<< dRunTime * 1000.0 << " ms (" << (uiNumFrames > 0 ? dRunTime / uiNumFrames * 1000.0 : 0.0) << " ms per frame)" << endl;
+	}
+	else if (cInputRecorder->IsRecording())
+	{
+		cout << "Application::Run(): Recorded " << cInputRecorder->GetNumFrames() << " frames and " << ullNumTicks << " ticks" << endl;
 	}
 }
 
@@ -332,15 +503,46 @@ void Application::Destroy(void)
 	CGameStateManager::GetInstance()->Destroy();
 	// Destory the ShaderManager
 	CShaderManager::GetInstance()->Destroy();
-
+	// Destroy the MeshManager
+	CMeshManager::GetInstance()->Destroy();
+	// Destroy the AnimationSetManager
+	CAnimationSetManager::GetInstance()->Destroy();
+	// Destroy the ImageLoader and stop its decoding threads
+	CImageLoader::GetInstance()->Destroy();
+	// Destroy the AssetPack after the ImageLoader and unmap it
+	CAssetPack::GetInstance()->Destroy();
+	// Destroy the RenderQueue
+	CRenderQueue::GetInstance()->Destroy();
+	// Destroy the FrameTimer before the RenderState, as it deletes its GPU queries
+	CFrameTimer::GetInstance()->Destroy();
+	// Destroy the RenderState
+	CRenderState::GetInstance()->Destroy();
+
+	// Destroy the input recorder, which closes its log
+	CInputRecorder::GetInstance()->Destroy();
 	// Destroy the mouse instance
 	CMouseController::GetInstance()->Destroy();
 	// Destroy the keyboard instance
 	CKeyboardController::GetInstance()->Destroy();
 
+	// Stop the job workers after everything which can run a job is destroyed
+	CJobSystem::GetInstance()->Destroy();
+
+	// Destroy the CFixedTimeStep instance
+	CFixedTimeStep::GetInstance()->Destroy();
+
+	// Destroy the CMetricsRegistry instance and close its file
+	CMetricsRegistry::GetInstance()->Destroy();
+
+	// Destroy the CRandomService instance
+	CRandomService::GetInstance()->Destroy();
+
 	// Destroy the CFPSCounter instance
 	if (cFPSCounter)
 	{
+		// Print the frame times and the pacing of the session before they are lost
+		cFPSCounter->PrintFrameTimeStats();
+		cFramePacer.PrintPacingStats();
 		cFPSCounter->Destroy();
 		cFPSCounter = NULL;
 	}
@@ -352,6 +554,9 @@ void Application::Destroy(void)
 
 	// Destroy the CSettings instance
 	CSettings::GetInstance()->Destroy();
+
+	// Restore the timer resolution
+	CPlatform::Destroy();
 }
 
 /**
@@ -359,6 +564,16 @@ void Application::Destroy(void)
  */
 Application::Application(void)
 	: cFPSCounter(NULL)
+	, dStartupTime(0.0)
+	, bStartupReported(false)
+	, uiMetricDrawCalls(0)
+	, uiMetricClears(0)
+	, uiMetricStateChanges(0)
+	, uiMetricUniformUploads(0)
+	, uiMetricTextureBinds(0)
+	, uiMetricBytesUploaded(0)
+	, uiMetricTextures(0)
+	, uiMetricFrameTime(0)
 {
 }
 
@@ -10,6 +10,8 @@
 #include "DesignPatterns\SingletonTemplate.h"
 
 #include "TimeControl\StopWatch.h"
+// Frame Pacer
+#include "TimeControl\FramePacer.h"
 //#include "Scene2D\Scene2D.h"
 
 // FPS Counter
@@ -31,8 +33,12 @@ public:
 	void Destroy(void);
 	
 protected:
-	// Declare timer for calculating time per frame
-	CStopWatch cStopWatch;
+	// Declare the frame pacer which starts the frames at the target rate, and measures the time per frame
+	CFramePacer cFramePacer;
+	// Declare timer for calculating the time from the start until all the images are loaded
+	CStopWatch cStartupStopWatch;
+	double dStartupTime;
+	bool bStartupReported;
 
 	// The handler to the CSettings instance
 	CSettings* cSettings;
@@ -41,6 +47,16 @@ protected:
 	// The handler to the CFPSCounter instance
 	CFPSCounter* cFPSCounter;
 
+	// The metrics of the rendering and the frame time, which are shown in the metrics panel
+	unsigned int uiMetricDrawCalls;
+	unsigned int uiMetricClears;
+	unsigned int uiMetricStateChanges;
+	unsigned int uiMetricUniformUploads;
+	unsigned int uiMetricTextureBinds;
+	unsigned int uiMetricBytesUploaded;
+	unsigned int uiMetricTextures;
+	unsigned int uiMetricFrameTime;
+
 	// Constructor
 	Application(void);
 
@@ -19,4 +19,8 @@ public:
 	virtual bool Update(const double dElapsedTime) = 0;
 	virtual void Render() = 0;
 	virtual void Destroy() = 0;
+
+	// Update the simulation by a tick of the fixed time step. Update() is called once a frame
+	// for the input and the GUI, and this is called for every tick which is due in the frame
+	virtual bool FixedUpdate(const double dElapsedTime) { return true; }
 };
@@ -1,5 +1,8 @@
 #include "GameStateManager.h"
 
+// Include CProfiler for the profiler zones
+#include "TimeControl\Profiler.h"
+
 #include <iostream>
 
 using namespace std;
@@ -49,6 +52,8 @@ void CGameStateManager::Destroy(void)
  */
 bool CGameStateManager::Update(const double dElapsedTime)
 {
+	PROFILE_FUNCTION();
+
 	// Check for change of scene
 	if (nextGameState != activeGameState)
 	{
@@ -86,11 +91,32 @@ bool CGameStateManager::Update(const double dElapsedTime)
 	return true;
 }
 
+/**
+ @brief Update the simulation of this class instance by a tick
+ */
+bool CGameStateManager::FixedUpdate(const double dElapsedTime)
+{
+	PROFILE_FUNCTION();
+
+	// Do not update a CGameState which is being changed, as it is exited in the next Update()
+	if ((activeGameState == nullptr) || (nextGameState != activeGameState))
+		return true;
+
+	if (activeGameState->FixedUpdate(dElapsedTime) == false)
+		return false;
+	if (pauseGameState)
+		pauseGameState->FixedUpdate(dElapsedTime);
+
+	return true;
+}
+
 /**
  @brief Render this class instance
  */
 void CGameStateManager::Render(void)
 {
+	PROFILE_FUNCTION();
+
 	if (activeGameState)
 		activeGameState->Render();
 	if (pauseGameState)
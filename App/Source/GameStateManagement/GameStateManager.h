@@ -18,6 +18,8 @@ public:
 	// System Interface
 	// Update this class instance
 	bool Update(const double dElapsedTime);
+	// Update the simulation of this class instance by a tick
+	bool FixedUpdate(const double dElapsedTime);
 	// Render this class instance
 	void Render(void);
 
@@ -26,12 +26,16 @@
 
  // Include shader
 #include "RenderControl\shader.h"
+// Include CRenderState
+#include "RenderControl\RenderState.h"
 
 // Include CSettings
 #include "GameControl/Settings.h"
 
 // Include CKeyboardController
 #include "Inputs/KeyboardController.h"
+// Include CInputRecorder to replay the mouse of the GUI
+#include "Inputs/InputRecorder.h"
 
 #include <iostream>
 #include "System\filesystem.h"
@@ -102,6 +106,7 @@ bool CGameWinState::Update(const double dElapsedTime)
 	// Start the Dear ImGui frame
 	ImGui_ImplOpenGL3_NewFrame();
 	ImGui_ImplGlfw_NewFrame();
+	CInputRecorder::GetInstance()->UpdateGUIInputs();
 	ImGui::NewFrame();
 
 	ImGuiWindowFlags window_flags = 0;
@@ -164,7 +169,7 @@ bool CGameWinState::Update(const double dElapsedTime)
 void CGameWinState::Render(void)
 {
 	// Clear the screen and buffer
-	glClearColor(0.0f, 0.55f, 1.00f, 1.00f);
+	CRenderState::GetInstance()->ClearColor(0.0f, 0.55f, 1.00f, 1.00f);
 
 	//Render Background
 	background->Render();
@@ -26,6 +26,8 @@
 
  // Include shader
 #include "RenderControl\shader.h"
+// Include CRenderState
+#include "RenderControl\RenderState.h"
 
 // Include CSettings
 #include "GameControl/Settings.h"
@@ -97,7 +99,7 @@ bool CIntroState::Update(const double dElapsedTime)
 void CIntroState::Render()
 {
 	// Clear the screen and buffer
-	glClearColor(0.0f, 0.55f, 1.00f, 1.00f);
+	CRenderState::GetInstance()->ClearColor(0.0f, 0.55f, 1.00f, 1.00f);
 
 	//Draw the background
  	background->Render();
@@ -26,12 +26,16 @@
 
  // Include shader
 #include "RenderControl\shader.h"
+// Include CRenderState
+#include "RenderControl\RenderState.h"
 
 // Include CSettings
 #include "GameControl/Settings.h"
 
 // Include CKeyboardController
 #include "Inputs/KeyboardController.h"
+// Include CInputRecorder to replay the mouse of the GUI
+#include "Inputs/InputRecorder.h"
 
 #include <iostream>
 #include "System\filesystem.h"
@@ -86,13 +90,13 @@ bool CMenuState::Init(void)
 	// Load the images for buttons
 	CImageLoader* il = CImageLoader::GetInstance();
 	play2DButtonData.fileName = "Image\\GUI\\PlayButton.png";
-	play2DButtonData.textureID = il->LoadTextureGetID(play2DButtonData.fileName.c_str(), false);
+	play2DButtonData.textureID = il->LoadTextureAsync(play2DButtonData.fileName.c_str(), false);
 
 	play3DButtonData.fileName = "Image\\GUI\\PlayButton_3D.png";
-	play3DButtonData.textureID = il->LoadTextureGetID(play3DButtonData.fileName.c_str(), false);
+	play3DButtonData.textureID = il->LoadTextureAsync(play3DButtonData.fileName.c_str(), false);
 
 	exitButtonData.fileName = "Image\\GUI\\ExitButton.png";
-	exitButtonData.textureID = il->LoadTextureGetID(exitButtonData.fileName.c_str(), false);
+	exitButtonData.textureID = il->LoadTextureAsync(exitButtonData.fileName.c_str(), false);
 
 	// Enable the cursor
 	if (CSettings::GetInstance()->bDisableMousePointer == true)
@@ -113,6 +117,7 @@ bool CMenuState::Update(const double dElapsedTime)
 	// Start the Dear ImGui frame
 	ImGui_ImplOpenGL3_NewFrame();
 	ImGui_ImplGlfw_NewFrame();
+	CInputRecorder::GetInstance()->UpdateGUIInputs();
 	ImGui::NewFrame();
 
 	ImGuiWindowFlags window_flags = 0;
@@ -195,7 +200,7 @@ bool CMenuState::Update(const double dElapsedTime)
 void CMenuState::Render(void)
 {
 	// Clear the screen and buffer
-	glClearColor(0.0f, 0.55f, 1.00f, 1.00f);
+	CRenderState::GetInstance()->ClearColor(0.0f, 0.55f, 1.00f, 1.00f);
 
 	//Render Background
 	background->Render();
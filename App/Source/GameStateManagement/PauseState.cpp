@@ -26,6 +26,8 @@
 
  // Include shader
 #include "RenderControl\shader.h"
+// Include CRenderState
+#include "RenderControl\RenderState.h"
 
 // Include CSettings
 #include "GameControl/Settings.h"
@@ -68,9 +70,9 @@ bool CPauseState::Init(void)
 	// Load the images for buttons
 	CImageLoader* il = CImageLoader::GetInstance();
 	VolumeIncreaseButtonData.fileName = "Image\\GUI\\VolumeIncreaseButton.png";
-	VolumeIncreaseButtonData.textureID = il->LoadTextureGetID(VolumeIncreaseButtonData.fileName.c_str(), false);
+	VolumeIncreaseButtonData.textureID = il->LoadTextureAsync(VolumeIncreaseButtonData.fileName.c_str(), false);
 	VolumeDecreaseButtonData.fileName = "Image\\GUI\\VolumeDecreaseButton.png";
-	VolumeDecreaseButtonData.textureID = il->LoadTextureGetID(VolumeDecreaseButtonData.fileName.c_str(), false);
+	VolumeDecreaseButtonData.textureID = il->LoadTextureAsync(VolumeDecreaseButtonData.fileName.c_str(), false);
 
 	return true;
 }
@@ -152,7 +154,7 @@ bool CPauseState::Update(const double dElapsedTime)
 void CPauseState::Render(void)
 {
 	// Clear the screen and buffer
-	glClearColor(0.0f, 0.55f, 1.00f, 1.00f);
+	CRenderState::GetInstance()->ClearColor(0.0f, 0.55f, 1.00f, 1.00f);
 
 	//cout << "CPauseState::Render()\n" << endl;
 }
@@ -114,6 +114,16 @@ bool CPlayGameState::Update(const double dElapsedTime)
 	return true;
 }
 
+/**
+ @brief Update the simulation of this class instance by a tick
+ */
+bool CPlayGameState::FixedUpdate(const double dElapsedTime)
+{
+	cScene2D->FixedUpdate(dElapsedTime);
+
+	return true;
+}
+
 /**
  @brief Render this class instance
  */
@@ -26,6 +26,8 @@ public:
 	virtual bool Init(void);
 	// Update this class instance
 	virtual bool Update(const double dElapsedTime);
+	// Update the simulation of this class instance by a tick
+	virtual bool FixedUpdate(const double dElapsedTime);
 	// Render this class instance
 	virtual void Render(void);
 	// Destroy this class instance
@@ -0,0 +1,198 @@
+/**
+ CHeadlessSimulation
+ @brief A class to run the game simulation without a window, GL context, sound device or GUI.
+		The map is loaded, turrets are placed from a script around the player's spawn,
+		and the waves are ticked by CScene2D::FixedUpdate() as fast as the CPU can run them.
+		The time and state of each wave and the outcome are printed.
+		Run the application with "--headless" and optionally the number of waves.
+ */
+#include "HeadlessSimulation.h"
+
+// Include the null render backend
+#include "RenderControl\RenderBackendNull.h"
+// Include CRenderState
+#include "RenderControl\RenderState.h"
+// Include CRenderQueue
+#include "RenderControl\RenderQueue.h"
+// Include Shader Manager
+#include "RenderControl\ShaderManager.h"
+// Include CMeshManager
+#include "Primitives\MeshManager.h"
+// Include CAnimationSetManager
+#include "Primitives\AnimationSetManager.h"
+// Include CImageLoader
+#include "System\ImageLoader.h"
+// Include CAssetPack
+#include "System\AssetPack.h"
+// Include CSettings
+#include "GameControl\Settings.h"
+// Include CStopWatch
+#include "TimeControl\StopWatch.h"
+// Include CMetricsRegistry, which the scene adds its metrics to
+#include "System\MetricsRegistry.h"
+// Include CSoundController, which has no sound device as it is not initialised
+#include "SoundController\SoundController.h"
+// Include CJobSystem which runs the jobs on the worker threads
+#include "System\JobSystem.h"
+// Include CRandomService which owns the random streams
+#include "System\RandomService.h"
+// Include CScene2D
+#include "Scene2D\Scene2D.h"
+// Include CInventoryManager for the lives of the player and the health of the base
+#include "Scene2D\InventoryManager.h"
+
+#include <iostream>
+#include <thread>
+#include <chrono>
+using namespace std;
+
+// Include Filesystem
+#include "System\filesystem.h"
+
+// The offsets from the player's spawn, in tiles, where the turrets are placed in this order
+static const int arrTurretOffsets[][2] = {
+	{ -2, -2 }, { -2, 2 }, { 2, -2 }, { 2, 2 },
+	{ 0, -3 }, { 0, 3 }, { -3, 0 }, { 3, 0 } };
+
+/**
+ @brief Run the simulation for a number of waves
+ @param uiNumWaves The number of waves to run. The last wave does not end, so it is at most 9
+ @return true if the simulation ran, otherwise false
+ */
+bool CHeadlessSimulation::Run(const unsigned int uiNumWaves)
+{
+	CSettings* cSettings = CSettings::GetInstance();
+	cSettings->bHeadless = true;
+
+	// Send all the calls to the null backend. This is set before any resource is created
+	CRenderState* cRenderState = CRenderState::GetInstance();
+	cRenderState->SetBackend(new CRenderBackendNull());
+	cRenderState->Viewport(0, 0, cSettings->iWindowWidth, cSettings->iWindowHeight);
+
+	// Start the job workers, one for each core but the main thread's
+	CJobSystem::GetInstance()->Init();
+
+	// Load the assets in the same way as the game
+	if (cSettings->bUseAssetPack == true)
+	{
+		if (CAssetPack::GetInstance()->Open(FileSystem::getPath(cSettings->sAssetPackFile)) == false)
+			cout << "CHeadlessSimulation::Run(): No asset pack was found. Loading the loose files." << endl;
+	}
+	CShaderManager::GetInstance()->Add("Shader2D", "Shader//Shader2D.vs", "Shader//Shader2D.fs");
+	CShaderManager::GetInstance()->Add("Shader2D_Colour", "Shader//Shader2D_Colour.vs", "Shader//Shader2D_Colour.fs");
+
+	bool bResult = false;
+	CScene2D* cScene2D = CScene2D::GetInstance();
+	if (cScene2D->Init() == false)
+	{
+		cout << "CHeadlessSimulation::Run(): Failed to load CScene2D" << endl;
+	}
+	else
+	{
+		// Wait for the textures to be decoded, so that the waves do not include the uploads
+		CImageLoader* cImageLoader = CImageLoader::GetInstance();
+		while (cImageLoader->GetNumPendingLoads() > 0)
+		{
+			cImageLoader->Update(1.0);
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		unsigned int uiNumTurrets = PlaceTurrets(cScene2D);
+		cout << "CHeadlessSimulation::Run(): Placed " << uiNumTurrets << " turrets. Running "
+			<< uiNumWaves << " waves with the " << cRenderState->GetBackend()->GetName() << " backend and the random seed "
+			<< CRandomService::GetInstance()->GetSeed() << endl;
+		RunWaves(cScene2D, uiNumWaves);
+		bResult = true;
+	}
+
+	// Destroy the singletons in the same order as Application::Destroy()
+	CSoundController::GetInstance()->Destroy();
+	cScene2D->Destroy();
+	// The GUI destroys the inventory in the game, but there is no GUI here
+	CInventoryManager::GetInstance()->Destroy();
+	CShaderManager::GetInstance()->Destroy();
+	CMeshManager::GetInstance()->Destroy();
+	CAnimationSetManager::GetInstance()->Destroy();
+	CImageLoader::GetInstance()->Destroy();
+	CAssetPack::GetInstance()->Destroy();
+	CRenderQueue::GetInstance()->Destroy();
+	CFrameTimer::GetInstance()->Destroy();
+	CRenderState::GetInstance()->Destroy();
+	CMouseController::GetInstance()->Destroy();
+	CKeyboardController::GetInstance()->Destroy();
+	CJobSystem::GetInstance()->Destroy();
+	CMetricsRegistry::GetInstance()->Destroy();
+	CRandomService::GetInstance()->Destroy();
+	cSettings->Destroy();
+
+	return bResult;
+}
+
+/**
+ @brief Place the scripted turrets around the player's spawn. The tiles which are not empty are skipped
+ @param cScene2D The scene
+ @return The number of turrets which were placed
+ */
+unsigned int CHeadlessSimulation::PlaceTurrets(CScene2D* cScene2D)
+{
+	const glm::vec2& vec2SpawnIndex = CMap2D::GetInstance()->GetPlayerSpawnIndex();
+	unsigned int uiNumTurrets = 0;
+	for (unsigned int i = 0; i < sizeof(arrTurretOffsets) / sizeof(arrTurretOffsets[0]); i++)
+	{
+		if (cScene2D->AddTurret((int)vec2SpawnIndex.y + arrTurretOffsets[i][0], (int)vec2SpawnIndex.x + arrTurretOffsets[i][1]))
+			uiNumTurrets++;
+	}
+	return uiNumTurrets;
+}
+
+/**
+ @brief Tick the scene as fast as possible until a number of waves are over or the base falls,
+		and print the ticks, time and state at the end of each wave
+ @param cScene2D The scene
+ @param uiNumWaves The number of waves to run
+ */
+void CHeadlessSimulation::RunWaves(CScene2D* cScene2D, const unsigned int uiNumWaves)
+{
+	CSettings* cSettings = CSettings::GetInstance();
+	CGameManager* cGameManager = CGameManager::GetInstance();
+	CInventoryManager* cInventoryManager = CInventoryManager::GetInstance();
+	CMetricsRegistry* cMetricsRegistry = CMetricsRegistry::GetInstance();
+
+	// The wave level stops at 10, so at most 9 waves can end
+	unsigned int uiWavesToRun = (uiNumWaves < 9) ? uiNumWaves : 9;
+	unsigned int uiWavesDone = 0;
+	unsigned long long ullTotalTicks = 0;
+	double dTotalTime = 0.0;
+
+	CStopWatch cStopWatch;
+	while ((uiWavesDone < uiWavesToRun) && (cGameManager->bPlayerLost == false))
+	{
+		int iWaveLevel = cScene2D->getWaveLevel();
+		unsigned int uiNumTicks = 0;
+		cStopWatch.StartTimer();
+		while ((cScene2D->getWaveLevel() == iWaveLevel) && (cGameManager->bPlayerLost == false))
+		{
+			cScene2D->FixedUpdate(cSettings->dTickElapsedTime);
+			// Each tick is a frame of the metrics, so that a dump has the game time in it
+			cMetricsRegistry->EndFrame(cSettings->dFixedTimeStep);
+			uiNumTicks++;
+		}
+		double dElapsedTime = cStopWatch.GetElapsedTime();
+		ullTotalTicks += uiNumTicks;
+		dTotalTime += dElapsedTime;
+		if (cGameManager->bPlayerLost == false)
+			uiWavesDone++;
+
+		cout << "CHeadlessSimulation: Wave " << iWaveLevel << (cGameManager->bPlayerLost ? " lost" : " survived") << ": "
+			<< uiNumTicks << " ticks in " << dElapsedTime * 1000.0 << " ms ("
+			<< (uiNumTicks > 0 ? dElapsedTime / uiNumTicks * 1000.0 : 0.0) << " ms per tick)" << endl;
+		cout << "\t" << cScene2D->getEnemyVec().size() << " enemies, "
+			<< cScene2D->getTurretVec().size() << " turrets, base HP "
+			<< cInventoryManager->GetItem("Base HP")->GetCount() << ", player lives "
+			<< cInventoryManager->GetItem("Lives")->GetCount() << endl;
+	}
+
+	cout << "CHeadlessSimulation: " << (cGameManager->bPlayerLost ? "Lost" : "Survived") << " after "
+		<< uiWavesDone << " of " << uiWavesToRun << " waves: " << ullTotalTicks << " ticks ("
+		<< ullTotalTicks * cSettings->dFixedTimeStep << " s of game time) in " << dTotalTime * 1000.0 << " ms" << endl;
+}
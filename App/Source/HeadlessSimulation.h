@@ -0,0 +1,25 @@
+/**
+ CHeadlessSimulation
+ @brief A class to run the game simulation without a window, GL context, sound device or GUI.
+		The map is loaded, turrets are placed from a script around the player's spawn,
+		and the waves are ticked by CScene2D::FixedUpdate() as fast as the CPU can run them.
+		The time and state of each wave and the outcome are printed.
+		Run the application with "--headless" and optionally the number of waves.
+ */
+#pragma once
+
+class CScene2D;
+
+class CHeadlessSimulation
+{
+public:
+	// Run the simulation for a number of waves, and return true if it ran
+	static bool Run(const unsigned int uiNumWaves);
+
+protected:
+	// Place the scripted turrets around the player's spawn, and return the number which were placed
+	static unsigned int PlaceTurrets(CScene2D* cScene2D);
+
+	// Tick the scene until a number of waves are over or the base falls, and print each wave
+	static void RunWaves(CScene2D* cScene2D, const unsigned int uiNumWaves);
+};
@@ -0,0 +1,131 @@
+/**
+ CJobBenchmark
+ @brief A class to measure CJobSystem: the cost of creating, running and waiting for a job,
+		and how a ParallelFor() over a fixed amount of work scales from one thread to all the cores.
+		Run the application with "--job-benchmark" and optionally the number of jobs.
+ */
+#include "JobBenchmark.h"
+
+// Include CJobSystem
+#include "System\JobSystem.h"
+// Include CStopWatch
+#include "TimeControl\StopWatch.h"
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+using namespace std;
+
+// The number of jobs which are created before they are waited for, which is less than CJobSystem::NUM_JOBS
+static const unsigned int NUM_BATCH_JOBS = 1024;
+// The number of items of the ParallelFor(), the items in a part, and the iterations of an item
+static const unsigned int NUM_ITEMS = 65536;
+static const unsigned int NUM_GRAIN_ITEMS = 256;
+static const unsigned int NUM_ITEM_ITERATIONS = 256;
+// The number of times the ParallelFor() is run. The fastest time is used
+static const unsigned int NUM_REPEATS = 5;
+
+/**
+ @brief Run the benchmarks
+ @param uiNumJobs The number of empty jobs to create for the spawn benchmark
+ @return true if the benchmarks ran, otherwise false
+ */
+bool CJobBenchmark::Run(const unsigned int uiNumJobs)
+{
+	CJobSystem* cJobSystem = CJobSystem::GetInstance();
+	unsigned int uiMaxThreads = std::thread::hardware_concurrency();
+	if (uiMaxThreads == 0)
+		uiMaxThreads = 1;
+
+	// The cost of a job, on the main thread only and with all the workers
+	cJobSystem->Init(0);
+	SpawnJobs(uiNumJobs);
+	if (uiMaxThreads > 1)
+	{
+		cJobSystem->Init(uiMaxThreads - 1);
+		SpawnJobs(uiNumJobs);
+	}
+
+	// The scaling of the same work from 1 thread to all the cores
+	double dSingleTime = 0.0;
+	unsigned int uiNumThreads = 1;
+	while (true)
+	{
+		cJobSystem->Init(uiNumThreads - 1);
+		double dTime = RunParallelFor(NUM_ITEMS);
+		if (uiNumThreads == 1)
+			dSingleTime = dTime;
+
+		double dSpeedUp = dSingleTime / dTime;
+		cout << "CJobBenchmark: ParallelFor() of " << NUM_ITEMS << " items on " << uiNumThreads << " threads: "
+			<< dTime * 1000.0 << " ms, " << dSpeedUp << "x speed up, "
+			<< dSpeedUp / uiNumThreads * 100.0 << "% efficiency" << endl;
+
+		if (uiNumThreads == uiMaxThreads)
+			break;
+		uiNumThreads = (uiNumThreads * 2 < uiMaxThreads) ? uiNumThreads * 2 : uiMaxThreads;
+	}
+
+	cJobSystem->Destroy();
+	return true;
+}
+
+/**
+ @brief Create, run and wait for a number of empty jobs in batches, and print the time per job
+ @param uiNumJobs The number of jobs
+ */
+void CJobBenchmark::SpawnJobs(const unsigned int uiNumJobs)
+{
+	CJobSystem* cJobSystem = CJobSystem::GetInstance();
+	CJobSystem::JobFunction fnEmpty = []() {};
+
+	CStopWatch cStopWatch;
+	cStopWatch.StartTimer();
+	unsigned int uiNumDone = 0;
+	while (uiNumDone < uiNumJobs)
+	{
+		unsigned int uiBatch = (uiNumJobs - uiNumDone < NUM_BATCH_JOBS) ? uiNumJobs - uiNumDone : NUM_BATCH_JOBS;
+		CJobSystem::SJob* pRoot = cJobSystem->CreateJob(CJobSystem::JobFunction());
+		for (unsigned int i = 0; i < uiBatch; i++)
+			cJobSystem->Run(cJobSystem->CreateJob(fnEmpty, pRoot));
+		cJobSystem->Run(pRoot);
+		cJobSystem->Wait(pRoot);
+		uiNumDone += uiBatch;
+	}
+	double dElapsedTime = cStopWatch.GetElapsedTime();
+
+	cout << "CJobBenchmark: " << uiNumJobs << " empty jobs on " << cJobSystem->GetNumThreads() << " threads: "
+		<< dElapsedTime * 1000000000.0 / uiNumJobs << " ns per job" << endl;
+}
+
+/**
+ @brief Run a ParallelFor() over a fixed amount of work a few times
+ @param uiNumItems The number of items
+ @return The fastest time in seconds
+ */
+double CJobBenchmark::RunParallelFor(const unsigned int uiNumItems)
+{
+	std::vector<float> results(uiNumItems, 0.0f);
+	CJobSystem::RangeFunction fnRange = [&results](const unsigned int uiBegin, const unsigned int uiEnd)
+	{
+		for (unsigned int i = uiBegin; i < uiEnd; i++)
+		{
+			float fValue = (float)i;
+			for (unsigned int j = 0; j < NUM_ITEM_ITERATIONS; j++)
+				fValue = sqrtf(fValue + (float)j);
+			results[i] = fValue;
+		}
+	};
+
+	double dFastestTime = 0.0;
+	CStopWatch cStopWatch;
+	for (unsigned int i = 0; i < NUM_REPEATS; i++)
+	{
+		cStopWatch.StartTimer();
+		CJobSystem::GetInstance()->ParallelFor(uiNumItems, NUM_GRAIN_ITEMS, fnRange);
+		double dTime = cStopWatch.GetElapsedTime();
+		if ((i == 0) || (dTime < dFastestTime))
+			dFastestTime = dTime;
+	}
+	return dFastestTime;
+}
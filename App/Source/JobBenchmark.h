@@ -0,0 +1,21 @@
+/**
+ CJobBenchmark
+ @brief A class to measure CJobSystem: the cost of creating, running and waiting for a job,
+		and how a ParallelFor() over a fixed amount of work scales from one thread to all the cores.
+		Run the application with "--job-benchmark" and optionally the number of jobs.
+ */
+#pragma once
+
+class CJobBenchmark
+{
+public:
+	// Run the benchmarks with a number of jobs, and return true if they ran
+	static bool Run(const unsigned int uiNumJobs);
+
+protected:
+	// Create, run and wait for a number of empty jobs, and print the time per job
+	static void SpawnJobs(const unsigned int uiNumJobs);
+
+	// Run a ParallelFor() over a fixed amount of work, and return the time in seconds
+	static double RunParallelFor(const unsigned int uiNumItems);
+};
@@ -0,0 +1,172 @@
+/**
+ CRenderBenchmark
+ @brief A class to measure the CPU cost of submitting the map through CRenderQueue and CRenderState,
+		with the null render backend so that no window or GPU is needed.
+		The map is drawn tile by tile and from its cache, and the time and calls per frame are printed.
+		Run the application with "--render-benchmark" and optionally the number of frames.
+ */
+#include "RenderBenchmark.h"
+
+// Include the null render backend
+#include "RenderControl\RenderBackendNull.h"
+// Include CRenderQueue
+#include "RenderControl\RenderQueue.h"
+// Include Shader Manager
+#include "RenderControl\ShaderManager.h"
+// Include CMeshManager
+#include "Primitives\MeshManager.h"
+// Include CImageLoader
+#include "System\ImageLoader.h"
+// Include CAssetPack
+#include "System\AssetPack.h"
+// Include CSettings
+#include "GameControl\Settings.h"
+// Include CKeyboardController, which CMap2D resets
+#include "Inputs\KeyboardController.h"
+// Include CStopWatch
+#include "TimeControl\StopWatch.h"
+// Include CMap2D
+#include "Scene2D\Map2D.h"
+// Include CMetricsRegistry, which CMap2D adds its metrics to
+#include "System\MetricsRegistry.h"
+
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <cstring>
+using namespace std;
+
+// Include Filesystem
+#include "System\filesystem.h"
+
+/**
+ @brief Run the benchmark for a number of frames in each mode
+ @param uiNumFrames The number of frames to render in each mode
+ @return true if the benchmark ran, otherwise false
+ */
+bool CRenderBenchmark::Run(const unsigned int uiNumFrames)
+{
+	CSettings* cSettings = CSettings::GetInstance();
+
+	// Send all the calls to the null backend. This is set before any resource is created
+	CRenderState* cRenderState = CRenderState::GetInstance();
+	cRenderState->SetBackend(new CRenderBackendNull());
+	cRenderState->Viewport(0, 0, cSettings->iWindowWidth, cSettings->iWindowHeight);
+
+	// Load the assets in the same way as the game
+	if (cSettings->bUseAssetPack == true)
+	{
+		if (CAssetPack::GetInstance()->Open(FileSystem::getPath(cSettings->sAssetPackFile)) == false)
+			cout << "CRenderBenchmark::Run(): No asset pack was found. Loading the loose files." << endl;
+	}
+	CShaderManager::GetInstance()->Add("Shader2D", "Shader//Shader2D.vs", "Shader//Shader2D.fs");
+	CShaderManager::GetInstance()->Add("Shader2D_Colour", "Shader//Shader2D_Colour.vs", "Shader//Shader2D_Colour.fs");
+
+	bool bResult = false;
+	CMap2D* cMap2D = CMap2D::GetInstance();
+	cMap2D->SetShader("Shader2D");
+	if (cMap2D->Init(1, 64, 64) == false)
+	{
+		cout << "CRenderBenchmark::Run(): Failed to load CMap2D" << endl;
+	}
+	else if (cMap2D->LoadMap("Maps/DM2213_Map_Level_03.csv", 0) == false)
+	{
+		cout << "CRenderBenchmark::Run(): Failed to load the map" << endl;
+	}
+	else
+	{
+		// Wait for the textures to be decoded, so that the frames do not include the uploads
+		CImageLoader* cImageLoader = CImageLoader::GetInstance();
+		while (cImageLoader->GetNumPendingLoads() > 0)
+		{
+			cImageLoader->Update(1.0);
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		cout << "CRenderBenchmark::Run(): Rendering " << uiNumFrames << " frames per mode with the "
+			<< cRenderState->GetBackend()->GetName() << " backend" << endl;
+		RenderFrames(uiNumFrames, false);
+		RenderFrames(uiNumFrames, true);
+		bResult = true;
+	}
+
+	// Destroy the singletons in the same order as Application::Destroy()
+	cMap2D->Destroy();
+	CShaderManager::GetInstance()->Destroy();
+	CMeshManager::GetInstance()->Destroy();
+	CImageLoader::GetInstance()->Destroy();
+	CAssetPack::GetInstance()->Destroy();
+	CRenderQueue::GetInstance()->Destroy();
+	CRenderState::GetInstance()->Destroy();
+	CKeyboardController::GetInstance()->Destroy();
+	CMetricsRegistry::GetInstance()->Destroy();
+	cSettings->Destroy();
+
+	return bResult;
+}
+
+/**
+ @brief Render the map for a number of frames, and print the average time and calls per frame
+ @param uiNumFrames The number of frames to render
+ @param bRenderCache true to draw the map from its cache, false to draw it tile by tile
+ */
+void CRenderBenchmark::RenderFrames(const unsigned int uiNumFrames, const bool bRenderCache)
+{
+	CMap2D* cMap2D = CMap2D::GetInstance();
+	CRenderQueue* cRenderQueue = CRenderQueue::GetInstance();
+	CRenderState* cRenderState = CRenderState::GetInstance();
+
+	cMap2D->SetRenderCache(bRenderCache);
+	// The same camera as the start of the game
+	glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	float fProjection = 1.0f / (float)CSettings::GetInstance()->NUM_TILES_MULTIPLIERX;
+	glm::mat4 projection = glm::ortho(-fProjection, fProjection, -fProjection, fProjection, -10.0f, 10.0f);
+
+	// Render one frame first, so that the cache is filled before it is measured
+	cRenderState->BeginFrame();
+	cRenderQueue->Begin(projection * view);
+	cMap2D->Render(view, projection);
+	cRenderQueue->Flush();
+
+	CRenderState::SStats sTotal;
+	memset(&sTotal, 0, sizeof(sTotal));
+	CStopWatch cStopWatch;
+	cStopWatch.StartTimer();
+	for (unsigned int i = 0; i < uiNumFrames; i++)
+	{
+		cRenderState->BeginFrame();
+		cRenderQueue->Begin(projection * view);
+		cMap2D->Render(view, projection);
+		cRenderQueue->Flush();
+		AddStats(sTotal, cRenderState->GetCurrentFrameStats());
+	}
+	double dElapsedTime = cStopWatch.GetElapsedTime();
+
+	cout << "CRenderBenchmark: Map drawn " << (bRenderCache ? "from its cache" : "tile by tile") << ": "
+		<< (dElapsedTime / uiNumFrames) * 1000.0 << " ms per frame" << endl;
+	cout << "\tper frame: " << sTotal.uiDrawCalls / uiNumFrames << " draw calls, "
+		<< sTotal.uiClears / uiNumFrames << " clears, "
+		<< sTotal.uiNumIndices / uiNumFrames << " indices, "
+		<< sTotal.uiIssued / uiNumFrames << " state changes (" << sTotal.uiSkipped / uiNumFrames << " skipped), "
+		<< sTotal.uiUniformUploads / uiNumFrames << " uniform uploads, "
+		<< sTotal.uiTextureBinds / uiNumFrames << " texture binds, "
+		<< (sTotal.ullBufferBytes + sTotal.ullTextureBytes) / uiNumFrames << " bytes uploaded" << endl;
+}
+
+/**
+ @brief Add the counters of a frame to a total
+ @param sTotal The total
+ @param sFrame The counters of a frame
+ */
+void CRenderBenchmark::AddStats(CRenderState::SStats& sTotal, const CRenderState::SStats& sFrame)
+{
+	sTotal.uiIssued += sFrame.uiIssued;
+	sTotal.uiSkipped += sFrame.uiSkipped;
+	sTotal.uiDrawCalls += sFrame.uiDrawCalls;
+	sTotal.uiClears += sFrame.uiClears;
+	sTotal.uiNumIndices += sFrame.uiNumIndices;
+	sTotal.uiUniformUploads += sFrame.uiUniformUploads;
+	sTotal.uiTextureBinds += sFrame.uiTextureBinds;
+	sTotal.ullBufferBytes += sFrame.ullBufferBytes;
+	sTotal.ullTextureBytes += sFrame.ullTextureBytes;
+}
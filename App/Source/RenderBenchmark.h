@@ -0,0 +1,25 @@
+/**
+ CRenderBenchmark
+ @brief A class to measure the CPU cost of submitting the map through CRenderQueue and CRenderState,
+		with the null render backend so that no window or GPU is needed.
+		The map is drawn tile by tile and from its cache, and the time and calls per frame are printed.
+		Run the application with "--render-benchmark" and optionally the number of frames.
+ */
+#pragma once
+
+// Include CRenderState for the counters of a frame
+#include "RenderControl\RenderState.h"
+
+class CRenderBenchmark
+{
+public:
+	// Run the benchmark for a number of frames in each mode, and return true if it ran
+	static bool Run(const unsigned int uiNumFrames);
+
+protected:
+	// Render the map for a number of frames, and print the average time and calls per frame
+	static void RenderFrames(const unsigned int uiNumFrames, const bool bRenderCache);
+
+	// Add the counters of a frame to a total
+	static void AddStats(CRenderState::SStats& sTotal, const CRenderState::SStats& sFrame);
+};
@@ -35,11 +35,8 @@ CBackgroundEntity::~CBackgroundEntity()
 
 bool CBackgroundEntity::Init()
 {
-	glGenVertexArrays(1, &VAO);
-	glBindVertexArray(VAO);
-
 	// Load a texture 
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID(textureName.c_str(), true);
+	iTextureID = CImageLoader::GetInstance()->LoadTextureAsync(textureName.c_str(), true);
 	if (iTextureID == 0)
 	{
 		cout << "Unable to load " << textureName.c_str() << endl;
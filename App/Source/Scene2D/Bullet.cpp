@@ -3,6 +3,16 @@
 #include "System\ImageLoader.h"
 
 #include "RenderControl\ShaderManager.h"
+// Include Render State
+#include "RenderControl\RenderState.h"
+// Include Render Queue
+#include "RenderControl\RenderQueue.h"
+// Include Mesh Manager
+#include "Primitives\MeshManager.h"
+// Include CProfiler for the profiler zones
+#include "TimeControl\Profiler.h"
+// Include CFixedTimeStep to draw the bullets between the ticks
+#include "TimeControl\FixedTimeStep.h"
 
 #include "Primitives/MeshBuilder.h"
 
@@ -20,14 +30,17 @@ CBullet::CBullet(glm::vec2 vec2Index, int direction)
 
 	cSettings = CSettings::GetInstance();
 
-	quadMesh = CMeshBuilder::GenerateQuad(glm::vec4(1, 1, 1, 1), cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT);
+	// Draw the bullet where it is fired from in the first frame, instead of moving it there
+	vec2UVCoordinate.x = cSettings->ConvertIndexToUVSpace(cSettings->x, vec2Index.x, false, vec2NumMicroSteps.x * cSettings->MICRO_STEP_XAXIS);
+	vec2UVCoordinate.y = cSettings->ConvertIndexToUVSpace(cSettings->y, vec2Index.y, false, vec2NumMicroSteps.y * cSettings->MICRO_STEP_YAXIS);
+	vec2PrevUVCoordinate = vec2UVCoordinate;
+
+	//CS: Use the unit quad which is shared by all the entities
+	quadMesh = CMeshManager::GetInstance()->GetUnitQuad();
 
 	CShaderManager::GetInstance()->Use("Shader2D_Colour");
 	SetShader("Shader2D_Colour");
 
-	glGenVertexArrays(1, &VAO);
-	glBindVertexArray(VAO);
-
 	// Load the player texture
 	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Scene2D/Bullet.png", true);
 	if (iTextureID == 0)
@@ -37,6 +50,7 @@ CBullet::CBullet(glm::vec2 vec2Index, int direction)
 
 	Directional = false;
 	bIsActive = true;
+	pEnemyVector = NULL;
 	RotateAngle = 0.0f;
 	Damage = 4;
 	ElementType = 0;
@@ -57,14 +71,17 @@ CBullet::CBullet(glm::vec2 vec2Index, int direction, int NEWDamage, int NewELEME
 
 	cSettings = CSettings::GetInstance();
 
-	quadMesh = CMeshBuilder::GenerateQuad(glm::vec4(1, 1, 1, 1), cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT);
+	// Draw the bullet where it is fired from in the first frame, instead of moving it there
+	vec2UVCoordinate.x = cSettings->ConvertIndexToUVSpace(cSettings->x, vec2Index.x, false, vec2NumMicroSteps.x * cSettings->MICRO_STEP_XAXIS);
+	vec2UVCoordinate.y = cSettings->ConvertIndexToUVSpace(cSettings->y, vec2Index.y, false, vec2NumMicroSteps.y * cSettings->MICRO_STEP_YAXIS);
+	vec2PrevUVCoordinate = vec2UVCoordinate;
+
+	//CS: Use the unit quad which is shared by all the entities
+	quadMesh = CMeshManager::GetInstance()->GetUnitQuad();
 
 	CShaderManager::GetInstance()->Use("Shader2D_Colour");
 	SetShader("Shader2D_Colour");
 
-	glGenVertexArrays(1, &VAO);
-	glBindVertexArray(VAO);
-
 	// Load the player texture
 	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Scene2D/Bullet.png", true);
 	if (iTextureID == 0)
@@ -74,6 +91,7 @@ CBullet::CBullet(glm::vec2 vec2Index, int direction, int NEWDamage, int NewELEME
 
 	Directional = false;
 	bIsActive = true;
+	pEnemyVector = NULL;
 	RotateAngle = 0.0f;
 	Damage = NEWDamage;
 	ElementType = NewELEMENT;
@@ -94,14 +112,17 @@ CBullet::CBullet(glm::vec2 vec2Index, glm::vec2 targetvec2Index, int NEWDamage,
 
 	cSettings = CSettings::GetInstance();
 
-	quadMesh = CMeshBuilder::GenerateQuad(glm::vec4(1, 1, 1, 1), cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT);
+	// Draw the bullet where it is fired from in the first frame, instead of moving it there
+	vec2UVCoordinate.x = cSettings->ConvertIndexToUVSpace(cSettings->x, vec2Index.x, false, vec2NumMicroSteps.x * cSettings->MICRO_STEP_XAXIS);
+	vec2UVCoordinate.y = cSettings->ConvertIndexToUVSpace(cSettings->y, vec2Index.y, false, vec2NumMicroSteps.y * cSettings->MICRO_STEP_YAXIS);
+	vec2PrevUVCoordinate = vec2UVCoordinate;
+
+	//CS: Use the unit quad which is shared by all the entities
+	quadMesh = CMeshManager::GetInstance()->GetUnitQuad();
 
 	CShaderManager::GetInstance()->Use("Shader2D_Colour");
 	SetShader("Shader2D_Colour");
 
-	glGenVertexArrays(1, &VAO);
-	glBindVertexArray(VAO);
-
 	// Load the player texture
 	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Scene2D/Bullet.png", true);
 	if (iTextureID == 0)
@@ -111,6 +132,7 @@ CBullet::CBullet(glm::vec2 vec2Index, glm::vec2 targetvec2Index, int NEWDamage,
 
 	Directional = true;
 	bIsActive = true;
+	pEnemyVector = NULL;
 	RotateAngle = 0.0f;
 	Damage = NEWDamage;
 	ElementType = NewELEMENT;
@@ -122,15 +144,20 @@ CBullet::CBullet(glm::vec2 vec2Index, glm::vec2 targetvec2Index, int NEWDamage,
 
 CBullet::~CBullet()
 {
-	// Optional: de-allocate all resources once they've outlived their purpose:
-	glDeleteVertexArrays(1, &VAO);
+	// The quadMesh is shared, so it is deleted by CMeshManager
+	quadMesh = NULL;
 }
 
 void CBullet::Update()
 {
+	PROFILE_FUNCTION();
+
 	if (!bIsActive)
 		return;
 
+	// Store the UV coordinates of the last tick, to draw the bullet between them and the new ones
+	vec2PrevUVCoordinate = vec2UVCoordinate;
+
 	if (Directional == true)
 	{
 		if (vec2Index == Targetvec2Index)
@@ -203,8 +230,8 @@ void CBullet::PreRender()
 		return;
 
 	// Activate blending mode
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	CRenderState::GetInstance()->SetBlend(true);
+	CRenderState::GetInstance()->BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 	// Activate the shader
 	CShaderManager::GetInstance()->Use(sShaderName);
@@ -215,32 +242,23 @@ void CBullet::Render(const glm::mat4& view, const glm::mat4& projection)
 	if (!bIsActive)
 		return;
 
-	glBindVertexArray(VAO);
-	// Get matrix's uniform location and set matrix
-	unsigned int transformLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "transform");
-	unsigned int colorLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "runtimeColour");
 	transform = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
 	//transform = glm::rotate(transform, RotateAngle * (3.14159256f / 180), glm::vec3(1.0f, 0.0f, 0.0f));
-	transform = glm::translate(transform, glm::vec3(vec2UVCoordinate.x, vec2UVCoordinate.y, 0.0f));
-	// Update the shaders with the latest transform
-	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(projection * view * transform));
-	glUniform4fv(colorLoc, 1, glm::value_ptr(runtimeColour));
-
-	// Bind textures on corresponding texture units
-	glActiveTexture(GL_TEXTURE0);
-	// Get the texture to be rendered
-	glBindTexture(GL_TEXTURE_2D, iTextureID);
-		// CS: Render the animated sprite
-		glBindVertexArray(VAO);
-		quadMesh->Render();
-		glBindVertexArray(0);
-	glBindTexture(GL_TEXTURE_2D, 0);
+	// The frame is between the last two ticks, so draw the bullet between its positions of those ticks
+	glm::vec2 vec2RenderUVCoordinate = glm::mix(vec2PrevUVCoordinate, vec2UVCoordinate, CFixedTimeStep::GetInstance()->GetInterpolation());
+	transform = glm::translate(transform, glm::vec3(vec2RenderUVCoordinate.x, vec2RenderUVCoordinate.y, 0.0f));
+	// Scale the shared unit quad to the size of a tile
+	transform = glm::scale(transform, glm::vec3(cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT, 1.0f));
+
+	// Submit the quad to the render queue, which is flushed by CScene2D
+	CRenderQueue::GetInstance()->Submit(CRenderQueue::LAYER_BULLET, cShader, iTextureID,
+										quadMesh, transform, runtimeColour);
 }
 
 void CBullet::PostRender()
 {
 	// Disable blending
-	glDisable(GL_BLEND);
+	CRenderState::GetInstance()->SetBlend(false);
 }
 
 bool CBullet::GetIsActive()
@@ -268,15 +286,18 @@ glm::vec2 CBullet::GetBulletPos()
 	return vec2Index;
 }
 
-void CBullet::SetEnemyVector(vector<CEntity2D*> NEWenemyVector)
+void CBullet::SetEnemyVector(const vector<CEntity2D*>& NEWenemyVector)
 {
-	enemyVector = NEWenemyVector;
+	pEnemyVector = &NEWenemyVector;
 }
 
 void CBullet::findNearestEnemy()
 {
 	glm::vec2 NEWLive;
 	nearestEnemy = nullptr;
+	if (pEnemyVector == NULL)
+		return;
+	const vector<CEntity2D*>& enemyVector = *pEnemyVector;
 	for (int i = 0; i < enemyVector.size(); i++)
 	{
 		glm::vec2 currIndex = glm::vec2(enemyVector[i]->vec2Index.x, enemyVector[i]->vec2Index.y);
@@ -48,11 +48,14 @@ private:
 	glm::vec2 Targetvec2Index;
 	glm::vec2 DivVector;
 
+	// The UV coordinates of the last tick. The bullet is drawn between them and vec2UVCoordinate
+	glm::vec2 vec2PrevUVCoordinate;
+
 	// Current color
 	glm::vec4 runtimeColour;
 
-	// A vector containing the instance of CEnemy2Ds
-	vector<CEntity2D*> enemyVector;
+	// The enemies which the bullet looks for. They are not copied, so they must stay valid while the bullet uses them
+	const vector<CEntity2D*>* pEnemyVector;
 
 	glm::vec2 nearestLive;
 	CEntity2D* nearestEnemy;
@@ -84,7 +87,7 @@ public:
 
 	glm::vec2 GetBulletPos();
 
-	void SetEnemyVector(vector<CEntity2D*>);
+	void SetEnemyVector(const vector<CEntity2D*>& NEWenemyVector);
 
 	void findNearestEnemy();
 
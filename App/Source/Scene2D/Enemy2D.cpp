@@ -7,11 +7,20 @@
 #include "Enemy2D.h"
 
 #include <iostream>
+#include <cassert>
 using namespace std;
 // Include Shader Manager
 #include "RenderControl\ShaderManager.h"
+// Include Render State
+#include "RenderControl\RenderState.h"
+// Include Render Queue
+#include "RenderControl\RenderQueue.h"
+// Include Mesh Manager
+#include "Primitives\MeshManager.h"
 // Include Mesh Builder
 #include "Primitives/MeshBuilder.h"
+// Include Animation Set Manager
+#include "Primitives\AnimationSetManager.h"
 
 // Include GLEW
 #include <GL/glew.h>
@@ -21,8 +30,17 @@ using namespace std;
 
 // Include the Map2D as we will use it to check the player's movements and actions
 #include "Map2D.h"
+// Include CProfiler for the profiler zones
+#include "TimeControl\Profiler.h"
+// Include CFixedTimeStep to draw the enemy2D between the ticks
+#include "TimeControl\FixedTimeStep.h"
+// Include CMetricsRegistry to count the collision tests
+#include "System\MetricsRegistry.h"
+// Include CRandomService for the random spawns and wind
+#include "System\RandomService.h"
 // Include math.h
 #include <math.h>
+#include <algorithm>
 
 /**
  @brief Constructor This constructor has protected access modifier as this class will be a Singleton
@@ -38,6 +56,8 @@ CEnemy2D::CEnemy2D(void)
 	, statusCounter(0)
 	, quadMesh(NULL)
 	, cSoundController(NULL)
+	, animatedEnemy(NULL)
+	, cRandom(NULL)
 {
 	transform = glm::mat4(1.0f);	// make sure to initialize matrix to identity matrix first
 
@@ -49,9 +69,12 @@ CEnemy2D::CEnemy2D(void)
 
 	// Initialise vec2UVCoordinate
 	vec2UVCoordinate = glm::vec2(0.0f);
+	vec2PrevUVCoordinate = glm::vec2(0.0f);
 
 	i32vec2Destination = glm::i32vec2(0, 0);	// Initialise the iDestination
 	i32vec2Direction = glm::i32vec2(0, 0);		// Initialise the iDirection
+
+	uiMetricCollisionTests = CMetricsRegistry::GetInstance()->AddCounter("Collision Tests");
 }
 
 /**
@@ -59,12 +82,8 @@ CEnemy2D::CEnemy2D(void)
  */
 CEnemy2D::~CEnemy2D(void)
 {
-	// Delete the quadMesh
-	if (quadMesh)
-	{
-		delete quadMesh;
-		quadMesh = NULL;
-	}
+	// The quadMesh is shared, so it is deleted by CMeshManager
+	quadMesh = NULL;
 
 	// We won't delete this since it was created elsewhere
 	cPlayer2D = NULL;
@@ -74,25 +93,64 @@ CEnemy2D::~CEnemy2D(void)
 
 	cInventoryItem = NULL;
 	cInventoryManager = NULL;
-	animatedEnemy = NULL;
+	if (animatedEnemy)
+	{
+		delete animatedEnemy;
+		animatedEnemy = NULL;
+	}
 	cMouseController = NULL;
 
 	// optional: de-allocate all resources once they've outlived their purpose:
-	glDeleteVertexArrays(1, &VAO);
-	glDeleteBuffers(1, &VBO);
-	glDeleteBuffers(1, &EBO);
+	CRenderState::GetInstance()->DeleteBuffer(VBO);
+	CRenderState::GetInstance()->DeleteBuffer(EBO);
 }
 
 /**
-  @brief Initialise this instance
-  */
-bool CEnemy2D::Init(void)
+ @brief Get the animation clips shared by all the enemies, building them on the first call
+ @return The shared animation set
+ */
+const CAnimationSet* CEnemy2D::GetAnimationSet(void)
 {
+	const CAnimationSet* cAnimationSet = CAnimationSetManager::GetInstance()->Get("Enemy2D");
+	if (cAnimationSet)
+		return cAnimationSet;
+
+	// The clips are added in the order of ANIMATION, so their IDs match it
+	CAnimationSet* cNewAnimationSet = new CAnimationSet(13, 4);
+	//Movement
+	cNewAnimationSet->AddAnimation("right", 0, 3);
+	cNewAnimationSet->AddAnimation("left", 4, 7);
+	cNewAnimationSet->AddAnimation("Hright", 8, 11);
+	cNewAnimationSet->AddAnimation("Hleft", 12, 15);
+
+	//movement with status effect
+	//Burn
+	cNewAnimationSet->AddAnimation("burnRight", 16, 19);
+	cNewAnimationSet->AddAnimation("burnLeft", 20, 23);
+	cNewAnimationSet->AddAnimation("burnHright", 24, 27);
+	cNewAnimationSet->AddAnimation("burnHleft", 28, 31);
+	//Frozen
+	cNewAnimationSet->AddAnimation("frozenRight", 32, 35);
+	cNewAnimationSet->AddAnimation("frozenLeft", 36, 39);
+	cNewAnimationSet->AddAnimation("frozenHright", 40, 43);
+	cNewAnimationSet->AddAnimation("frozenHleft", 44, 47);
+	//Death
+	cNewAnimationSet->AddAnimation("Dright", 48, 51);
+	cNewAnimationSet->AddAnimation("Dleft", 52, 55);
 
-	// Rand seeding
-	//srand(time(NULL));
+	// Each clip in ANIMATION must have been added, or the IDs would not match the clips
+	assert(NUM_ANIMATIONS == cNewAnimationSet->GetNumAnimations());
 
+	return CAnimationSetManager::GetInstance()->Add("Enemy2D", cNewAnimationSet);
+}
 
+/**
+  @brief Initialise this instance
+  */
+bool CEnemy2D::Init(void)
+{
+	// The spawns and the wind use the stream of the enemies, which is seeded from the seed of the run
+	cRandom = CRandomService::GetInstance()->GetStream("Enemy2D");
 	MoveCooldown = 0;
 	AttackCooldown = 0;
 
@@ -125,25 +183,25 @@ bool CEnemy2D::Init(void)
 	cScene2D = CScene2D::GetInstance();
 
 	//Set the position of the enemy randomly on the edge of the map
-	int edge= rand() % 4;
+	int edge= cRandom->Int(4);
 	int X = 0, Y = 0;
 	switch (edge)
 	{
 	case 0:
-		X = rand() % 62;
+		X = cRandom->Int(62);
 		Y = 62;
 		break;
 	case 1:
 		X = 1;
-		Y = rand() % 62;
+		Y = cRandom->Int(62);
 		break;
 	case 2:
-		X = rand() % 62;
+		X = cRandom->Int(62);
 		Y = 1;
 		break;
 	case 3:
 		X = 62;
-		Y = rand() % 62;
+		Y = cRandom->Int(62);
 		break;
 	}
 	if (cMap2D->GetMapInfo(X, Y) != 0)
@@ -155,7 +213,7 @@ bool CEnemy2D::Init(void)
 
 
 	//Determining enemy type randomly
-	randType = rand() % cScene2D->getSpawnDeterminer();
+	randType = cRandom->Int(cScene2D->getSpawnDeterminer());
 	//randType = 69;
 	
 
@@ -219,12 +277,13 @@ bool CEnemy2D::Init(void)
 	Startvec2Index = vec2Index = glm::i32vec2(X, Y);
 	// By default, microsteps should be zero
 	i32vec2NumMicroSteps = glm::i32vec2(0, 0);
+	// Draw the enemy2D at the start position from the first frame, instead of moving it there
+	vec2UVCoordinate.x = cSettings->ConvertIndexToUVSpace(cSettings->x, vec2Index.x, false, i32vec2NumMicroSteps.x * cSettings->MICRO_STEP_XAXIS);
+	vec2UVCoordinate.y = cSettings->ConvertIndexToUVSpace(cSettings->y, vec2Index.y, false, i32vec2NumMicroSteps.y * cSettings->MICRO_STEP_YAXIS);
+	vec2PrevUVCoordinate = vec2UVCoordinate;
 
-	glGenVertexArrays(1, &VAO);
-	glBindVertexArray(VAO);
-
-	//CS: Create the Quad Mesh using the mesh builder
-	quadMesh = CMeshBuilder::GenerateQuad(glm::vec4(1, 1, 1, 1), cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT);
+	//CS: Use the unit quad which is shared by all the entities
+	quadMesh = CMeshManager::GetInstance()->GetUnitQuad();
 
 	if (enemyType == SKULL)
 	{
@@ -293,32 +352,11 @@ bool CEnemy2D::Init(void)
 	}
 
 
-	animatedEnemy = CMeshBuilder::GenerateSpriteAnimation(13, 4, cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT);
-	//Movement
-	animatedEnemy->AddAnimation("right", 0, 3);
-	animatedEnemy->AddAnimation("left", 4, 7);
-	animatedEnemy->AddAnimation("Hright", 8, 11);
-	animatedEnemy->AddAnimation("Hleft", 12, 15);
-
-	//movement with status effect
-	//Burn
-	animatedEnemy->AddAnimation("burnRight", 16, 19);
-	animatedEnemy->AddAnimation("burnLeft", 20, 23);
-	animatedEnemy->AddAnimation("burnHright", 24, 27);
-	animatedEnemy->AddAnimation("burnHleft", 28, 31);
-	//Frozen
-	animatedEnemy->AddAnimation("frozenRight", 32, 35);
-	animatedEnemy->AddAnimation("frozenLeft", 36, 39);
-	animatedEnemy->AddAnimation("frozenHright", 40, 43);
-	animatedEnemy->AddAnimation("frozenHleft", 44, 47);
-	//Death
-	animatedEnemy->AddAnimation("Dright", 48, 51);
-	animatedEnemy->AddAnimation("Dleft", 52, 55);
-
+	//CS: Create the animated sprite, which plays the clips shared by all the enemies
+	animatedEnemy = new CSpriteAnimation(GetAnimationSet());
 
-	
-	//CS: Play the "idle" animation as default
-	animatedEnemy->PlayAnimation("left", -1, 1.0f);
+	//CS: Play the "left" animation as default
+	animatedEnemy->PlayAnimation(ANIM_LEFT, -1, 1.0f);
 
 	//CS: Init the color to white
 	runtimeColour = glm::vec4(1.0, 1.0, 1.0, 1.0);
@@ -345,8 +383,8 @@ bool CEnemy2D::Init(void)
 bool CEnemy2D::babySlimeInit(glm::vec2 bossPos)
 {
 
-	// Rand seeding
-	srand(time(NULL));
+	// The spawns and the wind use the stream of the enemies, which is seeded from the seed of the run
+	cRandom = CRandomService::GetInstance()->GetStream("Enemy2D");
 
 
 	MoveCooldown = 0;
@@ -377,7 +415,7 @@ bool CEnemy2D::babySlimeInit(glm::vec2 bossPos)
 	cScene2D = CScene2D::GetInstance();
 
 	//Set the position of the enemy randomly on the edge of the map
-	int edge = rand() % 4;
+	int edge = cRandom->Int(4);
 	int X =bossPos.x, Y = bossPos.y;
 	//if (cMap2D->GetMapInfo(X, Y) != 0)
 	//{
@@ -394,12 +432,13 @@ bool CEnemy2D::babySlimeInit(glm::vec2 bossPos)
 	Startvec2Index = vec2Index = glm::i32vec2(X, Y);
 	// By default, microsteps should be zero
 	i32vec2NumMicroSteps = glm::i32vec2(0, 0);
+	// Draw the enemy2D at the start position from the first frame, instead of moving it there
+	vec2UVCoordinate.x = cSettings->ConvertIndexToUVSpace(cSettings->x, vec2Index.x, false, i32vec2NumMicroSteps.x * cSettings->MICRO_STEP_XAXIS);
+	vec2UVCoordinate.y = cSettings->ConvertIndexToUVSpace(cSettings->y, vec2Index.y, false, i32vec2NumMicroSteps.y * cSettings->MICRO_STEP_YAXIS);
+	vec2PrevUVCoordinate = vec2UVCoordinate;
 
-	glGenVertexArrays(1, &VAO);
-	glBindVertexArray(VAO);
-
-	//CS: Create the Quad Mesh using the mesh builder
-	quadMesh = CMeshBuilder::GenerateQuad(glm::vec4(1, 1, 1, 1), cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT);
+	//CS: Use the unit quad which is shared by all the entities
+	quadMesh = CMeshManager::GetInstance()->GetUnitQuad();
 
 
 	// Load the enemy2D texture
@@ -413,30 +452,11 @@ bool CEnemy2D::babySlimeInit(glm::vec2 bossPos)
 	MoveTime = 0.025;
 	AttackTime = 0.0f;
 
-	animatedEnemy = CMeshBuilder::GenerateSpriteAnimation(13, 4, cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT);
-	//Movement
-	animatedEnemy->AddAnimation("right", 0, 3);
-	animatedEnemy->AddAnimation("left", 4, 7);
-	animatedEnemy->AddAnimation("Hright", 8, 11);
-	animatedEnemy->AddAnimation("Hleft", 12, 15);
+	//CS: Create the animated sprite, which plays the clips shared by all the enemies
+	animatedEnemy = new CSpriteAnimation(GetAnimationSet());
 
-	//movement with status effect
-	//Burn
-	animatedEnemy->AddAnimation("burnRight", 16, 19);
-	animatedEnemy->AddAnimation("burnLeft", 20, 23);
-	animatedEnemy->AddAnimation("burnHright", 24, 27);
-	animatedEnemy->AddAnimation("burnHleft", 28, 31);
-	//Frozen
-	animatedEnemy->AddAnimation("frozenRight", 32, 35);
-	animatedEnemy->AddAnimation("frozenLeft", 36, 39);
-	animatedEnemy->AddAnimation("frozenHright", 40, 43);
-	animatedEnemy->AddAnimation("frozenHleft", 44, 47);
-	//Death
-	animatedEnemy->AddAnimation("Dright", 48, 51);
-	animatedEnemy->AddAnimation("Dleft", 52, 55);
-
-	//CS: Play the "idle" animation as default
-	animatedEnemy->PlayAnimation("left", -1, 1.0f);
+	//CS: Play the "left" animation as default
+	animatedEnemy->PlayAnimation(ANIM_LEFT, -1, 1.0f);
 
 	//CS: Init the color to white
 	runtimeColour = glm::vec4(1.0, 1.0, 1.0, 1.0);
@@ -463,8 +483,8 @@ bool CEnemy2D::babySlimeInit(glm::vec2 bossPos)
 //Slime boss's init
 bool CEnemy2D::slimeBossInit(void)
 {
-	// Rand seeding
-	srand(time(NULL));
+	// The spawns and the wind use the stream of the enemies, which is seeded from the seed of the run
+	cRandom = CRandomService::GetInstance()->GetStream("Enemy2D");
 
 
 	MoveCooldown = 0;
@@ -495,7 +515,7 @@ bool CEnemy2D::slimeBossInit(void)
 	cScene2D = CScene2D::GetInstance();
 
 	//Set the position of the enemy randomly on the edge of the map
-	int edge = rand() % 4;
+	int edge = cRandom->Int(4);
 	int X = 32, Y = 1;
 	if (cMap2D->GetMapInfo(X, Y) != 0)
 	{
@@ -516,12 +536,13 @@ bool CEnemy2D::slimeBossInit(void)
 	Startvec2Index = vec2Index = glm::i32vec2(X, Y);
 	// By default, microsteps should be zero
 	i32vec2NumMicroSteps = glm::i32vec2(0, 0);
+	// Draw the enemy2D at the start position from the first frame, instead of moving it there
+	vec2UVCoordinate.x = cSettings->ConvertIndexToUVSpace(cSettings->x, vec2Index.x, false, i32vec2NumMicroSteps.x * cSettings->MICRO_STEP_XAXIS);
+	vec2UVCoordinate.y = cSettings->ConvertIndexToUVSpace(cSettings->y, vec2Index.y, false, i32vec2NumMicroSteps.y * cSettings->MICRO_STEP_YAXIS);
+	vec2PrevUVCoordinate = vec2UVCoordinate;
 
-	glGenVertexArrays(1, &VAO);
-	glBindVertexArray(VAO);
-
-	//CS: Create the Quad Mesh using the mesh builder
-	quadMesh = CMeshBuilder::GenerateQuad(glm::vec4(1, 1, 1, 1), cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT);
+	//CS: Use the unit quad which is shared by all the entities
+	quadMesh = CMeshManager::GetInstance()->GetUnitQuad();
 
 
 	// Load the enemy2D texture
@@ -535,30 +556,11 @@ bool CEnemy2D::slimeBossInit(void)
 	MoveTime = 0.025;
 	AttackTime = 0.0f;
 
-	animatedEnemy = CMeshBuilder::GenerateSpriteAnimation(13, 4, cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT);
-	//Movement
-	animatedEnemy->AddAnimation("right", 0, 3);
-	animatedEnemy->AddAnimation("left", 4, 7);
-	animatedEnemy->AddAnimation("Hright", 8, 11);
-	animatedEnemy->AddAnimation("Hleft", 12, 15);
-
-	//movement with status effect
-	//Burn
-	animatedEnemy->AddAnimation("burnRight", 16, 19);
-	animatedEnemy->AddAnimation("burnLeft", 20, 23);
-	animatedEnemy->AddAnimation("burnHright", 24, 27);
-	animatedEnemy->AddAnimation("burnHleft", 28, 31);
-	//Frozen
-	animatedEnemy->AddAnimation("frozenRight", 32, 35);
-	animatedEnemy->AddAnimation("frozenLeft", 36, 39);
-	animatedEnemy->AddAnimation("frozenHright", 40, 43);
-	animatedEnemy->AddAnimation("frozenHleft", 44, 47);
-	//Death
-	animatedEnemy->AddAnimation("Dright", 48, 51);
-	animatedEnemy->AddAnimation("Dleft", 52, 55);
+	//CS: Create the animated sprite, which plays the clips shared by all the enemies
+	animatedEnemy = new CSpriteAnimation(GetAnimationSet());
 
-	//CS: Play the "idle" animation as default
-	animatedEnemy->PlayAnimation("left", -1, 1.0f);
+	//CS: Play the "left" animation as default
+	animatedEnemy->PlayAnimation(ANIM_LEFT, -1, 1.0f);
 
 	//CS: Init the color to white
 	runtimeColour = glm::vec4(1.0, 1.0, 1.0, 1.0);
@@ -587,6 +589,25 @@ bool CEnemy2D::slimeBossInit(void)
  */
 void CEnemy2D::Update(const double dElapsedTime)
 {
+	Think(dElapsedTime);
+	Apply();
+}
+
+/**
+ @brief Decide what this instance does in this tick. It reads the rest of the scene, but it only
+		changes this instance, so the enemies can think in parallel. The changes to the rest of the
+		scene are added to the actions, which Apply() does
+ @param dElapsedTime The time of the tick
+ */
+void CEnemy2D::Think(const double dElapsedTime)
+{
+	PROFILE_FUNCTION();
+
+	actions.clear();
+
+	// Store the UV coordinates of the last tick, to draw the enemy2D between them and the new ones
+	vec2PrevUVCoordinate = vec2UVCoordinate;
+
 	//Color tint display for HP
 	if (HP < (MAXHP / 2))
 	{
@@ -603,66 +624,24 @@ void CEnemy2D::Update(const double dElapsedTime)
 		meleeCounter++;
 	}
 
-	//Turret damage handler
+	//Turret damage handler. The hits are taken in Apply(), where the first enemy2D to take a bullet removes it
+	unsigned int uiNumCollisionTests = 0;
 	for (unsigned j = 0; j < cScene2D->getTurretVec().size(); ++j)
 	{
-		for (int i = cScene2D->getTurretVec()[j]->GetBulletGenerator()->GetBulletsVector().size() - 1; i >= 0; --i)
+		std::vector<CBullet*>& bullets = cScene2D->getTurretVec()[j]->GetBulletGenerator()->GetBulletsVector();
+		for (int i = bullets.size() - 1; i >= 0; --i)
 		{
-			if (cScene2D->getTurretVec()[j]->GetBulletGenerator()->GetBulletsVector()[i]->GetIsActive() == true)
+			if (bullets[i]->GetIsActive() == true)
 			{
-				if (glm::length(vec2Index - cScene2D->getTurretVec()[j]->GetBulletGenerator()->GetBulletsVector()[i]->GetBulletPos()) <= 2)
+				uiNumCollisionTests++;
+				if (glm::length(vec2Index - bullets[i]->GetBulletPos()) <= 2)
 				{
-					HP = HP - cScene2D->getTurretVec()[j]->GetBulletGenerator()->GetBulletsVector()[i]->GetDamage();
-					switch (cScene2D->getTurretVec()[j]->GetBulletGenerator()->GetBulletsVector()[i]->GetElement())
-					{
-						case 1:
-						{
-							status = BURN;
-							break;
-						}
-						case 2:
-						{
-							status = FREEZE;
-							break;
-						}
-						case 3:
-						{
-							int randomDirection = rand() % 4;
-							updateWindBLow(randomDirection);
-							break;
-						}
-						case 5:
-						{
-							if (status == FREEZE)
-							{
-								HP = HP - cScene2D->getTurretVec()[j]->GetBulletGenerator()->GetBulletsVector()[i]->GetDamage();
-							}
-							break;
-						}
-						default:
-						{
-							break;
-						}
-					}
-					cSoundController->PlaySoundByID(10);
-					if (HP <= 0)
-					{
-						sCurrentFSM = DEAD;
-
-						if (cScene2D->getEnemyVec().size() >= 0 && bIsActive == true)
-						{
-							//cout << cScene2D->getTurretVec()[j]->GetNearestEnemy() << endl;
-							cScene2D->getEnemyVec().erase(cScene2D->getEnemyVec().begin() + cScene2D->getTurretVec()[j]->GetNearestEnemy());
-						}
-					}
-					if (cScene2D->getTurretVec().size() > 0 && cScene2D->getTurretVec()[j]->GetBulletGenerator()->GetBulletsVector()[i]->GetIsActive() == true)
-					{
-						cScene2D->getTurretVec()[j]->GetBulletGenerator()->GetBulletsVector().erase((cScene2D->getTurretVec()[j]->GetBulletGenerator()->GetBulletsVector()).begin() + i);
-					}
+					AddAction(ACTION_TURRET_BULLET_HIT, j, bullets[i]);
 				}
 			}
 		}
 	}
+	CMetricsRegistry::GetInstance()->Add(uiMetricCollisionTests, uiNumCollisionTests);
 
 	//Status handler
 	switch (status)
@@ -716,22 +695,22 @@ void CEnemy2D::Update(const double dElapsedTime)
 		{
 			if (hitBox == true)
 			{
-				animatedEnemy->PlayAnimation("Hleft", -1, 1.0f);
+				animatedEnemy->PlayAnimation(ANIM_HLEFT, -1, 1.0f);
 			}
 			else
 			{
-				animatedEnemy->PlayAnimation("Left", -1, 1.0f);
+				animatedEnemy->PlayAnimation(ANIM_LEFT, -1, 1.0f);
 			}
 		}
 		else
 		{
 			if (hitBox == true)
 			{
-				animatedEnemy->PlayAnimation("Hright", -1, 1.0f);
+				animatedEnemy->PlayAnimation(ANIM_HRIGHT, -1, 1.0f);
 			}
 			else
 			{
-				animatedEnemy->PlayAnimation("Right", -1, 1.0f);
+				animatedEnemy->PlayAnimation(ANIM_RIGHT, -1, 1.0f);
 			}
 		}
 		switch (enemyType)
@@ -1000,21 +979,17 @@ void CEnemy2D::Update(const double dElapsedTime)
 			{
 				if (iFSMCounter >= 40)
 				{
-					cPlayer2D->changeBaseHP(ATK);
-					cSoundController->PlaySoundByID(9);
+					AddAction(ACTION_BASE_DAMAGE, ATK);
+					AddAction(ACTION_SOUND, 9);
 					iFSMCounter = 0;
 				}
 				break;
 			}
 			case SKULL:
 			{
-				cPlayer2D->UpdateHealthLives();
-				cSoundController->PlaySoundByID(7);
-				if (cScene2D->getEnemyVec().size() >= 0 && bIsActive == true)
-				{
-					cPlayer2D->findNearestEnemy();
-					cScene2D->getEnemyVec().erase(cScene2D->getEnemyVec().begin() + cPlayer2D->getNearestEnemy());
-				}
+				AddAction(ACTION_PLAYER_DAMAGE);
+				AddAction(ACTION_SOUND, 7);
+				AddAction(ACTION_REMOVE_NEAREST);
 				iFSMCounter = 0;
 				break;
 			}
@@ -1022,26 +997,14 @@ void CEnemy2D::Update(const double dElapsedTime)
 			{
 				if (iFSMCounter >= 40 && targetableTurret == false)
 				{
-					cPlayer2D->changeBaseHP(ATK);
-					cSoundController->PlaySoundByID(9);
+					AddAction(ACTION_BASE_DAMAGE, ATK);
+					AddAction(ACTION_SOUND, 9);
 					iFSMCounter = 0;
 				}
 				else if (iFSMCounter >= 40 && targetableTurret == true)
 				{
-					for (unsigned i = 0; i < cScene2D->getTurretVec().size(); ++i)
-					{
-						if (cScene2D->getTurretVec()[i]->getTurretPos() == findNearestTurret())
-						{
-							cScene2D->getTurretVec()[i]->SetGetTurretHP((cScene2D->getTurretVec()[i]->GetTurretHP() - ATK));
-							cSoundController->PlaySoundByID(9);
-							if (cScene2D->getTurretVec()[i]->GetTurretHP() <= 0)
-							{
-								sCurrentFSM = MOVING;
-							}
-							iFSMCounter = 0;
-							/*cout << cScene2D->getTurretVec()[i]->GetTurretHP() << "     " << cScene2D->getTurretVec().size() << endl;*/
-						}
-					}
+					AddAction(ACTION_TURRET_DAMAGE, ATK);
+					iFSMCounter = 0;
 				}
 				break;
 			}
@@ -1049,40 +1012,7 @@ void CEnemy2D::Update(const double dElapsedTime)
 			{
 				if (iFSMCounter >= 40)
 				{
-					if (cInventoryManager->GetItem("Iron")->GetCount() > 0 || cInventoryManager->GetItem("Bronze")->GetCount() > 0 ||
-						cInventoryManager->GetItem("Silver")->GetCount() > 0 || cInventoryManager->GetItem("Gold")->GetCount() > 0)
-					{
-						if (cInventoryManager->GetItem("Iron")->GetCount() > 0)
-						{
-							cInventoryItem = cInventoryManager->GetItem("Iron");
-							cInventoryItem->Remove(1);
-						}
-						if (cInventoryManager->GetItem("Bronze")->GetCount() > 0)
-						{
-							cInventoryItem = cInventoryManager->GetItem("Bronze");
-							cInventoryItem->Remove(1);
-						}
-						if (cInventoryManager->GetItem("Silver")->GetCount() > 0)
-						{
-							cInventoryItem = cInventoryManager->GetItem("Silver");
-							cInventoryItem->Remove(1);
-						}
-						if (cInventoryManager->GetItem("Gold")->GetCount() > 0)
-						{
-							cInventoryItem = cInventoryManager->GetItem("Gold");
-							cInventoryItem->Remove(1);
-						}
-						cSoundController->PlaySoundByID(11);
-					}
-					else
-					{
-						if (iFSMCounter >= 40)
-						{
-							cPlayer2D->UpdateHealthLives();
-							cSoundController->PlaySoundByID(12);
-							iFSMCounter = 0;
-						}
-					}
+					AddAction(ACTION_STEAL);
 					iFSMCounter = 0;
 				}
 				if (distance(vec2Index, cPlayer2D->vec2Index) >= 2)
@@ -1100,8 +1030,7 @@ void CEnemy2D::Update(const double dElapsedTime)
 	{
 		if (status == GOLD)
 		{
-			cInventoryItem = cInventoryManager->GetItem("Gold");
-			cInventoryItem->Add(1);
+			AddAction(ACTION_GOLD);
 		}
 		if (enemyType == SKULL || enemyType == SLIMEBABY)
 		{
@@ -1111,7 +1040,7 @@ void CEnemy2D::Update(const double dElapsedTime)
 		{
 			if (faceLeft == true)
 			{
-				animatedEnemy->PlayAnimation("Dleft", -1, 1.0f);
+				animatedEnemy->PlayAnimation(ANIM_DEAD_LEFT, -1, 1.0f);
 				if (iFSMCounter >= 43)
 				{
 					bIsActive = false;
@@ -1119,7 +1048,7 @@ void CEnemy2D::Update(const double dElapsedTime)
 			}
 			else
 			{
-				animatedEnemy->PlayAnimation("Dright", -1, 1.0f);
+				animatedEnemy->PlayAnimation(ANIM_DEAD_RIGHT, -1, 1.0f);
 				if (iFSMCounter >= 43)
 				{
 					bIsActive = false;
@@ -1128,8 +1057,7 @@ void CEnemy2D::Update(const double dElapsedTime)
 		}
 		else if (enemyType == SLIMEBOSS)
 		{
-			cScene2D->setSlimeBPos(vec2Index);
-			cScene2D->spawnExtraEnemy(4);
+			AddAction(ACTION_SPAWN_BABIES);
 			bIsActive = false;
 		}
 
@@ -1142,22 +1070,22 @@ void CEnemy2D::Update(const double dElapsedTime)
 		{
 			if (hitBox == true)
 			{
-				animatedEnemy->PlayAnimation("frozenHleft", -1, 1.0f);
+				animatedEnemy->PlayAnimation(ANIM_FROZEN_HLEFT, -1, 1.0f);
 			}
 			else
 			{
-				animatedEnemy->PlayAnimation("frozenLeft", -1, 1.0f);
+				animatedEnemy->PlayAnimation(ANIM_FROZEN_LEFT, -1, 1.0f);
 			}
 		}
 		else
 		{
 			if (hitBox == true)
 			{
-				animatedEnemy->PlayAnimation("frozenHright", -1, 1.0f);
+				animatedEnemy->PlayAnimation(ANIM_FROZEN_HRIGHT, -1, 1.0f);
 			}
 			else
 			{
-				animatedEnemy->PlayAnimation("frozenRight", -1, 1.0f);
+				animatedEnemy->PlayAnimation(ANIM_FROZEN_RIGHT, -1, 1.0f);
 			}
 		}
 		if (iFSMCounter >= 70)
@@ -1182,15 +1110,15 @@ void CEnemy2D::Update(const double dElapsedTime)
 				switch (status)
 				{
 				case NORMAL:
-					animatedEnemy->PlayAnimation("Hleft", -1, 1.0f);
+					animatedEnemy->PlayAnimation(ANIM_HLEFT, -1, 1.0f);
 					break;
 				case BURN:
-					animatedEnemy->PlayAnimation("burnHleft", -1, 1.0f);
+					animatedEnemy->PlayAnimation(ANIM_BURN_HLEFT, -1, 1.0f);
 					break;
 				}
 				//if (sCurrentFSM == FROZEN)
 				//{
-				//	animatedEnemy->PlayAnimation("frozenHleft", -1, 1.0f);
+				//	animatedEnemy->PlayAnimation(ANIM_FROZEN_HLEFT, -1, 1.0f);
 				//}
 			}
 			else
@@ -1198,15 +1126,15 @@ void CEnemy2D::Update(const double dElapsedTime)
 				switch (status)
 				{
 				case NORMAL:
-					animatedEnemy->PlayAnimation("left", -1, 1.0f);
+					animatedEnemy->PlayAnimation(ANIM_LEFT, -1, 1.0f);
 					break;
 				case BURN:
-					animatedEnemy->PlayAnimation("burnLeft", -1, 1.0f);
+					animatedEnemy->PlayAnimation(ANIM_BURN_LEFT, -1, 1.0f);
 					break;
 				}
 				//if (sCurrentFSM == FROZEN)
 				//{
-				//	animatedEnemy->PlayAnimation("frozenleft", -1, 1.0f);
+				//	animatedEnemy->PlayAnimation(ANIM_FROZEN_LEFT, -1, 1.0f);
 				//}
 			}
 		}
@@ -1217,15 +1145,15 @@ void CEnemy2D::Update(const double dElapsedTime)
 				switch (status)
 				{
 				case NORMAL:
-					animatedEnemy->PlayAnimation("Hright", -1, 1.0f);
+					animatedEnemy->PlayAnimation(ANIM_HRIGHT, -1, 1.0f);
 					break;
 				case BURN:
-					animatedEnemy->PlayAnimation("burnHright", -1, 1.0f);
+					animatedEnemy->PlayAnimation(ANIM_BURN_HRIGHT, -1, 1.0f);
 					break;
 				}
 				//if (sCurrentFSM == FROZEN)
 				//{
-				//	animatedEnemy->PlayAnimation("frozenHright", -1, 1.0f);
+				//	animatedEnemy->PlayAnimation(ANIM_FROZEN_HRIGHT, -1, 1.0f);
 				//}
 			}
 			else
@@ -1233,15 +1161,15 @@ void CEnemy2D::Update(const double dElapsedTime)
 				switch (status)
 				{
 				case NORMAL:
-					animatedEnemy->PlayAnimation("right", -1, 1.0f);
+					animatedEnemy->PlayAnimation(ANIM_RIGHT, -1, 1.0f);
 					break;
 				case BURN:
-					animatedEnemy->PlayAnimation("burnRight", -1, 1.0f);
+					animatedEnemy->PlayAnimation(ANIM_BURN_RIGHT, -1, 1.0f);
 					break;
 				}
 				//if (sCurrentFSM == FROZEN)
 				//{
-				//	animatedEnemy->PlayAnimation("frozenRight", -1, 1.0f);
+				//	animatedEnemy->PlayAnimation(ANIM_FROZEN_RIGHT, -1, 1.0f);
 				//}
 			}
 		}
@@ -1251,19 +1179,14 @@ void CEnemy2D::Update(const double dElapsedTime)
 		{
 			if (enemyType == SKULL)
 			{
-				cPlayer2D->UpdateHealthLives();
-				cSoundController->PlaySoundByID(7);
+				AddAction(ACTION_PLAYER_DAMAGE);
+				AddAction(ACTION_SOUND, 7);
+				AddAction(ACTION_REMOVE_NEAREST);
 				sCurrentFSM = DEAD;
-				if (cScene2D->getEnemyVec().size() >= 0 && bIsActive == true)
-				{
-					cPlayer2D->findNearestEnemy();
-					cScene2D->getEnemyVec().erase(cScene2D->getEnemyVec().begin() + cPlayer2D->getNearestEnemy());
-				}
-
 			}
 			else if ((enemyType == SKELE1 || enemyType == VAMPIRE) && sCurrentFSM != DEAD)
 			{
-				cPlayer2D->SetHitBox(true);
+				AddAction(ACTION_PLAYER_HITBOX);
 				sCurrentFSM = ATTACK;
 			}
 		}
@@ -1277,6 +1200,197 @@ void CEnemy2D::Update(const double dElapsedTime)
 	vec2UVCoordinate.y = cSettings->ConvertIndexToUVSpace(cSettings->y, vec2Index.y, false, i32vec2NumMicroSteps.y * cSettings->MICRO_STEP_YAXIS);
 }
 
+/**
+ @brief Do the actions which were decided in Think(), in the order which they were asked for.
+		The enemies apply their actions one at a time and in their order in the scene, so the
+		result does not depend on how the enemies were spread over the threads in Think()
+ */
+void CEnemy2D::Apply(void)
+{
+	PROFILE_FUNCTION();
+
+	for (unsigned int i = 0; i < actions.size(); i++)
+	{
+		const SAction& sAction = actions[i];
+		switch (sAction.eType)
+		{
+			case ACTION_SOUND:
+			{
+				cSoundController->PlaySoundByID(sAction.iValue);
+				break;
+			}
+			case ACTION_TURRET_BULLET_HIT:
+			{
+				if (sAction.iValue >= (int)cScene2D->getTurretVec().size())
+					break;
+				CTurret* cTurret = cScene2D->getTurretVec()[sAction.iValue];
+				std::vector<CBullet*>& bullets = cTurret->GetBulletGenerator()->GetBulletsVector();
+				// An enemy2D before this one may have taken the bullet already
+				std::vector<CBullet*>::iterator it = std::find(bullets.begin(), bullets.end(), sAction.pBullet);
+				if ((it == bullets.end()) || ((*it)->GetIsActive() == false))
+					break;
+
+				HP = HP - (*it)->GetDamage();
+				switch ((*it)->GetElement())
+				{
+					case 1:
+					{
+						status = BURN;
+						break;
+					}
+					case 2:
+					{
+						status = FREEZE;
+						break;
+					}
+					case 3:
+					{
+						int randomDirection = cRandom->Int(4);
+						updateWindBLow(randomDirection);
+						break;
+					}
+					case 5:
+					{
+						if (status == FREEZE)
+						{
+							HP = HP - (*it)->GetDamage();
+						}
+						break;
+					}
+					default:
+					{
+						break;
+					}
+				}
+				cSoundController->PlaySoundByID(10);
+				if (HP <= 0)
+				{
+					sCurrentFSM = DEAD;
+					if (bIsActive == true)
+					{
+						RemoveEnemy(cTurret->GetNearestEnemy());
+					}
+				}
+				bullets.erase(it);
+				break;
+			}
+			case ACTION_PLAYER_BULLET_HIT:
+			{
+				// An enemy2D before this one may have taken the bullet already
+				if (sAction.pBullet->GetIsActive() == false)
+					break;
+
+				HP = HP - sAction.pBullet->GetDamage();
+				sAction.pBullet->SetbIsActive(false);
+				if (HP <= 0 && sCurrentFSM != DEAD)
+				{
+					if (status == GOLD)
+					{
+						cInventoryItem = cInventoryManager->GetItem("Gold");
+						cInventoryItem->Add(1);
+					}
+					sCurrentFSM = DEAD;
+					if (bIsActive == true)
+					{
+						sAction.pBullet->findNearestEnemy();
+						RemoveEnemy(sAction.pBullet->getNearestEnemy());
+					}
+				}
+				break;
+			}
+			case ACTION_BASE_DAMAGE:
+			{
+				cPlayer2D->changeBaseHP(sAction.iValue);
+				break;
+			}
+			case ACTION_PLAYER_DAMAGE:
+			{
+				cPlayer2D->UpdateHealthLives();
+				break;
+			}
+			case ACTION_REMOVE_NEAREST:
+			{
+				if (bIsActive == true)
+				{
+					cPlayer2D->findNearestEnemy();
+					RemoveEnemy(cPlayer2D->getNearestEnemy());
+				}
+				break;
+			}
+			case ACTION_TURRET_DAMAGE:
+			{
+				for (unsigned j = 0; j < cScene2D->getTurretVec().size(); ++j)
+				{
+					if (cScene2D->getTurretVec()[j]->getTurretPos() == findNearestTurret())
+					{
+						cScene2D->getTurretVec()[j]->SetGetTurretHP((cScene2D->getTurretVec()[j]->GetTurretHP() - sAction.iValue));
+						cSoundController->PlaySoundByID(9);
+						if (cScene2D->getTurretVec()[j]->GetTurretHP() <= 0)
+						{
+							sCurrentFSM = MOVING;
+						}
+					}
+				}
+				break;
+			}
+			case ACTION_STEAL:
+			{
+				if (cInventoryManager->GetItem("Iron")->GetCount() > 0 || cInventoryManager->GetItem("Bronze")->GetCount() > 0 ||
+					cInventoryManager->GetItem("Silver")->GetCount() > 0 || cInventoryManager->GetItem("Gold")->GetCount() > 0)
+				{
+					if (cInventoryManager->GetItem("Iron")->GetCount() > 0)
+					{
+						cInventoryItem = cInventoryManager->GetItem("Iron");
+						cInventoryItem->Remove(1);
+					}
+					if (cInventoryManager->GetItem("Bronze")->GetCount() > 0)
+					{
+						cInventoryItem = cInventoryManager->GetItem("Bronze");
+						cInventoryItem->Remove(1);
+					}
+					if (cInventoryManager->GetItem("Silver")->GetCount() > 0)
+					{
+						cInventoryItem = cInventoryManager->GetItem("Silver");
+						cInventoryItem->Remove(1);
+					}
+					if (cInventoryManager->GetItem("Gold")->GetCount() > 0)
+					{
+						cInventoryItem = cInventoryManager->GetItem("Gold");
+						cInventoryItem->Remove(1);
+					}
+					cSoundController->PlaySoundByID(11);
+				}
+				else
+				{
+					cPlayer2D->UpdateHealthLives();
+					cSoundController->PlaySoundByID(12);
+				}
+				break;
+			}
+			case ACTION_GOLD:
+			{
+				cInventoryItem = cInventoryManager->GetItem("Gold");
+				cInventoryItem->Add(1);
+				break;
+			}
+			case ACTION_SPAWN_BABIES:
+			{
+				cScene2D->setSlimeBPos(vec2Index);
+				cScene2D->spawnExtraEnemy(4);
+				break;
+			}
+			case ACTION_PLAYER_HITBOX:
+			{
+				cPlayer2D->SetHitBox(true);
+				break;
+			}
+			default:
+				break;
+		}
+	}
+	actions.clear();
+}
+
 /**
  @brief Set up the OpenGL display environment before rendering
  */
@@ -1286,47 +1400,38 @@ void CEnemy2D::PreRender(void)
 		return;
 
 	// bind textures on corresponding texture units
-	glActiveTexture(GL_TEXTURE0);
+	CRenderState::GetInstance()->ActiveTexture(GL_TEXTURE0);
 
 	// Activate blending mode
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	CRenderState::GetInstance()->SetBlend(true);
+	CRenderState::GetInstance()->BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 	// Activate the shader
 	CShaderManager::GetInstance()->Use(sShaderName);
 }
 
 /**
- @brief Render this instance
+ @brief Render this instance by submitting it to the CRenderQueue
  */
 void CEnemy2D::Render(const glm::mat4& view, const glm::mat4& projection)
 {
 	if (!bIsActive)
 		return;
 
-	glBindVertexArray(VAO);
-	// get matrix's uniform location and set matrix
-	unsigned int transformLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "transform");
-	unsigned int colorLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "runtimeColour");
-	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
+	// The frame is between the last two ticks, so draw the enemy2D between its positions of those ticks
+	glm::vec2 vec2RenderUVCoordinate = glm::mix(vec2PrevUVCoordinate, vec2UVCoordinate, CFixedTimeStep::GetInstance()->GetInterpolation());
 
 	transform = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
-	transform = glm::translate(transform, glm::vec3(vec2UVCoordinate.x,
-		vec2UVCoordinate.y,
+	transform = glm::translate(transform, glm::vec3(vec2RenderUVCoordinate.x,
+		vec2RenderUVCoordinate.y,
 		0.0f));
-	// Update the shaders with the latest transform
-	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(projection * view * transform));
-	glUniform4fv(colorLoc, 1, glm::value_ptr(runtimeColour));
 
-	// Get the texture to be rendered
-	glBindTexture(GL_TEXTURE_2D, iTextureID);
-
-	// Render the tile
-	//glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-	
-	animatedEnemy->Render();
-	glBindVertexArray(0);
+	transform = glm::scale(transform, glm::vec3(cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT, 1.0f));
 
+	// Submit the current frame of the animated sprite to the render queue, which is flushed by CScene2D
+	CRenderQueue::GetInstance()->Submit(CRenderQueue::LAYER_ENEMY, cShader, iTextureID,
+										quadMesh, transform, runtimeColour,
+										animatedEnemy->GetCurrentFrame(), animatedEnemy->GetSpriteGrid());
 }
 
 /**
@@ -1338,7 +1443,7 @@ void CEnemy2D::PostRender(void)
 		return;
 
 	// Disable blending
-	glDisable(GL_BLEND);
+	CRenderState::GetInstance()->SetBlend(false);
 }
 
 /**
@@ -1645,7 +1750,7 @@ bool CEnemy2D::IsMidAir(void)
 }
 
 /**
- @brief Let enemy2D interact with the player.
+ @brief Let enemy2D interact with the player. The hits on the player and by the player's bullets are added to the actions
  */
 bool CEnemy2D::InteractWithPlayer(void)
 {
@@ -1662,39 +1767,38 @@ bool CEnemy2D::InteractWithPlayer(void)
 	}
 
 	//Player ranged attack interaction
+	unsigned int uiNumCollisionTests = 0;
 	for (unsigned i = 0; i < cPlayer2D->GetBulletGenerator()->GetBulletsVector().size(); ++i)
 	{
 		if (cPlayer2D->GetBulletGenerator()->GetBulletsVector()[i]->GetIsActive() == true)
 		{
+			uiNumCollisionTests++;
 			if (glm::length(vec2Index - cPlayer2D->GetBulletGenerator()->GetBulletsVector()[i]->GetBulletPos()) <= 2)
 			{
-				HP = HP - cPlayer2D->GetBulletGenerator()->GetBulletsVector()[i]->GetDamage();
-				cPlayer2D->GetBulletGenerator()->GetBulletsVector()[i]->SetbIsActive(false);
-			}
-			if (HP <= 0)
-			{
-				if (status == GOLD)
-				{
-					cInventoryItem = cInventoryManager->GetItem("Gold");
-					cInventoryItem->Add(1);
-				}
-				sCurrentFSM = DEAD;
-				if (cScene2D->getEnemyVec().size() >= 0 && bIsActive == true)
+				// This is called a few times in a tick, so a bullet is only added once
+				CBullet* pBullet = cPlayer2D->GetBulletGenerator()->GetBulletsVector()[i];
+				bool bAdded = false;
+				for (unsigned int j = 0; j < actions.size(); j++)
 				{
-					cPlayer2D->GetBulletGenerator()->GetBulletsVector()[i]->findNearestEnemy();
-					cout << cPlayer2D->GetBulletGenerator()->GetBulletsVector()[i]->getNearestEnemy() << endl;
-					cScene2D->getEnemyVec().erase(cScene2D->getEnemyVec().begin() + (cPlayer2D->GetBulletGenerator()->GetBulletsVector()[i]->getNearestEnemy()));
+					if ((actions[j].eType == ACTION_PLAYER_BULLET_HIT) && (actions[j].pBullet == pBullet))
+					{
+						bAdded = true;
+						break;
+					}
 				}
+				if (bAdded == false)
+					AddAction(ACTION_PLAYER_BULLET_HIT, 0, pBullet);
 			}
 		}
 	}
+	CMetricsRegistry::GetInstance()->Add(uiMetricCollisionTests, uiNumCollisionTests);
 
 	//Player melee attack interaction
 	if (GetHitBox() == true)
 	{
 		if (cMouseController->IsButtonDown(GLFW_MOUSE_BUTTON_LEFT) && meleeCounter >= 40)
 		{
-			cSoundController->PlaySoundByID(5);
+			AddAction(ACTION_SOUND, 5);
 			if (enemyType == SKULL)
 			{
 				HP = HP - 4;
@@ -1707,12 +1811,8 @@ bool CEnemy2D::InteractWithPlayer(void)
 			if (HP <= 0)
 			{
 				sCurrentFSM = DEAD;
-				cSoundController->PlaySoundByID(7);
-				if (cScene2D->getEnemyVec().size() >= 0 && bIsActive == true)
-				{
-					cPlayer2D->findNearestEnemy();
-					cScene2D->getEnemyVec().erase(cScene2D->getEnemyVec().begin() + cPlayer2D->getNearestEnemy());
-				}
+				AddAction(ACTION_SOUND, 7);
+				AddAction(ACTION_REMOVE_NEAREST);
 			}
 			meleeCounter = 0;
 		}
@@ -1930,6 +2030,35 @@ glm::vec2& CEnemy2D::findNearestBasePart()
 	return nearestBasePart;
 }
 
+/**
+ @brief Add an action for Apply()
+ @param eType The type of the action
+ @param iValue The value of the action, such as the ID of a sound or the damage
+ @param pBullet The bullet which hit this enemy2D, or NULL
+ */
+void CEnemy2D::AddAction(const ACTION_TYPE eType, const int iValue, CBullet* pBullet)
+{
+	SAction sAction;
+	sAction.eType = eType;
+	sAction.iValue = iValue;
+	sAction.pBullet = pBullet;
+	actions.push_back(sAction);
+}
+
+/**
+ @brief Remove an enemy from the scene's enemies. An enemy before this one may have removed
+		some of them in this tick, so the index is checked
+ @param iIndex The index of the enemy in the scene's enemies
+ */
+void CEnemy2D::RemoveEnemy(const int iIndex)
+{
+	std::vector<CEntity2D*>& enemyVector = cScene2D->getEnemyVec();
+	if ((iIndex >= 0) && (iIndex < (int)enemyVector.size()))
+	{
+		enemyVector.erase(enemyVector.begin() + iIndex);
+	}
+}
+
 void CEnemy2D::updateWindBLow(int direction)
 {
 	int distancedBlown = 0;
@@ -8,6 +8,8 @@
 
 class CScene2D;
 class CTurret;
+class CBullet;
+class CRandom;
 
 // Include shader
 #include "RenderControl\shader.h"
@@ -42,6 +44,8 @@ class CMap2D;
 #include "Inputs\KeyboardController.h"
 #include "Inputs\MouseController.h"
 
+#include <vector>
+
 class CEnemy2D : public CEntity2D
 {
 public:
@@ -56,9 +60,15 @@ public:
 	bool babySlimeInit(glm::vec2 bossPos);
 	bool slimeBossInit(void);
 
-	// Update
+	// Update. It is Think() followed by Apply()
 	void Update(const double dElapsedTime);
 
+	// Decide what to do in this tick. It only changes this enemy2D, so the enemies can think in parallel
+	void Think(const double dElapsedTime);
+
+	// Do the actions which were decided in Think(). Call it for the enemies one at a time, in their order
+	void Apply(void);
+
 	// PreRender
 	void PreRender(void);
 
@@ -139,6 +149,57 @@ protected:
 		NUMOFSTATUSES
 	};
 
+	// The IDs of the animation clips, in the order which they are added to the animation set
+	enum ANIMATION
+	{
+		ANIM_RIGHT = 0,
+		ANIM_LEFT,
+		ANIM_HRIGHT,
+		ANIM_HLEFT,
+		ANIM_BURN_RIGHT,
+		ANIM_BURN_LEFT,
+		ANIM_BURN_HRIGHT,
+		ANIM_BURN_HLEFT,
+		ANIM_FROZEN_RIGHT,
+		ANIM_FROZEN_LEFT,
+		ANIM_FROZEN_HRIGHT,
+		ANIM_FROZEN_HLEFT,
+		ANIM_DEAD_RIGHT,
+		ANIM_DEAD_LEFT,
+		NUM_ANIMATIONS
+	};
+
+	// The actions which change the rest of the scene. Think() adds them and Apply() does them
+	enum ACTION_TYPE
+	{
+		ACTION_SOUND = 0,			// Play the sound iValue
+		ACTION_TURRET_BULLET_HIT,	// Take the hit of pBullet from the turret at iValue
+		ACTION_PLAYER_BULLET_HIT,	// Take the hit of pBullet from the player
+		ACTION_BASE_DAMAGE,			// Damage the base by iValue
+		ACTION_PLAYER_DAMAGE,		// Take a life from the player
+		ACTION_REMOVE_NEAREST,		// Remove the enemy which is nearest to the player
+		ACTION_TURRET_DAMAGE,		// Damage the nearest turret by iValue
+		ACTION_STEAL,				// Steal the player's ores, or take a life if there are none
+		ACTION_GOLD,				// Give the player a gold
+		ACTION_SPAWN_BABIES,		// Spawn the baby slimes around this enemy2D
+		ACTION_PLAYER_HITBOX,		// Set the player's hitbox
+		NUM_ACTIONS
+	};
+
+	// An action which Think() asked for
+	struct SAction
+	{
+		ACTION_TYPE eType;
+		int iValue;
+		CBullet* pBullet;
+	};
+
+	// Get the animation clips shared by all the enemies
+	static const CAnimationSet* GetAnimationSet(void);
+
+	// The actions of this tick, in the order which they were asked for
+	std::vector<SAction> actions;
+
 	glm::vec2 i32vec2OldIndex;
 	glm::vec2 nearestLive;
 	CTurret* nearestTurret;
@@ -171,6 +232,8 @@ protected:
 
 	// The vec2 variable which stores the UV coordinates to render the enemy2D
 	glm::vec2 vec2UVCoordinate;
+	// The UV coordinates of the last tick. The enemy2D is drawn between them and vec2UVCoordinate
+	glm::vec2 vec2PrevUVCoordinate;
 
 	// The vec2 which stores the indices of the destination for enemy2D in the Map2D
 	glm::vec2 i32vec2Destination;
@@ -238,6 +301,12 @@ protected:
 	// Handler to the CSoundController
 	CSoundController* cSoundController;
 
+	// The random stream of the enemies
+	CRandom* cRandom;
+
+	// The metric of the bullets which were tested against this enemy
+	unsigned int uiMetricCollisionTests;
+
 	// Keyboard Controller singleton instance
 	CKeyboardController* cKeyboardController;
 
@@ -268,5 +337,11 @@ protected:
 	void UpdatePosition(glm::vec2 destination);
 
 	void updateWindBLow(int direction);
+
+	// Add an action for Apply()
+	void AddAction(const ACTION_TYPE eType, const int iValue = 0, CBullet* pBullet = NULL);
+
+	// Remove an enemy from the scene's enemies, if the index is in it
+	void RemoveEnemy(const int iIndex);
 };
 
@@ -12,6 +12,16 @@ class CTurret;
 
 // Include Image loader
 #include "System/ImageLoader.h"
+// Include CFrameTimer for its overlay
+#include "TimeControl/FrameTimer.h"
+// Include CProfiler for the profiler zones
+#include "TimeControl/Profiler.h"
+// Include CMetricsRegistry for its panel
+#include "System/MetricsRegistry.h"
+// Include CInputRecorder to replay the mouse of the GUI
+#include "Inputs/InputRecorder.h"
+// Include CFixedTimeStep for the time scale of the simulation
+#include "TimeControl/FixedTimeStep.h"
 
 #include "Turret.h"
 
@@ -72,25 +82,25 @@ bool CGUI_Scene2D::Init(void)
 
 	CImageLoader* Image = CImageLoader::GetInstance();
 	InventoryBG.fileName = "Image\\GUI\\Inventory.png";
-	InventoryBG.textureID = Image->LoadTextureGetID(InventoryBG.fileName.c_str(), true);
+	InventoryBG.textureID = Image->LoadTextureAsync(InventoryBG.fileName.c_str(), true);
 	EquipButton.fileName = "Image\\GUI\\Equip.png";
-	EquipButton.textureID = Image->LoadTextureGetID(EquipButton.fileName.c_str(), true);
+	EquipButton.textureID = Image->LoadTextureAsync(EquipButton.fileName.c_str(), true);
 	EquippedButton.fileName = "Image\\GUI\\Equipped.png";
-	EquippedButton.textureID = Image->LoadTextureGetID(EquippedButton.fileName.c_str(), true);
+	EquippedButton.textureID = Image->LoadTextureAsync(EquippedButton.fileName.c_str(), true);
 	CraftingBG.fileName = "Image\\GUI\\Crafting.png";
-	CraftingBG.textureID = Image->LoadTextureGetID(CraftingBG.fileName.c_str(), true);
+	CraftingBG.textureID = Image->LoadTextureAsync(CraftingBG.fileName.c_str(), true);
 	LeftButton.fileName = "Image\\GUI\\LeftButton.png";
-	LeftButton.textureID = Image->LoadTextureGetID(LeftButton.fileName.c_str(), true);
+	LeftButton.textureID = Image->LoadTextureAsync(LeftButton.fileName.c_str(), true);
 	RightButton.fileName = "Image\\GUI\\RightButton.png";
-	RightButton.textureID = Image->LoadTextureGetID(RightButton.fileName.c_str(), true);
+	RightButton.textureID = Image->LoadTextureAsync(RightButton.fileName.c_str(), true);
 	CraftButton.fileName = "Image\\GUI\\Craft.png";
-	CraftButton.textureID = Image->LoadTextureGetID(CraftButton.fileName.c_str(), true);
+	CraftButton.textureID = Image->LoadTextureAsync(CraftButton.fileName.c_str(), true);
 	UpgradeBG.fileName = "Image\\GUI\\UpgradeMenu.png";
-	UpgradeBG.textureID = Image->LoadTextureGetID(UpgradeBG.fileName.c_str(), true);
+	UpgradeBG.textureID = Image->LoadTextureAsync(UpgradeBG.fileName.c_str(), true);
 	UpgradeButton.fileName = "Image\\GUI\\Upgrade.png";
-	UpgradeButton.textureID = Image->LoadTextureGetID(UpgradeButton.fileName.c_str(), true);
+	UpgradeButton.textureID = Image->LoadTextureAsync(UpgradeButton.fileName.c_str(), true);
 	DestroyButton.fileName = "Image\\GUI\\Destroy.png";
-	DestroyButton.textureID = Image->LoadTextureGetID(DestroyButton.fileName.c_str(), true);
+	DestroyButton.textureID = Image->LoadTextureAsync(DestroyButton.fileName.c_str(), true);
 
 	// Setup Dear ImGui context
 	IMGUI_CHECKVERSION();
@@ -249,7 +259,7 @@ bool CGUI_Scene2D::Init(void)
 	}
 	for (int i = 0; i < TurretImg.size(); i++)
 	{
-		TurretImg[i].textureID = Image->LoadTextureGetID(TurretImg[i].fileName.c_str(), true);
+		TurretImg[i].textureID = Image->LoadTextureAsync(TurretImg[i].fileName.c_str(), true);
 	}
 
 	recipeNo = 0;
@@ -271,6 +281,8 @@ bool CGUI_Scene2D::Init(void)
 
 void CGUI_Scene2D::Update(const double dElapsedTime)
 {
+	PROFILE_FUNCTION();
+
 	// Calculate the relative scale to our default windows width
 	const float relativeScale_x = cSettings->iWindowWidth / 800.0f;
 	const float relativeScale_y = cSettings->iWindowHeight / 600.0f;
@@ -278,8 +290,13 @@ void CGUI_Scene2D::Update(const double dElapsedTime)
 	// Start the Dear ImGui frame
 	ImGui_ImplOpenGL3_NewFrame();
 	ImGui_ImplGlfw_NewFrame();
+	CInputRecorder::GetInstance()->UpdateGUIInputs();
 	ImGui::NewFrame();
 
+	// Add the frame timing overlay and the metrics panel, if they are visible
+	CFrameTimer::GetInstance()->RenderOverlay();
+	CMetricsRegistry::GetInstance()->RenderPanel();
+
 	// If the OpenGL window is minimised, then don't render the IMGUI widgets
 	if ((relativeScale_x == 0.0f) || (relativeScale_y == 0.0f))
 	{
@@ -1772,6 +1789,20 @@ void CGUI_Scene2D::Update(const double dElapsedTime)
 	ImGui::SetWindowFontScale(1.5f * relativeScale_y);
 	ImGui::TextColored(ImVec4(1, 1, 0, 1), "Time elapsed: %d", cScene2D->getElapsed());
 	ImGui::End();
+	// Show the requested and the achieved time scale when the simulation is fast-forwarded
+	CFixedTimeStep* cFixedTimeStep = CFixedTimeStep::GetInstance();
+	if (cFixedTimeStep->GetTimeScale() != 1.0)
+	{
+		ImGui::Begin("Time scale", NULL, wavesWindowFlags);
+		ImGui::SetWindowPos(ImVec2(cSettings->iWindowWidth * 0.0f, cSettings->iWindowHeight * 0.17f));
+		ImGui::SetWindowSize(ImVec2(100.0f * relativeScale_x, 25.0f * relativeScale_y));
+		ImGui::SetWindowFontScale(1.5f * relativeScale_y);
+		if (cFixedTimeStep->GetTimeScale() > 0.0)
+			ImGui::TextColored(ImVec4(1, 1, 0, 1), "Speed: %gx (%.1fx)", cFixedTimeStep->GetTimeScale(), cFixedTimeStep->GetAchievedTimeScale());
+		else
+			ImGui::TextColored(ImVec4(1, 1, 0, 1), "Speed: max (%.1fx)", cFixedTimeStep->GetAchievedTimeScale());
+		ImGui::End();
+	}
 	if (prevWave < cScene2D->getPrevLevel())
 	{
 		ImGui::Begin("WAVE INCREASE ANNOUNCEMENT", NULL, wavesWindowFlags);
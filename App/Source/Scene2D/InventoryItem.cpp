@@ -21,7 +21,7 @@ CInventoryItem::CInventoryItem(const char* imagePath)
 {
 	if (imagePath)
 	{
-		iTextureID = CImageLoader::GetInstance()->LoadTextureGetID(imagePath, true);
+		iTextureID = CImageLoader::GetInstance()->LoadTextureAsync(imagePath, true);
 		if (iTextureID == 0)
 		{
 			cout << "Unable to load " << imagePath << endl;
@@ -8,15 +8,26 @@
 
 // Include Shader Manager
 #include "RenderControl\ShaderManager.h"
+// Include Render State
+#include "RenderControl\RenderState.h"
+// Include Render Queue
+#include "RenderControl\RenderQueue.h"
+// Include Mesh Manager
+#include "Primitives\MeshManager.h"
 
 // Include Filesystem
 #include "System\filesystem.h"
 // Include ImageLoader
 #include "System\ImageLoader.h"
+// Include CProfiler for the profiler zones
+#include "TimeControl\Profiler.h"
+// Include CMetricsRegistry to count the path finding calls
+#include "System\MetricsRegistry.h"
 #include "Primitives/MeshBuilder.h"
 
 #include <iostream>
 #include <vector>
+#include <algorithm>
 #include <math.h>
 using namespace std;
 
@@ -29,7 +40,17 @@ using namespace std::placeholders;
 CMap2D::CMap2D(void)
 	: uiCurLevel(0)
 	, quadMesh(NULL)
+	, uiCacheFBO(0)
+	, uiCacheTexture(0)
+	, uiCacheTileSize(0)
+	, bRenderCache(true)
+	, bCacheAllDirty(true)
+	, uiCacheNumUploads(0)
 {
+	CMetricsRegistry* cMetricsRegistry = CMetricsRegistry::GetInstance();
+	uiMetricPathFindCalls = cMetricsRegistry->AddCounter("PathFind Calls");
+	uiMetricNodesExpanded = cMetricsRegistry->AddCounter("PathFind Nodes Expanded");
+	uiMetricNodesPerPath = cMetricsRegistry->AddHistogram("PathFind Nodes per Call");
 }
 
 /**
@@ -51,16 +72,15 @@ CMap2D::~CMap2D(void)
 	}
 	delete[] arrMapInfo;
 
-	if (quadMesh)
-	{
-		delete quadMesh;
-		quadMesh = NULL;
-	}
+	// The quadMesh is shared, so it is deleted by CMeshManager
+	quadMesh = NULL;
+
+	// Delete the cache of the tiles
+	DeleteRenderCache();
 
 	// optional: de-allocate all resources once they've outlived their purpose:
-	glDeleteVertexArrays(1, &VAO);
-	glDeleteBuffers(1, &VBO);
-	glDeleteBuffers(1, &EBO);
+	CRenderState::GetInstance()->DeleteBuffer(VBO);
+	CRenderState::GetInstance()->DeleteBuffer(EBO);
 
 	// Set this to NULL since it was created elsewhere, so we let it be deleted there.
 	cSettings = NULL;
@@ -107,11 +127,12 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 	cSettings->NUM_TILES_YAXIS = uiNumRows;
 	cSettings->UpdateSpecifications();
 
-	glGenVertexArrays(1, &VAO);
-	glBindVertexArray(VAO);
+	//CS: Use the unit quad which is shared by all the entities
+	quadMesh = CMeshManager::GetInstance()->GetUnitQuad();
 
-	//CS: Create the Quad Mesh using the mesh builder
-	quadMesh = CMeshBuilder::GenerateQuad(glm::vec4(1, 1, 1, 1), cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT);
+	// The map may have a different size now, so create the cache of the tiles again when it is drawn
+	DeleteRenderCache();
+	bCacheAllDirty = true;
 
 	// Load and create textures
 	// Load the ground texture
@@ -120,7 +141,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 	{
 		// Top Wall
 		{
-			iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Tiles/tile001.png", true);
+			iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Tiles/tile001.png", true);
 			if (iTextureID == 0)
 			{
 				cout << "Image/Tiles/tile001.png" << endl;
@@ -132,7 +153,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 				MapOfTextureIDs.insert(pair<int, int>(101, iTextureID));
 			}
 
-			iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Tiles/tile002.png", true);
+			iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Tiles/tile002.png", true);
 			if (iTextureID == 0)
 			{
 				cout << "Image/Tiles/tile002.png" << endl;
@@ -144,7 +165,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 				MapOfTextureIDs.insert(pair<int, int>(102, iTextureID));
 			}
 
-			iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Tiles/tile003.png", true);
+			iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Tiles/tile003.png", true);
 			if (iTextureID == 0)
 			{
 				cout << "Image/Tiles/tile003.png" << endl;
@@ -156,7 +177,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 				MapOfTextureIDs.insert(pair<int, int>(103, iTextureID));
 			}
 
-			iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Tiles/tile004.png", true);
+			iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Tiles/tile004.png", true);
 			if (iTextureID == 0)
 			{
 				cout << "Image/Tiles/tile004.png" << endl;
@@ -171,7 +192,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 
 		// Left Wall
 		{
-			iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Tiles/tile000.png", true);
+			iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Tiles/tile000.png", true);
 			if (iTextureID == 0)
 			{
 				cout << "Image/Tiles/tile000.png" << endl;
@@ -183,7 +204,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 				MapOfTextureIDs.insert(pair<int, int>(111, iTextureID));
 			}
 
-			iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Tiles/tile010.png", true);
+			iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Tiles/tile010.png", true);
 			if (iTextureID == 0)
 			{
 				cout << "Image/Tiles/tile010.png" << endl;
@@ -195,7 +216,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 				MapOfTextureIDs.insert(pair<int, int>(112, iTextureID));
 			}
 
-			iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Tiles/tile020.png", true);
+			iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Tiles/tile020.png", true);
 			if (iTextureID == 0)
 			{
 				cout << "Image/Tiles/tile020.png" << endl;
@@ -207,7 +228,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 			MapOfTextureIDs.insert(pair<int, int>(113, iTextureID));
 			}
 
-			iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Tiles/tile030.png", true);
+			iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Tiles/tile030.png", true);
 			if (iTextureID == 0)
 			{
 				cout << "Image/Tiles/tile030.png" << endl;
@@ -219,7 +240,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 				MapOfTextureIDs.insert(pair<int, int>(114, iTextureID));
 			}
 
-			iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Tiles/tile040.png", true);
+			iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Tiles/tile040.png", true);
 			if (iTextureID == 0)
 			{
 				cout << "Image/Tiles/tile040.png" << endl;
@@ -234,7 +255,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 
 		// Right Wall
 		{
-		iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Tiles/tile005.png", true);
+		iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Tiles/tile005.png", true);
 		if (iTextureID == 0)
 		{
 			cout << "Image/Tiles/tile005.png" << endl;
@@ -246,7 +267,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 			MapOfTextureIDs.insert(pair<int, int>(121, iTextureID));
 		}
 
-		iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Tiles/tile015.png", true);
+		iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Tiles/tile015.png", true);
 		if (iTextureID == 0)
 		{
 		cout << "Image/Tiles/tile015.png" << endl;
@@ -258,7 +279,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 		MapOfTextureIDs.insert(pair<int, int>(122, iTextureID));
 		}
 
-		iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Tiles/tile025.png", true);
+		iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Tiles/tile025.png", true);
 		if (iTextureID == 0)
 		{
 			cout << "Image/Tiles/tile025.png" << endl;
@@ -270,7 +291,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 			MapOfTextureIDs.insert(pair<int, int>(123, iTextureID));
 		}
 
-		iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Tiles/tile035.png", true);
+		iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Tiles/tile035.png", true);
 		if (iTextureID == 0)
 		{
 			cout << "Image/Tiles/tile035.png" << endl;
@@ -282,7 +303,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 			MapOfTextureIDs.insert(pair<int, int>(124, iTextureID));
 		}
 
-		iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Tiles/tile045.png", true);
+		iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Tiles/tile045.png", true);
 		if (iTextureID == 0)
 		{
 			cout << "Image/Tiles/tile045.png" << endl;
@@ -297,7 +318,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 
 		// Bottom Wall
 		{
-		iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Tiles/tile041.png", true);
+		iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Tiles/tile041.png", true);
 		if (iTextureID == 0)
 		{
 			cout << "Image/Tiles/tile041.png" << endl;
@@ -309,7 +330,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 			MapOfTextureIDs.insert(pair<int, int>(131, iTextureID));
 		}
 
-		iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Tiles/tile042.png", true);
+		iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Tiles/tile042.png", true);
 		if (iTextureID == 0)
 		{
 			cout << "Image/Tiles/tile042.png" << endl;
@@ -321,7 +342,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 			MapOfTextureIDs.insert(pair<int, int>(132, iTextureID));
 		}
 
-		iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Tiles/tile043.png", true);
+		iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Tiles/tile043.png", true);
 		if (iTextureID == 0)
 		{
 			cout << "Image/Tiles/tile043.png" << endl;
@@ -333,7 +354,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 			MapOfTextureIDs.insert(pair<int, int>(133, iTextureID));
 		}
 
-		iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Tiles/tile044.png", true);
+		iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Tiles/tile044.png", true);
 		if (iTextureID == 0)
 		{
 			cout << "Image/Tiles/tile044.png" << endl;
@@ -348,7 +369,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 
 		// Ground
 		{
-			iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Tiles/tile018.png", true);
+			iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Tiles/tile018.png", true);
 			if (iTextureID == 0)
 			{
 				cout << "Image/Tiles/tile018.png" << endl;
@@ -369,7 +390,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 				MapOfTextureIDs.insert(pair<int, int>(9, iTextureID));
 			}
 
-			iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Tiles/tile078.png", true);
+			iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Tiles/tile078.png", true);
 			if (iTextureID == 0)
 			{
 				cout << "Image/Tiles/tile078.png" << endl;
@@ -385,7 +406,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 		// Materials
 		{
 			// Wood
-			iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Tiles/WoodTile.png", true);
+			iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Tiles/WoodTile.png", true);
 			if (iTextureID == 0)
 			{
 				cout << "Image/Tiles/WoodTile.png" << endl;
@@ -397,7 +418,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 				MapOfTextureIDs.insert(pair<int, int>(135, iTextureID));
 			}
 			// Silver
-			iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Tiles/StoneTile.png", true);
+			iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Tiles/StoneTile.png", true);
 			if (iTextureID == 0)
 			{
 				cout << "Image/Tiles/SilverTile.png" << endl;
@@ -409,7 +430,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 				MapOfTextureIDs.insert(pair<int, int>(140, iTextureID));
 			}
 			// Iron
-			iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Tiles/IronTile.png", true);
+			iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Tiles/IronTile.png", true);
 			if (iTextureID == 0)
 			{
 				cout << "Image/Tiles/IronTile.png" << endl;
@@ -421,7 +442,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 				MapOfTextureIDs.insert(pair<int, int>(141, iTextureID));
 			}
 			// Silver
-			iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Tiles/SilverTile.png", true);
+			iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Tiles/SilverTile.png", true);
 			if (iTextureID == 0)
 			{
 				cout << "Image/Tiles/SilverTile.png" << endl;
@@ -433,7 +454,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 				MapOfTextureIDs.insert(pair<int, int>(142, iTextureID));
 			}
 			// Bronze
-			iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Tiles/BronzeTile.png", true);
+			iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Tiles/BronzeTile.png", true);
 			if (iTextureID == 0)
 			{
 				cout << "Image/Tiles/BronzeTile.png" << endl;
@@ -445,7 +466,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 				MapOfTextureIDs.insert(pair<int, int>(143, iTextureID));
 			}
 			// Gold
-			iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Tiles/GoldTile.png", true);
+			iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Tiles/GoldTile.png", true);
 			if (iTextureID == 0)
 			{
 				cout << "Image/Tiles/GoldTile.png" << endl;
@@ -460,7 +481,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 
 		// Turrets
 		{
-			iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Turret/Turret.png", true);
+			iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Turret/Turret.png", true);
 			if (iTextureID == 0)
 			{
 				cout << "Image/Turret/Turret.png" << endl;
@@ -472,7 +493,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 				MapOfTextureIDs.insert(pair<int, int>(150, iTextureID));
 			}
 
-			iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Turret/WoodWall.png", true);
+			iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Turret/WoodWall.png", true);
 			if (iTextureID == 0)
 			{
 				cout << "Image/Turret/WoodWall.png" << endl;
@@ -483,7 +504,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 				// Store the texture ID into MapOfTextureIDs
 				MapOfTextureIDs.insert(pair<int, int>(152, iTextureID));
 			}
-			iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Turret/StoneWall.png", true);
+			iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Turret/StoneWall.png", true);
 			if (iTextureID == 0)
 			{
 				cout << "Image/Turret/StoneWall.png" << endl;
@@ -494,7 +515,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 				// Store the texture ID into MapOfTextureIDs
 				MapOfTextureIDs.insert(pair<int, int>(153, iTextureID));
 			}
-			iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Turret/IronWall.png", true);
+			iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Turret/IronWall.png", true);
 			if (iTextureID == 0)
 			{
 				cout << "Image/Turret/IronWall.png" << endl;
@@ -510,7 +531,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 		//Base
 		{
 			//Top left
-			iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Scene2D/BaseTL.tga", true);
+			iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Scene2D/BaseTL.tga", true);
 			if (iTextureID == 0)
 			{
 				cout << "Image/Scene2D/BaseTL.tga" << endl;
@@ -522,7 +543,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 				MapOfTextureIDs.insert(pair<int, int>(136, iTextureID));
 			}
 			//Top right
-			iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Scene2D/BaseTR.tga", true);
+			iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Scene2D/BaseTR.tga", true);
 			if (iTextureID == 0)
 			{
 				cout << "Image/Scene2D/BaseTR.tga" << endl;
@@ -534,7 +555,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 				MapOfTextureIDs.insert(pair<int, int>(137, iTextureID));
 			}
 			//Bottom left
-			iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Scene2D/BaseBL.tga", true);
+			iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Scene2D/BaseBL.tga", true);
 			if (iTextureID == 0)
 			{
 				cout << "Image/Scene2D/BaseBL.tga" << endl;
@@ -546,7 +567,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 				MapOfTextureIDs.insert(pair<int, int>(138, iTextureID));
 			}
 			//Bottom right
-			iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Scene2D/BaseBR.tga", true);
+			iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Scene2D/BaseBR.tga", true);
 			if (iTextureID == 0)
 			{
 				cout << "Image/Scene2D/BaseBR.tga" << endl;
@@ -561,7 +582,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 	}
 
 	// Load the Life texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Scene2D_Lives.tga", true);
+	iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Scene2D_Lives.tga", true);
 	if (iTextureID == 0)
 	{
 		cout << "Unable to load Image/Scene2D_Lives.tga" << endl;
@@ -573,7 +594,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 		MapOfTextureIDs.insert(pair<int, int>(10, iTextureID));
 	}
 	// Load the spike texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Scene2D_Spikes.tga", true);
+	iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Scene2D_Spikes.tga", true);
 	if (iTextureID == 0)
 	{
 		cout << "Unable to load Image/Scene2D_Spikes.tga" << endl;
@@ -585,7 +606,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 		MapOfTextureIDs.insert(pair<int, int>(20, iTextureID));
 	}
 	// Load the Spa texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Scene2D_Spa.tga", true);
+	iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Scene2D_Spa.tga", true);
 	if (iTextureID == 0)
 	{
 		cout << "Unable to load Image/Scene2D_Spa.tga" << endl;
@@ -598,7 +619,7 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 	}
 	
 	// Load the Exit texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Tiles/tile039.png", true);
+	iTextureID = CImageLoader::GetInstance()->LoadTextureAsync("Image/Tiles/tile039.png", true);
 	if (iTextureID == 0)
 	{
 		cout << "Unable to load Image/Tiles/tile039.png" << endl;
@@ -611,28 +632,18 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 	}
 
 	// Initialise the variables for AStar
-	m_weight = 1;
-	m_startPos = glm::vec2(0, 0);
-	m_targetPos = glm::vec2(0, 0);
 	//m_size = cSettings->NUM_TILES_YAXIS* cSettings->NUM_TILES_XAXIS;
 
 	m_nrOfDirections = 4;
 	m_directions = { { -1, 0 }, { 1, 0 }, { 0, 1 }, { 0, -1 },
 						{ -1, -1 }, { 1, 1 }, { -1, 1 }, { 1, -1 } };
 
-	// Resize these 2 lists
-	m_cameFromList.resize(cSettings->NUM_TILES_YAXIS * cSettings->NUM_TILES_XAXIS);
-	m_closedList.resize(cSettings->NUM_TILES_YAXIS * cSettings->NUM_TILES_XAXIS, false);
-
 	//// Clear AStar memory
 	//ClearAStar();
 
 	// Create and initialise the CPlayer2D
 	cPlayer2D = CPlayer2D::GetInstance();
 
-
-	// Rand seeding
-	srand(time(NULL));
 	return true;
 }
 
@@ -667,37 +678,46 @@ void CMap2D::Update(const double dElapsedTime)
 void CMap2D::PreRender(void)
 {
 	// Activate blending mode
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	CRenderState::GetInstance()->SetBlend(true);
+	CRenderState::GetInstance()->BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 	// bind textures on corresponding texture units
-	glActiveTexture(GL_TEXTURE0);
+	CRenderState::GetInstance()->ActiveTexture(GL_TEXTURE0);
 
 	// Activate the shader
 	CShaderManager::GetInstance()->Use(sShaderName);
 }
 
 /**
- @brief Render Render this instance
+ @brief Render this instance by submitting it to the CRenderQueue
  */
 void CMap2D::Render(const glm::mat4& view, const glm::mat4& projection)
 {
-	// get matrix's uniform location and set matrix
-	unsigned int transformLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "transform");
-	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
+	if (bRenderCache)
+	{
+		// Draw the tiles which changed into the cache. This falls back to drawing the tiles if it fails
+		UpdateRenderCache();
+	}
+
+	if (bRenderCache)
+	{
+		// The map covers -1 to 1 in both axes, so draw the cache as one quad over it
+		float fMapWidth = cSettings->NUM_TILES_XAXIS * cSettings->TILE_WIDTH;
+		float fMapHeight = cSettings->NUM_TILES_YAXIS * cSettings->TILE_HEIGHT;
+		transform = glm::mat4(1.0f);
+		transform = glm::translate(transform, glm::vec3(-1.0f + fMapWidth * 0.5f, 1.0f - fMapHeight * 0.5f, 0.0f));
+		transform = glm::scale(transform, glm::vec3(fMapWidth, fMapHeight, 1.0f));
+
+		//CS: Submit the cached map to the render queue, which is flushed by CScene2D
+		CRenderQueue::GetInstance()->Submit(CRenderQueue::LAYER_MAP, cShader, uiCacheTexture, quadMesh, transform);
+		return;
+	}
+
 	// Render
 	for (unsigned int uiRow = 0; uiRow < cSettings->NUM_TILES_YAXIS; uiRow++)
 	{
 		for (unsigned int uiCol = 0; uiCol < cSettings->NUM_TILES_XAXIS; uiCol++)
 		{
-			transform = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
-			transform = glm::translate(transform, glm::vec3(cSettings->ConvertIndexToUVSpace(cSettings->x, uiCol, false, 0),
-															cSettings->ConvertIndexToUVSpace(cSettings->y, uiRow, true, 0),
-															0.0f));
-
-			// Update the shaders with the latest transform
-			glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(projection * view * transform));
-
 			// Render a tile
 			RenderTile(uiRow, uiCol);
 		}
@@ -710,7 +730,7 @@ void CMap2D::Render(const glm::mat4& view, const glm::mat4& projection)
 void CMap2D::PostRender(void)
 {
 	// Disable blending
-	glDisable(GL_BLEND);
+	CRenderState::GetInstance()->SetBlend(false);
 }
 
 // Set the specifications of the map
@@ -781,10 +801,16 @@ void CMap2D::SetNumSteps(const CSettings::AXIS sAxis, const unsigned int uiValue
  */
 void CMap2D::SetMapInfo(const unsigned int uiRow, const unsigned int uiCol, const int iValue, const bool bInvert)
 {
+	unsigned int uiMapRow = uiRow;
 	if (bInvert)
-		arrMapInfo[uiCurLevel][cSettings->NUM_TILES_YAXIS - uiRow - 1][uiCol].value = iValue;
-	else
-		arrMapInfo[uiCurLevel][uiRow][uiCol].value = iValue;
+		uiMapRow = cSettings->NUM_TILES_YAXIS - uiRow - 1;
+
+	if (arrMapInfo[uiCurLevel][uiMapRow][uiCol].value != iValue)
+	{
+		arrMapInfo[uiCurLevel][uiMapRow][uiCol].value = iValue;
+		// Draw this tile into the cache again
+		MarkCacheDirty(uiMapRow, uiCol);
+	}
 }
 
 /**
@@ -806,6 +832,11 @@ int CMap2D::GetMapInfo(const unsigned int uiRow, const int unsigned uiCol, const
  */ 
 bool CMap2D::LoadMap(string filename, const unsigned int uiCurLevel)
 {
+	// Use the parsed map from the asset pack if it was cooked
+	const CAssetPack::SEntry* pEntry = CAssetPack::GetInstance()->Find(filename, CAssetPack::ASSET_MAP);
+	if (pEntry != NULL)
+		return LoadMapFromPack(pEntry, uiCurLevel);
+
 	doc = rapidcsv::Document(FileSystem::getPath(filename).c_str());
 
 	// Check if the sizes of CSV data matches the declared arrMapInfo sizes
@@ -831,6 +862,59 @@ bool CMap2D::LoadMap(string filename, const unsigned int uiCurLevel)
 		}
 	}
 
+	// Draw all the tiles into the cache again
+	bCacheAllDirty = true;
+
+	return true;
+}
+
+/**
+ @brief Load a map which was cooked into the asset pack. The tile values are copied without parsing,
+		and the column names are set into the rapidcsv::Document so that SaveMap() writes the same header
+ @param pEntry The entry of the map in the asset pack
+ @param uiCurLevel The level to load the map into
+ */
+bool CMap2D::LoadMapFromPack(const CAssetPack::SEntry* pEntry, const unsigned int uiCurLevel)
+{
+	// Check if the sizes of the cooked map matches the declared arrMapInfo sizes
+	if ((cSettings->NUM_TILES_XAXIS != pEntry->uiWidth) ||
+		(cSettings->NUM_TILES_YAXIS != pEntry->uiHeight))
+	{
+		cout << "Sizes of cooked map does not match declared arrMapInfo sizes." << endl;
+		return false;
+	}
+	const size_t uiValuesSize = (size_t)pEntry->uiWidth * pEntry->uiHeight * sizeof(int32_t);
+	if (pEntry->ulSize < uiValuesSize)
+	{
+		cout << "Cooked map is smaller than its tile values." << endl;
+		return false;
+	}
+
+	const int32_t* piValues = (const int32_t*)CAssetPack::GetInstance()->GetData(pEntry);
+	for (unsigned int uiRow = 0; uiRow < cSettings->NUM_TILES_YAXIS; uiRow++)
+	{
+		for (unsigned int uiCol = 0; uiCol < cSettings->NUM_TILES_XAXIS; ++uiCol)
+		{
+			arrMapInfo[uiCurLevel][uiRow][uiCol].value = piValues[uiRow * cSettings->NUM_TILES_XAXIS + uiCol];
+			if (arrMapInfo[uiCurLevel][uiRow][uiCol].value == 200)
+				playerSpawnIndex = glm::vec2((float)uiCol, (float)(cSettings->NUM_TILES_YAXIS - uiRow) - 1.f);
+		}
+	}
+
+	// The column names follow the tile values, separated by '\n'
+	doc = rapidcsv::Document();
+	const char* pcNames = (const char*)(piValues) + uiValuesSize;
+	const char* pcNamesEnd = pcNames + ((size_t)pEntry->ulSize - uiValuesSize);
+	for (unsigned int uiCol = 0; pcNames < pcNamesEnd; uiCol++)
+	{
+		const char* pcNameEnd = std::find(pcNames, pcNamesEnd, '\n');
+		doc.SetColumnName(uiCol, std::string(pcNames, pcNameEnd));
+		pcNames = (pcNameEnd == pcNamesEnd) ? pcNamesEnd : pcNameEnd + 1;
+	}
+
+	// Draw all the tiles into the cache again
+	bCacheAllDirty = true;
+
 	return true;
 }
 
@@ -890,6 +974,8 @@ void CMap2D::SetCurrentLevel(unsigned int uiCurLevel)
 {
 	if (uiCurLevel < uiNumLevels)
 	{
+		if (this->uiCurLevel != uiCurLevel)
+			bCacheAllDirty = true;
 		this->uiCurLevel = uiCurLevel;
 	}
 }
@@ -910,16 +996,232 @@ void CMap2D::RenderTile(const unsigned int uiRow, const unsigned int uiCol)
 {
 	if (arrMapInfo[uiCurLevel][uiRow][uiCol].value < 200)
 	{
-		//if (arrMapInfo[uiCurLevel][uiRow][uiCol].value < 3)
-		glBindTexture(GL_TEXTURE_2D, MapOfTextureIDs.at(arrMapInfo[uiCurLevel][uiRow][uiCol].value));
+		transform = GetTileTransform(uiRow, uiCol);
+
+		//CS: Submit the tile to the render queue, which is flushed by CScene2D
+		CRenderQueue::GetInstance()->Submit(CRenderQueue::LAYER_MAP, cShader,
+											MapOfTextureIDs.at(arrMapInfo[uiCurLevel][uiRow][uiCol].value),
+											quadMesh, transform);
+	}
+}
+
+
+/**
+ @brief Get the model transform of a tile, which scales the shared unit quad to the size of a tile
+ @param iRow A const int variable containing the row index of the tile
+ @param iCol A const int variable containing the column index of the tile
+ */
+glm::mat4 CMap2D::GetTileTransform(const unsigned int uiRow, const unsigned int uiCol) const
+{
+	glm::mat4 tileTransform = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
+	tileTransform = glm::translate(tileTransform, glm::vec3(cSettings->ConvertIndexToUVSpace(cSettings->x, uiCol, false, 0),
+															cSettings->ConvertIndexToUVSpace(cSettings->y, uiRow, true, 0),
+															0.0f));
+	tileTransform = glm::scale(tileTransform, glm::vec3(cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT, 1.0f));
+	return tileTransform;
+}
+
+/**
+ @brief Enable or disable drawing the map from an offscreen texture which caches its tiles
+ @param bEnable A const bool variable which is true to draw from the cache, or false to draw every tile
+ */
+void CMap2D::SetRenderCache(const bool bEnable)
+{
+	bRenderCache = bEnable;
+	// The cache is not updated while it is disabled, so draw all the tiles into it when it is enabled again
+	if (bRenderCache)
+		bCacheAllDirty = true;
+}
+
+/**
+ @brief Check if the map is drawn from the offscreen texture
+ */
+bool CMap2D::IsRenderCacheEnabled(void) const
+{
+	return bRenderCache;
+}
+
+/**
+ @brief Mark a tile to be drawn into the cache again
+ @param iRow A const int variable containing the row index of the tile in arrMapInfo
+ @param iCol A const int variable containing the column index of the tile in arrMapInfo
+ */
+void CMap2D::MarkCacheDirty(const unsigned int uiRow, const unsigned int uiCol)
+{
+	if (bCacheAllDirty)
+		return;
+
+	cacheDirtyTiles.push_back(glm::u32vec2(uiCol, uiRow));
+	// If many tiles changed, such as when a new wave starts, it is faster to draw all of them
+	if (cacheDirtyTiles.size() > (cSettings->NUM_TILES_XAXIS * cSettings->NUM_TILES_YAXIS) / 4)
+	{
+		bCacheAllDirty = true;
+		cacheDirtyTiles.clear();
+	}
+}
+
+/**
+ @brief Create the cache framebuffer and texture
+ @return true if the framebuffer is complete, otherwise false
+ */
+bool CMap2D::CreateRenderCache(void)
+{
+	// Match the size of a tile on the screen, so that the cache looks the same as drawing the tiles
+	unsigned int uiTileWidth = (unsigned int)ceil((float)(cSettings->iWindowWidth * cSettings->NUM_TILES_MULTIPLIERX) / cSettings->NUM_TILES_XAXIS);
+	unsigned int uiTileHeight = (unsigned int)ceil((float)(cSettings->iWindowHeight * cSettings->NUM_TILES_MULTIPLIERY) / cSettings->NUM_TILES_YAXIS);
+	uiCacheTileSize = (uiTileWidth > uiTileHeight) ? uiTileWidth : uiTileHeight;
+
+	// Make sure that the cache fits in a texture
+	CRenderState* cRenderState = CRenderState::GetInstance();
+	GLint iMaxTextureSize = cRenderState->GetMaxTextureSize();
+	unsigned int uiMaxTiles = (cSettings->NUM_TILES_XAXIS > cSettings->NUM_TILES_YAXIS) ? cSettings->NUM_TILES_XAXIS : cSettings->NUM_TILES_YAXIS;
+	if (uiCacheTileSize * uiMaxTiles > (unsigned int)iMaxTextureSize)
+		uiCacheTileSize = (unsigned int)iMaxTextureSize / uiMaxTiles;
+	if (uiCacheTileSize == 0)
+	{
+		cout << "CMap2D::CreateRenderCache() : The map is too large to be cached in a texture" << endl;
+		return false;
+	}
 
-		glBindVertexArray(VAO);
-		//CS: Render the tile
-		quadMesh->Render();
-		glBindVertexArray(0);
+	// Create the texture which the tiles are drawn into
+	uiCacheTexture = cRenderState->GenTexture();
+	cRenderState->ActiveTexture(GL_TEXTURE0);
+	cRenderState->BindTexture2D(uiCacheTexture);
+	cRenderState->TexImage2D(0, GL_RGBA8,
+				cSettings->NUM_TILES_XAXIS * uiCacheTileSize, cSettings->NUM_TILES_YAXIS * uiCacheTileSize,
+				GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+	cRenderState->TexParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	cRenderState->TexParameter(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	cRenderState->TexParameter(GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	cRenderState->TexParameter(GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	cRenderState->BindTexture2D(0);
+
+	// Create the framebuffer with the texture as its colour buffer
+	uiCacheFBO = cRenderState->GenFramebuffer();
+	cRenderState->BindFramebuffer(uiCacheFBO);
+	GLenum eStatus = cRenderState->AttachFramebufferTexture(uiCacheTexture);
+	cRenderState->BindFramebuffer(0);
+
+	if (eStatus != GL_FRAMEBUFFER_COMPLETE)
+	{
+		cout << "CMap2D::CreateRenderCache() : The framebuffer is not complete (0x" << hex << eStatus << dec << ")" << endl;
+		DeleteRenderCache();
+		return false;
 	}
+
+	// The new texture is empty, so draw all the tiles into it
+	bCacheAllDirty = true;
+	return true;
 }
 
+/**
+ @brief Delete the cache framebuffer and texture
+ */
+void CMap2D::DeleteRenderCache(void)
+{
+	if (uiCacheFBO != 0)
+	{
+		CRenderState::GetInstance()->DeleteFramebuffer(uiCacheFBO);
+		uiCacheFBO = 0;
+	}
+	if (uiCacheTexture != 0)
+	{
+		// CRenderState forgets its bindings, so that binding a new texture with the same ID is not skipped
+		CRenderState::GetInstance()->DeleteTexture(uiCacheTexture);
+		uiCacheTexture = 0;
+	}
+}
+
+/**
+ @brief Draw the tiles which changed into the cache
+ */
+void CMap2D::UpdateRenderCache(void)
+{
+	if ((uiCacheFBO == 0) && (CreateRenderCache() == false))
+	{
+		// Draw the tiles every frame instead
+		bRenderCache = false;
+		return;
+	}
+
+	// A tile texture may have been a placeholder when the cache was drawn
+	unsigned int uiNumUploads = CImageLoader::GetInstance()->GetNumUploads();
+	if (uiNumUploads != uiCacheNumUploads)
+	{
+		uiCacheNumUploads = uiNumUploads;
+		bCacheAllDirty = true;
+	}
+
+	if ((bCacheAllDirty == false) && (cacheDirtyTiles.empty()))
+		return;
+
+	// Keep the viewport and clear colour, so that they can be restored for the rest of the frame
+	CRenderState* cRenderState = CRenderState::GetInstance();
+	GLint iViewport[4];
+	cRenderState->GetViewport(iViewport);
+	GLfloat fClearColour[4];
+	cRenderState->GetClearColor(fClearColour);
+
+	cRenderState->BindFramebuffer(uiCacheFBO);
+	cRenderState->Viewport(0, 0, cSettings->NUM_TILES_XAXIS * uiCacheTileSize, cSettings->NUM_TILES_YAXIS * uiCacheTileSize);
+	cRenderState->ClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+
+	// The map covers -1 to 1 in both axes, which is the whole framebuffer
+	CShaderManager::GetInstance()->Use(sShaderName);
+	CShader* cActiveShader = UpdateUniformHandles();
+	cActiveShader->set(uniformViewProjection, glm::mat4(1.0f));
+	cActiveShader->setVec2("spriteGrid", glm::vec2(1.0f));
+	cActiveShader->setInt("spriteFrame", 0);
+
+	// The tiles do not overlap, so they replace the texels of the cache instead of blending with them.
+	// The cache is blended when it is drawn, just like the tiles would have been
+	cRenderState->SetBlend(false);
+	cRenderState->ActiveTexture(GL_TEXTURE0);
+
+	if (bCacheAllDirty)
+	{
+		cRenderState->Clear(GL_COLOR_BUFFER_BIT);
+		for (unsigned int uiRow = 0; uiRow < cSettings->NUM_TILES_YAXIS; uiRow++)
+		{
+			for (unsigned int uiCol = 0; uiCol < cSettings->NUM_TILES_XAXIS; uiCol++)
+			{
+				if (arrMapInfo[uiCurLevel][uiRow][uiCol].value >= 200)
+					continue;
+				cActiveShader->set(uniformTransform, GetTileTransform(uiRow, uiCol));
+				cRenderState->BindTexture2D(MapOfTextureIDs.at(arrMapInfo[uiCurLevel][uiRow][uiCol].value));
+				quadMesh->Render();
+			}
+		}
+	}
+	else
+	{
+		// Clear only the changed tiles, as a tile which is removed is not drawn over
+		cRenderState->SetScissorTest(true);
+		for (unsigned int i = 0; i < cacheDirtyTiles.size(); i++)
+		{
+			unsigned int uiCol = cacheDirtyTiles[i].x;
+			unsigned int uiRow = cacheDirtyTiles[i].y;
+			// Row 0 of arrMapInfo is at the top of the map, but at the bottom of the framebuffer
+			cRenderState->Scissor(uiCol * uiCacheTileSize, (cSettings->NUM_TILES_YAXIS - uiRow - 1) * uiCacheTileSize,
+					uiCacheTileSize, uiCacheTileSize);
+			cRenderState->Clear(GL_COLOR_BUFFER_BIT);
+
+			if (arrMapInfo[uiCurLevel][uiRow][uiCol].value >= 200)
+				continue;
+			cActiveShader->set(uniformTransform, GetTileTransform(uiRow, uiCol));
+			cRenderState->BindTexture2D(MapOfTextureIDs.at(arrMapInfo[uiCurLevel][uiRow][uiCol].value));
+			quadMesh->Render();
+		}
+		cRenderState->SetScissorTest(false);
+	}
+
+	bCacheAllDirty = false;
+	cacheDirtyTiles.clear();
+
+	cRenderState->BindFramebuffer(0);
+	cRenderState->Viewport(iViewport[0], iViewport[1], iViewport[2], iViewport[3]);
+	cRenderState->ClearColor(fClearColour[0], fClearColour[1], fClearColour[2], fClearColour[3]);
+}
 
 /**
  @brief Find a path
@@ -929,6 +1231,11 @@ std::vector<glm::vec2> CMap2D::PathFind(	const glm::vec2& startPos,
 											HeuristicFunction heuristicFunc, 
 											const int weight)
 {
+	PROFILE_FUNCTION();
+
+	CMetricsRegistry* cMetricsRegistry = CMetricsRegistry::GetInstance();
+	cMetricsRegistry->Add(uiMetricPathFindCalls);
+
 	// Check if the startPos and targetPost are blocked
 	if (isBlocked(startPos.y, startPos.x) ||
 		(isBlocked(targetPos.y, targetPos.x)))
@@ -939,41 +1246,44 @@ std::vector<glm::vec2> CMap2D::PathFind(	const glm::vec2& startPos,
 		return path;
 	}
 
-	// Set up the variables and lists
-	m_startPos = startPos;
-	m_targetPos = targetPos;
-	m_weight = weight;
-	m_heuristic = std::bind(heuristicFunc, _1, _2, _3);
+	// Set up the variables and lists of this thread, so that the enemies can find their paths in parallel
+	SAStarLists& sLists = GetAStarLists();
+	sLists.m_startPos = startPos;
+	sLists.m_targetPos = targetPos;
+	sLists.m_weight = weight;
+	sLists.m_heuristic = std::bind(heuristicFunc, _1, _2, _3);
 
 	// Reset AStar lists
-	ResetAStarLists();
+	ResetAStarLists(sLists);
 
 	// Add the start pos to 2 lists
-	m_cameFromList[ConvertTo1D(m_startPos)].parent = m_startPos;
-	m_openList.push(Grid(m_startPos, 0));
+	sLists.m_cameFromList[ConvertTo1D(sLists.m_startPos)].parent = sLists.m_startPos;
+	sLists.m_openList.push(Grid(sLists.m_startPos, 0));
 
 	unsigned int fNew, gNew, hNew;
 	glm::vec2 currentPos;
+	unsigned int uiNumNodesExpanded = 0;
 
 	// Start the path finding...
-	while (!m_openList.empty())
+	while (!sLists.m_openList.empty())
 	{
 		// Get the node with the least f value
-		currentPos = m_openList.top().pos;
+		currentPos = sLists.m_openList.top().pos;
 		//cout << endl << "*** New position to check: " << currentPos.x << ", " << currentPos.y << endl;
-		//cout << "*** targetPos: " << m_targetPos.x << ", " << m_targetPos.y << endl;
+		//cout << "*** targetPos: " << sLists.m_targetPos.x << ", " << sLists.m_targetPos.y << endl;
 
 		// If the targetPos was reached, then quit this loop
-		if (currentPos == m_targetPos)
+		if (currentPos == sLists.m_targetPos)
 		{
-			//cout << "=== Found the targetPos: " << m_targetPos.x << ", " << m_targetPos.y << endl;
-			while (m_openList.size() != 0)
-				m_openList.pop();
+			//cout << "=== Found the targetPos: " << sLists.m_targetPos.x << ", " << sLists.m_targetPos.y << endl;
+			while (sLists.m_openList.size() != 0)
+				sLists.m_openList.pop();
 			break;
 		}
 
-		m_openList.pop();
-		m_closedList[ConvertTo1D(currentPos)] = true;
+		sLists.m_openList.pop();
+		sLists.m_closedList[ConvertTo1D(currentPos)] = true;
+		uiNumNodesExpanded++;
 
 		// Check the neighbors of the current node
 		for (unsigned int i = 0; i < m_nrOfDirections; ++i)
@@ -984,22 +1294,22 @@ std::vector<glm::vec2> CMap2D::PathFind(	const glm::vec2& startPos,
 			//cout << "\t#" << i << ": Check this: " << neighborPos.x << ", " << neighborPos.y << ":\t";
 			if (!isValid(neighborPos) || 
 				isBlocked(neighborPos.y, neighborPos.x) || 
-				m_closedList[neighborIndex] == true)
+				sLists.m_closedList[neighborIndex] == true)
 			{
 				//cout << "This position is not valid. Going to next neighbour." << endl;
 				continue;
 			}
 
-			gNew = m_cameFromList[ConvertTo1D(currentPos)].g + 1;
-			hNew = m_heuristic(neighborPos, m_targetPos, m_weight);
+			gNew = sLists.m_cameFromList[ConvertTo1D(currentPos)].g + 1;
+			hNew = sLists.m_heuristic(neighborPos, sLists.m_targetPos, sLists.m_weight);
 			fNew = gNew + hNew;
 
-			if (m_cameFromList[neighborIndex].f == 0 || fNew < m_cameFromList[neighborIndex].f)
+			if (sLists.m_cameFromList[neighborIndex].f == 0 || fNew < sLists.m_cameFromList[neighborIndex].f)
 			{
 				//cout << "Adding to Open List: " << neighborPos.x << ", " << neighborPos.y;
 				//cout << ". [ f : " << fNew << ", g : " << gNew << ", h : " << hNew << "]" << endl;
-				m_openList.push(Grid(neighborPos, fNew));
-				m_cameFromList[neighborIndex] = { neighborPos, currentPos, fNew, gNew, hNew };
+				sLists.m_openList.push(Grid(neighborPos, fNew));
+				sLists.m_cameFromList[neighborIndex] = { neighborPos, currentPos, fNew, gNew, hNew };
 			}
 			else
 			{
@@ -1009,39 +1319,52 @@ std::vector<glm::vec2> CMap2D::PathFind(	const glm::vec2& startPos,
 		//system("pause");
 	}
 
-	return BuildPath();
+	cMetricsRegistry->Add(uiMetricNodesExpanded, uiNumNodesExpanded);
+	cMetricsRegistry->Observe(uiMetricNodesPerPath, uiNumNodesExpanded);
+
+	return BuildPath(sLists);
+}
+
+/**
+ @brief Get the AStar lists of the calling thread
+ */
+CMap2D::SAStarLists& CMap2D::GetAStarLists(void)
+{
+	static thread_local SAStarLists sLists;
+	return sLists;
 }
 
 /**
  @brief Build a path
+ @param sLists The AStar lists after calling PathFind()
  */
-std::vector<glm::vec2> CMap2D::BuildPath() const
+std::vector<glm::vec2> CMap2D::BuildPath(const SAStarLists& sLists) const
 {
 	std::vector<glm::vec2> path;
-	auto currentPos = m_targetPos;
+	auto currentPos = sLists.m_targetPos;
 	auto currentIndex = ConvertTo1D(currentPos);
 
-	while (!(m_cameFromList[currentIndex].parent == currentPos))
+	while (!(sLists.m_cameFromList[currentIndex].parent == currentPos))
 	{
 		path.push_back(currentPos);
-		currentPos = m_cameFromList[currentIndex].parent;
+		currentPos = sLists.m_cameFromList[currentIndex].parent;
 		currentIndex = ConvertTo1D(currentPos);
 	}
 
 	// If the path has only 1 entry, then it is the the target position
 	if (path.size() == 1)
 	{
-		// if m_startPos is next to m_targetPos, then having 1 path point is OK
+		// if sLists.m_startPos is next to sLists.m_targetPos, then having 1 path point is OK
 		if (m_nrOfDirections == 4)
 		{
-			if (abs(m_targetPos.y - m_startPos.y) + abs(m_targetPos.x - m_startPos.x) > 1)
+			if (abs(sLists.m_targetPos.y - sLists.m_startPos.y) + abs(sLists.m_targetPos.x - sLists.m_startPos.x) > 1)
 				path.clear();
 		}
 		else
 		{
-			if (abs(m_targetPos.y - m_startPos.y) + abs(m_targetPos.x - m_startPos.x) > 2)
+			if (abs(sLists.m_targetPos.y - sLists.m_startPos.y) + abs(sLists.m_targetPos.x - sLists.m_startPos.x) > 2)
 				path.clear();
-			else if (abs(m_targetPos.y - m_startPos.y) + abs(m_targetPos.x - m_startPos.x) > 1)
+			else if (abs(sLists.m_targetPos.y - sLists.m_startPos.y) + abs(sLists.m_targetPos.x - sLists.m_startPos.x) > 1)
 				path.clear();
 		}
 	}
@@ -1084,9 +1407,10 @@ void CMap2D::PrintSelf(void) const
 		}
 	}
 
-	cout << "m_openList: " << m_openList.size() << endl;
-	cout << "m_cameFromList: " << m_cameFromList.size() << endl;
-	cout << "m_closedList: " << m_closedList.size() << endl;
+	const SAStarLists& sLists = GetAStarLists();
+	cout << "m_openList: " << sLists.m_openList.size() << endl;
+	cout << "m_cameFromList: " << sLists.m_cameFromList.size() << endl;
+	cout << "m_closedList: " << sLists.m_closedList.size() << endl;
 
 	cout << "===== AStar::PrintSelf() =====" << endl;
 }
@@ -1138,43 +1462,51 @@ int CMap2D::ConvertTo1D(const glm::vec2& pos) const
 }
 
 /**
- @brief Delete AStar lists
+ @brief Delete the AStar lists of the calling thread
  */
 bool CMap2D::DeleteAStarLists(void)
 {
+	SAStarLists& sLists = GetAStarLists();
 	// Delete m_openList
-	while (m_openList.size() != 0)
-		m_openList.pop();
+	while (sLists.m_openList.size() != 0)
+		sLists.m_openList.pop();
 	// Delete m_cameFromList
-	m_cameFromList.clear();
+	sLists.m_cameFromList.clear();
 	// Delete m_closedList
-	m_closedList.clear();
+	sLists.m_closedList.clear();
 
 	return true;
 }
 
 
 /**
- @brief Reset AStar lists
+ @brief Reset AStar lists. They are resized to the map on the first path finding of a thread
+ @param sLists The AStar lists
  */
-bool CMap2D::ResetAStarLists(void)
+bool CMap2D::ResetAStarLists(SAStarLists& sLists)
 {
 	// Delete m_openList
-	while (m_openList.size() != 0)
-		m_openList.pop();
+	while (sLists.m_openList.size() != 0)
+		sLists.m_openList.pop();
+	// Resize these 2 lists
+	const unsigned int uiNumTiles = cSettings->NUM_TILES_YAXIS * cSettings->NUM_TILES_XAXIS;
+	if (sLists.m_cameFromList.size() != uiNumTiles)
+		sLists.m_cameFromList.resize(uiNumTiles);
+	if (sLists.m_closedList.size() != uiNumTiles)
+		sLists.m_closedList.resize(uiNumTiles, false);
 	// Reset m_cameFromList
-	for (int i = 0; i < m_cameFromList.size(); i++)
+	for (int i = 0; i < sLists.m_cameFromList.size(); i++)
 	{
-		m_cameFromList[i].pos = glm::vec2(0,0);
-		m_cameFromList[i].parent = glm::vec2(0, 0);
-		m_cameFromList[i].f = 0;
-		m_cameFromList[i].g = 0;
-		m_cameFromList[i].h = 0;
+		sLists.m_cameFromList[i].pos = glm::vec2(0,0);
+		sLists.m_cameFromList[i].parent = glm::vec2(0, 0);
+		sLists.m_cameFromList[i].f = 0;
+		sLists.m_cameFromList[i].g = 0;
+		sLists.m_cameFromList[i].h = 0;
 	}
 	// Reset m_closedList
-	for (int i = 0; i < m_closedList.size(); i++)
+	for (int i = 0; i < sLists.m_closedList.size(); i++)
 	{
-		m_closedList[i] = false;
+		sLists.m_closedList[i] = false;
 	}
 
 	return true;
@@ -22,6 +22,8 @@
 
 // Include the RapidCSV
 #include "System/rapidcsv.h"
+// Include the AssetPack for the cooked maps
+#include "System/AssetPack.h"
 // Include map storage
 #include <map>
 
@@ -135,6 +137,11 @@ public:
 
 	const glm::vec2& GetPlayerSpawnIndex() const;
 
+	// Enable or disable drawing the map from an offscreen texture which caches its tiles
+	void SetRenderCache(const bool bEnable);
+	// Check if the map is drawn from the offscreen texture
+	bool IsRenderCacheEnabled(void) const;
+
 	bool bIsActive;
 	bool hitBox;
 
@@ -174,9 +181,55 @@ protected:
 	// Render a tile
 	void RenderTile(const unsigned int uiRow, const unsigned int uiCol);
 
+	// Offscreen framebuffer and texture which cache the rendered tiles of the current level
+	GLuint uiCacheFBO;
+	GLuint uiCacheTexture;
+	// The size of a tile in the cache texture, in pixels
+	unsigned int uiCacheTileSize;
+	// If true, the map is drawn as one quad with the cache texture
+	bool bRenderCache;
+	// If true, all the tiles are drawn into the cache again, e.g. after a level is loaded
+	bool bCacheAllDirty;
+	// The number of images which CImageLoader had uploaded when the cache was drawn.
+	// The tiles are loaded asynchronously, so the cache is drawn again when this changes
+	unsigned int uiCacheNumUploads;
+	// The tiles which changed since the cache was updated, as (column, row) in arrMapInfo
+	std::vector<glm::u32vec2> cacheDirtyTiles;
+
+	// Mark a tile to be drawn into the cache again
+	void MarkCacheDirty(const unsigned int uiRow, const unsigned int uiCol);
+	// Create the cache framebuffer and texture
+	bool CreateRenderCache(void);
+	// Delete the cache framebuffer and texture
+	void DeleteRenderCache(void);
+	// Draw the dirty tiles into the cache
+	void UpdateRenderCache(void);
+	// Get the model transform of a tile
+	glm::mat4 GetTileTransform(const unsigned int uiRow, const unsigned int uiCol) const;
+
+	// Load a map which was cooked into the asset pack
+	bool LoadMapFromPack(const CAssetPack::SEntry* pEntry, const unsigned int uiCurLevel);
+
+	// The lists and the variables of a path finding. Each thread has its own, so that
+	// the enemies can find their paths in parallel
+	struct SAStarLists
+	{
+		int m_weight;
+		glm::vec2 m_startPos;
+		glm::vec2 m_targetPos;
+		// The handle for heuristic functions
+		HeuristicFunction m_heuristic;
+
+		std::priority_queue<Grid> m_openList;
+		std::vector<bool> m_closedList;
+		std::vector<Grid> m_cameFromList;
+	};
+
 	// For A-Star PathFinding
+	// Get the AStar lists of the calling thread
+	static SAStarLists& GetAStarLists(void);
 	// Build a path from m_cameFromList after calling PathFind()
-	std::vector<glm::vec2> BuildPath() const;
+	std::vector<glm::vec2> BuildPath(const SAStarLists& sLists) const;
 	// Check if a grid is valid
 	bool isValid(const glm::vec2& pos) const;
 	// Check if a grid is blocked
@@ -189,21 +242,17 @@ protected:
 	// Delete AStar lists
 	bool DeleteAStarLists(void);
 	// Reset AStar lists
-	bool ResetAStarLists(void);
+	bool ResetAStarLists(SAStarLists& sLists);
 
 	// Variables for A-Star PathFinding
-	int m_weight;
 	unsigned int m_nrOfDirections;
-	glm::vec2 m_startPos;
-	glm::vec2 m_targetPos;
 
-	// The handle for heuristic functions
-	HeuristicFunction m_heuristic;
+	// The metrics of the path finding
+	unsigned int uiMetricPathFindCalls;
+	unsigned int uiMetricNodesExpanded;
+	unsigned int uiMetricNodesPerPath;
 
-	// Lists for A-Star PathFinding
-	std::priority_queue<Grid> m_openList;
-	std::vector<bool> m_closedList;
-	std::vector<Grid> m_cameFromList;
+	// The directions for A-Star PathFinding
 	std::vector<glm::vec2> m_directions;
 
 	//CS: Animated Sprite
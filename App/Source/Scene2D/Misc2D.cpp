@@ -7,12 +7,21 @@
 #include "Misc2D.h"
 
 #include <iostream>
+#include <cassert>
 using namespace std;
 
 // Include Shader Manager
 #include "RenderControl\ShaderManager.h"
+// Include Render State
+#include "RenderControl\RenderState.h"
+// Include Render Queue
+#include "RenderControl\RenderQueue.h"
+// Include Mesh Manager
+#include "Primitives\MeshManager.h"
 // Include Mesh Builder
 #include "Primitives/MeshBuilder.h"
+// Include Animation Set Manager
+#include "Primitives\AnimationSetManager.h"
 
 // Include GLEW
 #include <GL/glew.h>
@@ -36,6 +45,7 @@ CMisc2D::CMisc2D(void)
 	, sCurrentFSM(FSM::IDLE)
 	, iFSMCounter(0)
 	, quadMesh(NULL)
+	, animatedMisc(NULL)
 {
 	transform = glm::mat4(1.0f);	// make sure to initialize matrix to identity matrix first
 
@@ -57,12 +67,8 @@ CMisc2D::CMisc2D(void)
  */
 CMisc2D::~CMisc2D(void)
 {
-	// Delete the quadMesh
-	if (quadMesh)
-	{
-		delete quadMesh;
-		quadMesh = NULL;
-	}
+	// The quadMesh is shared, so it is deleted by CMeshManager
+	quadMesh = NULL;
 
 	// We won't delete this since it was created elsewhere
 	cPlayer2D = NULL;
@@ -70,10 +76,35 @@ CMisc2D::~CMisc2D(void)
 	// We won't delete this since it was created elsewhere
 	cMap2D = NULL;
 
+	if (animatedMisc)
+	{
+		delete animatedMisc;
+		animatedMisc = NULL;
+	}
+
 	// optional: de-allocate all resources once they've outlived their purpose:
-	glDeleteVertexArrays(1, &VAO);
-	glDeleteBuffers(1, &VBO);
-	glDeleteBuffers(1, &EBO);
+	CRenderState::GetInstance()->DeleteBuffer(VBO);
+	CRenderState::GetInstance()->DeleteBuffer(EBO);
+}
+
+/**
+ @brief Get the animation clips shared by all the misc items, building them on the first call
+ @return The shared animation set
+ */
+const CAnimationSet* CMisc2D::GetAnimationSet(void)
+{
+	const CAnimationSet* cAnimationSet = CAnimationSetManager::GetInstance()->Get("Misc2D");
+	if (cAnimationSet)
+		return cAnimationSet;
+
+	// The clips are added in the order of ANIMATION, so their IDs match it
+	CAnimationSet* cNewAnimationSet = new CAnimationSet(1, 4);
+	cNewAnimationSet->AddAnimation("idle", 0, 3);
+
+	// Each clip in ANIMATION must have been added, or the IDs would not match the clips
+	assert(NUM_ANIMATIONS == cNewAnimationSet->GetNumAnimations());
+
+	return CAnimationSetManager::GetInstance()->Add("Misc2D", cNewAnimationSet);
 }
 
 /**
@@ -112,11 +143,8 @@ bool CMisc2D::Init(void)
 	// By default, microsteps should be zero
 	i32vec2NumMicroSteps = glm::i32vec2(0, 0);
 
-	glGenVertexArrays(1, &VAO);
-	glBindVertexArray(VAO);
-
-	//CS: Create the Quad Mesh using the mesh builder
-	quadMesh = CMeshBuilder::GenerateQuad(glm::vec4(1, 1, 1, 1), cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT);
+	//CS: Use the unit quad which is shared by all the entities
+	quadMesh = CMeshManager::GetInstance()->GetUnitQuad();
 
 	if (miscType == COIN)
 	{
@@ -139,10 +167,10 @@ bool CMisc2D::Init(void)
 		}
 	}
 
-	animatedMisc = CMeshBuilder::GenerateSpriteAnimation(1, 4, cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT);
-	animatedMisc->AddAnimation("idle", 0, 3);
+	//CS: Create the animated sprite, which plays the clips shared by all the misc items
+	animatedMisc = new CSpriteAnimation(GetAnimationSet());
 	//CS: Play the "idle" animation as default
-	animatedMisc->PlayAnimation("idle", -1, 1.0f);
+	animatedMisc->PlayAnimation(ANIM_IDLE, -1, 1.0f);
 
 	//CS: Init the color to white
 	runtimeColour = glm::vec4(1.0, 1.0, 1.0, 1.0);
@@ -201,45 +229,35 @@ void CMisc2D::PreRender(void)
 		return;
 
 	// bind textures on corresponding texture units
-	glActiveTexture(GL_TEXTURE0);
+	CRenderState::GetInstance()->ActiveTexture(GL_TEXTURE0);
 
 	// Activate blending mode
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	CRenderState::GetInstance()->SetBlend(true);
+	CRenderState::GetInstance()->BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 	// Activate the shader
 	CShaderManager::GetInstance()->Use(sShaderName);
 }
 
 /**
- @brief Render this instance
+ @brief Render this instance by submitting it to the CRenderQueue
  */
 void CMisc2D::Render(const glm::mat4& view, const glm::mat4& projection)
 {
 	if (!bIsActive)
 		return;
 
-	glBindVertexArray(VAO);
-	// get matrix's uniform location and set matrix
-	unsigned int transformLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "transform");
-	unsigned int colorLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "runtimeColour");
 	transform = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
 	transform = glm::translate(transform, glm::vec3(vec2UVCoordinate.x,
 		vec2UVCoordinate.y,
 		0.0f));
-	// Update the shaders with the latest transform
-	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(projection * view * transform));
-	glUniform4fv(colorLoc, 1, glm::value_ptr(runtimeColour));
-
-	// Get the texture to be rendered
-	glBindTexture(GL_TEXTURE_2D, iTextureID);
 
-	// Render the tile
-	//glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-	//quadMesh->Render();
-	animatedMisc->Render();
-	glBindVertexArray(0);
+	transform = glm::scale(transform, glm::vec3(cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT, 1.0f));
 
+	// Submit the current frame of the animated sprite to the render queue, which is flushed by CScene2D
+	CRenderQueue::GetInstance()->Submit(CRenderQueue::LAYER_MISC, cShader, iTextureID,
+										quadMesh, transform, runtimeColour,
+										animatedMisc->GetCurrentFrame(), animatedMisc->GetSpriteGrid());
 }
 
 /**
@@ -251,7 +269,7 @@ void CMisc2D::PostRender(void)
 		return;
 
 	// Disable blending
-	glDisable(GL_BLEND);
+	CRenderState::GetInstance()->SetBlend(false);
 }
 
 /**
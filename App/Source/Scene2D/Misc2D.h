@@ -109,6 +109,16 @@ protected:
 		A = 2
 	};
 
+	// The IDs of the animation clips, in the order which they are added to the animation set
+	enum ANIMATION
+	{
+		ANIM_IDLE = 0,
+		NUM_ANIMATIONS
+	};
+
+	// Get the animation clips shared by all the misc items
+	static const CAnimationSet* GetAnimationSet(void);
+
 	glm::vec2 i32vec2OldIndex;
 
 	//CS: The quadMesh for drawing the tiles
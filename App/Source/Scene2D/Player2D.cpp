@@ -7,10 +7,15 @@
 #include "Player2D.h"
 
 #include <iostream>
+#include <cassert>
 using namespace std;
 
 // Include Shader Manager
 #include "RenderControl\ShaderManager.h"
+// Include Render State
+#include "RenderControl\RenderState.h"
+// Include Render Queue
+#include "RenderControl\RenderQueue.h"
 
 // Include ImageLoader
 #include "System\ImageLoader.h"
@@ -18,6 +23,16 @@ using namespace std;
 // Include the Map2D as we will use it to check the player's movements and actions
 #include "Map2D.h"
 #include "Primitives/MeshBuilder.h"
+// Include CMeshManager which owns the shared meshes
+#include "Primitives\MeshManager.h"
+// Include CAnimationSetManager which owns the shared animation clips
+#include "Primitives\AnimationSetManager.h"
+// Include CProfiler for the profiler zones
+#include "TimeControl\Profiler.h"
+// Include CFixedTimeStep to draw the player between the ticks
+#include "TimeControl\FixedTimeStep.h"
+// Include CRandomService to place the ores randomly
+#include "System\RandomService.h"
 
 // Include Game Manager
 #include "GameManager.h"
@@ -31,6 +46,8 @@ CPlayer2D::CPlayer2D(void)
 	, cInventoryManager(NULL)
 	, cInventoryItem(NULL)
 	, cSoundController(NULL)
+	, quadMesh(NULL)
+	, animatedPlayer(NULL)
 {
 	transform = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
 
@@ -42,6 +59,7 @@ CPlayer2D::CPlayer2D(void)
 
 	// Initialise vec2UVCoordinate
 	vec2UVCoordinate = glm::vec2(0.0f);
+	vec2PrevUVCoordinate = glm::vec2(0.0f);
 }
 
 /**
@@ -61,14 +79,20 @@ CPlayer2D::~CPlayer2D(void)
 	// We won't delete this since it was created elsewhere
 	cMap2D = NULL;
 
+	// The quadMesh is shared, so it is deleted by CMeshManager
+	quadMesh = NULL;
+
+	if (animatedPlayer)
+	{
+		delete animatedPlayer;
+		animatedPlayer = NULL;
+	}
+
 	if (cBulletGenerator)
 	{
 		delete cBulletGenerator;
 		cBulletGenerator = nullptr;
 	}
-
-	// optional: de-allocate all resources once they've outlived their purpose:
-	glDeleteVertexArrays(1, &VAO);
 }
 
 /**
@@ -108,9 +132,11 @@ bool CPlayer2D::Init(void)
 	vec2Index = glm::i32vec2(uiCol, uiRow);
 	// By default, microsteps should be zero
 	vec2NumMicroSteps = glm::i32vec2(0, 0);
+	// Draw the player at the start position from the first frame, instead of moving it there
+	vec2UVCoordinate.x = cSettings->ConvertIndexToUVSpace(cSettings->x, vec2Index.x, false, vec2NumMicroSteps.x * cSettings->MICRO_STEP_XAXIS);
+	vec2UVCoordinate.y = cSettings->ConvertIndexToUVSpace(cSettings->y, vec2Index.y, false, vec2NumMicroSteps.y * cSettings->MICRO_STEP_YAXIS);
+	vec2PrevUVCoordinate = vec2UVCoordinate;
 
-	glGenVertexArrays(1, &VAO);
-	glBindVertexArray(VAO);
 	
 	// Load the player texture 
 	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Sprites/Player.png", true);
@@ -120,19 +146,15 @@ bool CPlayer2D::Init(void)
 		return false;
 	}
 	
+	//CS: Use the shared quad, and draw the frames of the sprite sheet on it
+	quadMesh = CMeshManager::GetInstance()->GetUnitQuad();
+
 	//CS: Create the animated sprite and setup the animation 
-	animatedPlayer = CMeshBuilder::GenerateSpriteAnimation(8, 4, cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT);
-	animatedPlayer->AddAnimation("rightS", 0, 3);
-	animatedPlayer->AddAnimation("leftS", 4, 7);
-	animatedPlayer->AddAnimation("HrightS", 8, 11);
-	animatedPlayer->AddAnimation("HleftS", 12, 15);
-	
-	animatedPlayer->AddAnimation("rightW", 16, 19);
-	animatedPlayer->AddAnimation("leftW", 20, 23);
-	animatedPlayer->AddAnimation("HrightW", 24, 27);
-	animatedPlayer->AddAnimation("HleftW", 28, 31);
+	if (animatedPlayer)
+		delete animatedPlayer;
+	animatedPlayer = new CSpriteAnimation(GetAnimationSet());
 	//CS: Play the "idle" animation as default
-	animatedPlayer->PlayAnimation("rightW", -1, 1.0f);
+	animatedPlayer->PlayAnimation(ANIM_RIGHT_W, -1, 1.0f);
 
 	//CS: Init the color to white
 	runtimeColour = glm::vec4(1.0, 1.0, 1.0, 1.0);
@@ -176,6 +198,34 @@ bool CPlayer2D::Init(void)
 	return true;
 }
 
+/**
+ @brief Get the animation clips of the player, building them on the first call
+ @return The shared animation set
+ */
+const CAnimationSet* CPlayer2D::GetAnimationSet(void)
+{
+	const CAnimationSet* cAnimationSet = CAnimationSetManager::GetInstance()->Get("Player2D");
+	if (cAnimationSet)
+		return cAnimationSet;
+
+	// The clips are added in the order of ANIMATION, so their IDs match it
+	CAnimationSet* cNewAnimationSet = new CAnimationSet(8, 4);
+	cNewAnimationSet->AddAnimation("rightS", 0, 3);
+	cNewAnimationSet->AddAnimation("leftS", 4, 7);
+	cNewAnimationSet->AddAnimation("HrightS", 8, 11);
+	cNewAnimationSet->AddAnimation("HleftS", 12, 15);
+
+	cNewAnimationSet->AddAnimation("rightW", 16, 19);
+	cNewAnimationSet->AddAnimation("leftW", 20, 23);
+	cNewAnimationSet->AddAnimation("HrightW", 24, 27);
+	cNewAnimationSet->AddAnimation("HleftW", 28, 31);
+
+	// Each clip in ANIMATION must have been added, or the IDs would not match the clips
+	assert(NUM_ANIMATIONS == cNewAnimationSet->GetNumAnimations());
+
+	return CAnimationSetManager::GetInstance()->Add("Player2D", cNewAnimationSet);
+}
+
 /**
  @brief Reset this instance
  */
@@ -193,6 +243,10 @@ bool CPlayer2D::Reset()
 	vec2Index = glm::i32vec2(uiCol, uiRow);
 	// By default, microsteps should be zero
 	vec2NumMicroSteps = glm::i32vec2(0, 0);
+	// Draw the player at the start position from the first frame, instead of moving it there
+	vec2UVCoordinate.x = cSettings->ConvertIndexToUVSpace(cSettings->x, vec2Index.x, false, vec2NumMicroSteps.x * cSettings->MICRO_STEP_XAXIS);
+	vec2UVCoordinate.y = cSettings->ConvertIndexToUVSpace(cSettings->y, vec2Index.y, false, vec2NumMicroSteps.y * cSettings->MICRO_STEP_YAXIS);
+	vec2PrevUVCoordinate = vec2UVCoordinate;
 
 	//Set it to fall upon entering new level
 	//cPhysics2D.SetStatus(CPhysics2D::STATUS::FALL);
@@ -201,7 +255,7 @@ bool CPlayer2D::Reset()
 	iJumpCount = 0;
 
 	//CS: Play the "idle" animation as default
-	animatedPlayer->PlayAnimation("right", -1, 1.0f);
+	animatedPlayer->PlayAnimation(ANIM_RIGHT_W, -1, 1.0f);
 
 	//CS: Init the color to white
 	runtimeColour = glm::vec4(1.0, 1.0, 1.0, 1.0);
@@ -214,13 +268,21 @@ bool CPlayer2D::Reset()
  */
 void CPlayer2D::Update(const double dElapsedTime)
 {
+	PROFILE_FUNCTION();
+
 	static double time = 0.0;
 	time += dElapsedTime;
 
+	// Store the UV coordinates of the last tick, to draw the player between them and the new ones
+	vec2PrevUVCoordinate = vec2UVCoordinate;
+
 	if (cInventoryManager->GetItem("Lives")->GetCount() <= 0)
 	{
 		vec2Index = cMap2D->GetPlayerSpawnIndex();
 		vec2NumMicroSteps.x = vec2NumMicroSteps.y = 0.f;
+		// Draw the player at the spawn position at once, instead of moving it there
+		vec2PrevUVCoordinate.x = cSettings->ConvertIndexToUVSpace(cSettings->x, vec2Index.x, false, vec2NumMicroSteps.x * cSettings->MICRO_STEP_XAXIS);
+		vec2PrevUVCoordinate.y = cSettings->ConvertIndexToUVSpace(cSettings->y, vec2Index.y, false, vec2NumMicroSteps.y * cSettings->MICRO_STEP_YAXIS);
 		cInventoryManager->GetItem("Lives")->Add(100);
 		cInventoryManager->GetItem("Plank")->Remove(cInventoryManager->GetItem("Plank")->GetCount());
 		cInventoryManager->GetItem("Stone")->Remove(cInventoryManager->GetItem("Stone")->GetCount());
@@ -484,22 +546,22 @@ void CPlayer2D::Update(const double dElapsedTime)
 	{
 		if (WeaponEquiped)
 		{
-			animatedPlayer->PlayAnimation("leftS", -1, 1.0f);
+			animatedPlayer->PlayAnimation(ANIM_LEFT_S, -1, 1.0f);
 		}
 		else
 		{
-			animatedPlayer->PlayAnimation("leftW", -1, 1.0f);
+			animatedPlayer->PlayAnimation(ANIM_LEFT_W, -1, 1.0f);
 		}
 	}
 	if (FaceDirection == RIGHT)
 	{
 		if (WeaponEquiped)
 		{
-			animatedPlayer->PlayAnimation("rightS", -1, 1.0f);
+			animatedPlayer->PlayAnimation(ANIM_RIGHT_S, -1, 1.0f);
 		}
 		else
 		{
-			animatedPlayer->PlayAnimation("rightW", -1, 1.0f);
+			animatedPlayer->PlayAnimation(ANIM_RIGHT_W, -1, 1.0f);
 		}
 	}
 
@@ -537,8 +599,8 @@ void CPlayer2D::Update(const double dElapsedTime)
 void CPlayer2D::PreRender(void)
 {
 	// Activate blending mode
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	CRenderState::GetInstance()->SetBlend(true);
+	CRenderState::GetInstance()->BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 	// Activate the shader
 	CShaderManager::GetInstance()->Use(sShaderName);
@@ -548,36 +610,28 @@ void CPlayer2D::PreRender(void)
 }
 
 /**
- @brief Render this instance
+ @brief Render this instance by submitting it to the CRenderQueue
  */
 void CPlayer2D::Render(const glm::mat4& view, const glm::mat4& projection)
 {
-	glBindVertexArray(VAO);
-	// get matrix's uniform location and set matrix
-	unsigned int transformLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "transform");
-	unsigned int colorLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "runtimeColour");
-	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
+	// The frame is between the last two ticks, so draw the player between its positions of those ticks
+	glm::vec2 vec2RenderUVCoordinate = glm::mix(vec2PrevUVCoordinate, vec2UVCoordinate, CFixedTimeStep::GetInstance()->GetInterpolation());
 
 	transform = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
-	transform = glm::translate(transform, glm::vec3(vec2UVCoordinate.x,
-													vec2UVCoordinate.y,
+	transform = glm::translate(transform, glm::vec3(vec2RenderUVCoordinate.x,
+													vec2RenderUVCoordinate.y,
 													0.0f));
-	// Update the shaders with the latest transform
-	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(projection * view * transform));
-	glUniform4fv(colorLoc, 1, glm::value_ptr(runtimeColour));
-
-	// bind textures on corresponding texture units
-	glActiveTexture(GL_TEXTURE0);
-	// Get the texture to be rendered
-	glBindTexture(GL_TEXTURE_2D, iTextureID);
-
-		//CS: Render the animated sprite
-		glBindVertexArray(VAO);
-		animatedPlayer->Render();
-		for (unsigned i = 0; i < cBulletGenerator->GetBulletsVector().size(); ++i)
-			cBulletGenerator->GetBulletsVector()[i]->Render(view, projection);
-		glBindVertexArray(0);
-	glBindTexture(GL_TEXTURE_2D, 0);
+
+	transform = glm::scale(transform, glm::vec3(cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT, 1.0f));
+
+	// Submit the current frame of the animated sprite to the render queue, which is flushed by CScene2D
+	CRenderQueue::GetInstance()->Submit(CRenderQueue::LAYER_PLAYER, cShader, iTextureID,
+										quadMesh, transform, runtimeColour,
+										animatedPlayer->GetCurrentFrame(), animatedPlayer->GetSpriteGrid());
+
+	// The bullets are submitted to their own layer
+	for (unsigned i = 0; i < cBulletGenerator->GetBulletsVector().size(); ++i)
+		cBulletGenerator->GetBulletsVector()[i]->Render(view, projection);
 }
 
 /**
@@ -586,7 +640,7 @@ void CPlayer2D::Render(const glm::mat4& view, const glm::mat4& projection)
 void CPlayer2D::PostRender(void)
 {
 	// Disable blending
-	glDisable(GL_BLEND);
+	CRenderState::GetInstance()->SetBlend(false);
 	for (unsigned i = 0; i < cBulletGenerator->GetBulletsVector().size(); ++i)
 		cBulletGenerator->GetBulletsVector()[i]->PostRender();
 }
@@ -907,10 +961,12 @@ void CPlayer2D::InteractWithMap(void)
 
 void CPlayer2D::RandomTileGenerator(void)
 {
+	// The ores are placed from the stream of the player, which is seeded from the seed of the run
+	CRandom* cRandom = CRandomService::GetInstance()->GetStream("Player2D");
 	while (n_wood > 0)
 	{
-		X = 15 + (rand() % 35);
-		Y = 15 + (rand() % 35);
+		X = 15 + cRandom->Int(35);
+		Y = 15 + cRandom->Int(35);
 		if (cMap2D->GetMapInfo(X, Y) == 0)
 		{
 			cMap2D->SetMapInfo(X, Y, 135);
@@ -919,8 +975,8 @@ void CPlayer2D::RandomTileGenerator(void)
 	}
 	while (n_stone > 0)
 	{
-		X = 15 + (rand() % 35);
-		Y = 15 + (rand() % 35);
+		X = 15 + cRandom->Int(35);
+		Y = 15 + cRandom->Int(35);
 		if (cMap2D->GetMapInfo(X, Y) == 0)
 		{
 			cMap2D->SetMapInfo(X, Y, 140);
@@ -929,8 +985,8 @@ void CPlayer2D::RandomTileGenerator(void)
 	}
 	while (n_iron > 0)
 	{
-		X = 5 + (rand() % 55);
-		Y = 5 + (rand() % 55);
+		X = 5 + cRandom->Int(55);
+		Y = 5 + cRandom->Int(55);
 		if (cMap2D->GetMapInfo(X, Y) == 0)
 		{
 			cMap2D->SetMapInfo(X, Y, 141);
@@ -939,8 +995,8 @@ void CPlayer2D::RandomTileGenerator(void)
 	}
 	while (n_silver > 0)
 	{
-		X = 5 + (rand() % 55);
-		Y = 5 + (rand() % 55);
+		X = 5 + cRandom->Int(55);
+		Y = 5 + cRandom->Int(55);
 		if (cMap2D->GetMapInfo(X, Y) == 0)
 		{
 			cMap2D->SetMapInfo(X, Y, 142);
@@ -949,8 +1005,8 @@ void CPlayer2D::RandomTileGenerator(void)
 	}
 	while (n_bronze > 0)
 	{
-		X = 5 + (rand() % 55);
-		Y = 5 + (rand() % 55);
+		X = 5 + cRandom->Int(55);
+		Y = 5 + cRandom->Int(55);
 		if (cMap2D->GetMapInfo(X, Y) == 0)
 		{
 			cMap2D->SetMapInfo(X, Y, 143);
@@ -959,8 +1015,8 @@ void CPlayer2D::RandomTileGenerator(void)
 	}
 	while (n_gold > 0)
 	{
-		X = 5 + (rand() % 55);
-		Y = 5+ (rand() % 55);
+		X = 5 + cRandom->Int(55);
+		Y = 5+ cRandom->Int(55);
 		if (cMap2D->GetMapInfo(X, Y) == 0)
 		{
 			cMap2D->SetMapInfo(X, Y, 144);
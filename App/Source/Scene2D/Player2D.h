@@ -104,11 +104,31 @@ protected:
 		NUM_DIRECTIONS
 	};
 
+	// The IDs of the animation clips, in the order which they are added to the animation set
+	enum ANIMATION
+	{
+		ANIM_RIGHT_S = 0,
+		ANIM_LEFT_S,
+		ANIM_HRIGHT_S,
+		ANIM_HLEFT_S,
+		ANIM_RIGHT_W,
+		ANIM_LEFT_W,
+		ANIM_HRIGHT_W,
+		ANIM_HLEFT_W,
+		NUM_ANIMATIONS
+	};
+
+	// Get the animation clips of the player
+	static const CAnimationSet* GetAnimationSet(void);
+
 	DIRECTION dir;
 
 	glm::vec2 vec2OldIndex;
 	glm::vec2 vec2OldMicroSteps;
 
+	// The UV coordinates of the last tick. The player is drawn between them and vec2UVCoordinate
+	glm::vec2 vec2PrevUVCoordinate;
+
 	CBulletGenerator* cBulletGenerator;
 
 	CScene2D* cScene2D;
@@ -124,6 +144,9 @@ protected:
 	// Physics
 	CPhysics2D cPhysics2D;
 
+	//CS: The shared quadMesh for drawing the player
+	CMesh* quadMesh;
+
 	//CS: Animated Sprite
 	CSpriteAnimation* animatedPlayer;
 
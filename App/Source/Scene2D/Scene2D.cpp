@@ -6,13 +6,46 @@
  */
 #include "Scene2D.h"
 #include <iostream>
+#include <algorithm>
 using namespace std;
 
 // Include Shader Manager
 #include "RenderControl\ShaderManager.h"
+// Include Render Queue
+#include "RenderControl\RenderQueue.h"
+// Include Render State
+#include "RenderControl\RenderState.h"
+// Include CProfiler for the profiler zones
+#include "TimeControl\Profiler.h"
+// Include CMetricsRegistry for the counts of the entities
+#include "System\MetricsRegistry.h"
+// Include CJobSystem to update the enemies and the turrets in parallel
+#include "System\JobSystem.h"
+// Include CFixedTimeStep to change the time scale of the simulation
+#include "TimeControl\FixedTimeStep.h"
+// Include CInputRecorder to check if the inputs are recorded or replayed
+#include "Inputs\InputRecorder.h"
 
 #include "System\filesystem.h"
 
+// The number of enemies in a job of the enemy update. Each enemy finds a path, so a job of a few is long enough
+static const unsigned int ENEMY_THINK_GRAIN_SIZE = 2;
+// The number of turrets in a job of the turret update
+static const unsigned int TURRET_THINK_GRAIN_SIZE = 8;
+// The most enemies and bosses which are spawned in a tick. The rest of a burst are spawned in the next ticks
+static const unsigned int MAX_ENEMY_SPAWNS_PER_TICK = 2;
+static const unsigned int MAX_BOSS_SPAWNS_PER_TICK = 1;
+// The time scales which F9 goes through. 0 is as fast as possible
+static const double arrTimeScales[] = { 1.0, 2.0, 4.0, 16.0, 0.0 };
+
+/**
+ @brief Order the fire requests by the index of their turret
+ */
+static bool CompareFireRequestTurret(const STurretFireRequest& sRequestA, const STurretFireRequest& sRequestB)
+{
+	return sRequestA.uiTurretIndex < sRequestB.uiTurretIndex;
+}
+
 
 /**
  @brief Constructor This constructor has protected access modifier as this class will be a Singleton
@@ -25,6 +58,19 @@ CScene2D::CScene2D(void)
 	, cGUI_Scene2D(NULL)
 	, cGameManager(NULL)
 	, cSoundController(NULL)
+	, dWorldRenderTime(0.0)
+	, uiNumWorldRenderFrames(0)
+	, uiZonePlayerUpdate(0)
+	, uiZoneEnemyUpdate(0)
+	, uiZoneTurretUpdate(0)
+	, uiZoneMapRender(0)
+	, uiZoneEntityRender(0)
+	, uiZoneGUIUpdate(0)
+	, uiZoneGUIRender(0)
+	, uiMetricEnemies(0)
+	, uiMetricTurrets(0)
+	, uiMetricBullets(0)
+	, uiMetricEnemiesSpawned(0)
 {
 }
 
@@ -64,6 +110,7 @@ CScene2D::~CScene2D(void)
 		enemyVector[i] = NULL;
 	}
 	enemyVector.clear();
+	turretEnemies.clear();
 
 	// Destroy the enemies
 	for (int i = 0; i < miscVector.size(); i++)
@@ -103,13 +150,23 @@ bool CScene2D::Init(void)
 
 	elapsed = 0;
 	timeElapsed = 0.025;
-	spawnRate = 8;
-
-	waveLevel = 1;
-	previousWave = 0;
-	spawnBoss = false;
 
-	spawnDeterminer = 2;
+	// Add the zones of the frame timer. The render zones are timed on the GPU too
+	CFrameTimer* cFrameTimer = CFrameTimer::GetInstance();
+	uiZonePlayerUpdate = cFrameTimer->AddZone("Player Update", false);
+	uiZoneEnemyUpdate = cFrameTimer->AddZone("Enemy Update", false);
+	uiZoneTurretUpdate = cFrameTimer->AddZone("Turret Update", false);
+	uiZoneMapRender = cFrameTimer->AddZone("Map Render", true);
+	uiZoneEntityRender = cFrameTimer->AddZone("Entity Render", true);
+	uiZoneGUIUpdate = cFrameTimer->AddZone("GUI Update", false);
+	uiZoneGUIRender = cFrameTimer->AddZone("GUI Render", true);
+
+	// Add the metrics of the entities
+	CMetricsRegistry* cMetricsRegistry = CMetricsRegistry::GetInstance();
+	uiMetricEnemies = cMetricsRegistry->AddGauge("Enemies Alive");
+	uiMetricTurrets = cMetricsRegistry->AddGauge("Turrets");
+	uiMetricBullets = cMetricsRegistry->AddGauge("Bullets Alive");
+	uiMetricEnemiesSpawned = cMetricsRegistry->AddCounter("Enemies Spawned");
 
 	// Create and initialise the Map 2D
 	cMap2D = CMap2D::GetInstance();
@@ -139,6 +196,12 @@ bool CScene2D::Init(void)
 		// The loading of a map has failed. Return false
 		return false;
 	}
+	// Load the waves of the map, which start from the first wave
+	if (cWaveScheduler.LoadWaves("Data/DM2213_Waves_Level_03.csv", timeElapsed) == false)
+	{
+		// The loading of the waves has failed. Return false
+		return false;
+	}
 
 	// Activate diagonal movement
 	cMap2D->SetDiagonalMovement(true);
@@ -160,6 +223,7 @@ bool CScene2D::Init(void)
 
 	// Create and initialise the CEnemy2D
 	enemyVector.clear();
+	turretEnemies.clear();
 
 	/*CTeamMate2D* cTeamMate2D = new CTeamMate2D();
 	if (cTeamMate2D->Init() == false)
@@ -193,9 +257,12 @@ bool CScene2D::Init(void)
 	// Store the keyboard controller singleton instance here
 	cMouseController = CMouseController::GetInstance();
 
-	// Store the cGUI_Scene2D singleton instance here
-	cGUI_Scene2D = CGUI_Scene2D::GetInstance();
-	cGUI_Scene2D->Init();
+	// Store the cGUI_Scene2D singleton instance here. There is no GUI without a window
+	if (CSettings::GetInstance()->bHeadless == false)
+	{
+		cGUI_Scene2D = CGUI_Scene2D::GetInstance();
+		cGUI_Scene2D->Init();
+	}
 
 	// Game Manager
 	cGameManager = CGameManager::GetInstance();
@@ -227,95 +294,64 @@ bool CScene2D::Init(void)
 }
 
 /**
-@brief Update Update this instance
+@brief Update the input and the GUI of this instance, once a frame
 */
 bool CScene2D::Update(const double dElapsedTime)
 {
-	// Call the cPlayer2D's update method before Map2D as we want to capture the inputs before map2D update
-	cPlayer2D->Update(dElapsedTime);
-	cSoundController->PlaySoundByID(1);
+	PROFILE_FUNCTION();
 
-	elapsed += timeElapsed;
-	//cout << intElapsed << endl;
-	if (remainder(elapsed, spawnRate) >= 0 && remainder(elapsed, spawnRate) <= 0.025)
+	// Toggle drawing the map from its cache, and print the average render time of the previous mode
+	if (cKeyboardController->IsKeyPressed(GLFW_KEY_F7))
 	{
-		CEnemy2D* cEnemy2D = new CEnemy2D();
-		// Pass shader to cEnemy2D
-		cEnemy2D->SetShader("Shader2D_Colour");
-		// Initialise the instance
-		if (cEnemy2D->Init() == true)
+		if (uiNumWorldRenderFrames > 0)
 		{
-			cEnemy2D->SetPlayer2D(cPlayer2D);
-			enemyVector.push_back(cEnemy2D);
+			cout << "CScene2D: Map drawn " << (cMap2D->IsRenderCacheEnabled() ? "from its cache" : "tile by tile")
+				<< ", average world render time " << (dWorldRenderTime / uiNumWorldRenderFrames) * 1000.0
+				<< " ms over " << uiNumWorldRenderFrames << " frames" << endl;
 		}
+		cMap2D->SetRenderCache(!cMap2D->IsRenderCacheEnabled());
+		dWorldRenderTime = 0.0;
+		uiNumWorldRenderFrames = 0;
 	}
-	if (spawnBoss == true)
+	// Show or hide the frame timing overlay
+	if (cKeyboardController->IsKeyPressed(GLFW_KEY_F3))
+		CFrameTimer::GetInstance()->SetOverlayVisible(!CFrameTimer::GetInstance()->IsOverlayVisible());
+	// Start recording the profiler zones, or stop and write them to a Chrome trace
+	if (cKeyboardController->IsKeyPressed(GLFW_KEY_F4))
 	{
-		CEnemy2D* cEnemy2D = new CEnemy2D();
-		// Pass shader to cEnemy2D
-		cEnemy2D->SetShader("Shader2D_Colour");
-		// Initialise the instance
-		if (cEnemy2D->slimeBossInit() == true)
+		if (CProfiler::IsRecording())
 		{
-			cEnemy2D->SetPlayer2D(cPlayer2D);
-			enemyVector.push_back(cEnemy2D);
+			CProfiler::GetInstance()->Stop();
+			CProfiler::GetInstance()->WriteChromeTrace(CSettings::GetInstance()->sProfileTraceFile);
 		}
-		spawnBoss = false;
+		else
+			CProfiler::GetInstance()->Start();
 	}
-	//cout << remainder(elapsed, 60) << endl;
-	if (remainder(elapsed, 30) >= 0 && remainder(elapsed, 30) <= 0.025 && elapsed >= 6 && waveLevel <= 9)
+	// Show or hide the metrics panel
+	if (cKeyboardController->IsKeyPressed(GLFW_KEY_F5))
+		CMetricsRegistry::GetInstance()->SetPanelVisible(!CMetricsRegistry::GetInstance()->IsPanelVisible());
+	// Go to the next time scale of the simulation, which runs more ticks in a frame
+	if (cKeyboardController->IsKeyPressed(GLFW_KEY_F9))
 	{
-		previousWave = waveLevel;
-		waveLevel += 1;
-
-		if (spawnRate > 4)
+		CFixedTimeStep* cFixedTimeStep = CFixedTimeStep::GetInstance();
+		const unsigned int uiNumTimeScales = sizeof(arrTimeScales) / sizeof(arrTimeScales[0]);
+		unsigned int uiTimeScale = 0;
+		while ((uiTimeScale < uiNumTimeScales) && (arrTimeScales[uiTimeScale] != cFixedTimeStep->GetTimeScale()))
+			uiTimeScale++;
+		uiTimeScale = (uiTimeScale + 1) % uiNumTimeScales;
+		// The ticks of a frame at the max time scale depend on the speed of the computer,
+		// so it is skipped while the inputs are recorded or replayed
+		if ((arrTimeScales[uiTimeScale] <= 0.0) && (CInputRecorder::GetInstance()->GetMode() != CInputRecorder::MODE_NONE))
 		{
-			spawnRate = spawnRate - 4;
+			cout << "CScene2D: The time scale max is skipped while the inputs are recorded or replayed" << endl;
+			uiTimeScale = 0;
 		}
-		else if (spawnRate > 2)
-		{
-			spawnRate = spawnRate - 2;
-		}
-		else if (spawnRate > 1)
-		{
-			spawnRate = spawnRate - 1;
-		}
-		if (waveLevel % 2 != 0 && waveLevel != 1)
-		{
-			spawnBoss = true;
-		}
-		if (waveLevel == 5)
-		{
-			spawnDeterminer = 3;
-		}
-		else if (waveLevel == 6)
-		{
-			spawnDeterminer = 4;
-		}
-	}
-	else if (remainder(elapsed, 60) >= 0 && remainder(elapsed, 60) <= 0.025 && waveLevel == 10)
-	{
-
-	}
-
-	for (int i = 0; i < enemyVector.size(); i++)
-	{
-		enemyVector[i]->Update(dElapsedTime);
-	}
-	
-	for (int i = 0; i < miscVector.size(); i++)
-	{
-		miscVector[i]->Update(dElapsedTime);
-	}
-
-	for (int i = 0; i < turretVector.size(); i++)
-	{
-		turretVector[i]->SetEnemyVector(enemyVector);
-		turretVector[i]->Update(dElapsedTime);
+		cFixedTimeStep->SetTimeScale(arrTimeScales[uiTimeScale]);
+		if (arrTimeScales[uiTimeScale] > 0.0)
+			cout << "CScene2D: Time scale " << arrTimeScales[uiTimeScale] << "x" << endl;
+		else
+			cout << "CScene2D: Time scale max" << endl;
 	}
-	
-	// Call the Map2D's update method
-	cMap2D->Update(dElapsedTime);
 
 	// Get keyboard updates
 	if (cKeyboardController->IsKeyReleased(GLFW_KEY_F6))
@@ -336,7 +372,10 @@ bool CScene2D::Update(const double dElapsedTime)
 	}
 
 	// Call the cGUI_Scene2D's update method
+	CFrameTimer* cFrameTimer = CFrameTimer::GetInstance();
+	cFrameTimer->BeginZone(uiZoneGUIUpdate);
 	cGUI_Scene2D->Update(dElapsedTime);
+	cFrameTimer->EndZone(uiZoneGUIUpdate);
 
 	// Check if the game should go to the next level
 	if (cGameManager->bLevelCompleted == true)
@@ -351,6 +390,7 @@ bool CScene2D::Update(const double dElapsedTime)
 
 		// Create and initialise the CEnemy2D
 		enemyVector.clear();
+		turretEnemies.clear();
 		//while (true)
 		//{
 		//	CEnemy2D* cEnemy2D = new CEnemy2D();
@@ -739,20 +779,158 @@ bool CScene2D::Update(const double dElapsedTime)
 	return true;
 }
 
+/**
+@brief Update the entities by a tick of the fixed time step
+*/
+void CScene2D::FixedUpdate(const double dElapsedTime)
+{
+	PROFILE_FUNCTION();
+
+	CFrameTimer* cFrameTimer = CFrameTimer::GetInstance();
+
+	// Call the cPlayer2D's update method before Map2D as we want to capture the inputs before map2D update
+	cFrameTimer->BeginZone(uiZonePlayerUpdate);
+	cPlayer2D->Update(dElapsedTime);
+	cFrameTimer->EndZone(uiZonePlayerUpdate);
+	cSoundController->PlaySoundByID(1);
+
+	// The game time advances by a fixed amount every tick
+	elapsed += timeElapsed;
+
+	// Run the wave events of this tick. The enemies and the bosses which are due are spawned
+	// a few in each tick, so that a burst of spawns is spread over the next ticks
+	cWaveScheduler.Update();
+	unsigned int uiNumSpawns = cWaveScheduler.TakeSpawns(CWaveScheduler::EVENT_SPAWN, MAX_ENEMY_SPAWNS_PER_TICK);
+	for (unsigned int i = 0; i < uiNumSpawns; i++)
+	{
+		PROFILE_SCOPE("CScene2D::SpawnEnemy");
+		CEnemy2D* cEnemy2D = new CEnemy2D();
+		// Pass shader to cEnemy2D
+		cEnemy2D->SetShader("Shader2D_Colour");
+		// Initialise the instance
+		if (cEnemy2D->Init() == true)
+		{
+			cEnemy2D->SetPlayer2D(cPlayer2D);
+			enemyVector.push_back(cEnemy2D);
+			CMetricsRegistry::GetInstance()->Add(uiMetricEnemiesSpawned);
+		}
+	}
+	unsigned int uiNumBosses = cWaveScheduler.TakeSpawns(CWaveScheduler::EVENT_BOSS, MAX_BOSS_SPAWNS_PER_TICK);
+	for (unsigned int i = 0; i < uiNumBosses; i++)
+	{
+		PROFILE_SCOPE("CScene2D::SpawnBoss");
+		CEnemy2D* cEnemy2D = new CEnemy2D();
+		// Pass shader to cEnemy2D
+		cEnemy2D->SetShader("Shader2D_Colour");
+		// Initialise the instance
+		if (cEnemy2D->slimeBossInit() == true)
+		{
+			cEnemy2D->SetPlayer2D(cPlayer2D);
+			enemyVector.push_back(cEnemy2D);
+			CMetricsRegistry::GetInstance()->Add(uiMetricEnemiesSpawned);
+		}
+	}
+
+	// The enemies think in parallel, and then apply their actions one at a time in their order,
+	// so that the result is the same for any number of threads. The actions can add and remove
+	// enemies, so the enemies of this tick are copied first
+	cFrameTimer->BeginZone(uiZoneEnemyUpdate);
+	std::vector<CEntity2D*> tickEnemies(enemyVector);
+	CJobSystem::GetInstance()->ParallelFor(tickEnemies.size(), ENEMY_THINK_GRAIN_SIZE,
+		[&tickEnemies, dElapsedTime](const unsigned int uiBegin, const unsigned int uiEnd)
+		{
+			for (unsigned int i = uiBegin; i < uiEnd; i++)
+				static_cast<CEnemy2D*>(tickEnemies[i])->Think(dElapsedTime);
+		});
+	for (unsigned int i = 0; i < tickEnemies.size(); i++)
+	{
+		static_cast<CEnemy2D*>(tickEnemies[i])->Apply();
+	}
+	cFrameTimer->EndZone(uiZoneEnemyUpdate);
+	
+	for (int i = 0; i < miscVector.size(); i++)
+	{
+		miscVector[i]->Update(dElapsedTime);
+	}
+
+	// The destroyed turrets are removed first, as it changes the map and the turrets. Then the turrets
+	// aim at the enemies and decide what to fire in parallel, and update their bullets too. The enemies
+	// are copied once for all the turrets, and the copy does not change until the turrets are done.
+	// Each thread gathers its fire requests in its own buffer, so no lock is needed. The requests are
+	// tagged with the index of their turret, and the buffers are merged on this thread in the order of
+	// the turrets after all the turrets are done, so that they are done in the same order for any number of threads
+	cFrameTimer->BeginZone(uiZoneTurretUpdate);
+	std::vector<CTurret*> tickTurrets(turretVector);
+	for (unsigned int i = 0; i < tickTurrets.size(); i++)
+	{
+		tickTurrets[i]->RemoveIfDestroyed();
+	}
+	tickTurrets = turretVector;
+	turretEnemies = enemyVector;
+	CJobSystem* cJobSystem = CJobSystem::GetInstance();
+	turretFireRequests.resize(cJobSystem->GetNumThreads());
+	cJobSystem->ParallelFor(tickTurrets.size(), TURRET_THINK_GRAIN_SIZE,
+		[this, &tickTurrets, dElapsedTime](const unsigned int uiBegin, const unsigned int uiEnd)
+		{
+			std::vector<CTurret::SFireRequest>& fireRequests = turretFireRequests[CJobSystem::GetThreadIndex()];
+			for (unsigned int i = uiBegin; i < uiEnd; i++)
+			{
+				unsigned int uiFirstRequest = fireRequests.size();
+				tickTurrets[i]->SetEnemyVector(turretEnemies);
+				tickTurrets[i]->Think(dElapsedTime, fireRequests);
+				for (unsigned int j = uiFirstRequest; j < fireRequests.size(); j++)
+					fireRequests[j].uiTurretIndex = i;
+			}
+		});
+	// A turret's requests are all in one buffer in their order, so a stable sort keeps their order
+	for (unsigned int i = 0; i < turretFireRequests.size(); i++)
+	{
+		orderedFireRequests.insert(orderedFireRequests.end(), turretFireRequests[i].begin(), turretFireRequests[i].end());
+		turretFireRequests[i].clear();
+	}
+	std::stable_sort(orderedFireRequests.begin(), orderedFireRequests.end(), CompareFireRequestTurret);
+	for (unsigned int i = 0; i < orderedFireRequests.size(); i++)
+	{
+		orderedFireRequests[i].pTurret->Fire(orderedFireRequests[i]);
+	}
+	orderedFireRequests.clear();
+	cFrameTimer->EndZone(uiZoneTurretUpdate);
+
+	// Count the live entities after they were updated
+	unsigned int uiNumBullets = 0;
+	for (int i = 0; i < turretVector.size(); i++)
+	{
+		std::vector<CBullet*>& bullets = turretVector[i]->GetBulletGenerator()->GetBulletsVector();
+		for (unsigned int j = 0; j < bullets.size(); j++)
+		{
+			if (bullets[j]->GetIsActive())
+				uiNumBullets++;
+		}
+	}
+	std::vector<CBullet*>& playerBullets = cPlayer2D->GetBulletGenerator()->GetBulletsVector();
+	for (unsigned int j = 0; j < playerBullets.size(); j++)
+	{
+		if (playerBullets[j]->GetIsActive())
+			uiNumBullets++;
+	}
+	CMetricsRegistry* cMetricsRegistry = CMetricsRegistry::GetInstance();
+	cMetricsRegistry->Set(uiMetricEnemies, enemyVector.size());
+	cMetricsRegistry->Set(uiMetricTurrets, turretVector.size());
+	cMetricsRegistry->Set(uiMetricBullets, uiNumBullets);
+	
+	// Call the Map2D's update method
+	cMap2D->Update(dElapsedTime);
+}
+
 /**
  @brief PreRender Set up the OpenGL display environment before rendering
  */
 void CScene2D::PreRender(void)
 {
-	// Reset the OpenGL rendering environment
-	glLoadIdentity();
-
-	// Clear the screen and buffer
-	glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
-	glClear(GL_COLOR_BUFFER_BIT);
-
-	// Enable 2D texture rendering
-	glEnable(GL_TEXTURE_2D);
+	// Clear the screen and buffer. The fixed function state, such as GL_TEXTURE_2D,
+	// is not used by the shaders, so it is not set up here
+	CRenderState::GetInstance()->ClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+	CRenderState::GetInstance()->Clear(GL_COLOR_BUFFER_BIT);
 }
 
 /**
@@ -760,6 +938,8 @@ void CScene2D::PreRender(void)
  */
 void CScene2D::Render(void)
 {
+	PROFILE_FUNCTION();
+
 	glm::mat4 view(1.f), projection(1.f);
 
 	// Idea is to use player's index / number of tiles in the axis to position the camera
@@ -797,56 +977,52 @@ void CScene2D::Render(void)
 	// Same effect as zooming in the camera by 4x (glm::ortho ranges from -1.f to 1.f)
 	projection = glm::ortho(-PROJ_MIN_MAX, PROJ_MIN_MAX, -PROJ_MIN_MAX, PROJ_MIN_MAX, -10.f, 10.f);
 
-	// Call the Map2D's PreRender()
-	cMap2D->PreRender();
-	// Call the Map2D's Render()
+	// Measure the CPU time to submit and flush the world
+	double dStartTime = glfwGetTime();
+
+	// Start a new frame in the render queue. The view-projection is uploaded once per shader
+	CRenderQueue* cRenderQueue = CRenderQueue::GetInstance();
+	cRenderQueue->Begin(projection * view);
+
+	// Submit the Map2D's tiles, and flush them on their own so that the map is timed apart from the entities
+	CFrameTimer* cFrameTimer = CFrameTimer::GetInstance();
+	cFrameTimer->BeginZone(uiZoneMapRender);
 	cMap2D->Render(view, projection);
-	// Call the Map2D's PostRender()
-	cMap2D->PostRender();
+	cRenderQueue->Flush();
+	cFrameTimer->EndZone(uiZoneMapRender);
 
+	cFrameTimer->BeginZone(uiZoneEntityRender);
+
+	// Submit the CEnemy2Ds
 	for (int i = 0; i < enemyVector.size(); i++)
-	{
-		// Call the CEnemy2D's PreRender()
-		enemyVector[i]->PreRender();
-		// Call the CEnemy2D's Render()
 		enemyVector[i]->Render(view, projection);
-		// Call the CEnemy2D's PostRender()
-		enemyVector[i]->PostRender();
-	}
 
+	// Submit the CMisc2Ds
 	for (int i = 0; i < miscVector.size(); i++)
-	{
-		// Call the CMisc2D's PreRender()
-		miscVector[i]->PreRender();
-		// Call the CMisc2D's Render()
 		miscVector[i]->Render(view, projection);
-		// Call the CMisc2D's PostRender()
-		miscVector[i]->PostRender();
-	}
 
+	// Submit the CTurrets and their bullets
 	for (int i = 0; i < turretVector.size(); i++)
-	{
-		// Call the CMisc2D's PreRender()
-		turretVector[i]->PreRender();
-		// Call the CMisc2D's Render()
 		turretVector[i]->Render(view, projection);
-		// Call the CMisc2D's PostRender()
-		turretVector[i]->PostRender();
-	}
 
-	// Call the CPlayer2D's PreRender()
-	cPlayer2D->PreRender();
-	// Call the CPlayer2D's Render()
+	// Submit the CPlayer2D and its bullets
 	cPlayer2D->Render(view, projection);
-	// Call the CPlayer2D's PostRender()
-	cPlayer2D->PostRender();
 
+	// Sort the draw commands by layer, shader and texture, and render them
+	cRenderQueue->Flush();
+	cFrameTimer->EndZone(uiZoneEntityRender);
+
+	dWorldRenderTime += glfwGetTime() - dStartTime;
+	uiNumWorldRenderFrames++;
+
+	cFrameTimer->BeginZone(uiZoneGUIRender);
 	// Call the cGUI_Scene2D's PreRender()
 	cGUI_Scene2D->PreRender();
 	// Call the cGUI_Scene2D's Render()
 	cGUI_Scene2D->Render();
 	// Call the cGUI_Scene2D's PostRender()
 	cGUI_Scene2D->PostRender();
+	cFrameTimer->EndZone(uiZoneGUIRender);
 }
 
 /**
@@ -865,6 +1041,34 @@ vector<CTurret*>& CScene2D::getTurretVec(void)
 {
 	return turretVector;
 }
+
+/**
+@brief Place a turret on an empty tile, without taking it from the inventory, e.g. for a scripted game
+@param iRow The row of the tile
+@param iCol The column of the tile
+@return true if the turret was placed, false if the tile is outside the map or not empty
+*/
+bool CScene2D::AddTurret(const int iRow, const int iCol)
+{
+	if ((iRow < 0) || (iRow >= (int)CSettings::GetInstance()->NUM_TILES_YAXIS)
+		|| (iCol < 0) || (iCol >= (int)CSettings::GetInstance()->NUM_TILES_XAXIS)
+		|| (cMap2D->GetMapInfo(iRow, iCol) != 0))
+		return false;
+
+	CTurret* cTurret = new CTurret();
+	// Pass shader to cTurret
+	cTurret->SetShader("Shader2D_Colour");
+	// Initialise the instance
+	if (cTurret->Init(iRow, iCol) == false)
+	{
+		delete cTurret;
+		return false;
+	}
+	cMap2D->SetMapInfo(iRow, iCol, 150);
+	cTurret->SetEnemyVector(enemyVector);
+	turretVector.push_back(cTurret);
+	return true;
+}
 vector<CEntity2D*>& CScene2D::getEnemyVec(void)
 {
 	return enemyVector;
@@ -930,12 +1134,12 @@ int CScene2D::GetTurretNo(void)
 
 int CScene2D::getWaveLevel(void)
 {
-	return waveLevel;
+	return cWaveScheduler.GetWaveLevel();
 }
 
 int CScene2D::getSpawnDeterminer(void)
 {
-	return spawnDeterminer;
+	return cWaveScheduler.GetSpawnDeterminer();
 }
 
 int CScene2D::getElapsed(void)
@@ -945,5 +1149,5 @@ int CScene2D::getElapsed(void)
 
 int CScene2D::getPrevLevel(void)
 {
-	return previousWave;
+	return cWaveScheduler.GetPreviousWave();
 }
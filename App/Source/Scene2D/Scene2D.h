@@ -38,6 +38,10 @@ class CPlayer2D;
 #include "Misc2D.h"
 // Include CTurret
 #include "Turret.h"
+// Include CWaveScheduler
+#include "WaveScheduler.h"
+// Include STurretFireRequest
+#include "TurretFireRequest.h"
 
 // Include vector
 #include <vector>
@@ -54,6 +58,9 @@ class CPlayer2D;
 // Game Manager
 #include "GameManager.h"
 
+// Include CFrameTimer to time the parts of a frame
+#include "TimeControl\FrameTimer.h"
+
 class CScene2D : public CSingletonTemplate<CScene2D>
 {
 	friend CSingletonTemplate<CScene2D>;
@@ -61,9 +68,12 @@ public:
 	// Init
 	bool Init(void);
 
-	// Update
+	// Update the input and the GUI, once a frame
 	bool Update(const double dElapsedTime);
 
+	// Update the entities by a tick of the fixed time step
+	void FixedUpdate(const double dElapsedTime);
+
 	// PreRender
 	void PreRender(void);
 
@@ -77,6 +87,9 @@ public:
 
 	vector<CTurret*>& getTurretVec(void);
 
+	// Place a turret on an empty tile, without taking it from the inventory
+	bool AddTurret(const int iRow, const int iCol);
+
 	vector<CEntity2D*>& getEnemyVec(void);
 
 	void spawnExtraEnemy(int i);
@@ -105,6 +118,12 @@ protected:
 	vector<CEntity2D*> miscVector;
 	// A vector containing the instance of CTurret2Ds
 	vector<CTurret*> turretVector;
+	// The enemies which the turrets and their bullets aim at. They are copied from enemyVector before the turrets think
+	vector<CEntity2D*> turretEnemies;
+	// The fire requests of the turrets, with a buffer for each thread of CJobSystem,
+	// and all of them in the order of the turrets, which they are done in
+	vector<vector<STurretFireRequest> > turretFireRequests;
+	vector<STurretFireRequest> orderedFireRequests;
 
 	// Keyboard Controller singleton instance
 	CKeyboardController* cKeyboardController;
@@ -129,21 +148,37 @@ protected:
 	int Closest;
 	bool PlayerWon;
 
-	int spawnDeterminer;
-
 	double elapsed;
 	double timeElapsed;
-	int spawnRate;
 	int TurretNo;
 
-	int waveLevel;
-	int previousWave;
-	bool spawnBoss;
+	// The waves and the spawns of the enemies, which are run from the wave table
+	CWaveScheduler cWaveScheduler;
 
 	bool extraEnemyToSpawn;
 
 	glm::vec2 slimeBossPos;
 
+	// The total CPU time spent to submit and flush the world, and the number of frames it was measured over.
+	// It is used to compare drawing the map from its cache against drawing every tile
+	double dWorldRenderTime;
+	unsigned int uiNumWorldRenderFrames;
+
+	// The zones of the frame timer, which are shown in its overlay. Press F3 to show it
+	unsigned int uiZonePlayerUpdate;
+	unsigned int uiZoneEnemyUpdate;
+	unsigned int uiZoneTurretUpdate;
+	unsigned int uiZoneMapRender;
+	unsigned int uiZoneEntityRender;
+	unsigned int uiZoneGUIUpdate;
+	unsigned int uiZoneGUIRender;
+
+	// The metrics of the entities, which are shown in the metrics panel. Press F5 to show it
+	unsigned int uiMetricEnemies;
+	unsigned int uiMetricTurrets;
+	unsigned int uiMetricBullets;
+	unsigned int uiMetricEnemiesSpawned;
+
 	// Constructor
 	CScene2D(void);
 	// Destructor
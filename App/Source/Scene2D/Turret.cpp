@@ -11,6 +11,12 @@ using namespace std;
 
 // Include Shader Manager
 #include "RenderControl\ShaderManager.h"
+// Include Render State
+#include "RenderControl\RenderState.h"
+// Include Render Queue
+#include "RenderControl\RenderQueue.h"
+// Include Mesh Manager
+#include "Primitives\MeshManager.h"
 // Include Mesh Builder
 #include "Primitives/MeshBuilder.h"
 
@@ -22,6 +28,10 @@ using namespace std;
 
 // Include the Map2D as we will use it to check the player's movements and actions
 #include "Map2D.h"
+// Include CProfiler for the profiler zones
+#include "TimeControl\Profiler.h"
+// Include CRandomService for the random streams of the turrets
+#include "System\RandomService.h"
 // Include math.h
 #include <math.h>
 
@@ -35,6 +45,8 @@ CTurret::CTurret(void)
 	, sCurrentFSM(FSM::IDLE)
 	, iFSMCounter(0)
 	, quadMesh(NULL)
+	, pEnemyVector(NULL)
+	, pFireRequests(NULL)
 {
 	transform = glm::mat4(1.0f);	// make sure to initialize matrix to identity matrix first
 
@@ -56,20 +68,15 @@ CTurret::CTurret(void)
  */
 CTurret::~CTurret(void)
 {
-	// Delete the quadMesh
-	if (quadMesh)
-	{
-		delete quadMesh;
-		quadMesh = NULL;
-	}
+	// The quadMesh is shared, so it is deleted by CMeshManager
+	quadMesh = NULL;
 
 	// We won't delete this since it was created elsewhere
 	cMap2D = NULL;
 
 	// optional: de-allocate all resources once they've outlived their purpose:
-	glDeleteVertexArrays(1, &VAO);
-	glDeleteBuffers(1, &VBO);
-	glDeleteBuffers(1, &EBO);
+	CRenderState::GetInstance()->DeleteBuffer(VBO);
+	CRenderState::GetInstance()->DeleteBuffer(EBO);
 }
 
 /**
@@ -96,11 +103,8 @@ bool CTurret::Init(int uiRow, int uiCol)
 	// By default, microsteps should be zero
 	i32vec2NumMicroSteps = glm::i32vec2(0, 0);
 
-	glGenVertexArrays(1, &VAO);
-	glBindVertexArray(VAO);
-
-	//CS: Create the Quad Mesh using the mesh builder
-	quadMesh = CMeshBuilder::GenerateQuad(glm::vec4(1, 1, 1, 1), cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT);
+	//CS: Use the unit quad which is shared by all the entities
+	quadMesh = CMeshManager::GetInstance()->GetUnitQuad();
 
 	//CS: Init the color to white
 	runtimeColour = glm::vec4(1.0, 1.0, 1.0, 1.0);
@@ -113,8 +117,8 @@ bool CTurret::Init(int uiRow, int uiCol)
 
 	cBulletGenerator = new CBulletGenerator();
 
-	// Rand seeding
-	srand(time(NULL));
+	// Each turret has its own random stream, so its numbers do not depend on the thread which runs Think()
+	cRandom = CRandomService::GetInstance()->CreateStream("Turret");
 
 	Time = 0.0;
 	CurrTime = 0.0;
@@ -160,11 +164,8 @@ bool CTurret::Init(int uiRow, int uiCol, int WallType)
 	// By default, microsteps should be zero
 	i32vec2NumMicroSteps = glm::i32vec2(0, 0);
 
-	glGenVertexArrays(1, &VAO);
-	glBindVertexArray(VAO);
-
-	//CS: Create the Quad Mesh using the mesh builder
-	quadMesh = CMeshBuilder::GenerateQuad(glm::vec4(1, 1, 1, 1), cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT);
+	//CS: Use the unit quad which is shared by all the entities
+	quadMesh = CMeshManager::GetInstance()->GetUnitQuad();
 
 	//CS: Init the color to white
 	runtimeColour = glm::vec4(1.0, 1.0, 1.0, 1.0);
@@ -177,8 +178,8 @@ bool CTurret::Init(int uiRow, int uiCol, int WallType)
 
 	cBulletGenerator = new CBulletGenerator();
 
-	// Rand seeding
-	srand(time(NULL));
+	// Each turret has its own random stream, so its numbers do not depend on the thread which runs Think()
+	cRandom = CRandomService::GetInstance()->CreateStream("Turret");
 
 	Time = 0.0;
 	CurrTime = 0.0;
@@ -239,13 +240,30 @@ bool CTurret::Init(int uiRow, int uiCol, int WallType)
 }
 
 /**
- @brief Update this instance
+ @brief Update this instance. It is RemoveIfDestroyed(), Think() and then Fire() for the requests
  */
 void CTurret::Update(const double dElapsedTime)
 {
-	if (!bIsActive)
+	if (RemoveIfDestroyed() == true)
 		return;
 
+	std::vector<SFireRequest> fireRequests;
+	Think(dElapsedTime, fireRequests);
+	for (unsigned int i = 0; i < fireRequests.size(); i++)
+	{
+		fireRequests[i].pTurret->Fire(fireRequests[i]);
+	}
+}
+
+/**
+ @brief Remove this instance from the map and the scene if the monsters destroyed it.
+		It changes the map and the scene's turrets, so it is called on the main thread
+ @return true if it was removed
+ */
+bool CTurret::RemoveIfDestroyed(void)
+{
+	if (!bIsActive)
+		return false;
 
 	//Monster damage handler
 	if (TurretHP <= 0)
@@ -259,8 +277,26 @@ void CTurret::Update(const double dElapsedTime)
 			}
 		}
 		bIsActive = false;
-		return;
+		return true;
 	}
+	return false;
+}
+
+/**
+ @brief Aim at the nearest enemy, decide what to fire and update the bullets. It only changes
+		this instance and its bullets, so the turrets can think in parallel. The bullets to create,
+		and the changes to the rest of the scene, are added to the fire requests, which Fire() does
+ @param dElapsedTime The time of the tick
+ @param fireRequests The fire requests of the calling thread
+ */
+void CTurret::Think(const double dElapsedTime, std::vector<SFireRequest>& fireRequests)
+{
+	PROFILE_FUNCTION();
+
+	if (!bIsActive || TurretHP <= 0)
+		return;
+
+	pFireRequests = &fireRequests;
 
 	if (turretType != WOOD_WALL && turretType != STONE_WALL && turretType != IRON_WALL)
 	{
@@ -280,7 +316,7 @@ void CTurret::Update(const double dElapsedTime)
 				case GETRANDOMTURRET:
 				case GETRANDOMTURRET2:
 				{
-					int Path = rand() % 4;
+					int Path = cRandom.Int(4);
 					if (Path == 0 || Path == 1)
 					{
 						Path = 1;
@@ -293,7 +329,7 @@ void CTurret::Update(const double dElapsedTime)
 					{
 						Path = 3;
 					}
-					int Tier = rand() % 3 + 1;
+					int Tier = cRandom.Int(3) + 1;
 					int BranchNo = 0;
 					switch (Tier)
 					{
@@ -301,21 +337,21 @@ void CTurret::Update(const double dElapsedTime)
 						BranchNo = 1;
 						if (Path == 3)
 						{
-							Path = rand() % 1 + 1;
+							Path = cRandom.Int(1) + 1;
 						}
 						break;
 					case 2:
-						BranchNo = rand() % 2 + 1;
+						BranchNo = cRandom.Int(2) + 1;
 						break;
 					case 3:
-						BranchNo = rand() % 5 + 1;
+						BranchNo = cRandom.Int(5) + 1;
 						break;
 					case 4:
-						BranchNo = rand() % 17 + 1;
+						BranchNo = cRandom.Int(17) + 1;
 						break;
 					}
 					upgradeLeft = int(Path + BranchNo * 10 + Tier * 1000);
-					UpgradeTurret(true);
+					AddFireRequest(SFireRequest::UPGRADE);
 					break;
 				}
 
@@ -325,40 +361,35 @@ void CTurret::Update(const double dElapsedTime)
 				case ETERNAL_BLIZZARD_TURRET2:
 				case ETERNAL_BLIZZARD_TURRET3:
 				{
-					int RandX = rand() % cSettings->NUM_TILES_XAXIS + 1;
-					int RandY = rand() % cSettings->NUM_TILES_YAXIS + 1;
-					if (rand() % 101 <= ElementChance)
+					int RandX = cRandom.Int(cSettings->NUM_TILES_XAXIS) + 1;
+					int RandY = cRandom.Int(cSettings->NUM_TILES_YAXIS) + 1;
+					if (cRandom.Int(101) <= ElementChance)
 					{
-						cBulletGenerator->GenerateBullet(glm::vec2(RandX, RandY + 5), 3, TurretDamage, TurretElement, Colour);
+						RequestBullet(glm::vec2(RandX, RandY + 5), 3, TurretDamage, TurretElement, Colour);
 					}
 					else
 					{
-						cBulletGenerator->GenerateBullet(glm::vec2(RandX, RandY + 5), 3, TurretDamage, NORMAL, Colour);
+						RequestBullet(glm::vec2(RandX, RandY + 5), 3, TurretDamage, NORMAL, Colour);
 					}
 					break;
 				}
 
 				// Misc
 				case ORE_GENERATOR:
-					cInventoryItem = cInventoryManager->GetItem("Iron");
-					cInventoryItem->Add(1);
-					cInventoryItem = cInventoryManager->GetItem("Silver");
-					cInventoryItem->Add(1);
-					cInventoryItem = cInventoryManager->GetItem("Bronze");
-					cInventoryItem->Add(1);
+					AddFireRequest(SFireRequest::ADD_ORES);
 					break;
 
 				case ROBOT_PLAYER:
 					// Had Code here but broke the game so yeaaa
 					//UpdatePosition();
 					upgradeLeft = RANDOM_DMG_TURRET;
-					UpgradeTurret(true);
+					AddFireRequest(SFireRequest::UPGRADE);
 					break;
 				case TANK:
 					// Had Code here but broke the game so yeaaa
 					//UpdatePosition();
 					upgradeLeft = RANDOM_DMG_TURRET;
-					UpgradeTurret(true);
+					AddFireRequest(SFireRequest::UPGRADE);
 					break;
 
 				}
@@ -386,7 +417,7 @@ void CTurret::Update(const double dElapsedTime)
 				case REINFORCED_IRON_TURRET2:
 				case SHINY_IRON_TURRET:
 				case GOLDEN_TURRET:
-					cBulletGenerator->GenerateBullet(this->vec2Index, nearestEnemy->vec2Index, TurretDamage, TurretElement, Colour);
+					RequestBullet(this->vec2Index, nearestEnemy->vec2Index, TurretDamage, TurretElement, Colour);
 					break;
 				
 				// Elemental Turret
@@ -407,54 +438,54 @@ void CTurret::Update(const double dElapsedTime)
 				case STRONG_WIND_TURRET:
 				case BLOWBACK_TURRET:
 				case WINDY_TURRET:
-					if (rand() % 101 <= ElementChance)
+					if (cRandom.Int(101) <= ElementChance)
 					{
-						cBulletGenerator->GenerateBullet(this->vec2Index, nearestEnemy->vec2Index, TurretDamage, TurretElement, Colour);
+						RequestBullet(this->vec2Index, nearestEnemy->vec2Index, TurretDamage, TurretElement, Colour);
 					}
 					else
 					{
-						cBulletGenerator->GenerateBullet(this->vec2Index, nearestEnemy->vec2Index, TurretDamage, NORMAL, Colour);
+						RequestBullet(this->vec2Index, nearestEnemy->vec2Index, TurretDamage, NORMAL, Colour);
 					}
 					break;
 				case BLUE_FLAME_TURRET:
 				case DUO_FLAME_SPEAR_TURRET:
-					if (rand() % 100 <= 50)
+					if (cRandom.Int(100) <= 50)
 					{
-						cBulletGenerator->GenerateBullet(this->vec2Index, nearestEnemy->vec2Index, TurretDamage, BURN, Colour);
+						RequestBullet(this->vec2Index, nearestEnemy->vec2Index, TurretDamage, BURN, Colour);
 					}
 					else
 					{
-						cBulletGenerator->GenerateBullet(this->vec2Index, nearestEnemy->vec2Index, TurretDamage, FROZEN, Colour);
+						RequestBullet(this->vec2Index, nearestEnemy->vec2Index, TurretDamage, FROZEN, Colour);
 					}
 					break;
 				case BLUE_FLAMETHROWER_TURRET:
-					if (rand() % 100 <= 50)
+					if (cRandom.Int(100) <= 50)
 					{
-						cBulletGenerator->GenerateBullet(this->vec2Index, nearestEnemy->vec2Index, TurretDamage, BURN, Colour);
+						RequestBullet(this->vec2Index, nearestEnemy->vec2Index, TurretDamage, BURN, Colour);
 					}
 					else
 					{
-						cBulletGenerator->GenerateBullet(this->vec2Index, nearestEnemy->vec2Index, TurretDamage, FROZEN, Colour);
+						RequestBullet(this->vec2Index, nearestEnemy->vec2Index, TurretDamage, FROZEN, Colour);
 					}
 					break;
 
 				// Random DMG Turret
 				case RANDOM_DMG_TURRET:
-					cBulletGenerator->GenerateBullet(this->vec2Index, nearestEnemy->vec2Index, rand() % 10 + 4, TurretElement, Colour);
+					RequestBullet(this->vec2Index, nearestEnemy->vec2Index, cRandom.Int(10) + 4, TurretElement, Colour);
 					break;
 				case RANDOM_DMG_TURRETV2:
-					cBulletGenerator->GenerateBullet(this->vec2Index, nearestEnemy->vec2Index, rand() % 12 + 6, TurretElement, Colour);
+					RequestBullet(this->vec2Index, nearestEnemy->vec2Index, cRandom.Int(12) + 6, TurretElement, Colour);
 					break;
 				case RANDOM_DMG_TURRETV3:
-					cBulletGenerator->GenerateBullet(this->vec2Index, nearestEnemy->vec2Index, rand() % 15 + 9, TurretElement, Colour);
+					RequestBullet(this->vec2Index, nearestEnemy->vec2Index, cRandom.Int(15) + 9, TurretElement, Colour);
 					break;
 
 				// TuretTuretTuret
 				case TURRET3:
-					cBulletGenerator->GenerateBullet(this->vec2Index, nearestEnemy->vec2Index, TurretDamage, TurretElement, Colour);
+					RequestBullet(this->vec2Index, nearestEnemy->vec2Index, TurretDamage, TurretElement, Colour);
 				case TURRET2:
-					cBulletGenerator->GenerateBullet(this->vec2Index, nearestEnemy->vec2Index, TurretDamage, TurretElement, Colour);
-					cBulletGenerator->GenerateBullet(this->vec2Index, nearestEnemy->vec2Index, TurretDamage, TurretElement, Colour);
+					RequestBullet(this->vec2Index, nearestEnemy->vec2Index, TurretDamage, TurretElement, Colour);
+					RequestBullet(this->vec2Index, nearestEnemy->vec2Index, TurretDamage, TurretElement, Colour);
 					break;
 
 				// Burst
@@ -470,112 +501,112 @@ void CTurret::Update(const double dElapsedTime)
 						TurretCooldown = 1.5;
 						CurrBurst = 0;
 					}
-					cBulletGenerator->GenerateBullet(this->vec2Index, nearestEnemy->vec2Index, TurretDamage, TurretElement, Colour);
+					RequestBullet(this->vec2Index, nearestEnemy->vec2Index, TurretDamage, TurretElement, Colour);
 					break;
 
 				// Rainbow
 				case ISTERIOUS_TURRET:
 				case TURRETINFINITY:
-					cBulletGenerator->GenerateBullet(this->vec2Index, nearestEnemy->vec2Index, TurretDamage, TurretElement, Colour);
-					Colour = glm::vec4(static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, 1);
+					RequestBullet(this->vec2Index, nearestEnemy->vec2Index, TurretDamage, TurretElement, Colour);
+					Colour = glm::vec4(static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, 1);
 					break;
 				case YOUSTERIOUS_TURRET:
-					cBulletGenerator->GenerateBullet(this->vec2Index, nearestEnemy->vec2Index, TurretDamage, TurretElement, Colour);
-					Colour = glm::vec4(static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, 1);
+					RequestBullet(this->vec2Index, nearestEnemy->vec2Index, TurretDamage, TurretElement, Colour);
+					Colour = glm::vec4(static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, 1);
 					break;
 				case THEYSTERIOUS_TURRET:
-					cBulletGenerator->GenerateBullet(glm::vec2(this->vec2Index.x - 1,	this->vec2Index.y + 1), glm::vec2(nearestEnemy->vec2Index.x - 1,	nearestEnemy->vec2Index.y + 1), TurretDamage, TurretElement, Colour);
-					Colour = glm::vec4(static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, 1);
-					cBulletGenerator->GenerateBullet(glm::vec2(this->vec2Index.x,		this->vec2Index.y + 1), glm::vec2(nearestEnemy->vec2Index.x,		nearestEnemy->vec2Index.y + 1), TurretDamage, TurretElement, Colour);
-					Colour = glm::vec4(static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, 1);
-					cBulletGenerator->GenerateBullet(glm::vec2(this->vec2Index.x + 1,	this->vec2Index.y + 1), glm::vec2(nearestEnemy->vec2Index.x + 1,	nearestEnemy->vec2Index.y + 1), TurretDamage, TurretElement, Colour);
-					Colour = glm::vec4(static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, 1);
-					cBulletGenerator->GenerateBullet(glm::vec2(this->vec2Index.x - 1,	this->vec2Index.y),		glm::vec2(nearestEnemy->vec2Index.x - 1,	nearestEnemy->vec2Index.y),		TurretDamage, TurretElement, Colour);
-					Colour = glm::vec4(static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, 1);
-					cBulletGenerator->GenerateBullet(glm::vec2(this->vec2Index.x,		this->vec2Index.y),		glm::vec2(nearestEnemy->vec2Index.x,		nearestEnemy->vec2Index.y),		TurretDamage, TurretElement, Colour);
-					Colour = glm::vec4(static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, 1);
-					cBulletGenerator->GenerateBullet(glm::vec2(this->vec2Index.x + 1,	this->vec2Index.y),		glm::vec2(nearestEnemy->vec2Index.x + 1,	nearestEnemy->vec2Index.y),		TurretDamage, TurretElement, Colour);
-					Colour = glm::vec4(static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, 1);
-					cBulletGenerator->GenerateBullet(glm::vec2(this->vec2Index.x - 1,	this->vec2Index.y - 1), glm::vec2(nearestEnemy->vec2Index.x - 1,	nearestEnemy->vec2Index.y - 1), TurretDamage, TurretElement, Colour);
-					Colour = glm::vec4(static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, 1);
-					cBulletGenerator->GenerateBullet(glm::vec2(this->vec2Index.x,		this->vec2Index.y - 1), glm::vec2(nearestEnemy->vec2Index.x,		nearestEnemy->vec2Index.y - 1), TurretDamage, TurretElement, Colour);
-					Colour = glm::vec4(static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, 1);
-					cBulletGenerator->GenerateBullet(glm::vec2(this->vec2Index.x + 1,	this->vec2Index.y - 1), glm::vec2(nearestEnemy->vec2Index.x + 1,	nearestEnemy->vec2Index.y - 1), TurretDamage, TurretElement, Colour);
-					Colour = glm::vec4(static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, 1);
+					RequestBullet(glm::vec2(this->vec2Index.x - 1,	this->vec2Index.y + 1), glm::vec2(nearestEnemy->vec2Index.x - 1,	nearestEnemy->vec2Index.y + 1), TurretDamage, TurretElement, Colour);
+					Colour = glm::vec4(static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, 1);
+					RequestBullet(glm::vec2(this->vec2Index.x,		this->vec2Index.y + 1), glm::vec2(nearestEnemy->vec2Index.x,		nearestEnemy->vec2Index.y + 1), TurretDamage, TurretElement, Colour);
+					Colour = glm::vec4(static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, 1);
+					RequestBullet(glm::vec2(this->vec2Index.x + 1,	this->vec2Index.y + 1), glm::vec2(nearestEnemy->vec2Index.x + 1,	nearestEnemy->vec2Index.y + 1), TurretDamage, TurretElement, Colour);
+					Colour = glm::vec4(static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, 1);
+					RequestBullet(glm::vec2(this->vec2Index.x - 1,	this->vec2Index.y),		glm::vec2(nearestEnemy->vec2Index.x - 1,	nearestEnemy->vec2Index.y),		TurretDamage, TurretElement, Colour);
+					Colour = glm::vec4(static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, 1);
+					RequestBullet(glm::vec2(this->vec2Index.x,		this->vec2Index.y),		glm::vec2(nearestEnemy->vec2Index.x,		nearestEnemy->vec2Index.y),		TurretDamage, TurretElement, Colour);
+					Colour = glm::vec4(static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, 1);
+					RequestBullet(glm::vec2(this->vec2Index.x + 1,	this->vec2Index.y),		glm::vec2(nearestEnemy->vec2Index.x + 1,	nearestEnemy->vec2Index.y),		TurretDamage, TurretElement, Colour);
+					Colour = glm::vec4(static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, 1);
+					RequestBullet(glm::vec2(this->vec2Index.x - 1,	this->vec2Index.y - 1), glm::vec2(nearestEnemy->vec2Index.x - 1,	nearestEnemy->vec2Index.y - 1), TurretDamage, TurretElement, Colour);
+					Colour = glm::vec4(static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, 1);
+					RequestBullet(glm::vec2(this->vec2Index.x,		this->vec2Index.y - 1), glm::vec2(nearestEnemy->vec2Index.x,		nearestEnemy->vec2Index.y - 1), TurretDamage, TurretElement, Colour);
+					Colour = glm::vec4(static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, 1);
+					RequestBullet(glm::vec2(this->vec2Index.x + 1,	this->vec2Index.y - 1), glm::vec2(nearestEnemy->vec2Index.x + 1,	nearestEnemy->vec2Index.y - 1), TurretDamage, TurretElement, Colour);
+					Colour = glm::vec4(static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, 1);
 					break;
 				case WESTERIOUS_TURRET:
-					cBulletGenerator->GenerateBullet(this->vec2Index, nearestEnemy->vec2Index, TurretDamage, TurretElement, Colour);
-					Colour = glm::vec4(static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, 1);
+					RequestBullet(this->vec2Index, nearestEnemy->vec2Index, TurretDamage, TurretElement, Colour);
+					Colour = glm::vec4(static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, 1);
 					break;
 
 					// Glitched
 				case GLITCHED_TURRET:
-					TurretCooldown = static_cast<float>((rand() % 250)) / 100.f;
-					Colour = glm::vec4(static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, 1);
-					cBulletGenerator->GenerateBullet(this->vec2Index, nearestEnemy->vec2Index, TurretDamage, TurretElement, Colour);
+					TurretCooldown = static_cast<float>((cRandom.Int(250))) / 100.f;
+					Colour = glm::vec4(static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, 1);
+					RequestBullet(this->vec2Index, nearestEnemy->vec2Index, TurretDamage, TurretElement, Colour);
 					break;
 				case UPGRADED_GLITCHED_TURRET:
-					TurretCooldown = static_cast<float>((rand() % 150)) / 100.f;
-					Colour = glm::vec4(static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, 1);
-					cBulletGenerator->GenerateBullet(this->vec2Index, nearestEnemy->vec2Index, TurretDamage, TurretElement, Colour);
+					TurretCooldown = static_cast<float>((cRandom.Int(150))) / 100.f;
+					Colour = glm::vec4(static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, 1);
+					RequestBullet(this->vec2Index, nearestEnemy->vec2Index, TurretDamage, TurretElement, Colour);
 					break;
 
 				// Multishot
 				case MULTISHOT_TURRET:
-					cBulletGenerator->GenerateBullet(this->vec2Index, 0, TurretDamage, TurretElement, Colour);
-					cBulletGenerator->GenerateBullet(this->vec2Index, 1, TurretDamage, TurretElement, Colour);
-					cBulletGenerator->GenerateBullet(this->vec2Index, 2, TurretDamage, TurretElement, Colour);
-					cBulletGenerator->GenerateBullet(this->vec2Index, 3, TurretDamage, TurretElement, Colour);
+					RequestBullet(this->vec2Index, 0, TurretDamage, TurretElement, Colour);
+					RequestBullet(this->vec2Index, 1, TurretDamage, TurretElement, Colour);
+					RequestBullet(this->vec2Index, 2, TurretDamage, TurretElement, Colour);
+					RequestBullet(this->vec2Index, 3, TurretDamage, TurretElement, Colour);
 					break;
 				case MULTIMULTISHOT_TURRET:
-					cBulletGenerator->GenerateBullet(this->vec2Index, 0, TurretDamage, TurretElement, Colour);
-					cBulletGenerator->GenerateBullet(this->vec2Index, 1, TurretDamage, TurretElement, Colour);
-					cBulletGenerator->GenerateBullet(this->vec2Index, 2, TurretDamage, TurretElement, Colour);
-					cBulletGenerator->GenerateBullet(this->vec2Index, 3, TurretDamage, TurretElement, Colour);
-					cBulletGenerator->GenerateBullet(this->vec2Index, 4, TurretDamage, TurretElement, Colour);
-					cBulletGenerator->GenerateBullet(this->vec2Index, 5, TurretDamage, TurretElement, Colour);
-					cBulletGenerator->GenerateBullet(this->vec2Index, 6, TurretDamage, TurretElement, Colour);
-					cBulletGenerator->GenerateBullet(this->vec2Index, 7, TurretDamage, TurretElement, Colour);
+					RequestBullet(this->vec2Index, 0, TurretDamage, TurretElement, Colour);
+					RequestBullet(this->vec2Index, 1, TurretDamage, TurretElement, Colour);
+					RequestBullet(this->vec2Index, 2, TurretDamage, TurretElement, Colour);
+					RequestBullet(this->vec2Index, 3, TurretDamage, TurretElement, Colour);
+					RequestBullet(this->vec2Index, 4, TurretDamage, TurretElement, Colour);
+					RequestBullet(this->vec2Index, 5, TurretDamage, TurretElement, Colour);
+					RequestBullet(this->vec2Index, 6, TurretDamage, TurretElement, Colour);
+					RequestBullet(this->vec2Index, 7, TurretDamage, TurretElement, Colour);
 					break;
 				case STARSHOT_TURRET:
-					cBulletGenerator->GenerateBullet(this->vec2Index, 0, TurretDamage, TurretElement, Colour);
-					cBulletGenerator->GenerateBullet(this->vec2Index, 1, TurretDamage, TurretElement, Colour);
-					cBulletGenerator->GenerateBullet(this->vec2Index, 2, TurretDamage, TurretElement, Colour);
-					cBulletGenerator->GenerateBullet(this->vec2Index, 5, TurretDamage, TurretElement, Colour);
-					cBulletGenerator->GenerateBullet(this->vec2Index, 7, TurretDamage, TurretElement, Colour);
+					RequestBullet(this->vec2Index, 0, TurretDamage, TurretElement, Colour);
+					RequestBullet(this->vec2Index, 1, TurretDamage, TurretElement, Colour);
+					RequestBullet(this->vec2Index, 2, TurretDamage, TurretElement, Colour);
+					RequestBullet(this->vec2Index, 5, TurretDamage, TurretElement, Colour);
+					RequestBullet(this->vec2Index, 7, TurretDamage, TurretElement, Colour);
 					break;
 				case MULTIFIRE_TURRET:
-					if (rand() % 100 <= ElementChance)
+					if (cRandom.Int(100) <= ElementChance)
 					{
-						cBulletGenerator->GenerateBullet(this->vec2Index, 0, TurretDamage, TurretElement, Colour);
-						cBulletGenerator->GenerateBullet(this->vec2Index, 1, TurretDamage, TurretElement, Colour);
-						cBulletGenerator->GenerateBullet(this->vec2Index, 2, TurretDamage, TurretElement, Colour);
-						cBulletGenerator->GenerateBullet(this->vec2Index, 3, TurretDamage, TurretElement, Colour);
+						RequestBullet(this->vec2Index, 0, TurretDamage, TurretElement, Colour);
+						RequestBullet(this->vec2Index, 1, TurretDamage, TurretElement, Colour);
+						RequestBullet(this->vec2Index, 2, TurretDamage, TurretElement, Colour);
+						RequestBullet(this->vec2Index, 3, TurretDamage, TurretElement, Colour);
 					}
 					else
 					{
-						cBulletGenerator->GenerateBullet(this->vec2Index, 0, TurretDamage, NORMAL, Colour);
-						cBulletGenerator->GenerateBullet(this->vec2Index, 1, TurretDamage, NORMAL, Colour);
-						cBulletGenerator->GenerateBullet(this->vec2Index, 2, TurretDamage, NORMAL, Colour);
-						cBulletGenerator->GenerateBullet(this->vec2Index, 3, TurretDamage, NORMAL, Colour);
+						RequestBullet(this->vec2Index, 0, TurretDamage, NORMAL, Colour);
+						RequestBullet(this->vec2Index, 1, TurretDamage, NORMAL, Colour);
+						RequestBullet(this->vec2Index, 2, TurretDamage, NORMAL, Colour);
+						RequestBullet(this->vec2Index, 3, TurretDamage, NORMAL, Colour);
 					}
 					break;
 				case SNOWSTAR_TURRET:
-					if (rand() % 100 <= ElementChance)
+					if (cRandom.Int(100) <= ElementChance)
 					{
-						cBulletGenerator->GenerateBullet(this->vec2Index, 0, TurretDamage, TurretElement, Colour);
-						cBulletGenerator->GenerateBullet(this->vec2Index, 1, TurretDamage, TurretElement, Colour);
-						cBulletGenerator->GenerateBullet(this->vec2Index, 2, TurretDamage, TurretElement, Colour);
-						cBulletGenerator->GenerateBullet(this->vec2Index, 5, TurretDamage, TurretElement, Colour);
-						cBulletGenerator->GenerateBullet(this->vec2Index, 7, TurretDamage, TurretElement, Colour);
+						RequestBullet(this->vec2Index, 0, TurretDamage, TurretElement, Colour);
+						RequestBullet(this->vec2Index, 1, TurretDamage, TurretElement, Colour);
+						RequestBullet(this->vec2Index, 2, TurretDamage, TurretElement, Colour);
+						RequestBullet(this->vec2Index, 5, TurretDamage, TurretElement, Colour);
+						RequestBullet(this->vec2Index, 7, TurretDamage, TurretElement, Colour);
 					}
 					else
 					{
-						cBulletGenerator->GenerateBullet(this->vec2Index, 0, TurretDamage, NORMAL, Colour);
-						cBulletGenerator->GenerateBullet(this->vec2Index, 1, TurretDamage, NORMAL, Colour);
-						cBulletGenerator->GenerateBullet(this->vec2Index, 2, TurretDamage, NORMAL, Colour);
-						cBulletGenerator->GenerateBullet(this->vec2Index, 5, TurretDamage, NORMAL, Colour);
-						cBulletGenerator->GenerateBullet(this->vec2Index, 7, TurretDamage, NORMAL, Colour);
+						RequestBullet(this->vec2Index, 0, TurretDamage, NORMAL, Colour);
+						RequestBullet(this->vec2Index, 1, TurretDamage, NORMAL, Colour);
+						RequestBullet(this->vec2Index, 2, TurretDamage, NORMAL, Colour);
+						RequestBullet(this->vec2Index, 5, TurretDamage, NORMAL, Colour);
+						RequestBullet(this->vec2Index, 7, TurretDamage, NORMAL, Colour);
 					}
 					break;
 
@@ -584,7 +615,7 @@ void CTurret::Update(const double dElapsedTime)
 				case UPGRADED_FIREWALL_TURRET:
 					// Had Code here but broke the game so yeaaa
 					upgradeLeft = RANDOM_DMG_TURRET;
-					UpgradeTurret(true);
+					AddFireRequest(SFireRequest::UPGRADE);
 					break;
 
 					// Ice Floor
@@ -592,39 +623,39 @@ void CTurret::Update(const double dElapsedTime)
 				case UPGRADED_ICE_FLOOR_TURRET:
 					// Had Code here but broke the game so yeaaa
 					upgradeLeft = RANDOM_DMG_TURRET;
-					UpgradeTurret(true);
+					AddFireRequest(SFireRequest::UPGRADE);
 					break;
 
 					// Misc
 				case THUNDER_TURRET:
 				case FINAL_THUNDER:
-					cBulletGenerator->GenerateBullet(glm::vec2(nearestEnemy->vec2Index.x, nearestEnemy->vec2Index.y + 5), 3, TurretDamage, TurretElement, Colour);
+					RequestBullet(glm::vec2(nearestEnemy->vec2Index.x, nearestEnemy->vec2Index.y + 5), 3, TurretDamage, TurretElement, Colour);
 					break;
 				case STORM_TURRET:
-					if (rand() % 101 <= ElementChance)
+					if (cRandom.Int(101) <= ElementChance)
 					{
-						cBulletGenerator->GenerateBullet(glm::vec2(nearestEnemy->vec2Index.x, nearestEnemy->vec2Index.y + 5), 3, TurretDamage, TurretElement, Colour);
+						RequestBullet(glm::vec2(nearestEnemy->vec2Index.x, nearestEnemy->vec2Index.y + 5), 3, TurretDamage, TurretElement, Colour);
 					}
 					else
 					{
-						cBulletGenerator->GenerateBullet(glm::vec2(nearestEnemy->vec2Index.x, nearestEnemy->vec2Index.y + 5), 3, TurretDamage, NORMAL, Colour);
+						RequestBullet(glm::vec2(nearestEnemy->vec2Index.x, nearestEnemy->vec2Index.y + 5), 3, TurretDamage, NORMAL, Colour);
 					}
 					break;
 				case TRIPLE_THUNDER_TURRET:
-					cBulletGenerator->GenerateBullet(glm::vec2(nearestEnemy->vec2Index.x, nearestEnemy->vec2Index.y + 5), 3, TurretDamage, TurretElement, Colour);
+					RequestBullet(glm::vec2(nearestEnemy->vec2Index.x, nearestEnemy->vec2Index.y + 5), 3, TurretDamage, TurretElement, Colour);
 					break;
 				case WRONGDIRECTION_TURRET:
-					cBulletGenerator->GenerateBullet(this->vec2Index, -(nearestEnemy->vec2Index), TurretDamage, TurretElement, Colour);
+					RequestBullet(this->vec2Index, -(nearestEnemy->vec2Index), TurretDamage, TurretElement, Colour);
 					break;
 				case SHOTGUN_TURRET:
-					cBulletGenerator->GenerateBullet(this->vec2Index, glm::vec2(nearestEnemy->vec2Index.x - 2, nearestEnemy->vec2Index.y - 2), TurretDamage, TurretElement, Colour);
-					cBulletGenerator->GenerateBullet(this->vec2Index, glm::vec2(nearestEnemy->vec2Index.x, nearestEnemy->vec2Index.y), TurretDamage, TurretElement, Colour);
-					cBulletGenerator->GenerateBullet(this->vec2Index, glm::vec2(nearestEnemy->vec2Index.x + 2, nearestEnemy->vec2Index.y + 2), TurretDamage, TurretElement, Colour);
+					RequestBullet(this->vec2Index, glm::vec2(nearestEnemy->vec2Index.x - 2, nearestEnemy->vec2Index.y - 2), TurretDamage, TurretElement, Colour);
+					RequestBullet(this->vec2Index, glm::vec2(nearestEnemy->vec2Index.x, nearestEnemy->vec2Index.y), TurretDamage, TurretElement, Colour);
+					RequestBullet(this->vec2Index, glm::vec2(nearestEnemy->vec2Index.x + 2, nearestEnemy->vec2Index.y + 2), TurretDamage, TurretElement, Colour);
 					break;
 				case FLIP_A_COIN_TURRET:
 				{
 					int Damage;
-					if (rand() % 2 == 1)
+					if (cRandom.Int(2) == 1)
 					{
 						Damage = 20;
 					}
@@ -632,13 +663,13 @@ void CTurret::Update(const double dElapsedTime)
 					{
 						Damage = 0;
 					}
-					cBulletGenerator->GenerateBullet(this->vec2Index, nearestEnemy->vec2Index, Damage, TurretElement, Colour);
+					RequestBullet(this->vec2Index, nearestEnemy->vec2Index, Damage, TurretElement, Colour);
 					break;
 				}
 				case RANDOM_DIRECTION_TURRET:
 				{
-					int Direction = rand() % 8;
-					cBulletGenerator->GenerateBullet(this->vec2Index, Direction);
+					int Direction = cRandom.Int(8);
+					RequestBullet(this->vec2Index, Direction);
 					break;
 				}
 				}
@@ -648,15 +679,110 @@ void CTurret::Update(const double dElapsedTime)
 		for (unsigned i = 0; i < cBulletGenerator->GetBulletsVector().size(); ++i)
 		{
 			cBulletGenerator->GetBulletsVector()[i]->Update();
-			cBulletGenerator->GetBulletsVector()[i]->SetEnemyVector(enemyVector);
+			cBulletGenerator->GetBulletsVector()[i]->SetEnemyVector(*pEnemyVector);
 		}
 	}
 
+	pFireRequests = NULL;
+
 	// Update the UV Coordinates
 	vec2UVCoordinate.x = cSettings->ConvertIndexToUVSpace(cSettings->x, vec2Index.x, false, i32vec2NumMicroSteps.x * cSettings->MICRO_STEP_XAXIS);
 	vec2UVCoordinate.y = cSettings->ConvertIndexToUVSpace(cSettings->y, vec2Index.y, false, i32vec2NumMicroSteps.y * cSettings->MICRO_STEP_YAXIS);
 }
 
+/**
+ @brief Do a fire request of Think(). It creates the resources of the bullets and changes the scene,
+		so it is called on the main thread. The new bullets are updated once, as in the tick they are fired
+ @param sFireRequest The fire request
+ */
+void CTurret::Fire(const SFireRequest& sFireRequest)
+{
+	switch (sFireRequest.eType)
+	{
+	case SFireRequest::BULLET_DEFAULT:
+		cBulletGenerator->GenerateBullet(sFireRequest.vec2Index, sFireRequest.iDirection);
+		break;
+	case SFireRequest::BULLET_DIRECTION:
+		cBulletGenerator->GenerateBullet(sFireRequest.vec2Index, sFireRequest.iDirection, sFireRequest.iDamage, sFireRequest.iElement, sFireRequest.colour);
+		break;
+	case SFireRequest::BULLET_TARGET:
+		cBulletGenerator->GenerateBullet(sFireRequest.vec2Index, sFireRequest.vec2Target, sFireRequest.iDamage, sFireRequest.iElement, sFireRequest.colour);
+		break;
+	case SFireRequest::ADD_ORES:
+		cInventoryItem = cInventoryManager->GetItem("Iron");
+		cInventoryItem->Add(1);
+		cInventoryItem = cInventoryManager->GetItem("Silver");
+		cInventoryItem->Add(1);
+		cInventoryItem = cInventoryManager->GetItem("Bronze");
+		cInventoryItem->Add(1);
+		return;
+	case SFireRequest::UPGRADE:
+		UpgradeTurret(true);
+		return;
+	default:
+		return;
+	}
+
+	CBullet* pBullet = cBulletGenerator->GetBulletsVector().back();
+	pBullet->Update();
+	pBullet->SetEnemyVector(*pEnemyVector);
+}
+
+/**
+ @brief Add a fire request for Fire()
+ @param eType The type of the fire request
+ */
+void CTurret::AddFireRequest(const SFireRequest::TYPE eType)
+{
+	SFireRequest sFireRequest;
+	sFireRequest.eType = eType;
+	sFireRequest.pTurret = this;
+	sFireRequest.uiTurretIndex = 0;
+	sFireRequest.vec2Index = glm::vec2(0.0f);
+	sFireRequest.vec2Target = glm::vec2(0.0f);
+	sFireRequest.iDirection = 0;
+	sFireRequest.iDamage = 0;
+	sFireRequest.iElement = NORMAL;
+	sFireRequest.colour = glm::vec4(1.0f);
+	pFireRequests->push_back(sFireRequest);
+}
+
+/**
+ @brief Request a bullet in a direction, with the default damage and colour
+ */
+void CTurret::RequestBullet(const glm::vec2 vec2Index, const int direction)
+{
+	AddFireRequest(SFireRequest::BULLET_DEFAULT);
+	pFireRequests->back().vec2Index = vec2Index;
+	pFireRequests->back().iDirection = direction;
+}
+
+/**
+ @brief Request a bullet in a direction
+ */
+void CTurret::RequestBullet(const glm::vec2 vec2Index, const int direction, const int NEWDamage, const int NewELEMENT, const glm::vec4 Colour)
+{
+	AddFireRequest(SFireRequest::BULLET_DIRECTION);
+	pFireRequests->back().vec2Index = vec2Index;
+	pFireRequests->back().iDirection = direction;
+	pFireRequests->back().iDamage = NEWDamage;
+	pFireRequests->back().iElement = NewELEMENT;
+	pFireRequests->back().colour = Colour;
+}
+
+/**
+ @brief Request a bullet towards a target
+ */
+void CTurret::RequestBullet(const glm::vec2 vec2Index, const glm::vec2 Targetvec2Index, const int NEWDamage, const int NewELEMENT, const glm::vec4 Colour)
+{
+	AddFireRequest(SFireRequest::BULLET_TARGET);
+	pFireRequests->back().vec2Index = vec2Index;
+	pFireRequests->back().vec2Target = Targetvec2Index;
+	pFireRequests->back().iDamage = NEWDamage;
+	pFireRequests->back().iElement = NewELEMENT;
+	pFireRequests->back().colour = Colour;
+}
+
 /**
  @brief Set up the OpenGL display environment before rendering
  */
@@ -666,11 +792,11 @@ void CTurret::PreRender(void)
 		return;
 
 	// bind textures on corresponding texture units
-	glActiveTexture(GL_TEXTURE0);
+	CRenderState::GetInstance()->ActiveTexture(GL_TEXTURE0);
 
 	// Activate blending mode
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	CRenderState::GetInstance()->SetBlend(true);
+	CRenderState::GetInstance()->BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 	// Activate the shader
 	CShaderManager::GetInstance()->Use(sShaderName);
@@ -680,38 +806,27 @@ void CTurret::PreRender(void)
 }
 
 /**
- @brief Render this instance
+ @brief Render this instance by submitting it to the CRenderQueue
  */
 void CTurret::Render(const glm::mat4& view, const glm::mat4& projection)
 {
 	if (!bIsActive)
 		return;
 
-	glBindVertexArray(VAO);
-	// get matrix's uniform location and set matrix
-	unsigned int transformLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "transform");
-	unsigned int colorLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "runtimeColour");
-	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
-
 	transform = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
 	transform = glm::translate(transform, glm::vec3(vec2UVCoordinate.x,
 		vec2UVCoordinate.y,
 		0.0f));
-	// Update the shaders with the latest transform
-	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(projection * view * transform));
-	glUniform4fv(colorLoc, 1, glm::value_ptr(runtimeColour));
+	// Scale the shared unit quad to the size of a tile
+	transform = glm::scale(transform, glm::vec3(cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT, 1.0f));
 
-	// Get the texture to be rendered
-	glBindTexture(GL_TEXTURE_2D, iTextureID);
+	// Submit the quad to the render queue, which is flushed by CScene2D
+	CRenderQueue::GetInstance()->Submit(CRenderQueue::LAYER_TURRET, cShader, iTextureID,
+										quadMesh, transform, runtimeColour);
 
-	// Render the tile
-	glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-	quadMesh->Render();
-	//animatedMisc->Render();
+	// The bullets are submitted to their own layer, so they are drawn above all the turrets
 	for (unsigned i = 0; i < cBulletGenerator->GetBulletsVector().size(); ++i)
 		cBulletGenerator->GetBulletsVector()[i]->Render(view, projection);
-	glBindVertexArray(0);
-
 }
 
 /**
@@ -723,7 +838,7 @@ void CTurret::PostRender(void)
 		return;
 
 	// Disable blending
-	glDisable(GL_BLEND);
+	CRenderState::GetInstance()->SetBlend(false);
 	for (unsigned i = 0; i < cBulletGenerator->GetBulletsVector().size(); ++i)
 		cBulletGenerator->GetBulletsVector()[i]->PostRender();
 }
@@ -750,9 +865,9 @@ void CTurret::Seti32vec2NumMicroSteps(const int iNumMicroSteps_XAxis, const int
 	this->i32vec2NumMicroSteps.y = iNumMicroSteps_YAxis;
 }
 
-void CTurret::SetEnemyVector(vector<CEntity2D*> NEWenemyVector)
+void CTurret::SetEnemyVector(const vector<CEntity2D*>& NEWenemyVector)
 {
-	enemyVector = NEWenemyVector;
+	pEnemyVector = &NEWenemyVector;
 }
 
 int CTurret::GetNearestEnemy()
@@ -1311,7 +1426,7 @@ void CTurret::UpgradeTurret(bool IsLeft)
 		TurretElement = NORMAL;
 		TurretCooldown = 1.5;
 		range = 10.0;
-		Colour = glm::vec4(static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, 1);
+		Colour = glm::vec4(static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, 1);
 		break;
 
 	// Tier 3
@@ -1445,7 +1560,7 @@ void CTurret::UpgradeTurret(bool IsLeft)
 		TurretElement = NORMAL;
 		TurretCooldown = 1.5;
 		range = 10.0;
-		Colour = glm::vec4(static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, 1);
+		Colour = glm::vec4(static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, 1);
 		break;
 	case GETRANDOMTURRET:
 		iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Turret/GetRandomTurret.png", true);
@@ -1596,7 +1711,7 @@ void CTurret::UpgradeTurret(bool IsLeft)
 		TurretElement = NORMAL;
 		TurretCooldown = 1.5;
 		range = 10.0;
-		Colour = glm::vec4(static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, 1);
+		Colour = glm::vec4(static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, 1);
 		break;
 
 	// Tier 4
@@ -1895,7 +2010,7 @@ void CTurret::UpgradeTurret(bool IsLeft)
 		TurretElement = NORMAL;
 		TurretCooldown = 999.9;
 		range = 10.0;
-		Colour = glm::vec4(static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, 1);
+		Colour = glm::vec4(static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, 1);
 		break;
 
 	case RANDOM_DMG_TURRETV3:
@@ -1961,7 +2076,7 @@ void CTurret::UpgradeTurret(bool IsLeft)
 		TurretElement = NORMAL;
 		TurretCooldown = 1.5;
 		range = 10.0;
-		Colour = glm::vec4(static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, 1);
+		Colour = glm::vec4(static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, 1);
 		break;
 	case GETRANDOMTURRET2:
 		iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Turret/GetRandomTurret.png", true);
@@ -2386,7 +2501,7 @@ void CTurret::UpgradeTurret(bool IsLeft)
 		TurretElement = NORMAL;
 		TurretCooldown = 1.5;
 		range = 20.0;
-		Colour = glm::vec4(static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, 1);
+		Colour = glm::vec4(static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, 1);
 		break;
 		break;
 	case THEYSTERIOUS_TURRET:
@@ -2403,7 +2518,7 @@ void CTurret::UpgradeTurret(bool IsLeft)
 		TurretElement = NORMAL;
 		TurretCooldown = 1.5;
 		range = 20.0;
-		Colour = glm::vec4(static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, 1);
+		Colour = glm::vec4(static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, 1);
 		break;
 		break;
 	case WESTERIOUS_TURRET:
@@ -2420,15 +2535,15 @@ void CTurret::UpgradeTurret(bool IsLeft)
 		TurretElement = NORMAL;
 		TurretCooldown = 1.5;
 		range = 10.0;
-		Colour = glm::vec4(static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, static_cast<float>((rand() % 100)) / 100.f, 1);
+		Colour = glm::vec4(static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, static_cast<float>((cRandom.Int(100))) / 100.f, 1);
 		break;
 	}
 
 	if (upgradeLeft != NONE && upgradeRight != NONE && upgradeRare != NONE)
 	{
-		if (rand() % 4 == 0) // 1 out of 4
+		if (cRandom.Int(4) == 0) // 1 out of 4
 		{
-			if (rand() % 2 == 0) // 1 out of 2
+			if (cRandom.Int(2) == 0) // 1 out of 2
 			{
 				upgradeLeft = upgradeRare;
 			}
@@ -2461,6 +2576,9 @@ void CTurret::findNearestEnemy()
 {
 	glm::vec2 NEWLive;
 	nearestEnemy = nullptr;
+	if (pEnemyVector == NULL)
+		return;
+	const vector<CEntity2D*>& enemyVector = *pEnemyVector;
 	for (int i = 0; i < enemyVector.size(); i++)
 	{
 		glm::vec2 currIndex = glm::vec2(enemyVector[i]->vec2Index.x, enemyVector[i]->vec2Index.y);
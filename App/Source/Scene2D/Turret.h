@@ -42,6 +42,12 @@ class CScene2D;
 
 #include "BulletGenerator.h"
 
+// Include STurretFireRequest
+#include "TurretFireRequest.h"
+
+// Include CRandom
+#include "System\Random.h"
+
 // Include Keyboard controller
 #include "Inputs\KeyboardController.h"
 
@@ -59,9 +65,21 @@ public:
 
 	bool Init(int, int, int);
 
-	// Update
+	// A request of Think() to fire a bullet or to change the scene
+	typedef STurretFireRequest SFireRequest;
+
+	// Update. It is RemoveIfDestroyed(), Think() and then Fire() for the requests
 	void Update(const double dElapsedTime);
 
+	// Remove this turret from the map and the scene if it was destroyed. Call it on the main thread
+	bool RemoveIfDestroyed(void);
+
+	// Aim, decide what to fire and update the bullets. It only changes this turret, so the turrets can think in parallel
+	void Think(const double dElapsedTime, std::vector<SFireRequest>& fireRequests);
+
+	// Do a fire request of Think(). Call it on the main thread
+	void Fire(const SFireRequest& sFireRequest);
+
 	// PreRender
 	void PreRender(void);
 
@@ -89,7 +107,7 @@ public:
 	// Set the UV coordinates of the enemy2D
 	glm::vec2 Getvec2UVCoordinates(void) const;
 
-	void SetEnemyVector(vector<CEntity2D*>);
+	void SetEnemyVector(const vector<CEntity2D*>& NEWenemyVector);
 
 	int GetNearestEnemy();
 
@@ -264,8 +282,8 @@ protected:
 	// Handler to the CMap2D instance
 	CMap2D* cMap2D;
 
-	// A vector containing the instance of CEnemy2Ds
-	vector<CEntity2D*> enemyVector;
+	// The enemies which the turret and its bullets aim at. They are not copied, so they must stay valid while the turret uses them
+	const vector<CEntity2D*>* pEnemyVector;
 
 	// A transformation matrix for controlling where to render the entities
 	glm::mat4 transform;
@@ -340,6 +358,12 @@ protected:
 
 	int FaceDirection;
 
+	// The fire requests of the thread which runs Think(), while it runs
+	std::vector<SFireRequest>* pFireRequests;
+
+	// The random stream of this turret
+	CRandom cRandom;
+
 	// Constraint the enemy2D's position within a boundary
 	void Constraint(DIRECTION eDirection = LEFT);
 
@@ -357,5 +381,13 @@ protected:
 	// Update position
 	void UpdatePosition(void);
 
+	// Add a fire request for Fire()
+	void AddFireRequest(const SFireRequest::TYPE eType);
+
+	// Request a bullet, with the same parameters as CBulletGenerator::GenerateBullet()
+	void RequestBullet(const glm::vec2 vec2Index, const int direction);
+	void RequestBullet(const glm::vec2 vec2Index, const int direction, const int NEWDamage, const int NewELEMENT, const glm::vec4 Colour);
+	void RequestBullet(const glm::vec2 vec2Index, const glm::vec2 Targetvec2Index, const int NEWDamage, const int NewELEMENT, const glm::vec4 Colour);
+
 };
 
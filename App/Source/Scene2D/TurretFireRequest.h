@@ -0,0 +1,36 @@
+/**
+ STurretFireRequest
+ @brief A request of CTurret::Think() to fire a bullet or to change the scene. The requests are gathered
+		on the threads which think, and CTurret::Fire() does them on the main thread, as a bullet loads
+		its resources. It is in its own file, so that CScene2D can keep the requests of the turrets
+ */
+#pragma once
+
+// Include GLM
+#include <includes/glm.hpp>
+
+class CTurret;
+
+struct STurretFireRequest
+{
+	enum TYPE
+	{
+		BULLET_DEFAULT = 0,		// A bullet in a direction, with the default damage and colour
+		BULLET_DIRECTION,		// A bullet in a direction
+		BULLET_TARGET,			// A bullet towards a target
+		ADD_ORES,				// Add an ore of each kind to the inventory
+		UPGRADE,				// Upgrade the turret to upgradeLeft
+		NUM_TYPES
+	};
+
+	TYPE eType;
+	CTurret* pTurret;
+	// The index of the turret in the turrets which thought in this tick. The requests are done in its order
+	unsigned int uiTurretIndex;
+	glm::vec2 vec2Index;
+	glm::vec2 vec2Target;
+	int iDirection;
+	int iDamage;
+	int iElement;
+	glm::vec4 colour;
+};
@@ -0,0 +1,250 @@
+/**
+ CWaveScheduler
+ @brief A class which schedules the waves and the spawns of the enemies from a wave table.
+		The wave table is a CSV file with a row for each wave: its start time and the interval
+		between its spawns in seconds of game time, the number of enemies of each spawn,
+		the number of bosses and the spawn determiner of its enemies. The table is compiled
+		into a queue of events ordered by their tick: a wave event which changes the difficulty,
+		boss events and spawn events. Update() runs the events of a tick exactly once, and
+		the spawns which are due are taken a few at a time, so that a burst is spread over ticks.
+ */
+#include "WaveScheduler.h"
+
+// Include rapidcsv to parse the wave table
+#include "System\rapidcsv.h"
+// Include CAssetPack to read the wave table from the asset pack if it was cooked
+#include "System\AssetPack.h"
+
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+using namespace std;
+
+// Include Filesystem
+#include "System\filesystem.h"
+
+/**
+ @brief Order the waves by their start
+ */
+static bool CompareWaveStart(const CWaveScheduler::SWave& sWaveA, const CWaveScheduler::SWave& sWaveB)
+{
+	return sWaveA.uiStartTick < sWaveB.uiStartTick;
+}
+
+/**
+ @brief Constructor
+ */
+CWaveScheduler::CWaveScheduler(void)
+	: uiNumQueued(0)
+	, uiTick(0)
+	, iWaveLevel(1)
+	, iPreviousWave(0)
+	, iSpawnDeterminer(2)
+	, uiPendingSpawns(0)
+	, uiPendingBosses(0)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CWaveScheduler::~CWaveScheduler(void)
+{
+}
+
+/**
+ @brief Load a wave table and compile it into the events. The columns are Wave, Start, SpawnInterval,
+		SpawnCount, Bosses and SpawnDeterminer, and the times are in seconds of game time
+ @param sFilename The file path of the wave table
+ @param dTickTime The game time of a tick in seconds, which the times are converted with
+ @return true if the wave table was loaded, otherwise false
+ */
+bool CWaveScheduler::LoadWaves(const std::string& sFilename, const double dTickTime)
+{
+	std::vector<SWave> loadedWaves;
+	try
+	{
+		// Use the wave table in the asset pack if it was cooked
+		rapidcsv::Document doc;
+		const CAssetPack::SEntry* pEntry = CAssetPack::GetInstance()->Find(sFilename, CAssetPack::ASSET_TEXT);
+		if (pEntry != NULL)
+		{
+			std::istringstream textStream(std::string((const char*)CAssetPack::GetInstance()->GetData(pEntry), (size_t)pEntry->ulSize));
+			doc = rapidcsv::Document(textStream);
+		}
+		else
+		{
+			doc = rapidcsv::Document(FileSystem::getPath(sFilename).c_str());
+		}
+
+		std::vector<int> waveColumn = doc.GetColumn<int>("Wave");
+		std::vector<double> startColumn = doc.GetColumn<double>("Start");
+		std::vector<double> spawnIntervalColumn = doc.GetColumn<double>("SpawnInterval");
+		std::vector<int> spawnCountColumn = doc.GetColumn<int>("SpawnCount");
+		std::vector<int> bossesColumn = doc.GetColumn<int>("Bosses");
+		std::vector<int> spawnDeterminerColumn = doc.GetColumn<int>("SpawnDeterminer");
+		for (size_t i = 0; i < waveColumn.size(); i++)
+		{
+			SWave sWave;
+			sWave.iWave = waveColumn[i];
+			sWave.uiStartTick = (unsigned int)(std::max(startColumn[i], 0.0) / dTickTime + 0.5);
+			// A spawn interval of less than a tick spawns in every tick
+			sWave.uiSpawnInterval = std::max((unsigned int)(std::max(spawnIntervalColumn[i], 0.0) / dTickTime + 0.5), 1u);
+			sWave.uiSpawnCount = (unsigned int)std::max(spawnCountColumn[i], 0);
+			sWave.uiNumBosses = (unsigned int)std::max(bossesColumn[i], 0);
+			sWave.iSpawnDeterminer = std::max(spawnDeterminerColumn[i], 1);
+			loadedWaves.push_back(sWave);
+		}
+	}
+	catch (const std::exception& e)
+	{
+		cout << "CWaveScheduler::LoadWaves(): Unable to load " << sFilename << ": " << e.what() << endl;
+		return false;
+	}
+
+	if (loadedWaves.empty())
+	{
+		cout << "CWaveScheduler::LoadWaves(): " << sFilename << " has no waves" << endl;
+		return false;
+	}
+
+	std::stable_sort(loadedWaves.begin(), loadedWaves.end(), CompareWaveStart);
+	waves.swap(loadedWaves);
+	Reset();
+	return true;
+}
+
+/**
+ @brief Start from the first wave again. The first wave is the current wave, and the events of all the waves are queued
+ */
+void CWaveScheduler::Reset(void)
+{
+	events = std::priority_queue<SEvent, std::vector<SEvent>, SLaterEvent>();
+	uiNumQueued = 0;
+	uiTick = 0;
+	iPreviousWave = 0;
+	uiPendingSpawns = 0;
+	uiPendingBosses = 0;
+	if (waves.empty())
+		return;
+
+	iWaveLevel = waves[0].iWave;
+	iSpawnDeterminer = waves[0].iSpawnDeterminer;
+	for (unsigned int i = 0; i < waves.size(); i++)
+	{
+		// The first wave is not started by an event, so that it is the current wave before the first tick
+		if (i > 0)
+			QueueEvent(EVENT_WAVE, waves[i].uiStartTick, i);
+		if (waves[i].uiNumBosses > 0)
+			QueueEvent(EVENT_BOSS, waves[i].uiStartTick, i);
+		if (waves[i].uiSpawnCount > 0)
+			QueueEvent(EVENT_SPAWN, waves[i].uiStartTick, i);
+	}
+}
+
+/**
+ @brief Run the events of the current tick and go to the next tick. Each event is run exactly once
+ */
+void CWaveScheduler::Update(void)
+{
+	while ((!events.empty()) && (events.top().uiTick <= uiTick))
+	{
+		SEvent sEvent = events.top();
+		events.pop();
+		const SWave& sWave = waves[sEvent.uiWaveIndex];
+		switch (sEvent.eType)
+		{
+		case EVENT_WAVE:
+			iPreviousWave = iWaveLevel;
+			iWaveLevel = sWave.iWave;
+			iSpawnDeterminer = sWave.iSpawnDeterminer;
+			break;
+		case EVENT_BOSS:
+			uiPendingBosses += sWave.uiNumBosses;
+			break;
+		case EVENT_SPAWN:
+		{
+			uiPendingSpawns += sWave.uiSpawnCount;
+			// Queue the next spawn of this wave, unless it is after the start of the next wave.
+			// The spawns of the last wave go on until the game ends
+			unsigned int uiNextTick = sEvent.uiTick + sWave.uiSpawnInterval;
+			if ((sEvent.uiWaveIndex + 1 >= waves.size()) || (uiNextTick < waves[sEvent.uiWaveIndex + 1].uiStartTick))
+				QueueEvent(EVENT_SPAWN, uiNextTick, sEvent.uiWaveIndex);
+			break;
+		}
+		default:
+			break;
+		}
+	}
+	uiTick++;
+}
+
+/**
+ @brief Take up to a number of the enemies or the bosses which are due to be spawned.
+		The rest are taken in the next ticks, so that a burst of spawns does not stall a tick
+ @param eType EVENT_SPAWN for the enemies, or EVENT_BOSS for the bosses
+ @param uiMaxSpawns The most which are taken
+ @return The number which should be spawned now
+ */
+unsigned int CWaveScheduler::TakeSpawns(const EVENT_TYPE eType, const unsigned int uiMaxSpawns)
+{
+	unsigned int* puiPending = NULL;
+	if (eType == EVENT_SPAWN)
+		puiPending = &uiPendingSpawns;
+	else if (eType == EVENT_BOSS)
+		puiPending = &uiPendingBosses;
+	else
+		return 0;
+
+	unsigned int uiNumSpawns = std::min(*puiPending, uiMaxSpawns);
+	*puiPending -= uiNumSpawns;
+	return uiNumSpawns;
+}
+
+/**
+ @brief Get the current wave
+ */
+int CWaveScheduler::GetWaveLevel(void) const
+{
+	return iWaveLevel;
+}
+
+/**
+ @brief Get the wave before the current wave, or 0 during the first wave
+ */
+int CWaveScheduler::GetPreviousWave(void) const
+{
+	return iPreviousWave;
+}
+
+/**
+ @brief Get the spawn determiner of the current wave, which picks the types of its enemies
+ */
+int CWaveScheduler::GetSpawnDeterminer(void) const
+{
+	return iSpawnDeterminer;
+}
+
+/**
+ @brief Get the current tick
+ */
+unsigned int CWaveScheduler::GetTick(void) const
+{
+	return uiTick;
+}
+
+/**
+ @brief Queue an event
+ @param eType The type of the event
+ @param uiTick The tick to run it in
+ @param uiWaveIndex The index of its wave in the wave table
+ */
+void CWaveScheduler::QueueEvent(const EVENT_TYPE eType, const unsigned int uiTick, const unsigned int uiWaveIndex)
+{
+	SEvent sEvent;
+	sEvent.eType = eType;
+	sEvent.uiTick = uiTick;
+	sEvent.uiSequence = uiNumQueued++;
+	sEvent.uiWaveIndex = uiWaveIndex;
+	events.push(sEvent);
+}
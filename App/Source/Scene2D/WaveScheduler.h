@@ -0,0 +1,107 @@
+/**
+ CWaveScheduler
+ @brief A class which schedules the waves and the spawns of the enemies from a wave table.
+		The wave table is a CSV file with a row for each wave: its start time and the interval
+		between its spawns in seconds of game time, the number of enemies of each spawn,
+		the number of bosses and the spawn determiner of its enemies. The table is compiled
+		into a queue of events ordered by their tick: a wave event which changes the difficulty,
+		boss events and spawn events. Update() runs the events of a tick exactly once, and
+		the spawns which are due are taken a few at a time, so that a burst is spread over ticks.
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <queue>
+
+class CWaveScheduler
+{
+public:
+	// The types of the events
+	enum EVENT_TYPE
+	{
+		EVENT_WAVE = 0,		// Start a wave, which changes the difficulty
+		EVENT_BOSS,			// Add the bosses of a wave to the spawns which are due
+		EVENT_SPAWN,		// Add the enemies of a spawn to the spawns which are due, and queue the next spawn of the wave
+		NUM_EVENT_TYPES
+	};
+
+	// A row of the wave table, with its times in ticks
+	struct SWave
+	{
+		int iWave;
+		unsigned int uiStartTick;
+		unsigned int uiSpawnInterval;
+		unsigned int uiSpawnCount;
+		unsigned int uiNumBosses;
+		int iSpawnDeterminer;
+	};
+
+	// Constructor
+	CWaveScheduler(void);
+
+	// Destructor
+	~CWaveScheduler(void);
+
+	// Load a wave table and compile it into the events. The times are converted into ticks of a length in seconds
+	bool LoadWaves(const std::string& sFilename, const double dTickTime);
+
+	// Start from the first wave again
+	void Reset(void);
+
+	// Run the events of the current tick and go to the next tick
+	void Update(void);
+
+	// Take up to a number of the enemies or the bosses which are due to be spawned
+	unsigned int TakeSpawns(const EVENT_TYPE eType, const unsigned int uiMaxSpawns);
+
+	// Get the current wave, the previous wave and the spawn determiner of the current wave
+	int GetWaveLevel(void) const;
+	int GetPreviousWave(void) const;
+	int GetSpawnDeterminer(void) const;
+
+	// Get the current tick
+	unsigned int GetTick(void) const;
+
+protected:
+	// An event of a wave, at a tick. The events of the same tick are run in the order they were queued
+	struct SEvent
+	{
+		EVENT_TYPE eType;
+		unsigned int uiTick;
+		unsigned int uiSequence;
+		unsigned int uiWaveIndex;
+	};
+
+	// Order the events so that the earliest is at the top of the queue
+	struct SLaterEvent
+	{
+		bool operator()(const SEvent& sEventA, const SEvent& sEventB) const
+		{
+			if (sEventA.uiTick != sEventB.uiTick)
+				return sEventA.uiTick > sEventB.uiTick;
+			return sEventA.uiSequence > sEventB.uiSequence;
+		}
+	};
+
+	// The wave table, ordered by the start of the waves
+	std::vector<SWave> waves;
+	// The events which are not run yet
+	std::priority_queue<SEvent, std::vector<SEvent>, SLaterEvent> events;
+	unsigned int uiNumQueued;
+
+	// The current tick
+	unsigned int uiTick;
+
+	// The state of the current wave
+	int iWaveLevel;
+	int iPreviousWave;
+	int iSpawnDeterminer;
+
+	// The enemies and the bosses which are due to be spawned
+	unsigned int uiPendingSpawns;
+	unsigned int uiPendingBosses;
+
+	// Queue an event
+	void QueueEvent(const EVENT_TYPE eType, const unsigned int uiTick, const unsigned int uiWaveIndex);
+};
@@ -6,6 +6,9 @@
  */
 #include "SoundController.h"
 
+// Include CMetricsRegistry to count the sounds which are started
+#include "System\MetricsRegistry.h"
+
 #include <iostream>
 using namespace std;
 
@@ -17,6 +20,7 @@ CSoundController::CSoundController(void)
 	, vec3dfListenerPos(vec3df(0, 0, 0))
 	, vec3dfListenerDir(vec3df(0, 0, 1))
 {
+	uiMetricSoundsStarted = CMetricsRegistry::GetInstance()->AddCounter("Sounds Started");
 }
 
 /**
@@ -80,6 +84,10 @@ bool CSoundController::LoadSound(	string filename,
 									CSoundInfo::SOUNDTYPE eSoundType,
 									vec3df vec3dfSoundPos)
 {
+	// Without a sound device, e.g. in the headless simulation, the sounds are not loaded
+	if (cSoundEngine == NULL)
+		return false;
+
 	//cout << filename.c_str() << endl;
 	// Load the sound from the file
 	ISoundSource* pSoundSource = cSoundEngine->addSoundSourceFromFile(filename.c_str(),
@@ -120,6 +128,10 @@ bool CSoundController::LoadSound(	string filename,
  */
 void CSoundController::PlaySoundByID(const int ID)
 {
+	// Without a sound device, there is nothing to play
+	if (cSoundEngine == NULL)
+		return;
+
 	CSoundInfo* pSoundInfo = GetSound(ID);
 	if (!pSoundInfo)
 	{
@@ -144,11 +156,15 @@ void CSoundController::PlaySoundByID(const int ID)
 								pSoundInfo->GetPosition(), 
 								pSoundInfo->GetLoopStatus());
 	}
+	CMetricsRegistry::GetInstance()->Add(uiMetricSoundsStarted);
 }
 
 // Stop a sound by its ID
 void CSoundController::StopPlayByID(const int ID)
 {
+	if (cSoundEngine == NULL)
+		return;
+
 	CSoundInfo* pSoundInfo = GetSound(ID);
 	if (!pSoundInfo)
 	{
@@ -168,6 +184,9 @@ void CSoundController::StopPlayByID(const int ID)
  */
 bool CSoundController::MasterVolumeIncrease(void)
 {
+	if (cSoundEngine == NULL)
+		return false;
+
 	// Get the current volume
 	float fCurrentVolume = cSoundEngine->getSoundVolume() + 0.1f;
 	// Check if the maximum volume has been reached
@@ -187,6 +206,9 @@ bool CSoundController::MasterVolumeIncrease(void)
  */
 bool CSoundController::MasterVolumeDecrease(void)
 {
+	if (cSoundEngine == NULL)
+		return false;
+
 	// Get the current volume
 	float fCurrentVolume = cSoundEngine->getSoundVolume() - 0.1f;
 	// Check if the minimum volume has been reached
@@ -208,6 +230,9 @@ bool CSoundController::MasterVolumeDecrease(void)
  */
 bool CSoundController::VolumeIncrease(const int ID)
 {
+	if (cSoundEngine == NULL)
+		return false;
+
 	// Get the ISoundSource
 	ISoundSource* pISoundSource = GetSound(ID)->GetSound();
 	if (pISoundSource == nullptr)
@@ -238,6 +263,9 @@ bool CSoundController::VolumeIncrease(const int ID)
  */
 bool CSoundController::VolumeDecrease(const int ID)
 {
+	if (cSoundEngine == NULL)
+		return false;
+
 	// Get the ISoundSource
 	ISoundSource* pISoundSource = GetSound(ID)->GetSound();
 	if (pISoundSource == nullptr)
@@ -1,6 +1,7 @@
 /**
  CSoundController
- @brief A class which manages the sound objects
+ @brief A class which manages the sound objects.
+		If Init() is not called, there is no sound device, and the sounds are not loaded or played
  By: Toh Da Jun
  Date: Mar 2020
  */
@@ -84,6 +85,9 @@ protected:
 	// For 3D sound only: Listender view direction
 	vec3df vec3dfListenerDir;
 
+	// The metric of the sounds which were started
+	unsigned int uiMetricSoundsStarted;
+
 	float prevSoundVolume;
 };
 
@@ -6,12 +6,224 @@
  */
 #include "Application.h"
 
+// Include CAssetPacker to cook the asset pack
+#include "System\AssetPacker.h"
+// Include CRenderBenchmark to profile the draw submission without a GPU
+#include "RenderBenchmark.h"
+// Include CHeadlessSimulation to run the waves without a window
+#include "HeadlessSimulation.h"
+// Include CJobBenchmark to measure the job system
+#include "JobBenchmark.h"
+// Include CProfiler to record the profiler zones from the start
+#include "TimeControl\Profiler.h"
+// Include CMetricsRegistry to write the metrics to a file
+#include "System\MetricsRegistry.h"
+// Include CRandomService to seed the gameplay randomness
+#include "System\RandomService.h"
+// Include CInputRecorder to record and replay the inputs
+#include "Inputs\InputRecorder.h"
+// Include Settings for the name of the asset pack
+#include "GameControl\Settings.h"
+
+#include <cstring>
+#include <cstdlib>
+#include <string>
+#include <chrono>
+#include <iostream>
+using namespace std;
+
+// Include Filesystem
+#include "System\filesystem.h"
+
+/**
+ @brief Stop the profiler if it is recording, write its trace and destroy it
+ @param sTraceFile The file path of the trace
+ */
+static void StopProfiler(const std::string& sTraceFile)
+{
+	if (CProfiler::IsRecording())
+	{
+		CProfiler::GetInstance()->Stop();
+		CProfiler::GetInstance()->WriteChromeTrace(sTraceFile);
+	}
+	CProfiler::GetInstance()->Destroy();
+}
+
 /**
  @brief This function is the main function which is called by the operating system when you run the executables
+ @param argc The number of command line arguments
+ @param argv The command line arguments. Run with "--cook" to cook the asset pack instead of
+		running the game, and add "--mips" to cook the mip chains of the images too.
+		Run with "--check-pack" to warn if a loose file was changed after the asset pack was cooked.
+		Run with "--render-benchmark [frames]" to measure the draw submission with the null render backend.
+		Run with "--headless [waves]" to run the waves without a window, sound or GUI as fast as possible, and print their timings.
+		Run with "--job-benchmark [jobs]" to measure the cost of a job and the scaling of the job system over the cores.
+		Run with "--profile [file]" to record the profiler zones from the start, and write them to a Chrome trace at the end.
+		Run with "--metrics [file]" to write the metrics to a CSV file, or a JSON file if it ends with ".json", every interval.
+		Run with "--fps <rate>" to set the target frame rate, where 0 is uncapped, or with "--vsync" to wait for the vertical sync.
+		Run with "--seed <seed>" to seed the gameplay randomness, so that a run can be repeated.
+		Run with "--record <file>" to record the inputs and the random seed into a log, and with
+		"--replay <file>" to play the game again with them, as fast as possible.
+		Run with "--speed <scale>" to start with the simulation running faster, where 0 is as fast as possible
  @return This function returns the error codes
  */
-int main(void)
+int main(int argc, char* argv[])
 {
+	bool bCook = false;
+	bool bMipMaps = false;
+	bool bRenderBenchmark = false;
+	unsigned int uiNumBenchmarkFrames = 1000;
+	bool bHeadless = false;
+	unsigned int uiNumHeadlessWaves = 9;
+	bool bJobBenchmark = false;
+	unsigned int uiNumBenchmarkJobs = 100000;
+	bool bProfile = false;
+	std::string sProfileTraceFile = CSettings::GetInstance()->sProfileTraceFile;
+	bool bMetrics = false;
+	std::string sMetricsFile = CSettings::GetInstance()->sMetricsFile;
+	std::string sRecordFile;
+	std::string sReplayFile;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--cook") == 0)
+			bCook = true;
+		else if (strcmp(argv[i], "--mips") == 0)
+			bMipMaps = true;
+		else if (strcmp(argv[i], "--check-pack") == 0)
+			CSettings::GetInstance()->bCheckAssetPack = true;
+		else if (strcmp(argv[i], "--render-benchmark") == 0)
+		{
+			bRenderBenchmark = true;
+			// The number of frames is optional
+			if ((i + 1 < argc) && (atoi(argv[i + 1]) > 0))
+				uiNumBenchmarkFrames = (unsigned int)atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--headless") == 0)
+		{
+			bHeadless = true;
+			// The number of waves is optional
+			if ((i + 1 < argc) && (atoi(argv[i + 1]) > 0))
+				uiNumHeadlessWaves = (unsigned int)atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--job-benchmark") == 0)
+		{
+			bJobBenchmark = true;
+			// The number of jobs is optional
+			if ((i + 1 < argc) && (atoi(argv[i + 1]) > 0))
+				uiNumBenchmarkJobs = (unsigned int)atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--profile") == 0)
+		{
+			bProfile = true;
+			// The trace file is optional
+			if ((i + 1 < argc) && (strncmp(argv[i + 1], "--", 2) != 0))
+			{
+				sProfileTraceFile = argv[++i];
+				CSettings::GetInstance()->sProfileTraceFile = argv[i];
+			}
+		}
+		else if (strcmp(argv[i], "--metrics") == 0)
+		{
+			bMetrics = true;
+			// The metrics file is optional
+			if ((i + 1 < argc) && (strncmp(argv[i + 1], "--", 2) != 0))
+				sMetricsFile = argv[++i];
+		}
+		else if ((strcmp(argv[i], "--fps") == 0) && (i + 1 < argc))
+			CSettings::GetInstance()->dTargetFrameRate = atof(argv[++i]);
+		else if (strcmp(argv[i], "--vsync") == 0)
+			CSettings::GetInstance()->bVSync = true;
+		else if ((strcmp(argv[i], "--seed") == 0) && (i + 1 < argc))
+			CSettings::GetInstance()->uiRandomSeed = (unsigned int)strtoul(argv[++i], NULL, 10);
+		else if ((strcmp(argv[i], "--speed") == 0) && (i + 1 < argc))
+			CSettings::GetInstance()->dTimeScale = atof(argv[++i]);
+		else if ((strcmp(argv[i], "--record") == 0) && (i + 1 < argc))
+			sRecordFile = argv[++i];
+		else if ((strcmp(argv[i], "--replay") == 0) && (i + 1 < argc))
+			sReplayFile = argv[++i];
+	}
+
+	// Create the profiler on this thread before any other thread can record a zone
+	CProfiler::GetInstance()->SetThreadName("Main");
+	if (bProfile)
+		CProfiler::GetInstance()->Start();
+
+	if (bCook)
+	{
+		// Cook the loose files into the asset pack, which is loaded by the next run
+		std::string sRootPath = FileSystem::getPath("");
+		sRootPath.erase(sRootPath.size() - 1);
+		bool bResult = CAssetPacker::Cook(sRootPath, FileSystem::getPath(CSettings::GetInstance()->sAssetPackFile), bMipMaps);
+		CSettings::GetInstance()->Destroy();
+		StopProfiler(sProfileTraceFile);
+		return bResult ? 0 : 1;
+	}
+
+	if (bRenderBenchmark)
+	{
+		// Render the map headless and print the cost of each frame, instead of running the game
+		bool bResult = CRenderBenchmark::Run(uiNumBenchmarkFrames);
+		StopProfiler(sProfileTraceFile);
+		return bResult ? 0 : 1;
+	}
+
+	if (bJobBenchmark)
+	{
+		// Measure the job system on all the cores, instead of running the game
+		bool bResult = CJobBenchmark::Run(uiNumBenchmarkJobs);
+		CSettings::GetInstance()->Destroy();
+		StopProfiler(sProfileTraceFile);
+		return bResult ? 0 : 1;
+	}
+
+	// A replay uses the random seed and the time scale of its log, and its frames are not paced by the buffer swaps
+	if (!sReplayFile.empty())
+	{
+		CInputRecorder* cInputRecorder = CInputRecorder::GetInstance();
+		if (cInputRecorder->StartReplay(sReplayFile) == false)
+		{
+			cInputRecorder->Destroy();
+			StopProfiler(sProfileTraceFile);
+			return 1;
+		}
+		if (cInputRecorder->GetFixedTimeStep() != CSettings::GetInstance()->dFixedTimeStep)
+			cout << "The input log was recorded with a tick of " << cInputRecorder->GetFixedTimeStep()
+				<< " s, so the replay can differ from the recording" << endl;
+		CSettings::GetInstance()->uiRandomSeed = cInputRecorder->GetRandomSeed();
+		CSettings::GetInstance()->dTimeScale = cInputRecorder->GetTimeScale();
+		CSettings::GetInstance()->bVSync = false;
+	}
+
+	// Seed the gameplay randomness. The seed is printed, so that a run without "--seed" can be repeated
+	unsigned int uiRandomSeed = CSettings::GetInstance()->uiRandomSeed;
+	if (uiRandomSeed == 0)
+	{
+		uiRandomSeed = (unsigned int)std::chrono::system_clock::now().time_since_epoch().count();
+		if (uiRandomSeed == 0)
+			uiRandomSeed = 1;
+		CSettings::GetInstance()->uiRandomSeed = uiRandomSeed;
+	}
+	CRandomService::GetInstance()->SetSeed(uiRandomSeed);
+	cout << "Random seed: " << uiRandomSeed << endl;
+
+	// Set how often the metrics are stored, and write them to a file if it was asked for
+	CMetricsRegistry::GetInstance()->SetInterval(CSettings::GetInstance()->dMetricsInterval);
+	if (bMetrics)
+		CMetricsRegistry::GetInstance()->StartDump(sMetricsFile);
+
+	if (bHeadless)
+	{
+		// Run the waves without a window and print their timings, instead of running the game
+		bool bResult = CHeadlessSimulation::Run(uiNumHeadlessWaves);
+		StopProfiler(sProfileTraceFile);
+		return bResult ? 0 : 1;
+	}
+
+	// Record the inputs with the random seed, so that the game can be replayed
+	if ((!sRecordFile.empty()) && (sReplayFile.empty()))
+		CInputRecorder::GetInstance()->StartRecording(sRecordFile, uiRandomSeed, CSettings::GetInstance()->dFixedTimeStep,
+													CSettings::GetInstance()->dTimeScale);
+
 	Application* pApp = Application::GetInstance();
 	// if the application is initialised properly, then run it
 	if (pApp->Init() == true)
@@ -25,10 +237,15 @@ int main(void)
 		// Set the Application handler to NULL
 		pApp = NULL;
 
+		// Write the trace if the profiler is still recording, after all the threads have stopped
+		StopProfiler(sProfileTraceFile);
+
 		// Return 0 since the application successfully ran
 		return 0;
 	}
 
+	StopProfiler(sProfileTraceFile);
+
 	// Return 1 if the application failed to run
 	return 1;
 }
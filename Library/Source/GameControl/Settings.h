@@ -8,8 +8,6 @@
 // Include SingletonTemplate
 #include "../DesignPatterns/SingletonTemplate.h"
 
-#include <Windows.h>
-
 // Include GLEW
 #ifndef GLEW_STATIC
 	#define GLEW_STATIC
@@ -32,6 +30,12 @@ public:
 
 	// File information
 	char* logl_root;	// Root directory for loading digital assets
+	bool bUseAssetPack = true;	// Load the digital assets from the asset pack if it was cooked
+	const char* sAssetPackFile = "Assets.pak";	// The asset pack in the root directory. Cook it with "App.exe --cook"
+	bool bCheckAssetPack = false;	// Warn if a loose file was changed after the asset pack was cooked. It reads the times of all the loose files, so set it with "App.exe --check-pack"
+	const char* sProfileTraceFile = "ProfileTrace.json";	// The Chrome trace which the profiler writes. Record it with F4 or "App.exe --profile"
+	const char* sMetricsFile = "Metrics.csv";	// The file which the metrics are written to with "App.exe --metrics". End it with ".json" for JSON
+	const double dMetricsInterval = 1.0;	// time in seconds between the values which the metrics panel shows and the metrics file stores
 
 	// GLFW Information
 	GLFWwindow* pWindow;
@@ -49,6 +53,17 @@ public:
 	// Frame Rate Information
 	const unsigned char FPS = 30; // FPS of this game
 	const unsigned int frameTime = 1000 / FPS; // time for each frame
+	const double dTextureUploadBudget = 0.002; // time in seconds for uploading loaded images in each frame
+	const double dHitchMultiplier = 2.0; // a frame which takes longer than this multiple of the target frame time is flagged as a hitch
+	double dTargetFrameRate = FPS; // the rate which the frame pacer starts the frames at, or 0 for uncapped. Set it with "App.exe --fps"
+	bool bVSync = false; // if true, the buffer swaps wait for the vertical sync instead of the frame pacer. Set it with "App.exe --vsync"
+	const double dFixedTimeStep = 1.0 / FPS; // time in seconds of a simulation tick. The counters of the entities count ticks at this rate
+	const double dTickElapsedTime = 0.0166666666666667; // the elapsed time which a tick passes to the entities. The game was tuned with it clamped to this
+	const unsigned int uiMaxFixedSteps = 4; // the most simulation ticks in a frame. After a longer frame, the game slows down
+	double dTimeScale = 1.0; // how fast the simulation runs, e.g. 16 for 16x, or 0 for as fast as possible. Press F9 to change it, or set it with "App.exe --speed"
+	const double dMaxTimeScaleBudget = 0.025; // the time in seconds which a frame spends on simulation ticks at the max time scale, before it is drawn
+	bool bHeadless = false; // if true, the simulation runs without a window, GL context, sound device or GUI. Set it with "App.exe --headless"
+	unsigned int uiRandomSeed = 0; // the seed of the gameplay randomness, or 0 to pick one from the clock. The same seed and inputs give the same game. Set it with "App.exe --seed"
 
 	// Input control
 	//const bool bActivateMouseInput
@@ -0,0 +1,374 @@
+/**
+ CInputRecorder
+ @brief A class to record the inputs of a game into a binary log, and to replay them.
+		The log starts with the random seed, the fixed time step and the time scale, and has a record for each frame
+		with its elapsed time and the changes to the keys, mouse buttons, mouse position and scroll
+		wheel. The inputs only change between frames, so the same frame times give the same ticks,
+		and every tick sees the same inputs as when they were recorded. A replay sets the inputs of
+		CKeyboardController and CMouseController from the log after the events are polled, and passes
+		the recorded frame times to the game, so that the frames can be run as fast as possible.
+ */
+#include "InputRecorder.h"
+
+// Include CMouseController
+#include "MouseController.h"
+// Include ImGui to set the mouse of the GUI
+#include "../GUI/imgui.h"
+
+#include <cstring>
+#include <iostream>
+using namespace std;
+
+/**
+ @brief Constructor
+ */
+CInputRecorder::CInputRecorder(void)
+	: eMode(MODE_NONE)
+	, uiNumFrames(0)
+{
+	memset(&sHeader, 0, sizeof(sHeader));
+	ResetInputs();
+}
+
+/**
+ @brief Destructor
+ */
+CInputRecorder::~CInputRecorder(void)
+{
+	Stop();
+}
+
+/**
+ @brief Start recording into a log. A log which was open is closed first
+ @param sFile The file path of the log
+ @param uiRandomSeed The random seed of the game, which is stored in the log
+ @param dFixedTimeStep The time of a tick, which is stored in the log
+ @param dTimeScale The time scale of the simulation, which is stored in the log. At the max time scale, 0,
+		the log is recorded but it cannot be replayed
+ @return true if the log was created
+ */
+bool CInputRecorder::StartRecording(const std::string& sFile, const unsigned int uiRandomSeed, const double dFixedTimeStep, const double dTimeScale)
+{
+	Stop();
+
+	logFile.open(sFile.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!logFile.is_open())
+	{
+		cout << "CInputRecorder::StartRecording(): Unable to create " << sFile << endl;
+		return false;
+	}
+
+	memset(&sHeader, 0, sizeof(sHeader));
+	memcpy(sHeader.acMagic, "SPIR", 4);
+	sHeader.uiVersion = uiVersion;
+	sHeader.uiRandomSeed = uiRandomSeed;
+	sHeader.dFixedTimeStep = dFixedTimeStep;
+	sHeader.dTimeScale = dTimeScale;
+	Write(sHeader);
+
+	ResetInputs();
+	uiNumFrames = 0;
+	eMode = MODE_RECORD;
+	cout << "CInputRecorder::StartRecording(): Recording the inputs into " << sFile << endl;
+	if (dTimeScale <= 0.0)
+		cout << "CInputRecorder::StartRecording(): WARNING: The time scale is max, so this log cannot be replayed" << endl;
+	return true;
+}
+
+/**
+ @brief Open a log to replay it, and read its random seed, fixed time step and time scale.
+		A log which was open is closed first
+ @param sFile The file path of the log
+ @return true if the log was opened, its header is valid and it was not recorded at the max time scale
+ */
+bool CInputRecorder::StartReplay(const std::string& sFile)
+{
+	Stop();
+
+	logFile.open(sFile.c_str(), std::ios::in | std::ios::binary);
+	if (!logFile.is_open())
+	{
+		cout << "CInputRecorder::StartReplay(): Unable to open " << sFile << endl;
+		return false;
+	}
+
+	if ((Read(sHeader) == false) || (memcmp(sHeader.acMagic, "SPIR", 4) != 0))
+	{
+		cout << "CInputRecorder::StartReplay(): " << sFile << " is not an input log" << endl;
+		logFile.close();
+		return false;
+	}
+	if (sHeader.uiVersion != uiVersion)
+	{
+		cout << "CInputRecorder::StartReplay(): " << sFile << " is version " << sHeader.uiVersion
+			<< ", but version " << uiVersion << " is needed" << endl;
+		logFile.close();
+		return false;
+	}
+	if (sHeader.dTimeScale <= 0.0)
+	{
+		cout << "CInputRecorder::StartReplay(): " << sFile << " was recorded at the max time scale, "
+			<< "so its ticks depended on the speed of the computer. It cannot be replayed" << endl;
+		logFile.close();
+		return false;
+	}
+
+	ResetInputs();
+	uiNumFrames = 0;
+	eMode = MODE_REPLAY;
+	cout << "CInputRecorder::StartReplay(): Replaying the inputs of " << sFile << endl;
+	return true;
+}
+
+/**
+ @brief Close the log
+ */
+void CInputRecorder::Stop(void)
+{
+	if (logFile.is_open())
+	{
+		logFile.close();
+		if ((eMode == MODE_RECORD) && (logFile.fail()))
+			cout << "CInputRecorder::Stop(): Unable to write the input log" << endl;
+	}
+	eMode = MODE_NONE;
+}
+
+/**
+ @brief Get the mode
+ */
+CInputRecorder::MODE CInputRecorder::GetMode(void) const
+{
+	return eMode;
+}
+
+/**
+ @brief Check if the inputs are being recorded
+ */
+bool CInputRecorder::IsRecording(void) const
+{
+	return (eMode == MODE_RECORD);
+}
+
+/**
+ @brief Check if the inputs are being replayed
+ */
+bool CInputRecorder::IsReplaying(void) const
+{
+	return (eMode == MODE_REPLAY);
+}
+
+/**
+ @brief Get the random seed of the log
+ */
+unsigned int CInputRecorder::GetRandomSeed(void) const
+{
+	return sHeader.uiRandomSeed;
+}
+
+/**
+ @brief Get the time of a tick when the log was recorded
+ */
+double CInputRecorder::GetFixedTimeStep(void) const
+{
+	return sHeader.dFixedTimeStep;
+}
+
+/**
+ @brief Get the time scale when the log was recorded
+ */
+double CInputRecorder::GetTimeScale(void) const
+{
+	return sHeader.dTimeScale;
+}
+
+/**
+ @brief Get the number of frames which were recorded or replayed
+ */
+unsigned int CInputRecorder::GetNumFrames(void) const
+{
+	return uiNumFrames;
+}
+
+/**
+ @brief Record the inputs of a frame. Call it after the events are polled and the input devices are updated
+ @param dElapsedTime The time since the last frame, which the next frame passes to the game
+ @return true if the frame was written
+ */
+bool CInputRecorder::RecordFrame(const double dElapsedTime)
+{
+	if (eMode != MODE_RECORD)
+		return false;
+
+	CKeyboardController* cKeyboardController = CKeyboardController::GetInstance();
+	CMouseController* cMouseController = CMouseController::GetInstance();
+	const std::bitset<CKeyboardController::MAX_KEYS>& currStatus = cKeyboardController->GetCurrStatus();
+	const std::bitset<CKeyboardController::MAX_KEYS>& prevStatus = cKeyboardController->GetPrevStatus();
+	double dCurrPosX = cMouseController->GetMousePositionX();
+	double dCurrPosY = cMouseController->GetMousePositionY();
+	double dCurrScrollX = cMouseController->GetMouseScrollStatus(CMouseController::SCROLL_TYPE_XOFFSET);
+	double dCurrScrollY = cMouseController->GetMouseScrollStatus(CMouseController::SCROLL_TYPE_YOFFSET);
+
+	// Only the inputs which changed since the last frame are written
+	unsigned char ucFlags = 0;
+	if (currStatus != keyStatus)
+		ucFlags |= FRAME_KEYS;
+	// The previous statuses are the last frame's, unless a key was pressed and released in the same frame
+	if (prevStatus != keyStatus)
+		ucFlags |= FRAME_PREV_KEYS;
+	if (cMouseController->GetButtonStatus() != ucButtonStatus)
+		ucFlags |= FRAME_BUTTONS;
+	if ((dCurrPosX != dMousePosX) || (dCurrPosY != dMousePosY))
+		ucFlags |= FRAME_POSITION;
+	if ((dCurrScrollX != dScrollX) || (dCurrScrollY != dScrollY))
+		ucFlags |= FRAME_SCROLL;
+
+	Write(dElapsedTime);
+	Write(ucFlags);
+	if (ucFlags & FRAME_KEYS)
+		WriteKeys(currStatus, keyStatus);
+	if (ucFlags & FRAME_PREV_KEYS)
+		WriteKeys(prevStatus, keyStatus);
+	if (ucFlags & FRAME_BUTTONS)
+	{
+		ucButtonStatus = cMouseController->GetButtonStatus();
+		Write(ucButtonStatus);
+	}
+	if (ucFlags & FRAME_POSITION)
+	{
+		dMousePosX = dCurrPosX;
+		dMousePosY = dCurrPosY;
+		Write(dMousePosX);
+		Write(dMousePosY);
+	}
+	if (ucFlags & FRAME_SCROLL)
+	{
+		dScrollX = dCurrScrollX;
+		dScrollY = dCurrScrollY;
+		Write(dScrollX);
+		Write(dScrollY);
+	}
+	keyStatus = currStatus;
+	uiNumFrames++;
+
+	if (logFile.fail())
+	{
+		cout << "CInputRecorder::RecordFrame(): Unable to write frame " << uiNumFrames << ". The recording is stopped" << endl;
+		Stop();
+		return false;
+	}
+	return true;
+}
+
+/**
+ @brief Set the inputs of the next frame from the log. Call it after the events are polled,
+		instead of updating the input devices, so that the inputs of the player are replaced
+ @param dElapsedTime The time since the last frame which was recorded
+ @return true if a frame was read, or false at the end of the log
+ */
+bool CInputRecorder::ReplayFrame(double& dElapsedTime)
+{
+	if (eMode != MODE_REPLAY)
+		return false;
+
+	double dFrameTime = 0.0;
+	unsigned char ucFlags = 0;
+	if ((Read(dFrameTime) == false) || (Read(ucFlags) == false))
+		return false;
+
+	std::bitset<CKeyboardController::MAX_KEYS> currStatus = keyStatus;
+	std::bitset<CKeyboardController::MAX_KEYS> prevStatus = keyStatus;
+	bool bResult = true;
+	if (ucFlags & FRAME_KEYS)
+		bResult = bResult && ReadKeys(currStatus);
+	if (ucFlags & FRAME_PREV_KEYS)
+		bResult = bResult && ReadKeys(prevStatus);
+	if (ucFlags & FRAME_BUTTONS)
+		bResult = bResult && Read(ucButtonStatus);
+	if (ucFlags & FRAME_POSITION)
+		bResult = bResult && Read(dMousePosX) && Read(dMousePosY);
+	if (ucFlags & FRAME_SCROLL)
+		bResult = bResult && Read(dScrollX) && Read(dScrollY);
+	if (bResult == false)
+	{
+		cout << "CInputRecorder::ReplayFrame(): Frame " << uiNumFrames + 1 << " of the input log is incomplete" << endl;
+		return false;
+	}
+
+	CKeyboardController::GetInstance()->SetStatus(currStatus, prevStatus);
+	CMouseController* cMouseController = CMouseController::GetInstance();
+	cMouseController->SetButtonStatus(ucButtonStatus);
+	cMouseController->UpdateMousePosition(dMousePosX, dMousePosY);
+	cMouseController->SetMouseScroll(dScrollX, dScrollY);
+
+	keyStatus = currStatus;
+	dElapsedTime = dFrameTime;
+	uiNumFrames++;
+	return true;
+}
+
+/**
+ @brief Set the mouse of the GUI from the replayed inputs, as the GUI reads the mouse of the window.
+		Call it after the GUI's platform backend starts a frame, and before ImGui::NewFrame()
+ */
+void CInputRecorder::UpdateGUIInputs(void)
+{
+	if (eMode != MODE_REPLAY)
+		return;
+
+	ImGuiIO& io = ImGui::GetIO();
+	io.MousePos = ImVec2((float)dMousePosX, (float)dMousePosY);
+	for (int i = 0; i < CMouseController::NUM_MB; i++)
+		io.MouseDown[i] = ((ucButtonStatus & (1 << i)) != 0);
+}
+
+/**
+ @brief Reset the inputs of the last frame to those of the input devices when they are created
+ */
+void CInputRecorder::ResetInputs(void)
+{
+	keyStatus.reset();
+	ucButtonStatus = 0;
+	dMousePosX = 0.0;
+	dMousePosY = 0.0;
+	dScrollX = 0.0;
+	dScrollY = 0.0;
+}
+
+/**
+ @brief Write the number of keys which are different in two sets, and their key codes
+ @param keys The keys
+ @param baseKeys The keys which they are compared with
+ */
+void CInputRecorder::WriteKeys(	const std::bitset<CKeyboardController::MAX_KEYS>& keys,
+								const std::bitset<CKeyboardController::MAX_KEYS>& baseKeys)
+{
+	std::bitset<CKeyboardController::MAX_KEYS> changedKeys = keys ^ baseKeys;
+	uint16_t usNumKeys = (uint16_t)changedKeys.count();
+	Write(usNumKeys);
+	for (uint16_t usKey = 0; usKey < CKeyboardController::MAX_KEYS; usKey++)
+	{
+		if (changedKeys.test(usKey))
+			Write(usKey);
+	}
+}
+
+/**
+ @brief Read the keys which were written by WriteKeys(), and flip them
+ @param keys The keys which they were compared with. They are changed into the keys which were written
+ @return true if the keys were read
+ */
+bool CInputRecorder::ReadKeys(std::bitset<CKeyboardController::MAX_KEYS>& keys)
+{
+	uint16_t usNumKeys = 0;
+	if (Read(usNumKeys) == false)
+		return false;
+	for (uint16_t i = 0; i < usNumKeys; i++)
+	{
+		uint16_t usKey = 0;
+		if ((Read(usKey) == false) || (usKey >= CKeyboardController::MAX_KEYS))
+			return false;
+		keys.flip(usKey);
+	}
+	return true;
+}
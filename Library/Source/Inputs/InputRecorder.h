@@ -0,0 +1,127 @@
+/**
+ CInputRecorder
+ @brief A class to record the inputs of a game into a binary log, and to replay them.
+		The log starts with the random seed, the fixed time step and the time scale, and has a record for each frame
+		with its elapsed time and the changes to the keys, mouse buttons, mouse position and scroll
+		wheel. The inputs only change between frames, so the same frame times give the same ticks,
+		and every tick sees the same inputs as when they were recorded. A replay sets the inputs of
+		CKeyboardController and CMouseController from the log after the events are polled, and passes
+		the recorded frame times to the game, so that the frames can be run as fast as possible.
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+// Include CKeyboardController for the number of keys
+#include "KeyboardController.h"
+
+#include <string>
+#include <fstream>
+#include <bitset>
+#include <stdint.h>
+
+class CInputRecorder : public CSingletonTemplate<CInputRecorder>
+{
+	friend CSingletonTemplate<CInputRecorder>;
+public:
+	// The modes of the recorder
+	enum MODE
+	{
+		MODE_NONE = 0,
+		MODE_RECORD,
+		MODE_REPLAY,
+		NUM_MODES
+	};
+
+	// The version of the log. A log of another version is not replayed
+	static const uint32_t uiVersion = 2;
+
+	// The header at the start of the log
+	struct SHeader
+	{
+		char acMagic[4];
+		uint32_t uiVersion;
+		uint32_t uiRandomSeed;
+		uint32_t uiReserved;
+		double dFixedTimeStep;
+		// The time scale when the recording started. A log which was recorded at the max time scale, 0,
+		// cannot be replayed, as the number of ticks of its frames depended on the speed of the computer
+		double dTimeScale;
+	};
+
+	// Start recording into a log
+	bool StartRecording(const std::string& sFile, const unsigned int uiRandomSeed, const double dFixedTimeStep, const double dTimeScale);
+	// Open a log to replay it, and read its random seed, fixed time step and time scale
+	bool StartReplay(const std::string& sFile);
+	// Close the log
+	void Stop(void);
+
+	// Get the mode
+	MODE GetMode(void) const;
+	// Check if the inputs are being recorded or replayed
+	bool IsRecording(void) const;
+	bool IsReplaying(void) const;
+	// Get the random seed, the fixed time step and the time scale of the log
+	unsigned int GetRandomSeed(void) const;
+	double GetFixedTimeStep(void) const;
+	double GetTimeScale(void) const;
+	// Get the number of frames which were recorded or replayed
+	unsigned int GetNumFrames(void) const;
+
+	// Record the inputs of a frame after the events are polled, with the time since the last frame
+	bool RecordFrame(const double dElapsedTime);
+	// Set the inputs of the next frame from the log after the events are polled, and get its elapsed time.
+	// Returns false at the end of the log
+	bool ReplayFrame(double& dElapsedTime);
+
+	// Set the mouse of the GUI from the replayed inputs. Call it after the GUI's platform backend starts a frame
+	void UpdateGUIInputs(void);
+
+protected:
+	// The flags of a frame, for the inputs which changed in it
+	enum FRAME_FLAG
+	{
+		FRAME_KEYS = 1 << 0,			// Keys were pressed or released
+		FRAME_PREV_KEYS = 1 << 1,		// The previous statuses of some keys are not their statuses in the last frame
+		FRAME_BUTTONS = 1 << 2,
+		FRAME_POSITION = 1 << 3,
+		FRAME_SCROLL = 1 << 4
+	};
+
+	MODE eMode;
+	std::fstream logFile;
+	SHeader sHeader;
+	unsigned int uiNumFrames;
+
+	// The inputs of the last frame, which the changes of a frame are compared with
+	std::bitset<CKeyboardController::MAX_KEYS> keyStatus;
+	unsigned char ucButtonStatus;
+	double dMousePosX, dMousePosY;
+	double dScrollX, dScrollY;
+
+	// Constructor
+	CInputRecorder(void);
+
+	// Destructor
+	virtual ~CInputRecorder(void);
+
+	// Reset the inputs of the last frame
+	void ResetInputs(void);
+
+	// Write and read the keys which are different in two sets
+	void WriteKeys(const std::bitset<CKeyboardController::MAX_KEYS>& keys, const std::bitset<CKeyboardController::MAX_KEYS>& baseKeys);
+	bool ReadKeys(std::bitset<CKeyboardController::MAX_KEYS>& keys);
+
+	// Write and read a value
+	template <typename T>
+	void Write(const T& value)
+	{
+		logFile.write((const char*)&value, sizeof(T));
+	}
+	template <typename T>
+	bool Read(T& value)
+	{
+		logFile.read((char*)&value, sizeof(T));
+		return (logFile.gcount() == sizeof(T));
+	}
+};
@@ -1,5 +1,7 @@
 #include "KeyboardController.h"
 
+#include <utility>
+
 /**
  @brief This Constructor is a protected access modified as this class instance will be a Singleton.
  */
@@ -32,6 +34,26 @@ void CKeyboardController::PostUpdate(void)
 	prevStatus = currStatus;
 }
 
+/**
+@brief Perform the operations before a tick of the fixed-step simulation.
+		The keys are compared with their statuses at the last tick instead of the last frame
+*/
+void CKeyboardController::PreFixedUpdate(void)
+{
+	std::swap(prevStatus, fixedPrevStatus);
+}
+
+/**
+@brief Perform the operations after a tick of the fixed-step simulation.
+		The statuses of this tick are stored for the next tick, and those of the last frame are restored
+*/
+void CKeyboardController::PostFixedUpdate(void)
+{
+	std::bitset<MAX_KEYS> framePrevStatus = fixedPrevStatus;
+	fixedPrevStatus = currStatus;
+	prevStatus = framePrevStatus;
+}
+
 /**
  @brief Perform update operation for a key
  */
@@ -90,6 +112,7 @@ void CKeyboardController::ResetKey(const int key)
 {
 	currStatus[key] = false;
 	prevStatus[key] = false;
+	fixedPrevStatus[key] = false;
 }
 
 /**
@@ -102,5 +125,33 @@ void CKeyboardController::Reset(void)
 	{
 		currStatus[key] = false;
 		prevStatus[key] = false;
+		fixedPrevStatus[key] = false;
 	}
 }
+
+/**
+ @brief Get the current statuses of all the keys
+ */
+const std::bitset<CKeyboardController::MAX_KEYS>& CKeyboardController::GetCurrStatus(void) const
+{
+	return currStatus;
+}
+
+/**
+ @brief Get the previous statuses of all the keys
+ */
+const std::bitset<CKeyboardController::MAX_KEYS>& CKeyboardController::GetPrevStatus(void) const
+{
+	return prevStatus;
+}
+
+/**
+ @brief Set the current and previous statuses of all the keys, e.g. to replay them
+ @param currStatus The current statuses
+ @param prevStatus The previous statuses
+ */
+void CKeyboardController::SetStatus(const std::bitset<MAX_KEYS>& currStatus, const std::bitset<MAX_KEYS>& prevStatus)
+{
+	this->currStatus = currStatus;
+	this->prevStatus = prevStatus;
+}
@@ -7,7 +7,6 @@
 
 #include "../DesignPatterns/SingletonTemplate.h"
 #include <bitset>
-#include <windows.h>
 
 class CKeyboardController : public CSingletonTemplate<CKeyboardController>
 {
@@ -24,6 +23,10 @@ public:
 	void Update(const int key, const int action);
 	// Perform post-update operations
 	void PostUpdate(void);
+	// Perform the operations before and after a tick of the fixed-step simulation, so that a key
+	// which was pressed or released since the last tick is seen by one tick, however many run in a frame
+	void PreFixedUpdate(void);
+	void PostFixedUpdate(void);
 
 	// User Interface
 	bool IsKeyDown(const int key);
@@ -36,6 +39,11 @@ public:
 	// Reset all keys
 	void Reset(void);
 
+	// Get or set the current and previous statuses of all the keys, to record and replay them
+	const std::bitset<MAX_KEYS>& GetCurrStatus(void) const;
+	const std::bitset<MAX_KEYS>& GetPrevStatus(void) const;
+	void SetStatus(const std::bitset<MAX_KEYS>& currStatus, const std::bitset<MAX_KEYS>& prevStatus);
+
 protected:
 	// Constructor
 	CKeyboardController(void);
@@ -45,4 +53,6 @@ protected:
 
 	// Bitset to store information about current and previous keypress statuses
 	std::bitset<MAX_KEYS> currStatus, prevStatus;
+	// Bitset to store the keypress statuses at the last tick. During a tick, it stores prevStatus instead
+	std::bitset<MAX_KEYS> fixedPrevStatus;
 };
@@ -197,4 +197,33 @@ double CMouseController::GetMouseDeltaX(void) const
 double CMouseController::GetMouseDeltaY(void) const
 {
 	return delta_posY;
+}
+
+/**
+ @brief Get the statuses of all the buttons
+ @return An unsigned char variable with a bit for each button which is down
+ */
+unsigned char CMouseController::GetButtonStatus(void) const
+{
+	return currBtnStatus;
+}
+
+/**
+ @brief Set the statuses of all the buttons, e.g. to replay them
+ @param _status A const unsigned char variable with a bit for each button which is down
+ */
+void CMouseController::SetButtonStatus(const unsigned char _status)
+{
+	currBtnStatus = _status;
+}
+
+/**
+ @brief Set the mouse scroll status, instead of adding to it
+ @param WheelOffset_X A const double variable which stores the offset in the x-axis
+ @param WheelOffset_Y A const double variable which stores the offset in the y-axis
+ */
+void CMouseController::SetMouseScroll(const double WheelOffset_X, const double WheelOffset_Y)
+{
+	this->WheelOffset_X = WheelOffset_X;
+	this->WheelOffset_Y = WheelOffset_Y;
 }
\ No newline at end of file
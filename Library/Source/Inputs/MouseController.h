@@ -45,6 +45,11 @@ public:
 	double GetMouseDeltaX(void) const;
 	double GetMouseDeltaY(void) const;
 
+	// Get or set the statuses of all the buttons, and set the scroll wheel offsets, to record and replay them
+	unsigned char GetButtonStatus(void) const;
+	void SetButtonStatus(const unsigned char _status);
+	void SetMouseScroll(const double WheelOffset_X, const double WheelOffset_Y);
+
 	// Get or Set status of keeping the mouse centered
 	inline bool GetKeepMouseCentered() const { return bKeepMouseCentered; };
 	inline void SetKeepMouseCentered(bool _value){ bKeepMouseCentered = _value; };
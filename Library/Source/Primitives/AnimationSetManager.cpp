@@ -0,0 +1,69 @@
+/**
+ CAnimationSetManager
+ @brief This class owns the CAnimationSets which are shared by the sprites of each type,
+		so that the animation clips are defined once instead of once per sprite.
+ */
+#include "AnimationSetManager.h"
+
+#include <iostream>
+using namespace std;
+
+/**
+@brief Constructor
+*/
+CAnimationSetManager::CAnimationSetManager(void)
+{
+}
+
+/**
+@brief Destructor
+*/
+CAnimationSetManager::~CAnimationSetManager(void)
+{
+	Exit();
+}
+
+/**
+@brief Delete all the animation sets
+*/
+void CAnimationSetManager::Exit(void)
+{
+	for (std::map<std::string, CAnimationSet*>::iterator it = animationSetMap.begin(); it != animationSetMap.end(); ++it)
+	{
+		delete it->second;
+	}
+	animationSetMap.clear();
+}
+
+/**
+@brief Add a fully built animation set
+@param _name The name of the animation set, usually the type of sprite which uses it
+@param cAnimationSet The animation set, which is deleted by this class
+@return The animation set which is stored under this name
+*/
+const CAnimationSet* CAnimationSetManager::Add(const std::string& _name, CAnimationSet* cAnimationSet)
+{
+	std::map<std::string, CAnimationSet*>::iterator it = animationSetMap.find(_name);
+	if (it != animationSetMap.end())
+	{
+		cout << "CAnimationSetManager::Add() : " << _name << " already exists, so the new set is discarded" << endl;
+		delete cAnimationSet;
+		return it->second;
+	}
+
+	animationSetMap[_name] = cAnimationSet;
+	return cAnimationSet;
+}
+
+/**
+@brief Get an animation set
+@param _name The name of the animation set
+@return The animation set, or NULL if it has not been added yet
+*/
+const CAnimationSet* CAnimationSetManager::Get(const std::string& _name) const
+{
+	std::map<std::string, CAnimationSet*>::const_iterator it = animationSetMap.find(_name);
+	if (it == animationSetMap.end())
+		return NULL;
+	return it->second;
+}
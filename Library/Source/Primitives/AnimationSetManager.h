@@ -0,0 +1,37 @@
+/**
+ CAnimationSetManager
+ @brief This class owns the CAnimationSets which are shared by the sprites of each type,
+		so that the animation clips are defined once instead of once per sprite.
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "..\DesignPatterns\SingletonTemplate.h"
+
+#include "SpriteAnimation.h"
+
+#include <map>
+#include <string>
+
+class CAnimationSetManager : public CSingletonTemplate<CAnimationSetManager>
+{
+	friend CSingletonTemplate<CAnimationSetManager>;
+public:
+	// Delete all the animation sets
+	void Exit(void);
+
+	// Add a fully built animation set. This class takes ownership of it, and it is not changed afterwards
+	const CAnimationSet* Add(const std::string& _name, CAnimationSet* cAnimationSet);
+	// Get an animation set, or NULL if it has not been added yet
+	const CAnimationSet* Get(const std::string& _name) const;
+
+protected:
+	// Constructor
+	CAnimationSetManager(void);
+
+	// Destructor
+	virtual ~CAnimationSetManager(void);
+
+	// The animation sets with their names
+	std::map<std::string, CAnimationSet*> animationSetMap;
+};
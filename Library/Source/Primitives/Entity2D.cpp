@@ -8,6 +8,8 @@
 
  // Include Shader Manager
 #include "..\RenderControl\ShaderManager.h"
+// Include Render State
+#include "..\RenderControl\RenderState.h"
 
 // Include ImageLoader
 #include "..\System\ImageLoader.h"
@@ -25,6 +27,7 @@ CEntity2D::CEntity2D(void)
 	, iTextureID(0)
 	, cSettings(NULL)
 	, mesh(NULL)
+	, cShader(NULL)
 {
 	transform = glm::mat4(1.0f);	// make sure to initialize matrix to identity matrix first
 
@@ -78,8 +81,6 @@ bool CEntity2D::Init(void)
 		1, 2, 3  // second triangle
 	};*/
 
-	glGenVertexArrays(1, &VAO);
-	glBindVertexArray(VAO);
 	//glGenBuffers(1, &VBO);
 	//glGenBuffers(1, &EBO);
 
@@ -119,6 +120,7 @@ bool CEntity2D::Init(void)
  void CEntity2D::SetShader(const std::string& _name)
  {
 	 this->sShaderName = _name;
+	 this->cShader = CShaderManager::GetInstance()->Get(_name);
  }
 
 /**
@@ -134,11 +136,11 @@ void CEntity2D::Update(const double dElapsedTime)
 void CEntity2D::PreRender(void)
 {
 	// bind textures on corresponding texture units
-	glActiveTexture(GL_TEXTURE0);
+	CRenderState::GetInstance()->ActiveTexture(GL_TEXTURE0);
 
 	// Activate blending mode
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	CRenderState::GetInstance()->SetBlend(true);
+	CRenderState::GetInstance()->BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 	// Activate the shader
 	CShaderManager::GetInstance()->Use("Shader2D");
@@ -149,50 +151,51 @@ void CEntity2D::PreRender(void)
  */
 void CEntity2D::Render(void)
 {
-	// get matrix's uniform location and set matrix
-	unsigned int transformLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "transform");
-	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
+	// get the active shader and its uniform handles
+	CShader* cActiveShader = UpdateUniformHandles();
 
 	transform = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
 	transform = glm::translate(transform, glm::vec3(vec2UVCoordinate.x,
 													vec2UVCoordinate.y,
 													0.0f));
-	// Update the shaders with the latest transform
-	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
+	// Update the shaders with the latest transform. This is drawn in screen space
+	cActiveShader->set(uniformViewProjection, glm::mat4(1.0f));
+	cActiveShader->set(uniformTransform, transform);
+	// Draw the whole texture without a tint, as the render queue may have left a sprite frame and colour set
+	cActiveShader->set(uniformRuntimeColour, glm::vec4(1.0f));
+	cActiveShader->set(uniformSpriteGrid, glm::vec2(1.0f));
+	cActiveShader->set(uniformSpriteFrame, 0);
 
 	// Get the texture to be rendered
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, iTextureID);
-		glBindVertexArray(VAO);
-
+	CRenderState::GetInstance()->ActiveTexture(GL_TEXTURE0);
+	CRenderState::GetInstance()->BindTexture2D(iTextureID);
 		//CS: Use mesh to render
 		mesh->Render();
-
-		glBindVertexArray(0);
-	glBindTexture(GL_TEXTURE_2D, 0);
+	CRenderState::GetInstance()->BindTexture2D(0);
 }
 
 void CEntity2D::Render(const glm::mat4& view, const glm::mat4& projection)
 {
-	// get matrix's uniform location and set matrix
-	unsigned int transformLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "transform");
+	// get the active shader and its uniform handles
+	CShader* cActiveShader = UpdateUniformHandles();
 	transform = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
 	transform = glm::translate(transform, glm::vec3(vec2UVCoordinate.x,
 		vec2UVCoordinate.y,
 		0.0f));
 	// Update the shaders with the latest transform
-	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(projection * view * transform));
+	cActiveShader->set(uniformViewProjection, projection * view);
+	cActiveShader->set(uniformTransform, transform);
+	// Draw the whole texture without a tint, as the render queue may have left a sprite frame and colour set
+	cActiveShader->set(uniformRuntimeColour, glm::vec4(1.0f));
+	cActiveShader->set(uniformSpriteGrid, glm::vec2(1.0f));
+	cActiveShader->set(uniformSpriteFrame, 0);
 
 	// Get the texture to be rendered
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, iTextureID);
-	glBindVertexArray(VAO);
-
+	CRenderState::GetInstance()->ActiveTexture(GL_TEXTURE0);
+	CRenderState::GetInstance()->BindTexture2D(iTextureID);
 	//CS: Use mesh to render
 	mesh->Render();
-
-	glBindVertexArray(0);
-	glBindTexture(GL_TEXTURE_2D, 0);
+	CRenderState::GetInstance()->BindTexture2D(0);
 }
 
 /**
@@ -201,7 +204,25 @@ void CEntity2D::Render(const glm::mat4& view, const glm::mat4& projection)
 void CEntity2D::PostRender(void)
 {
 	// Disable blending
-	glDisable(GL_BLEND);
+	CRenderState::GetInstance()->SetBlend(false);
+}
+
+/**
+ @brief Fetch the uniform handles again if the active shader has changed since the last call
+ @return The active shader
+ */
+CShader* CEntity2D::UpdateUniformHandles(void)
+{
+	CShader* cActiveShader = CShaderManager::GetInstance()->activeShader;
+	if (!uniformTransform.IsFor(cActiveShader))
+	{
+		uniformViewProjection = cActiveShader->getUniform<glm::mat4>("viewProjection");
+		uniformTransform = cActiveShader->getUniform<glm::mat4>("transform");
+		uniformRuntimeColour = cActiveShader->getUniform<glm::vec4>("runtimeColour");
+		uniformSpriteGrid = cActiveShader->getUniform<glm::vec2>("spriteGrid");
+		uniformSpriteFrame = cActiveShader->getUniform<int>("spriteFrame");
+	}
+	return cActiveShader;
 }
 
 void CEntity2D::SetHitBox(bool yes)
@@ -22,6 +22,9 @@
 
 //CS: Include Mesh.h to use to draw (include vertex and index buffers)
 #include "Mesh.h"
+
+// Include Shader for the uniform handles
+#include "..\RenderControl\Shader.h"
 using namespace std;
 
 class CEntity2D
@@ -73,6 +76,8 @@ public:
 protected:
 	// Name of Shader Program instance
 	std::string sShaderName;
+	// The Shader Program instance, which is looked up once in SetShader()
+	CShader* cShader;
 
 	//CS: The mesh that is used to draw objects
 	CMesh* mesh;
@@ -86,6 +91,16 @@ protected:
 	// A transformation matrix for controlling where to render the entities
 	glm::mat4 transform;
 
+	// Handles to the uniforms of the shader which this entity was last rendered with
+	CShader::Uniform<glm::mat4> uniformViewProjection;
+	CShader::Uniform<glm::mat4> uniformTransform;
+	CShader::Uniform<glm::vec4> uniformRuntimeColour;
+	CShader::Uniform<glm::vec2> uniformSpriteGrid;
+	CShader::Uniform<int> uniformSpriteFrame;
+
+	// Fetch the uniform handles again if the active shader has changed
+	CShader* UpdateUniformHandles(void);
+
 	// Settings
 	CSettings* cSettings;
 
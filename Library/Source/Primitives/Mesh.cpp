@@ -6,14 +6,18 @@
 #define GLEW_STATIC
 #endif
 
+// Include Render State
+#include "..\RenderControl\RenderState.h"
+
 /**
  @brief Constructor
  */
 CMesh::CMesh(void)
 	: mode(DRAW_TRIANGLES)
 {
-	glGenBuffers(1, &vertexBuffer);
-	glGenBuffers(1, &indexBuffer);
+	vertexArray = CRenderState::GetInstance()->GenVertexArray();
+	vertexBuffer = CRenderState::GetInstance()->GenBuffer();
+	indexBuffer = CRenderState::GetInstance()->GenBuffer();
 }
 
 /**
@@ -21,8 +25,29 @@ CMesh::CMesh(void)
  */
 CMesh::~CMesh(void)
 {
-	glDeleteBuffers(1, &vertexBuffer);
-	glDeleteBuffers(1, &indexBuffer);
+	CRenderState::GetInstance()->DeleteVertexArray(vertexArray);
+	CRenderState::GetInstance()->DeleteBuffer(vertexBuffer);
+	CRenderState::GetInstance()->DeleteBuffer(indexBuffer);
+}
+
+/**
+ @brief Record the vertex layout and buffers into the vertex array object.
+		This is called once by CMeshBuilder, after the buffers are filled.
+ */
+void CMesh::SetupVertexArray(void)
+{
+	CRenderState* cRenderState = CRenderState::GetInstance();
+	cRenderState->BindVertexArray(vertexArray);
+
+	cRenderState->BindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+	cRenderState->VertexAttribPointer(0, 3, GL_FLOAT, sizeof(Vertex), 0);
+	cRenderState->VertexAttribPointer(1, 4, GL_FLOAT, sizeof(Vertex), sizeof(glm::vec3));
+	cRenderState->VertexAttribPointer(2, 2, GL_FLOAT, sizeof(Vertex), sizeof(glm::vec3) + sizeof(glm::vec4));
+
+	// The element buffer binding is stored in the vertex array object
+	cRenderState->BindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+
+	cRenderState->BindVertexArray(0);
 }
 
 /**
@@ -30,25 +55,13 @@ CMesh::~CMesh(void)
  */
 void CMesh::Render(void)
 {
-	glEnableVertexAttribArray(0);
-	glEnableVertexAttribArray(1);
-	glEnableVertexAttribArray(2);
-
-	glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
-	glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)sizeof(glm::vec3));
-	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(sizeof(glm::vec3) + sizeof(glm::vec4)));
-	
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+	CRenderState* cRenderState = CRenderState::GetInstance();
+	cRenderState->BindVertexArray(vertexArray);
 
 	if (mode == DRAW_LINES)
-		glDrawElements(GL_LINES, indexSize, GL_UNSIGNED_INT, 0);
+		cRenderState->DrawElements(GL_LINES, indexSize, GL_UNSIGNED_INT, 0);
 	else if (mode == DRAW_TRIANGLE_STRIP)
-		glDrawElements(GL_TRIANGLE_STRIP, indexSize, GL_UNSIGNED_INT, 0);
+		cRenderState->DrawElements(GL_TRIANGLE_STRIP, indexSize, GL_UNSIGNED_INT, 0);
 	else
-		glDrawElements(GL_TRIANGLES, indexSize, GL_UNSIGNED_INT, 0);
-
-	glDisableVertexAttribArray(2);
-	glDisableVertexAttribArray(1);
-	glDisableVertexAttribArray(0);
+		cRenderState->DrawElements(GL_TRIANGLES, indexSize, GL_UNSIGNED_INT, 0);
 }
\ No newline at end of file
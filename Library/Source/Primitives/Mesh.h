@@ -42,6 +42,7 @@ public:
 		DRAW_MODE_LAST,
 	};
 
+	unsigned vertexArray;
 	unsigned vertexBuffer;
 	unsigned indexBuffer;
 	unsigned indexSize;
@@ -51,7 +52,9 @@ public:
 	// Constructor
 	CMesh(void);
 	// Destructor
-	~CMesh(void);
+	virtual ~CMesh(void);
+	// Record the vertex layout and buffers into the vertex array object
+	void SetupVertexArray(void);
 	virtual void Render();
 };
 
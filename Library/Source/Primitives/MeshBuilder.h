@@ -10,12 +10,10 @@
 #define MESH_BUILDER_H
 
 #include "Mesh.h"
-#include "SpriteAnimation.h"
 
 class CMeshBuilder
 {
 	public:
-		static CSpriteAnimation* GenerateSpriteAnimation(unsigned numRow, unsigned numCol, float tile_width = 1.0f, float tile_height = 1.0f);
 		static CMesh* GenerateQuad(glm::vec4 color = glm::vec4(1,1,1,1), float width = 1.0f, float height = 1.0f);
 
 		static CMesh* GenerateQuadWithPosition(	const glm::vec4 color = glm::vec4(1, 1, 1, 1), 
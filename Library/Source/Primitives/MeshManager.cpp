@@ -0,0 +1,48 @@
+/**
+ CMeshManager
+ @brief This class owns the meshes which are shared by many entities, so that each
+		entity does not create its own copy of the same vertex data.
+ */
+#include "MeshManager.h"
+
+// Include MeshBuilder
+#include "MeshBuilder.h"
+
+/**
+@brief Constructor
+*/
+CMeshManager::CMeshManager(void)
+	: cUnitQuad(NULL)
+{
+}
+
+/**
+@brief Destructor
+*/
+CMeshManager::~CMeshManager(void)
+{
+	Exit();
+}
+
+/**
+@brief Delete all the shared meshes
+*/
+void CMeshManager::Exit(void)
+{
+	if (cUnitQuad)
+	{
+		delete cUnitQuad;
+		cUnitQuad = NULL;
+	}
+}
+
+/**
+@brief Get a 1 x 1 quad centred on the origin, which is created on the first call
+@return The shared unit quad
+*/
+CMesh* CMeshManager::GetUnitQuad(void)
+{
+	if (cUnitQuad == NULL)
+		cUnitQuad = CMeshBuilder::GenerateQuad(glm::vec4(1, 1, 1, 1), 1.0f, 1.0f);
+	return cUnitQuad;
+}
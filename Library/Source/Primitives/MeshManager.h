@@ -0,0 +1,32 @@
+/**
+ CMeshManager
+ @brief This class owns the meshes which are shared by many entities, so that each
+		entity does not create its own copy of the same vertex data.
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "..\DesignPatterns\SingletonTemplate.h"
+
+#include "Mesh.h"
+
+class CMeshManager : public CSingletonTemplate<CMeshManager>
+{
+	friend CSingletonTemplate<CMeshManager>;
+public:
+	// Delete all the shared meshes. This must be called while the OpenGL context exists
+	void Exit(void);
+
+	// Get a 1 x 1 quad centred on the origin. Scale it with the model transform
+	CMesh* GetUnitQuad(void);
+
+protected:
+	// Constructor
+	CMeshManager(void);
+
+	// Destructor
+	virtual ~CMeshManager(void);
+
+	// The shared unit quad
+	CMesh* cUnitQuad;
+};
@@ -8,22 +8,188 @@ Sprite Animation
 */
 /******************************************************************************/
 #include "SpriteAnimation.h"
-#include "GL\glew.h"
 
 /******************************************************************************/
 /*!
 \brief
 Constructor
+
+param row - the number of rows in the sprite sheet
+
+param col - the number of columns in the sprite sheet
 */
 /******************************************************************************/
-CSpriteAnimation::CSpriteAnimation(int row, int col)
-	: CMesh()
-	, row(row)
+CAnimationSet::CAnimationSet(int row, int col)
+	: row(row)
 	, col(col)
+{
+}
+
+/******************************************************************************/
+/*!
+\brief
+Destructor
+*/
+/******************************************************************************/
+CAnimationSet::~CAnimationSet()
+{
+	//Remove everything
+	animations.clear();
+	animationIDs.clear();
+}
+
+/******************************************************************************/
+/*!
+\brief
+Add an animation to the Animation Set by defining the start and the end
+
+param anim_name - the name of the animation
+
+param start - the starting frame based on the sprite sheet
+
+param end - the ending frame based on the sprite sheet
+
+\exception None
+\return The ID of the animation
+*/
+/******************************************************************************/
+int CAnimationSet::AddAnimation(std::string anim_name, int start, int end)
+{
+	CAnimation anim;
+
+	//Check if start is more than end
+	//Swap over if it is
+	if(start > end)
+		std::swap(start, end);
+
+	//Add in all the frames in the range
+	for (int i = start; i <= end; ++i)
+	{
+		anim.AddFrame(i);
+	}
+
+	//Link the animation to the animation list
+	animations.push_back(anim);
+	animationIDs[anim_name] = animations.size() - 1;
+	return animations.size() - 1;
+}
+
+/******************************************************************************/
+/*!
+\brief
+Add an animation to the Animation Set by defining the frame values
+
+param anim_name - the name of the animation
+
+param count - the number of frame in the animation
+
+param ... - the frames
+
+\exception None
+\return The ID of the animation
+*/
+/******************************************************************************/
+int CAnimationSet::AddSequeneAnimation(std::string anim_name, int count ...)
+{
+	CAnimation anim;
+
+	va_list args;
+	va_start(args, count);
+	//Add the frames based on the input
+	for (int i = 0; i < count; ++i)
+	{
+		int value = va_arg(args, int);
+		anim.AddFrame(value);
+	}
+	va_end(args);
+
+	//Link the animation to the animation list
+	animations.push_back(anim);
+	animationIDs[anim_name] = animations.size() - 1;
+	return animations.size() - 1;
+}
+
+/******************************************************************************/
+/*!
+\brief
+Get the ID of an animation by its name
+
+param anim_name - the name of the animation
+
+\exception None
+\return The ID of the animation, or -1 if there is no animation with this name
+*/
+/******************************************************************************/
+int CAnimationSet::GetAnimationID(const std::string& anim_name) const
+{
+	std::unordered_map<std::string, int>::const_iterator it = animationIDs.find(anim_name);
+	if (it == animationIDs.end())
+		return -1;
+	return it->second;
+}
+
+/******************************************************************************/
+/*!
+\brief
+Get the number of animations in this Animation Set
+
+\exception None
+\return The number of animations
+*/
+/******************************************************************************/
+int CAnimationSet::GetNumAnimations() const
+{
+	return animations.size();
+}
+
+/******************************************************************************/
+/*!
+\brief
+Get an animation by its ID
+
+param id - the ID of the animation, which must be valid
+
+\exception None
+\return The animation
+*/
+/******************************************************************************/
+const CAnimation& CAnimationSet::GetAnimation(int id) const
+{
+	return animations[id];
+}
+
+/******************************************************************************/
+/*!
+\brief
+Get the layout of the sprite sheet
+
+\exception None
+\return The number of columns and rows in the sprite sheet
+*/
+/******************************************************************************/
+glm::vec2 CAnimationSet::GetSpriteGrid() const
+{
+	return glm::vec2(col, row);
+}
+
+/******************************************************************************/
+/*!
+\brief
+Constructor
+
+param animationSet - the shared animations which this sprite plays
+*/
+/******************************************************************************/
+CSpriteAnimation::CSpriteAnimation(const CAnimationSet* animationSet)
+	: animationSet(animationSet)
 	, currentTime(0)
+	, animTime(0)
 	, currentFrame(0)
 	, playCount(0)
-	, currentAnimation("")
+	, repeatCount(0)
+	, currentAnimation(0)
+	, animActive(false)
+	, ended(false)
 {
 }
 
@@ -35,17 +201,8 @@ Destructor
 /******************************************************************************/
 CSpriteAnimation::~CSpriteAnimation()
 {
-	//Loop through the animation list
-	for (auto iter = animationList.begin(); iter != animationList.end(); ++iter)
-	{
-		if (iter->second != NULL)
-		{
-			//delete the animation
-			delete iter->second;
-		}
-	}
-	//Remove everything
-	animationList.clear();
+	//We won't delete this since it is shared
+	animationSet = NULL;
 }
 
 /******************************************************************************/
@@ -62,42 +219,44 @@ param dt - the delta time
 void CSpriteAnimation::Update(double dt)
 {
 	//Check if the current animation is active
-	if (animationList[currentAnimation]->animActive)
+	if (animActive)
 	{
+		const CAnimation& animation = animationSet->GetAnimation(currentAnimation);
+
 		//Add the delta time
 		currentTime += static_cast<float>(dt);
 
 		//Get the number of frame to get the frame per second
-		int numFrame = animationList[currentAnimation]->frames.size();
-		float frameTime = animationList[currentAnimation]->animTime / numFrame;
+		int numFrame = animation.frames.size();
+		float frameTime = animTime / numFrame;
 
 		//Set the current frame based on the current time
-		currentFrame = animationList[currentAnimation]->frames[fmin((int)animationList[currentAnimation]->frames.size() - 1 , static_cast<int>(currentTime / frameTime))];
+		currentFrame = animation.frames[fmin(numFrame - 1, static_cast<int>(currentTime / frameTime))];
 
 		//check if the current time is more than the total animated time
-		if (currentTime >= animationList[currentAnimation]->animTime)
+		if (currentTime >= animTime)
 		{
 			//if it is less than the repeat count, increase the count and repeat
-			if (playCount < animationList[currentAnimation]->repeatCount)
+			if (playCount < repeatCount)
 			{
 				++playCount;
 				currentTime = 0;
-				currentFrame = animationList[currentAnimation]->frames[0];
+				currentFrame = animation.frames[0];
 			}
 			//if we repeat count is 0 or we have reach same number of play count
 			else
 			{
-				animationList[currentAnimation]->animActive = false;
-				animationList[currentAnimation]->ended = true;
+				animActive = false;
+				ended = true;
 			}
 
 			//If the animaton is infinite
-			if (animationList[currentAnimation]->repeatCount == -1)
+			if (repeatCount == -1)
 			{
 				currentTime = 0.f;
-				currentFrame = animationList[currentAnimation]->frames[0];
-				animationList[currentAnimation]->animActive = true;
-				animationList[currentAnimation]->ended = false;
+				currentFrame = animation.frames[0];
+				animActive = true;
+				ended = false;
 			}
 		}
 	}
@@ -106,125 +265,38 @@ void CSpriteAnimation::Update(double dt)
 /******************************************************************************/
 /*!
 \brief
-Render the Sprite Animation
-
-param None
-
-\exception None
-\return None
-*/
-/******************************************************************************/
-void CSpriteAnimation::Render()
-{
-	glEnableVertexAttribArray(0);
-	glEnableVertexAttribArray(1);
-	glEnableVertexAttribArray(2);
-
-	glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
-	glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)sizeof(glm::vec3));
-	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(sizeof(glm::vec3) + sizeof(glm::vec4)));
-
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
-
-	//Draw based on the current frame
-	if (mode == DRAW_LINES)
-		glDrawElements(GL_LINES, 6, GL_UNSIGNED_INT, (void*)(currentFrame * 6 * sizeof(GLuint)));
-	else if (mode == DRAW_TRIANGLE_STRIP)
-		glDrawElements(GL_TRIANGLE_STRIP, 6, GL_UNSIGNED_INT, (void*)(currentFrame * 6 * sizeof(GLuint)));
-	else
-		glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, (void*)(currentFrame * 6 * sizeof(GLuint)));
-
-	glDisableVertexAttribArray(2);
-	glDisableVertexAttribArray(1);
-	glDisableVertexAttribArray(0);
-}
-
-/******************************************************************************/
-/*!
-\brief
-Add an animation to the Sprite Animation by defining the start and the end
-
-param anim_name - the name of the animation
-
-param start - the starting frame based on the sprite sheet
-
-param end - the ending frame based on the sprite sheet
+Get the current frame of the current animation. The vertex shader uses it with
+the sprite grid to compute the UVs of this frame
 
 \exception None
-\return None
+\return The current frame, counted from the top left of the sprite sheet
 */
 /******************************************************************************/
-void CSpriteAnimation::AddAnimation(std::string anim_name, int start, int end)
+int CSpriteAnimation::GetCurrentFrame() const
 {
-	CAnimation* anim = new CAnimation();
-
-	//Check if start is more than end
-	//Swap over if it is
-	if(start > end)
-		std::swap(start, end);
-
-	//Add in all the frames in the range
-	for (int i = start; i <= end; ++i)
-	{
-		anim->AddFrame(i);
-	}
-
-	//Link the animation to the animation list
-	animationList[anim_name] = anim;
-	//Set the current animation if it does not exisit
-	if (currentAnimation == "")
-	{
-		currentAnimation = anim_name;
-	}
-	animationList[anim_name]->animActive = false;
+	return currentFrame;
 }
 
 /******************************************************************************/
 /*!
 \brief
-Add an animation to the Sprite Animation by defining the frame values
-
-param anim_name - the name of the animation
-
-param count - the number of frame in the animation
-
-param ... - the frames
+Get the layout of the sprite sheet
 
 \exception None
-\return None
+\return The number of columns and rows in the sprite sheet
 */
 /******************************************************************************/
-void CSpriteAnimation::AddSequeneAnimation(std::string anim_name, int count ...)
+glm::vec2 CSpriteAnimation::GetSpriteGrid() const
 {
-	CAnimation* anim = new CAnimation();
-
-	va_list args;
-	va_start(args, count);
-	//Add the frames based on the input
-	for (int i = 0; i < count; ++i)
-	{
-		int value = va_arg(args, int);
-		anim->AddFrame(value);
-	}
-	va_end(args);
-
-	//Link the animation to the animation list
-	animationList[anim_name] = anim;
-	//Set the current animation if it does not exisit
-	if (currentAnimation == "")
-	{
-		currentAnimation = anim_name;
-	}
-	animationList[anim_name]->animActive = false;
+	return animationSet->GetSpriteGrid();
 }
 
 /******************************************************************************/
 /*!
 \brief
-Play the animation based on the given name
+Play the animation based on the given ID
 
-param anim_name - the name of the animation
+param id - the ID of the animation in the Animation Set
 
 param repeat - the number of repeats (-1 for infinite looping)
 
@@ -234,18 +306,20 @@ param time - the total time of the animation
 \return None
 */
 /******************************************************************************/
-void CSpriteAnimation::PlayAnimation(std::string anim_name, int repeat, float time)
+void CSpriteAnimation::PlayAnimation(int id, int repeat, float time)
 {
+	//Check if the ID exist 
+	if ((id < 0) || (id >= animationSet->GetNumAnimations()))
+		return;
+
 	// Reset the playCount if the animation is changing
-	if (currentAnimation != anim_name)
+	if (currentAnimation != id)
 		playCount = 0;
 
-	//Check if the anim name exist 
-	if (animationList[anim_name] != nullptr)
-	{
-		currentAnimation = anim_name;
-		animationList[anim_name]->Set(repeat, time, true);
-	}
+	currentAnimation = id;
+	repeatCount = repeat;
+	animTime = time;
+	animActive = true;
 }
 
 /******************************************************************************/
@@ -259,7 +333,7 @@ Resume the current animation if it is Paused
 /******************************************************************************/
 void CSpriteAnimation::Resume()
 {
-	animationList[currentAnimation]->animActive = true;
+	animActive = true;
 }
 
 /******************************************************************************/
@@ -273,7 +347,7 @@ Pause the current animation
 /******************************************************************************/
 void CSpriteAnimation::Pause()
 {
-	animationList[currentAnimation]->animActive = false;
+	animActive = false;
 }
 
 /******************************************************************************/
@@ -287,6 +361,7 @@ Reset the current animation
 /******************************************************************************/
 void CSpriteAnimation::Reset()
 {
-	currentFrame = animationList[currentAnimation]->frames[0];
+	if (animationSet->GetNumAnimations() > 0)
+		currentFrame = animationSet->GetAnimation(currentAnimation).frames[0];
 	playCount = 0;
-}
\ No newline at end of file
+}
@@ -5,95 +5,110 @@
 \par	email: 
 \brief
 Sprite Animation that hold different classes 
--Animation Class - Managed frames and name of the animation
--Sprite Animation - Managed various animations of the sprite  
+-Animation Class - Managed frames of the animation
+-Animation Set - Managed the named animations shared by one type of sprite
+-Sprite Animation - Managed the playback of the animations of one sprite  
+The sprite sheet geometry is not owned by this class. Only the current frame
+is tracked here, and the UVs of that frame are computed in the vertex shader,
+so an animated sprite allocates no OpenGL buffers.
 */
 /******************************************************************************/
 #pragma once
-#include "Mesh.h"
+#include <includes/glm.hpp>
 #include <vector>
 #include <string>
 #include <unordered_map>
 #include <stdarg.h>
 #include <math.h>
 
+//An animation clip. It only holds the frames, as the playback state is kept
+//by each CSpriteAnimation which plays it
 struct CAnimation
 {
-	//Constructor
-	CAnimation():repeatCount(0),
-		animTime(0.0f),
-		ended(false),
-		animActive(false)
-	{
-	}
-
-	//repeat count, total animation time, 
-	void Set(int repeat, float time, bool active)
-	{
-		this->repeatCount = repeat;
-		this->animTime = time;
-		this->animActive = active;
-	}
-
 	//Adding frames to the frame vector
 	void AddFrame(int i)
 	{
 		frames.push_back(i);
 	}
 
-private:
-	//name of the animation
-	std::string animationName;
-
 	//The frames
 	std::vector<int> frames;
+};
 
-	//How many times to repeat
-	int repeatCount;
-	//The animation time
-	float animTime;
-	//Has the animation ended
-	bool ended;
-	//Is the animation active
-	bool animActive;
+//The animation clips of one type of sprite. It is built once, and then shared
+//by all the sprites of that type without being changed
+class CAnimationSet
+{
+public:
+	CAnimationSet(int row, int col);
+	~CAnimationSet();
+
+	//Add the clips. Each returns the ID of the new clip, which are given out in order from 0
+	int AddAnimation(std::string name, int start, int end);
+	int AddSequeneAnimation(std::string name, int count ...);
+
+	//Get the ID of a clip by its name. This hashes the name, so call it only while setting up
+	int GetAnimationID(const std::string& name) const;
+	//Get the number of clips
+	int GetNumAnimations() const;
+	//Get a clip by its ID
+	const CAnimation& GetAnimation(int id) const;
 
-	//Allow the Sprite Animation class to use private variable
-	friend class CSpriteAnimation;
+	//Get the layout of the sprite sheet as (columns, rows)
+	glm::vec2 GetSpriteGrid() const;
+
+private:
+	//number of rows
+	int row;
+	//number of columns 
+	int col;
+
+	//The clips, indexed by their ID
+	std::vector<CAnimation> animations;
+	//The IDs of the clips with their names
+	std::unordered_map<std::string, int> animationIDs;
 };
 
-//Sprite Animation that derives from Mesh for rendering
-class CSpriteAnimation : public CMesh
+//Sprite Animation which plays the clips of a shared CAnimationSet. It only keeps
+//the playback state, so switching clips does no hashing and no allocation
+class CSpriteAnimation
 {
 public:
-	CSpriteAnimation(int row, int col);
+	CSpriteAnimation(const CAnimationSet* animationSet);
 	~CSpriteAnimation();
 
 	//Update the animated sprite
 	void Update(double dt);
-	virtual void Render();
 
-	void AddAnimation(std::string name, int start, int end);
-	void AddSequeneAnimation(std::string name, int count ...);
-	void PlayAnimation(std::string name, int repeat, float time);
+	//Get the current frame, counted from the top left of the sprite sheet
+	int GetCurrentFrame() const;
+	//Get the layout of the sprite sheet as (columns, rows)
+	glm::vec2 GetSpriteGrid() const;
+
+	void PlayAnimation(int id, int repeat, float time);
 	void Pause();
 	void Resume();
 	void Reset();
 
 private:
-	//number of rows
-	int row;
-	//number of columns 
-	int col;
+	//The shared clips
+	const CAnimationSet* animationSet;
 
 	//the current time of the animation
 	float currentTime;
+	//The animation time
+	float animTime;
 	//the current frame of the animation
 	int currentFrame;
 	//How many time it has play
 	int playCount;
+	//How many times to repeat
+	int repeatCount;
 
-	//The name of the current animation
-	std::string currentAnimation;
-	//The list of the animations with their names
-	std::unordered_map<std::string, CAnimation*> animationList;
+	//The ID of the current animation
+	int currentAnimation;
+	//Is the animation active
+	bool animActive;
+	//Has the animation ended
+	bool ended;
 };
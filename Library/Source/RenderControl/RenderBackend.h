@@ -0,0 +1,94 @@
+/**
+ CRenderBackend
+ @brief The interface for the graphics API calls which are made while loading and rendering.
+		CRenderState sends all of its calls to a backend, so the game can be rendered with
+		OpenGL by CRenderBackendGL, or without a GPU by CRenderBackendNull.
+ */
+#pragma once
+
+// Include GLEW
+#ifndef GLEW_STATIC
+#include <GL/glew.h>
+#define GLEW_STATIC
+#endif
+
+#include <string>
+#include <vector>
+
+class CRenderBackend
+{
+public:
+	// An active uniform of a linked program
+	struct SUniformInfo
+	{
+		std::string sName;
+		GLint iLocation;
+		GLenum eType;
+	};
+
+	// Destructor
+	virtual ~CRenderBackend(void) {}
+
+	// Get the name of this backend, for the reports
+	virtual const char* GetName(void) const = 0;
+
+	// Pipeline state
+	virtual void UseProgram(const GLuint uiProgram) = 0;
+	virtual void BindVertexArray(const GLuint uiVAO) = 0;
+	virtual void ActiveTexture(const GLenum eUnit) = 0;
+	virtual void BindTexture2D(const GLuint uiTextureID) = 0;
+	virtual void SetEnabled(const GLenum eCapability, const bool bEnable) = 0;
+	virtual void BlendFunc(const GLenum eSrcFactor, const GLenum eDstFactor) = 0;
+	virtual void BindBuffer(const GLenum eTarget, const GLuint uiBuffer) = 0;
+	virtual void BindFramebuffer(const GLuint uiFramebuffer) = 0;
+	virtual void Viewport(const GLint iX, const GLint iY, const GLsizei iWidth, const GLsizei iHeight) = 0;
+	virtual void Scissor(const GLint iX, const GLint iY, const GLsizei iWidth, const GLsizei iHeight) = 0;
+	virtual void ClearColor(const GLfloat fRed, const GLfloat fGreen, const GLfloat fBlue, const GLfloat fAlpha) = 0;
+	virtual void PixelStore(const GLenum eName, const GLint iValue) = 0;
+
+	// Drawing
+	virtual void Clear(const GLbitfield uiMask) = 0;
+	virtual void DrawElements(const GLenum eMode, const GLsizei iCount, const GLenum eType, const void* pIndices) = 0;
+
+	// Buffers and vertex arrays
+	virtual GLuint GenBuffer(void) = 0;
+	virtual void DeleteBuffer(const GLuint uiBuffer) = 0;
+	virtual void BufferData(const GLenum eTarget, const GLsizeiptr iSize, const void* pData, const GLenum eUsage) = 0;
+	virtual void* MapBufferRange(const GLenum eTarget, const GLintptr iOffset, const GLsizeiptr iLength, const GLbitfield uiAccess) = 0;
+	virtual bool UnmapBuffer(const GLenum eTarget) = 0;
+	virtual GLuint GenVertexArray(void) = 0;
+	virtual void DeleteVertexArray(const GLuint uiVAO) = 0;
+	// Enable a vertex attribute and set its layout in the bound array buffer
+	virtual void VertexAttribPointer(const GLuint uiIndex, const GLint iSize, const GLenum eType, const GLsizei iStride, const size_t uiOffset) = 0;
+
+	// Textures and framebuffers
+	virtual GLuint GenTexture(void) = 0;
+	virtual void DeleteTexture(const GLuint uiTextureID) = 0;
+	virtual void TexImage2D(const GLint iLevel, const GLint iInternalFormat, const GLsizei iWidth, const GLsizei iHeight,
+							const GLenum eFormat, const GLenum eType, const void* pPixels) = 0;
+	virtual void TexParameter(const GLenum eName, const GLint iValue) = 0;
+	virtual void GenerateMipmap(void) = 0;
+	virtual GLint GetMaxTextureSize(void) = 0;
+	virtual GLuint GenFramebuffer(void) = 0;
+	virtual void DeleteFramebuffer(const GLuint uiFramebuffer) = 0;
+	// Attach a texture as the colour buffer of the bound framebuffer, and check if it is complete
+	virtual GLenum AttachFramebufferTexture(const GLuint uiTextureID) = 0;
+
+	// Shaders
+	// Compile and link a program. The geometry shader is optional
+	virtual GLuint CreateProgram(const char* pcVertexCode, const char* pcFragmentCode, const char* pcGeometryCode) = 0;
+	virtual void DeleteProgram(const GLuint uiProgram) = 0;
+	// Get the active uniforms of a linked program which have a location
+	virtual void GetActiveUniforms(const GLuint uiProgram, std::vector<SUniformInfo>& uniforms) = 0;
+	// Upload a uniform of the bound program. eType is the type of the value, e.g. GL_FLOAT_VEC2
+	virtual void Uniform(const GLint iLocation, const GLenum eType, const void* pValue) = 0;
+
+	// Queries
+	virtual GLuint GenQuery(void) = 0;
+	virtual void DeleteQuery(const GLuint uiQuery) = 0;
+	// Start and end a query, e.g. GL_TIME_ELAPSED. Only one query of a target can be active
+	virtual void BeginQuery(const GLenum eTarget, const GLuint uiQuery) = 0;
+	virtual void EndQuery(const GLenum eTarget) = 0;
+	// Get the result of a query without waiting for it. Returns false if it is not available yet
+	virtual bool GetQueryResult(const GLuint uiQuery, GLuint64& ullResult) = 0;
+};
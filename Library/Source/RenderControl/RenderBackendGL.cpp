@@ -0,0 +1,401 @@
+/**
+ CRenderBackendGL
+ @brief The render backend which sends the calls to OpenGL
+ */
+#include "RenderBackendGL.h"
+
+#include <iostream>
+using namespace std;
+
+/**
+@brief Constructor
+*/
+CRenderBackendGL::CRenderBackendGL(void)
+{
+}
+
+/**
+@brief Destructor
+*/
+CRenderBackendGL::~CRenderBackendGL(void)
+{
+}
+
+/**
+@brief Get the name of this backend
+*/
+const char* CRenderBackendGL::GetName(void) const
+{
+	return "OpenGL";
+}
+
+void CRenderBackendGL::UseProgram(const GLuint uiProgram)
+{
+	glUseProgram(uiProgram);
+}
+
+void CRenderBackendGL::BindVertexArray(const GLuint uiVAO)
+{
+	glBindVertexArray(uiVAO);
+}
+
+void CRenderBackendGL::ActiveTexture(const GLenum eUnit)
+{
+	glActiveTexture(eUnit);
+}
+
+void CRenderBackendGL::BindTexture2D(const GLuint uiTextureID)
+{
+	glBindTexture(GL_TEXTURE_2D, uiTextureID);
+}
+
+void CRenderBackendGL::SetEnabled(const GLenum eCapability, const bool bEnable)
+{
+	if (bEnable)
+		glEnable(eCapability);
+	else
+		glDisable(eCapability);
+}
+
+void CRenderBackendGL::BlendFunc(const GLenum eSrcFactor, const GLenum eDstFactor)
+{
+	glBlendFunc(eSrcFactor, eDstFactor);
+}
+
+void CRenderBackendGL::BindBuffer(const GLenum eTarget, const GLuint uiBuffer)
+{
+	glBindBuffer(eTarget, uiBuffer);
+}
+
+void CRenderBackendGL::BindFramebuffer(const GLuint uiFramebuffer)
+{
+	glBindFramebuffer(GL_FRAMEBUFFER, uiFramebuffer);
+}
+
+void CRenderBackendGL::Viewport(const GLint iX, const GLint iY, const GLsizei iWidth, const GLsizei iHeight)
+{
+	glViewport(iX, iY, iWidth, iHeight);
+}
+
+void CRenderBackendGL::Scissor(const GLint iX, const GLint iY, const GLsizei iWidth, const GLsizei iHeight)
+{
+	glScissor(iX, iY, iWidth, iHeight);
+}
+
+void CRenderBackendGL::ClearColor(const GLfloat fRed, const GLfloat fGreen, const GLfloat fBlue, const GLfloat fAlpha)
+{
+	glClearColor(fRed, fGreen, fBlue, fAlpha);
+}
+
+void CRenderBackendGL::PixelStore(const GLenum eName, const GLint iValue)
+{
+	glPixelStorei(eName, iValue);
+}
+
+void CRenderBackendGL::Clear(const GLbitfield uiMask)
+{
+	glClear(uiMask);
+}
+
+void CRenderBackendGL::DrawElements(const GLenum eMode, const GLsizei iCount, const GLenum eType, const void* pIndices)
+{
+	glDrawElements(eMode, iCount, eType, pIndices);
+}
+
+GLuint CRenderBackendGL::GenBuffer(void)
+{
+	GLuint uiBuffer = 0;
+	glGenBuffers(1, &uiBuffer);
+	return uiBuffer;
+}
+
+void CRenderBackendGL::DeleteBuffer(const GLuint uiBuffer)
+{
+	glDeleteBuffers(1, &uiBuffer);
+}
+
+void CRenderBackendGL::BufferData(const GLenum eTarget, const GLsizeiptr iSize, const void* pData, const GLenum eUsage)
+{
+	glBufferData(eTarget, iSize, pData, eUsage);
+}
+
+void* CRenderBackendGL::MapBufferRange(const GLenum eTarget, const GLintptr iOffset, const GLsizeiptr iLength, const GLbitfield uiAccess)
+{
+	return glMapBufferRange(eTarget, iOffset, iLength, uiAccess);
+}
+
+bool CRenderBackendGL::UnmapBuffer(const GLenum eTarget)
+{
+	return glUnmapBuffer(eTarget) == GL_TRUE;
+}
+
+GLuint CRenderBackendGL::GenVertexArray(void)
+{
+	GLuint uiVAO = 0;
+	glGenVertexArrays(1, &uiVAO);
+	return uiVAO;
+}
+
+void CRenderBackendGL::DeleteVertexArray(const GLuint uiVAO)
+{
+	glDeleteVertexArrays(1, &uiVAO);
+}
+
+void CRenderBackendGL::VertexAttribPointer(const GLuint uiIndex, const GLint iSize, const GLenum eType, const GLsizei iStride, const size_t uiOffset)
+{
+	glEnableVertexAttribArray(uiIndex);
+	glVertexAttribPointer(uiIndex, iSize, eType, GL_FALSE, iStride, (void*)uiOffset);
+}
+
+GLuint CRenderBackendGL::GenTexture(void)
+{
+	GLuint uiTextureID = 0;
+	glGenTextures(1, &uiTextureID);
+	return uiTextureID;
+}
+
+void CRenderBackendGL::DeleteTexture(const GLuint uiTextureID)
+{
+	glDeleteTextures(1, &uiTextureID);
+}
+
+void CRenderBackendGL::TexImage2D(const GLint iLevel, const GLint iInternalFormat, const GLsizei iWidth, const GLsizei iHeight,
+								const GLenum eFormat, const GLenum eType, const void* pPixels)
+{
+	glTexImage2D(GL_TEXTURE_2D, iLevel, iInternalFormat, iWidth, iHeight, 0, eFormat, eType, pPixels);
+}
+
+void CRenderBackendGL::TexParameter(const GLenum eName, const GLint iValue)
+{
+	glTexParameteri(GL_TEXTURE_2D, eName, iValue);
+}
+
+void CRenderBackendGL::GenerateMipmap(void)
+{
+	glGenerateMipmap(GL_TEXTURE_2D);
+}
+
+GLint CRenderBackendGL::GetMaxTextureSize(void)
+{
+	GLint iMaxTextureSize = 0;
+	glGetIntegerv(GL_MAX_TEXTURE_SIZE, &iMaxTextureSize);
+	return iMaxTextureSize;
+}
+
+GLuint CRenderBackendGL::GenFramebuffer(void)
+{
+	GLuint uiFramebuffer = 0;
+	glGenFramebuffers(1, &uiFramebuffer);
+	return uiFramebuffer;
+}
+
+void CRenderBackendGL::DeleteFramebuffer(const GLuint uiFramebuffer)
+{
+	glDeleteFramebuffers(1, &uiFramebuffer);
+}
+
+GLenum CRenderBackendGL::AttachFramebufferTexture(const GLuint uiTextureID)
+{
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, uiTextureID, 0);
+	return glCheckFramebufferStatus(GL_FRAMEBUFFER);
+}
+
+/**
+@brief Compile and link a program
+@param pcVertexCode The source of the vertex shader
+@param pcFragmentCode The source of the fragment shader
+@param pcGeometryCode The source of the geometry shader, or nullptr if there is none
+@return The ID of the program
+*/
+GLuint CRenderBackendGL::CreateProgram(const char* pcVertexCode, const char* pcFragmentCode, const char* pcGeometryCode)
+{
+	GLuint uiVertex = CompileShader(GL_VERTEX_SHADER, pcVertexCode, "VERTEX");
+	GLuint uiFragment = CompileShader(GL_FRAGMENT_SHADER, pcFragmentCode, "FRAGMENT");
+	GLuint uiGeometry = 0;
+	if (pcGeometryCode != nullptr)
+		uiGeometry = CompileShader(GL_GEOMETRY_SHADER, pcGeometryCode, "GEOMETRY");
+
+	GLuint uiProgram = glCreateProgram();
+	glAttachShader(uiProgram, uiVertex);
+	glAttachShader(uiProgram, uiFragment);
+	if (pcGeometryCode != nullptr)
+		glAttachShader(uiProgram, uiGeometry);
+	glLinkProgram(uiProgram);
+	CheckCompileErrors(uiProgram, "PROGRAM");
+
+	// Delete the shaders as they're linked into our program now and no longer necessary
+	glDeleteShader(uiVertex);
+	glDeleteShader(uiFragment);
+	if (pcGeometryCode != nullptr)
+		glDeleteShader(uiGeometry);
+
+	return uiProgram;
+}
+
+void CRenderBackendGL::DeleteProgram(const GLuint uiProgram)
+{
+	glDeleteProgram(uiProgram);
+}
+
+/**
+@brief Get the active uniforms of a linked program which have a location
+@param uiProgram The program
+@param uniforms The list to store the uniforms in. Arrays are stored under their plain names
+*/
+void CRenderBackendGL::GetActiveUniforms(const GLuint uiProgram, std::vector<SUniformInfo>& uniforms)
+{
+	GLint iNumUniforms = 0, iMaxNameLength = 0;
+	glGetProgramiv(uiProgram, GL_ACTIVE_UNIFORMS, &iNumUniforms);
+	glGetProgramiv(uiProgram, GL_ACTIVE_UNIFORM_MAX_LENGTH, &iMaxNameLength);
+	if (iNumUniforms <= 0)
+		return;
+
+	std::vector<GLchar> nameBuffer(iMaxNameLength + 1);
+	uniforms.reserve(uniforms.size() + iNumUniforms);
+	for (GLint i = 0; i < iNumUniforms; i++)
+	{
+		GLsizei iLength = 0;
+		GLint iArraySize = 0;
+		GLenum eType = 0;
+		glGetActiveUniform(uiProgram, (GLuint)i, (GLsizei)nameBuffer.size(), &iLength, &iArraySize, &eType, &nameBuffer[0]);
+		std::string sName(&nameBuffer[0], iLength);
+		// Arrays are reported as "name[0]"
+		if ((sName.size() > 3) && (sName.compare(sName.size() - 3, 3, "[0]") == 0))
+			sName.erase(sName.size() - 3);
+
+		// Uniforms inside uniform blocks have no location
+		GLint iLocation = glGetUniformLocation(uiProgram, sName.c_str());
+		if (iLocation < 0)
+			continue;
+
+		SUniformInfo sUniform;
+		sUniform.sName = sName;
+		sUniform.iLocation = iLocation;
+		sUniform.eType = eType;
+		uniforms.push_back(sUniform);
+	}
+}
+
+/**
+@brief Upload a uniform of the bound program
+@param iLocation The location of the uniform
+@param eType The type of the value
+@param pValue The value
+*/
+void CRenderBackendGL::Uniform(const GLint iLocation, const GLenum eType, const void* pValue)
+{
+	switch (eType)
+	{
+	case GL_INT:
+	case GL_BOOL:
+		glUniform1iv(iLocation, 1, (const GLint*)pValue);
+		break;
+	case GL_FLOAT:
+		glUniform1fv(iLocation, 1, (const GLfloat*)pValue);
+		break;
+	case GL_FLOAT_VEC2:
+		glUniform2fv(iLocation, 1, (const GLfloat*)pValue);
+		break;
+	case GL_FLOAT_VEC3:
+		glUniform3fv(iLocation, 1, (const GLfloat*)pValue);
+		break;
+	case GL_FLOAT_VEC4:
+		glUniform4fv(iLocation, 1, (const GLfloat*)pValue);
+		break;
+	case GL_FLOAT_MAT2:
+		glUniformMatrix2fv(iLocation, 1, GL_FALSE, (const GLfloat*)pValue);
+		break;
+	case GL_FLOAT_MAT3:
+		glUniformMatrix3fv(iLocation, 1, GL_FALSE, (const GLfloat*)pValue);
+		break;
+	case GL_FLOAT_MAT4:
+		glUniformMatrix4fv(iLocation, 1, GL_FALSE, (const GLfloat*)pValue);
+		break;
+	default:
+		cout << "CRenderBackendGL::Uniform() : Unsupported uniform type 0x" << hex << eType << dec << endl;
+		break;
+	}
+}
+
+/**
+@brief Compile a shader
+@param eType The type of the shader, e.g. GL_VERTEX_SHADER
+@param pcCode The source of the shader
+@param pcTypeName The name of the type, for the error messages
+@return The ID of the shader
+*/
+GLuint CRenderBackendGL::CompileShader(const GLenum eType, const char* pcCode, const char* pcTypeName)
+{
+	GLuint uiShader = glCreateShader(eType);
+	glShaderSource(uiShader, 1, &pcCode, NULL);
+	glCompileShader(uiShader);
+	CheckCompileErrors(uiShader, pcTypeName);
+	return uiShader;
+}
+
+/**
+@brief Print the errors of a shader or program which failed to compile or link
+@param uiShader The ID of the shader, or of the program if sType is "PROGRAM"
+@param sType The type of the shader, or "PROGRAM"
+*/
+void CRenderBackendGL::CheckCompileErrors(const GLuint uiShader, const std::string& sType)
+{
+	GLint success;
+	GLchar infoLog[1024];
+	if (sType != "PROGRAM")
+	{
+		glGetShaderiv(uiShader, GL_COMPILE_STATUS, &success);
+		if (!success)
+		{
+			glGetShaderInfoLog(uiShader, 1024, NULL, infoLog);
+			cout << "ERROR::SHADER_COMPILATION_ERROR of type: " << sType << "\n" << infoLog << "\n -- --------------------------------------------------- -- " << endl;
+		}
+	}
+	else
+	{
+		glGetProgramiv(uiShader, GL_LINK_STATUS, &success);
+		if (!success)
+		{
+			glGetProgramInfoLog(uiShader, 1024, NULL, infoLog);
+			cout << "ERROR::PROGRAM_LINKING_ERROR of type: " << sType << "\n" << infoLog << "\n -- --------------------------------------------------- -- " << endl;
+		}
+	}
+}
+
+GLuint CRenderBackendGL::GenQuery(void)
+{
+	GLuint uiQuery = 0;
+	glGenQueries(1, &uiQuery);
+	return uiQuery;
+}
+
+void CRenderBackendGL::DeleteQuery(const GLuint uiQuery)
+{
+	glDeleteQueries(1, &uiQuery);
+}
+
+void CRenderBackendGL::BeginQuery(const GLenum eTarget, const GLuint uiQuery)
+{
+	glBeginQuery(eTarget, uiQuery);
+}
+
+void CRenderBackendGL::EndQuery(const GLenum eTarget)
+{
+	glEndQuery(eTarget);
+}
+
+/**
+@brief Get the result of a query if the GPU has finished it, so that reading it never stalls
+@param uiQuery The query
+@param ullResult The result, e.g. the elapsed time in nanoseconds for GL_TIME_ELAPSED
+@return true if the result is available, otherwise false
+*/
+bool CRenderBackendGL::GetQueryResult(const GLuint uiQuery, GLuint64& ullResult)
+{
+	GLint iAvailable = 0;
+	glGetQueryObjectiv(uiQuery, GL_QUERY_RESULT_AVAILABLE, &iAvailable);
+	if (iAvailable == 0)
+		return false;
+	glGetQueryObjectui64v(uiQuery, GL_QUERY_RESULT, &ullResult);
+	return true;
+}
@@ -0,0 +1,80 @@
+/**
+ CRenderBackendGL
+ @brief The render backend which sends the calls to OpenGL
+ */
+#pragma once
+
+// Include the render backend interface
+#include "RenderBackend.h"
+
+class CRenderBackendGL : public CRenderBackend
+{
+public:
+	// Constructor
+	CRenderBackendGL(void);
+
+	// Destructor
+	virtual ~CRenderBackendGL(void);
+
+	// Get the name of this backend
+	virtual const char* GetName(void) const;
+
+	// Pipeline state
+	virtual void UseProgram(const GLuint uiProgram);
+	virtual void BindVertexArray(const GLuint uiVAO);
+	virtual void ActiveTexture(const GLenum eUnit);
+	virtual void BindTexture2D(const GLuint uiTextureID);
+	virtual void SetEnabled(const GLenum eCapability, const bool bEnable);
+	virtual void BlendFunc(const GLenum eSrcFactor, const GLenum eDstFactor);
+	virtual void BindBuffer(const GLenum eTarget, const GLuint uiBuffer);
+	virtual void BindFramebuffer(const GLuint uiFramebuffer);
+	virtual void Viewport(const GLint iX, const GLint iY, const GLsizei iWidth, const GLsizei iHeight);
+	virtual void Scissor(const GLint iX, const GLint iY, const GLsizei iWidth, const GLsizei iHeight);
+	virtual void ClearColor(const GLfloat fRed, const GLfloat fGreen, const GLfloat fBlue, const GLfloat fAlpha);
+	virtual void PixelStore(const GLenum eName, const GLint iValue);
+
+	// Drawing
+	virtual void Clear(const GLbitfield uiMask);
+	virtual void DrawElements(const GLenum eMode, const GLsizei iCount, const GLenum eType, const void* pIndices);
+
+	// Buffers and vertex arrays
+	virtual GLuint GenBuffer(void);
+	virtual void DeleteBuffer(const GLuint uiBuffer);
+	virtual void BufferData(const GLenum eTarget, const GLsizeiptr iSize, const void* pData, const GLenum eUsage);
+	virtual void* MapBufferRange(const GLenum eTarget, const GLintptr iOffset, const GLsizeiptr iLength, const GLbitfield uiAccess);
+	virtual bool UnmapBuffer(const GLenum eTarget);
+	virtual GLuint GenVertexArray(void);
+	virtual void DeleteVertexArray(const GLuint uiVAO);
+	virtual void VertexAttribPointer(const GLuint uiIndex, const GLint iSize, const GLenum eType, const GLsizei iStride, const size_t uiOffset);
+
+	// Textures and framebuffers
+	virtual GLuint GenTexture(void);
+	virtual void DeleteTexture(const GLuint uiTextureID);
+	virtual void TexImage2D(const GLint iLevel, const GLint iInternalFormat, const GLsizei iWidth, const GLsizei iHeight,
+							const GLenum eFormat, const GLenum eType, const void* pPixels);
+	virtual void TexParameter(const GLenum eName, const GLint iValue);
+	virtual void GenerateMipmap(void);
+	virtual GLint GetMaxTextureSize(void);
+	virtual GLuint GenFramebuffer(void);
+	virtual void DeleteFramebuffer(const GLuint uiFramebuffer);
+	virtual GLenum AttachFramebufferTexture(const GLuint uiTextureID);
+
+	// Shaders
+	virtual GLuint CreateProgram(const char* pcVertexCode, const char* pcFragmentCode, const char* pcGeometryCode);
+	virtual void DeleteProgram(const GLuint uiProgram);
+	virtual void GetActiveUniforms(const GLuint uiProgram, std::vector<SUniformInfo>& uniforms);
+	virtual void Uniform(const GLint iLocation, const GLenum eType, const void* pValue);
+
+	// Queries
+	virtual GLuint GenQuery(void);
+	virtual void DeleteQuery(const GLuint uiQuery);
+	virtual void BeginQuery(const GLenum eTarget, const GLuint uiQuery);
+	virtual void EndQuery(const GLenum eTarget);
+	virtual bool GetQueryResult(const GLuint uiQuery, GLuint64& ullResult);
+
+protected:
+	// Compile a shader, and print its errors if it fails
+	GLuint CompileShader(const GLenum eType, const char* pcCode, const char* pcTypeName);
+	// Print the errors of a shader or program which failed to compile or link
+	void CheckCompileErrors(const GLuint uiShader, const std::string& sType);
+};
@@ -0,0 +1,200 @@
+/**
+ CRenderBackendNull
+ @brief A render backend which needs no GPU or OpenGL context. It drops the draw calls
+		and state changes, and hands out IDs for the resources, so that the CPU cost and
+		the number of calls which are submitted through CRenderState can be measured headless.
+		The uniforms of a program are read from the "uniform" declarations in its sources.
+ */
+#include "RenderBackendNull.h"
+
+#include <sstream>
+
+/**
+@brief Constructor
+*/
+CRenderBackendNull::CRenderBackendNull(void)
+	: uiNextID(1)
+{
+}
+
+/**
+@brief Destructor
+*/
+CRenderBackendNull::~CRenderBackendNull(void)
+{
+	programUniforms.clear();
+}
+
+/**
+@brief Get the name of this backend
+*/
+const char* CRenderBackendNull::GetName(void) const
+{
+	return "Null";
+}
+
+GLuint CRenderBackendNull::GenBuffer(void)
+{
+	return uiNextID++;
+}
+
+/**
+@brief Map a buffer into memory which is thrown away when it is unmapped,
+		so that the copy into the buffer is still measured
+*/
+void* CRenderBackendNull::MapBufferRange(const GLenum eTarget, const GLintptr iOffset, const GLsizeiptr iLength, const GLbitfield uiAccess)
+{
+	if (iLength <= 0)
+		return NULL;
+	if (mappedBuffer.size() < (size_t)iLength)
+		mappedBuffer.resize((size_t)iLength);
+	return &mappedBuffer[0];
+}
+
+bool CRenderBackendNull::UnmapBuffer(const GLenum eTarget)
+{
+	return true;
+}
+
+GLuint CRenderBackendNull::GenVertexArray(void)
+{
+	return uiNextID++;
+}
+
+GLuint CRenderBackendNull::GenTexture(void)
+{
+	return uiNextID++;
+}
+
+/**
+@brief Get the maximum size of a texture, which is the size of a typical desktop GPU
+*/
+GLint CRenderBackendNull::GetMaxTextureSize(void)
+{
+	return 16384;
+}
+
+GLuint CRenderBackendNull::GenFramebuffer(void)
+{
+	return uiNextID++;
+}
+
+GLenum CRenderBackendNull::AttachFramebufferTexture(const GLuint uiTextureID)
+{
+	return GL_FRAMEBUFFER_COMPLETE;
+}
+
+/**
+@brief Create a program, and store the uniforms which are declared in its sources
+@param pcVertexCode The source of the vertex shader
+@param pcFragmentCode The source of the fragment shader
+@param pcGeometryCode The source of the geometry shader, or nullptr if there is none
+@return The ID of the program
+*/
+GLuint CRenderBackendNull::CreateProgram(const char* pcVertexCode, const char* pcFragmentCode, const char* pcGeometryCode)
+{
+	GLuint uiProgram = uiNextID++;
+	std::vector<SUniformInfo>& uniforms = programUniforms[uiProgram];
+	ParseUniforms(pcVertexCode, uniforms);
+	ParseUniforms(pcFragmentCode, uniforms);
+	if (pcGeometryCode != nullptr)
+		ParseUniforms(pcGeometryCode, uniforms);
+	return uiProgram;
+}
+
+GLuint CRenderBackendNull::GenQuery(void)
+{
+	return uiNextID++;
+}
+
+/**
+@brief Get the result of a query, which is always available and 0 as nothing is drawn
+*/
+bool CRenderBackendNull::GetQueryResult(const GLuint uiQuery, GLuint64& ullResult)
+{
+	ullResult = 0;
+	return true;
+}
+
+void CRenderBackendNull::DeleteProgram(const GLuint uiProgram)
+{
+	programUniforms.erase(uiProgram);
+}
+
+/**
+@brief Get the uniforms which were declared in the sources of a program
+*/
+void CRenderBackendNull::GetActiveUniforms(const GLuint uiProgram, std::vector<SUniformInfo>& uniforms)
+{
+	std::map<GLuint, std::vector<SUniformInfo>>::const_iterator it = programUniforms.find(uiProgram);
+	if (it != programUniforms.end())
+		uniforms.insert(uniforms.end(), it->second.begin(), it->second.end());
+}
+
+/**
+@brief Add the uniforms which are declared in a shader source, such as "uniform mat4 transform;".
+		Unlike OpenGL, uniforms which are declared but not used are also added
+@param pcCode The source of the shader
+@param uniforms The list of uniforms of the program
+*/
+void CRenderBackendNull::ParseUniforms(const char* pcCode, std::vector<SUniformInfo>& uniforms)
+{
+	if (pcCode == nullptr)
+		return;
+
+	std::istringstream codeStream(pcCode);
+	std::string sToken;
+	while (codeStream >> sToken)
+	{
+		if (sToken != "uniform")
+			continue;
+
+		std::string sType, sName;
+		codeStream >> sType;
+		if ((sType == "lowp") || (sType == "mediump") || (sType == "highp"))
+			codeStream >> sType;
+		codeStream >> sName;
+
+		// Remove the array size and the semicolon from the name
+		size_t uiEnd = sName.find_first_of("[;");
+		if (uiEnd != std::string::npos)
+			sName.erase(uiEnd);
+
+		GLenum eType = 0;
+		if (sType == "int") eType = GL_INT;
+		else if (sType == "bool") eType = GL_BOOL;
+		else if (sType == "float") eType = GL_FLOAT;
+		else if (sType == "vec2") eType = GL_FLOAT_VEC2;
+		else if (sType == "vec3") eType = GL_FLOAT_VEC3;
+		else if (sType == "vec4") eType = GL_FLOAT_VEC4;
+		else if (sType == "mat2") eType = GL_FLOAT_MAT2;
+		else if (sType == "mat3") eType = GL_FLOAT_MAT3;
+		else if (sType == "mat4") eType = GL_FLOAT_MAT4;
+		else if (sType == "sampler2D") eType = GL_SAMPLER_2D;
+		else if (sType == "sampler3D") eType = GL_SAMPLER_3D;
+		else if (sType == "samplerCube") eType = GL_SAMPLER_CUBE;
+		else if (sType == "sampler2DArray") eType = GL_SAMPLER_2D_ARRAY;
+		// Uniform blocks and other types are not uploaded through CShader
+		if ((eType == 0) || (sName.empty()))
+			continue;
+
+		// A uniform which is shared by the vertex and fragment shaders has one location
+		bool bFound = false;
+		for (unsigned int i = 0; i < uniforms.size(); i++)
+		{
+			if (uniforms[i].sName == sName)
+			{
+				bFound = true;
+				break;
+			}
+		}
+		if (bFound)
+			continue;
+
+		SUniformInfo sUniform;
+		sUniform.sName = sName;
+		sUniform.iLocation = (GLint)uniforms.size();
+		sUniform.eType = eType;
+		uniforms.push_back(sUniform);
+	}
+}
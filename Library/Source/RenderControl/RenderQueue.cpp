@@ -0,0 +1,188 @@
+/**
+ CRenderQueue
+ @brief This class collects the draw commands of a frame, sorts them by layer, shader
+		and texture, and then issues them with as few state changes as possible.
+ */
+#include "RenderQueue.h"
+
+// Include Render State
+#include "RenderState.h"
+// Include ShaderManager
+#include "ShaderManager.h"
+// Include Mesh
+#include "..\Primitives\Mesh.h"
+// Include CProfiler for the profiler zones
+#include "..\TimeControl\Profiler.h"
+
+#include <algorithm>
+
+/**
+@brief Constructor
+*/
+CRenderQueue::CRenderQueue(void)
+	: viewProjection(1.0f)
+	, uiNumCommands(0)
+	, uiNumShaderChanges(0)
+{
+}
+
+/**
+@brief Destructor
+*/
+CRenderQueue::~CRenderQueue(void)
+{
+	commands.clear();
+	sortedCommands.clear();
+	shaderUniforms.clear();
+}
+
+/**
+@brief Start a new frame
+@param viewProjection The view-projection matrix which is uploaded once per shader for this frame
+*/
+void CRenderQueue::Begin(const glm::mat4& viewProjection)
+{
+	this->viewProjection = viewProjection;
+	commands.clear();
+	uiNumCommands = 0;
+	uiNumShaderChanges = 0;
+}
+
+/**
+@brief Submit a command to draw a mesh
+@param eLayer The layer of this command. Lower layers are drawn first
+@param cShader The shader to draw with
+@param uiTextureID The texture to bind to texture unit 0
+@param cMesh The mesh to render, which binds its own vertex array object
+@param transform The model transform of this mesh
+@param runtimeColour The colour to tint this mesh with, if the shader supports it
+@param iSpriteFrame The frame of the sprite sheet to draw, counted from the top left
+@param spriteGrid The layout of the sprite sheet as (columns, rows). A plain texture is 1 x 1
+*/
+void CRenderQueue::Submit(	const LAYER eLayer,
+							CShader* cShader,
+							const GLuint uiTextureID,
+							CMesh* cMesh,
+							const glm::mat4& transform,
+							const glm::vec4& runtimeColour,
+							const int iSpriteFrame,
+							const glm::vec2& spriteGrid)
+{
+	if ((cShader == nullptr) || (cMesh == nullptr))
+		return;
+
+	// The sort key is layer | shader | texture, and the submission order keeps it stable
+	unsigned long long ullShader = GetShaderIndex(cShader) & 0xFF;
+	unsigned long long ullTexture = uiTextureID & 0xFFFF;
+	unsigned long long ullOrder = commands.size() & 0xFFFFFFFF;
+
+	SDrawCommand sCommand;
+	sCommand.ullSortKey = ((unsigned long long)eLayer << 56) | (ullShader << 48) | (ullTexture << 32) | ullOrder;
+	sCommand.cShader = cShader;
+	sCommand.uiTextureID = uiTextureID;
+	sCommand.cMesh = cMesh;
+	sCommand.transform = transform;
+	sCommand.runtimeColour = runtimeColour;
+	sCommand.spriteGrid = spriteGrid;
+	sCommand.iSpriteFrame = iSpriteFrame;
+	commands.push_back(sCommand);
+}
+
+/**
+@brief Sort and issue all the submitted commands, then empty the queue.
+		It can be flushed more than once in a frame, e.g. to time the layers apart
+*/
+void CRenderQueue::Flush(void)
+{
+	PROFILE_FUNCTION();
+
+	uiNumCommands += commands.size();
+	if (commands.empty())
+		return;
+
+	// Sort the keys instead of the commands, as the commands are much larger
+	sortedCommands.clear();
+	sortedCommands.reserve(commands.size());
+	for (unsigned int i = 0; i < commands.size(); i++)
+		sortedCommands.push_back(std::make_pair(commands[i].ullSortKey, i));
+	std::sort(sortedCommands.begin(), sortedCommands.end());
+
+	CRenderState* cRenderState = CRenderState::GetInstance();
+	CShader* cActiveShader = CShaderManager::GetInstance()->activeShader;
+	cRenderState->SetBlend(true);
+	cRenderState->BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	cRenderState->ActiveTexture(GL_TEXTURE0);
+
+	SShaderUniforms* sUniforms = nullptr;
+	for (unsigned int i = 0; i < sortedCommands.size(); i++)
+	{
+		const SDrawCommand& sCommand = commands[sortedCommands[i].second];
+
+		if ((sUniforms == nullptr) || (sUniforms->cShader != sCommand.cShader))
+		{
+			sUniforms = &shaderUniforms[(sCommand.ullSortKey >> 48) & 0xFF];
+			cRenderState->UseProgram(sCommand.cShader->ID);
+			// The shader skips this upload if it already has this frame's matrix
+			sCommand.cShader->set(sUniforms->viewProjection, viewProjection);
+			uiNumShaderChanges++;
+		}
+
+		cRenderState->BindTexture2D(sCommand.uiTextureID);
+		sCommand.cShader->set(sUniforms->transform, sCommand.transform);
+		sCommand.cShader->set(sUniforms->runtimeColour, sCommand.runtimeColour);
+		// The vertex shader computes the UVs of the frame, so all sprites can share one quad
+		sCommand.cShader->set(sUniforms->spriteGrid, sCommand.spriteGrid);
+		sCommand.cShader->set(sUniforms->spriteFrame, sCommand.iSpriteFrame);
+		sCommand.cMesh->Render();
+	}
+
+	cRenderState->BindVertexArray(0);
+	cRenderState->BindTexture2D(0);
+	cRenderState->SetBlend(false);
+
+	// The queue binds programs directly, so bind the shader manager's active shader again
+	if (cActiveShader)
+		cRenderState->UseProgram(cActiveShader->ID);
+
+	commands.clear();
+}
+
+/**
+@brief Get the number of commands flushed in the last frame, over all its flushes
+*/
+unsigned int CRenderQueue::GetNumCommands(void) const
+{
+	return uiNumCommands;
+}
+
+/**
+@brief Get the number of shader changes in the last frame, over all its flushes
+*/
+unsigned int CRenderQueue::GetNumShaderChanges(void) const
+{
+	return uiNumShaderChanges;
+}
+
+/**
+@brief Get the index of a shader in shaderUniforms, adding it if it is new
+@param cShader The shader
+@return The index of the shader
+*/
+unsigned int CRenderQueue::GetShaderIndex(CShader* cShader)
+{
+	for (unsigned int i = 0; i < shaderUniforms.size(); i++)
+	{
+		if (shaderUniforms[i].cShader == cShader)
+			return i;
+	}
+
+	SShaderUniforms sUniforms;
+	sUniforms.cShader = cShader;
+	sUniforms.viewProjection = cShader->getUniform<glm::mat4>("viewProjection");
+	sUniforms.transform = cShader->getUniform<glm::mat4>("transform");
+	sUniforms.runtimeColour = cShader->getUniform<glm::vec4>("runtimeColour");
+	sUniforms.spriteGrid = cShader->getUniform<glm::vec2>("spriteGrid");
+	sUniforms.spriteFrame = cShader->getUniform<int>("spriteFrame");
+	shaderUniforms.push_back(sUniforms);
+	return shaderUniforms.size() - 1;
+}
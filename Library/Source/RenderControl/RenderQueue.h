@@ -0,0 +1,111 @@
+/**
+ CRenderQueue
+ @brief This class collects the draw commands of a frame, sorts them by layer, shader
+		and texture, and then issues them with as few state changes as possible.
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "..\DesignPatterns\SingletonTemplate.h"
+
+// Include GLEW
+#ifndef GLEW_STATIC
+#include <GL/glew.h>
+#define GLEW_STATIC
+#endif
+
+// Include GLM
+#include <includes/glm.hpp>
+
+// Include Shader
+#include "Shader.h"
+
+#include <vector>
+
+class CMesh;
+
+class CRenderQueue : public CSingletonTemplate<CRenderQueue>
+{
+	friend CSingletonTemplate<CRenderQueue>;
+public:
+	// The layers, drawn from first to last. Within a layer, commands are grouped by shader and texture
+	enum LAYER
+	{
+		LAYER_MAP = 0,
+		LAYER_ENEMY,
+		LAYER_MISC,
+		LAYER_TURRET,
+		LAYER_BULLET,
+		LAYER_PLAYER,
+		LAYER_NUM_TOTAL
+	};
+
+	// A draw command submitted by an entity
+	struct SDrawCommand
+	{
+		unsigned long long ullSortKey;
+		CShader* cShader;
+		GLuint uiTextureID;
+		CMesh* cMesh;
+		glm::mat4 transform;
+		glm::vec4 runtimeColour;
+		glm::vec2 spriteGrid;
+		int iSpriteFrame;
+	};
+
+	// Start a new frame with the view-projection matrix which is shared by all commands
+	void Begin(const glm::mat4& viewProjection);
+
+	// Submit a command to draw a mesh with a model transform, and optionally a frame of a sprite sheet
+	void Submit(const LAYER eLayer,
+				CShader* cShader,
+				const GLuint uiTextureID,
+				CMesh* cMesh,
+				const glm::mat4& transform,
+				const glm::vec4& runtimeColour = glm::vec4(1.0f),
+				const int iSpriteFrame = 0,
+				const glm::vec2& spriteGrid = glm::vec2(1.0f));
+
+	// Sort and issue all the submitted commands, then empty the queue. It can be flushed more than once in a frame
+	void Flush(void);
+
+	// Get the number of commands flushed in the last frame
+	unsigned int GetNumCommands(void) const;
+	// Get the number of shader changes in the last frame
+	unsigned int GetNumShaderChanges(void) const;
+
+protected:
+	// The uniform handles of a shader used by the queue
+	struct SShaderUniforms
+	{
+		CShader* cShader;
+		CShader::Uniform<glm::mat4> viewProjection;
+		CShader::Uniform<glm::mat4> transform;
+		CShader::Uniform<glm::vec4> runtimeColour;
+		CShader::Uniform<glm::vec2> spriteGrid;
+		CShader::Uniform<int> spriteFrame;
+	};
+
+	// Constructor
+	CRenderQueue(void);
+
+	// Destructor
+	virtual ~CRenderQueue(void);
+
+	// Get the index of a shader in shaderUniforms, adding it if it is new
+	unsigned int GetShaderIndex(CShader* cShader);
+
+	// The view-projection matrix of this frame
+	glm::mat4 viewProjection;
+
+	// The commands of this frame, and their sort keys paired with their index
+	std::vector<SDrawCommand> commands;
+	std::vector<std::pair<unsigned long long, unsigned int>> sortedCommands;
+
+	// The shaders seen by the queue, in the order which they were first used
+	std::vector<SShaderUniforms> shaderUniforms;
+
+	// Statistics for the last flush
+	unsigned int uiNumCommands;
+	unsigned int uiNumShaderChanges;
+};
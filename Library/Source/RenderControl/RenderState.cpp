@@ -0,0 +1,544 @@
+/**
+ CRenderState
+ @brief This class shadows the OpenGL state which is changed while rendering,
+		so that calls which would not change anything are not sent to the driver.
+ */
+#include "RenderState.h"
+
+// Include the OpenGL render backend, which is used unless another backend is set
+#include "RenderBackendGL.h"
+
+#include <cstring>
+
+/**
+ @brief Get the number of bytes in a pixel of a texture upload
+ @param eFormat The format of the pixels, e.g. GL_RGBA
+ @param eType The type of each channel, e.g. GL_UNSIGNED_BYTE
+ */
+static unsigned int GetBytesPerPixel(const GLenum eFormat, const GLenum eType)
+{
+	unsigned int uiChannels = 4;
+	if ((eFormat == GL_RED) || (eFormat == GL_LUMINANCE) || (eFormat == GL_ALPHA))
+		uiChannels = 1;
+	else if ((eFormat == GL_RG) || (eFormat == GL_LUMINANCE_ALPHA))
+		uiChannels = 2;
+	else if (eFormat == GL_RGB)
+		uiChannels = 3;
+	return (eType == GL_FLOAT) ? uiChannels * 4 : uiChannels;
+}
+
+/**
+@brief Constructor
+*/
+CRenderState::CRenderState(void)
+	: cBackend(new CRenderBackendGL())
+	, uiNumTextures(0)
+{
+	memset(&sCurrentFrame, 0, sizeof(sCurrentFrame));
+	sLastFrame = sCurrentFrame;
+	memset(arrViewport, 0, sizeof(arrViewport));
+	memset(arrClearColour, 0, sizeof(arrClearColour));
+	Invalidate();
+}
+
+/**
+@brief Destructor
+*/
+CRenderState::~CRenderState(void)
+{
+	delete cBackend;
+	cBackend = nullptr;
+}
+
+/**
+@brief Set the backend which the calls are sent to. The resources which were created
+		with the previous backend cannot be used with the new one
+@param cBackend The backend. This class takes ownership of it
+*/
+void CRenderState::SetBackend(CRenderBackend* cBackend)
+{
+	if ((cBackend == nullptr) || (cBackend == this->cBackend))
+		return;
+	delete this->cBackend;
+	this->cBackend = cBackend;
+	Invalidate();
+}
+
+/**
+@brief Get the backend which the calls are sent to
+*/
+CRenderBackend* CRenderState::GetBackend(void) const
+{
+	return cBackend;
+}
+
+/**
+@brief Start a new frame: store the counters of the last frame and reset them.
+		The shadowed state is also forgotten, in case GL was changed outside this class.
+*/
+void CRenderState::BeginFrame(void)
+{
+	sLastFrame = sCurrentFrame;
+	memset(&sCurrentFrame, 0, sizeof(sCurrentFrame));
+	Invalidate();
+}
+
+/**
+@brief Forget the shadowed state, so that the next call of each kind is always issued
+*/
+void CRenderState::Invalidate(void)
+{
+	uiProgram = UNKNOWN;
+	uiVAO = UNKNOWN;
+	eActiveUnit = UNKNOWN;
+	for (unsigned int i = 0; i < NUM_TEXTURE_UNITS; i++)
+		arrTextures[i] = UNKNOWN;
+	uiBlend = UNKNOWN;
+	eBlendSrc = UNKNOWN;
+	eBlendDst = UNKNOWN;
+	uiScissorTest = UNKNOWN;
+	uiFramebuffer = UNKNOWN;
+}
+
+/**
+@brief Bind a shader program
+@param uiProgram The ID of the program
+*/
+void CRenderState::UseProgram(const GLuint uiProgram)
+{
+	if (this->uiProgram == uiProgram)
+	{
+		Count(false);
+		return;
+	}
+	this->uiProgram = uiProgram;
+	cBackend->UseProgram(uiProgram);
+	Count(true);
+}
+
+/**
+@brief Bind a vertex array object
+@param uiVAO The ID of the vertex array object
+*/
+void CRenderState::BindVertexArray(const GLuint uiVAO)
+{
+	if (this->uiVAO == uiVAO)
+	{
+		Count(false);
+		return;
+	}
+	this->uiVAO = uiVAO;
+	cBackend->BindVertexArray(uiVAO);
+	Count(true);
+}
+
+/**
+@brief Select the active texture unit
+@param eUnit The texture unit, from GL_TEXTURE0 onwards
+*/
+void CRenderState::ActiveTexture(const GLenum eUnit)
+{
+	if (eActiveUnit == eUnit)
+	{
+		Count(false);
+		return;
+	}
+	eActiveUnit = eUnit;
+	cBackend->ActiveTexture(eUnit);
+	Count(true);
+}
+
+/**
+@brief Bind a 2D texture to the active texture unit
+@param uiTextureID The ID of the texture
+*/
+void CRenderState::BindTexture2D(const GLuint uiTextureID)
+{
+	unsigned int uiUnit = eActiveUnit - GL_TEXTURE0;
+	if (uiUnit >= NUM_TEXTURE_UNITS)
+	{
+		// An unknown unit, or one beyond the shadowed range, is always issued
+		cBackend->BindTexture2D(uiTextureID);
+		sCurrentFrame.uiTextureBinds++;
+		Count(true);
+		return;
+	}
+	if (arrTextures[uiUnit] == uiTextureID)
+	{
+		Count(false);
+		return;
+	}
+	arrTextures[uiUnit] = uiTextureID;
+	cBackend->BindTexture2D(uiTextureID);
+	sCurrentFrame.uiTextureBinds++;
+	Count(true);
+}
+
+/**
+@brief Enable or disable blending
+@param bEnable true to enable blending
+*/
+void CRenderState::SetBlend(const bool bEnable)
+{
+	GLuint uiEnable = bEnable ? 1 : 0;
+	if (uiBlend == uiEnable)
+	{
+		Count(false);
+		return;
+	}
+	uiBlend = uiEnable;
+	cBackend->SetEnabled(GL_BLEND, bEnable);
+	Count(true);
+}
+
+/**
+@brief Set the blend function
+@param eSrcFactor The source blend factor
+@param eDstFactor The destination blend factor
+*/
+void CRenderState::BlendFunc(const GLenum eSrcFactor, const GLenum eDstFactor)
+{
+	if ((eBlendSrc == eSrcFactor) && (eBlendDst == eDstFactor))
+	{
+		Count(false);
+		return;
+	}
+	eBlendSrc = eSrcFactor;
+	eBlendDst = eDstFactor;
+	cBackend->BlendFunc(eSrcFactor, eDstFactor);
+	Count(true);
+}
+
+/**
+@brief Enable or disable the scissor test
+@param bEnable true to enable the scissor test
+*/
+void CRenderState::SetScissorTest(const bool bEnable)
+{
+	GLuint uiEnable = bEnable ? 1 : 0;
+	if (uiScissorTest == uiEnable)
+	{
+		Count(false);
+		return;
+	}
+	uiScissorTest = uiEnable;
+	cBackend->SetEnabled(GL_SCISSOR_TEST, bEnable);
+	Count(true);
+}
+
+/**
+@brief Bind a framebuffer
+@param uiFramebuffer The ID of the framebuffer, or 0 for the window
+*/
+void CRenderState::BindFramebuffer(const GLuint uiFramebuffer)
+{
+	if (this->uiFramebuffer == uiFramebuffer)
+	{
+		Count(false);
+		return;
+	}
+	this->uiFramebuffer = uiFramebuffer;
+	cBackend->BindFramebuffer(uiFramebuffer);
+	Count(true);
+}
+
+/**
+@brief Bind a buffer to a target. This is not shadowed, as the element array buffer binding
+		belongs to the bound vertex array object
+@param eTarget The target, e.g. GL_ARRAY_BUFFER
+@param uiBuffer The ID of the buffer
+*/
+void CRenderState::BindBuffer(const GLenum eTarget, const GLuint uiBuffer)
+{
+	cBackend->BindBuffer(eTarget, uiBuffer);
+	Count(true);
+}
+
+/**
+@brief Set the viewport
+*/
+void CRenderState::Viewport(const GLint iX, const GLint iY, const GLsizei iWidth, const GLsizei iHeight)
+{
+	arrViewport[0] = iX;
+	arrViewport[1] = iY;
+	arrViewport[2] = iWidth;
+	arrViewport[3] = iHeight;
+	cBackend->Viewport(iX, iY, iWidth, iHeight);
+	Count(true);
+}
+
+/**
+@brief Get the viewport which was set last
+@param iViewport The array to store the viewport in, as (x, y, width, height)
+*/
+void CRenderState::GetViewport(GLint iViewport[4]) const
+{
+	memcpy(iViewport, arrViewport, sizeof(arrViewport));
+}
+
+/**
+@brief Set the scissor box
+*/
+void CRenderState::Scissor(const GLint iX, const GLint iY, const GLsizei iWidth, const GLsizei iHeight)
+{
+	cBackend->Scissor(iX, iY, iWidth, iHeight);
+	Count(true);
+}
+
+/**
+@brief Set the clear colour
+*/
+void CRenderState::ClearColor(const GLfloat fRed, const GLfloat fGreen, const GLfloat fBlue, const GLfloat fAlpha)
+{
+	arrClearColour[0] = fRed;
+	arrClearColour[1] = fGreen;
+	arrClearColour[2] = fBlue;
+	arrClearColour[3] = fAlpha;
+	cBackend->ClearColor(fRed, fGreen, fBlue, fAlpha);
+	Count(true);
+}
+
+/**
+@brief Get the clear colour which was set last
+@param fClearColour The array to store the colour in
+*/
+void CRenderState::GetClearColor(GLfloat fClearColour[4]) const
+{
+	memcpy(fClearColour, arrClearColour, sizeof(arrClearColour));
+}
+
+/**
+@brief Set a pixel storage mode
+*/
+void CRenderState::PixelStore(const GLenum eName, const GLint iValue)
+{
+	cBackend->PixelStore(eName, iValue);
+	Count(true);
+}
+
+/**
+@brief Clear the buffers of the bound framebuffer
+@param uiMask The buffers to clear, e.g. GL_COLOR_BUFFER_BIT
+*/
+void CRenderState::Clear(const GLbitfield uiMask)
+{
+	cBackend->Clear(uiMask);
+	sCurrentFrame.uiClears++;
+}
+
+/**
+@brief Draw the indexed primitives of the bound vertex array object
+*/
+void CRenderState::DrawElements(const GLenum eMode, const GLsizei iCount, const GLenum eType, const void* pIndices)
+{
+	cBackend->DrawElements(eMode, iCount, eType, pIndices);
+	sCurrentFrame.uiDrawCalls++;
+	sCurrentFrame.uiNumIndices += iCount;
+}
+
+GLuint CRenderState::GenBuffer(void)
+{
+	return cBackend->GenBuffer();
+}
+
+void CRenderState::DeleteBuffer(const GLuint uiBuffer)
+{
+	cBackend->DeleteBuffer(uiBuffer);
+}
+
+/**
+@brief Create the storage of the buffer which is bound to a target, and upload data into it
+*/
+void CRenderState::BufferData(const GLenum eTarget, const GLsizeiptr iSize, const void* pData, const GLenum eUsage)
+{
+	cBackend->BufferData(eTarget, iSize, pData, eUsage);
+	if (pData != NULL)
+		sCurrentFrame.ullBufferBytes += iSize;
+}
+
+/**
+@brief Map a range of the buffer which is bound to a target. The mapped range is counted as uploaded
+*/
+void* CRenderState::MapBufferRange(const GLenum eTarget, const GLintptr iOffset, const GLsizeiptr iLength, const GLbitfield uiAccess)
+{
+	void* pMapped = cBackend->MapBufferRange(eTarget, iOffset, iLength, uiAccess);
+	if ((pMapped != NULL) && (uiAccess & GL_MAP_WRITE_BIT))
+		sCurrentFrame.ullBufferBytes += iLength;
+	return pMapped;
+}
+
+bool CRenderState::UnmapBuffer(const GLenum eTarget)
+{
+	return cBackend->UnmapBuffer(eTarget);
+}
+
+GLuint CRenderState::GenVertexArray(void)
+{
+	return cBackend->GenVertexArray();
+}
+
+/**
+@brief Delete a vertex array object. It is unbound first if it is bound,
+		so that a new one with the same ID is not skipped
+*/
+void CRenderState::DeleteVertexArray(const GLuint uiVAO)
+{
+	if (this->uiVAO == uiVAO)
+		this->uiVAO = UNKNOWN;
+	cBackend->DeleteVertexArray(uiVAO);
+}
+
+void CRenderState::VertexAttribPointer(const GLuint uiIndex, const GLint iSize, const GLenum eType, const GLsizei iStride, const size_t uiOffset)
+{
+	cBackend->VertexAttribPointer(uiIndex, iSize, eType, iStride, uiOffset);
+	Count(true);
+}
+
+GLuint CRenderState::GenTexture(void)
+{
+	GLuint uiTextureID = cBackend->GenTexture();
+	if (uiTextureID != 0)
+		uiNumTextures++;
+	return uiTextureID;
+}
+
+/**
+@brief Delete a texture. The shadowed bindings of it are forgotten,
+		so that a new texture with the same ID is not skipped
+*/
+void CRenderState::DeleteTexture(const GLuint uiTextureID)
+{
+	for (unsigned int i = 0; i < NUM_TEXTURE_UNITS; i++)
+	{
+		if (arrTextures[i] == uiTextureID)
+			arrTextures[i] = UNKNOWN;
+	}
+	cBackend->DeleteTexture(uiTextureID);
+	if ((uiTextureID != 0) && (uiNumTextures > 0))
+		uiNumTextures--;
+}
+
+/**
+@brief Upload pixels into a mip level of the bound 2D texture
+*/
+void CRenderState::TexImage2D(const GLint iLevel, const GLint iInternalFormat, const GLsizei iWidth, const GLsizei iHeight,
+								const GLenum eFormat, const GLenum eType, const void* pPixels)
+{
+	cBackend->TexImage2D(iLevel, iInternalFormat, iWidth, iHeight, eFormat, eType, pPixels);
+	// The pixels may be read from a bound pixel unpack buffer, so an offset of 0 is counted too
+	sCurrentFrame.ullTextureBytes += (unsigned long long)iWidth * iHeight * GetBytesPerPixel(eFormat, eType);
+}
+
+void CRenderState::TexParameter(const GLenum eName, const GLint iValue)
+{
+	cBackend->TexParameter(eName, iValue);
+	Count(true);
+}
+
+void CRenderState::GenerateMipmap(void)
+{
+	cBackend->GenerateMipmap();
+}
+
+GLint CRenderState::GetMaxTextureSize(void)
+{
+	return cBackend->GetMaxTextureSize();
+}
+
+GLuint CRenderState::GenFramebuffer(void)
+{
+	return cBackend->GenFramebuffer();
+}
+
+/**
+@brief Delete a framebuffer. It is unbound first if it is bound
+*/
+void CRenderState::DeleteFramebuffer(const GLuint uiFramebuffer)
+{
+	if (this->uiFramebuffer == uiFramebuffer)
+		this->uiFramebuffer = UNKNOWN;
+	cBackend->DeleteFramebuffer(uiFramebuffer);
+}
+
+GLenum CRenderState::AttachFramebufferTexture(const GLuint uiTextureID)
+{
+	return cBackend->AttachFramebufferTexture(uiTextureID);
+}
+
+GLuint CRenderState::CreateProgram(const char* pcVertexCode, const char* pcFragmentCode, const char* pcGeometryCode)
+{
+	return cBackend->CreateProgram(pcVertexCode, pcFragmentCode, pcGeometryCode);
+}
+
+/**
+@brief Delete a program. It is unbound first if it is bound
+*/
+void CRenderState::DeleteProgram(const GLuint uiProgram)
+{
+	if (this->uiProgram == uiProgram)
+		this->uiProgram = UNKNOWN;
+	cBackend->DeleteProgram(uiProgram);
+}
+
+void CRenderState::GetActiveUniforms(const GLuint uiProgram, std::vector<CRenderBackend::SUniformInfo>& uniforms)
+{
+	cBackend->GetActiveUniforms(uiProgram, uniforms);
+}
+
+/**
+@brief Upload a uniform of the bound program. CShader only calls this when the value changed
+*/
+void CRenderState::Uniform(const GLint iLocation, const GLenum eType, const void* pValue)
+{
+	cBackend->Uniform(iLocation, eType, pValue);
+	sCurrentFrame.uiUniformUploads++;
+}
+
+GLuint CRenderState::GenQuery(void)
+{
+	return cBackend->GenQuery();
+}
+
+void CRenderState::DeleteQuery(const GLuint uiQuery)
+{
+	cBackend->DeleteQuery(uiQuery);
+}
+
+void CRenderState::BeginQuery(const GLenum eTarget, const GLuint uiQuery)
+{
+	cBackend->BeginQuery(eTarget, uiQuery);
+}
+
+void CRenderState::EndQuery(const GLenum eTarget)
+{
+	cBackend->EndQuery(eTarget);
+}
+
+bool CRenderState::GetQueryResult(const GLuint uiQuery, GLuint64& ullResult)
+{
+	return cBackend->GetQueryResult(uiQuery, ullResult);
+}
+
+/**
+@brief Get the counters of the last completed frame
+*/
+const CRenderState::SStats& CRenderState::GetLastFrameStats(void) const
+{
+	return sLastFrame;
+}
+
+/**
+@brief Get the counters of the current frame so far
+*/
+const CRenderState::SStats& CRenderState::GetCurrentFrameStats(void) const
+{
+	return sCurrentFrame;
+}
+
+/**
+@brief Get the number of textures which were created and not deleted
+*/
+unsigned int CRenderState::GetNumTextures(void) const
+{
+	return uiNumTextures;
+}
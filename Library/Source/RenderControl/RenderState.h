@@ -0,0 +1,182 @@
+/**
+ CRenderState
+ @brief This class shadows the OpenGL state which is changed while rendering,
+		so that calls which would not change anything are not sent to the driver.
+		All the graphics calls go through this class to a CRenderBackend, which
+		counts the draw calls, state changes, uniform uploads, texture binds and
+		uploaded bytes of each frame, whether they are sent to OpenGL or not.
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "..\DesignPatterns\SingletonTemplate.h"
+
+// Include GLEW
+#ifndef GLEW_STATIC
+#include <GL/glew.h>
+#define GLEW_STATIC
+#endif
+
+// Include the render backend interface
+#include "RenderBackend.h"
+
+class CRenderState : public CSingletonTemplate<CRenderState>
+{
+	friend CSingletonTemplate<CRenderState>;
+public:
+	// The number of texture units which are shadowed
+	static const unsigned int NUM_TEXTURE_UNITS = 16;
+
+	// The counters of the calls which were made in a frame
+	struct SStats
+	{
+		unsigned int uiIssued;			// State changes which were sent to the backend
+		unsigned int uiSkipped;			// State changes which were dropped as they would not change anything
+		unsigned int uiDrawCalls;
+		unsigned int uiClears;			// Clears of the bound framebuffer, which are not counted as draw calls
+		unsigned int uiNumIndices;		// Indices drawn by the draw calls
+		unsigned int uiUniformUploads;
+		unsigned int uiTextureBinds;
+		unsigned long long ullBufferBytes;	// Bytes uploaded into buffers
+		unsigned long long ullTextureBytes;	// Bytes uploaded into textures
+	};
+
+	// Set the backend which the calls are sent to, e.g. a CRenderBackendNull for profiling without a GPU.
+	// This class takes ownership of it. Set it before any resource is created
+	void SetBackend(CRenderBackend* cBackend);
+	// Get the backend which the calls are sent to
+	CRenderBackend* GetBackend(void) const;
+
+	// Start a new frame: store the counters of the last frame, reset them and forget the shadowed state
+	void BeginFrame(void);
+
+	// Forget the shadowed state, e.g. after GL was changed without this class
+	void Invalidate(void);
+
+	// Bind a shader program
+	void UseProgram(const GLuint uiProgram);
+	// Bind a vertex array object
+	void BindVertexArray(const GLuint uiVAO);
+	// Select the active texture unit, e.g. GL_TEXTURE0
+	void ActiveTexture(const GLenum eUnit);
+	// Bind a 2D texture to the active texture unit
+	void BindTexture2D(const GLuint uiTextureID);
+	// Enable or disable blending
+	void SetBlend(const bool bEnable);
+	// Set the blend function
+	void BlendFunc(const GLenum eSrcFactor, const GLenum eDstFactor);
+	// Enable or disable the scissor test
+	void SetScissorTest(const bool bEnable);
+	// Bind a framebuffer, or 0 for the window
+	void BindFramebuffer(const GLuint uiFramebuffer);
+	// Bind a buffer to a target, e.g. GL_ARRAY_BUFFER
+	void BindBuffer(const GLenum eTarget, const GLuint uiBuffer);
+	// Set the viewport
+	void Viewport(const GLint iX, const GLint iY, const GLsizei iWidth, const GLsizei iHeight);
+	// Get the viewport which was set last, as (x, y, width, height)
+	void GetViewport(GLint iViewport[4]) const;
+	// Set the scissor box
+	void Scissor(const GLint iX, const GLint iY, const GLsizei iWidth, const GLsizei iHeight);
+	// Set the clear colour
+	void ClearColor(const GLfloat fRed, const GLfloat fGreen, const GLfloat fBlue, const GLfloat fAlpha);
+	// Get the clear colour which was set last
+	void GetClearColor(GLfloat fClearColour[4]) const;
+	// Set a pixel storage mode, e.g. GL_UNPACK_ALIGNMENT
+	void PixelStore(const GLenum eName, const GLint iValue);
+
+	// Clear the buffers of the bound framebuffer
+	void Clear(const GLbitfield uiMask);
+	// Draw the indexed primitives of the bound vertex array object
+	void DrawElements(const GLenum eMode, const GLsizei iCount, const GLenum eType, const void* pIndices);
+
+	// Create and delete buffers and vertex array objects
+	GLuint GenBuffer(void);
+	void DeleteBuffer(const GLuint uiBuffer);
+	void BufferData(const GLenum eTarget, const GLsizeiptr iSize, const void* pData, const GLenum eUsage);
+	void* MapBufferRange(const GLenum eTarget, const GLintptr iOffset, const GLsizeiptr iLength, const GLbitfield uiAccess);
+	bool UnmapBuffer(const GLenum eTarget);
+	GLuint GenVertexArray(void);
+	void DeleteVertexArray(const GLuint uiVAO);
+	// Enable a vertex attribute and set its layout in the bound array buffer
+	void VertexAttribPointer(const GLuint uiIndex, const GLint iSize, const GLenum eType, const GLsizei iStride, const size_t uiOffset);
+
+	// Create and delete textures and framebuffers. The texture calls apply to the bound 2D texture
+	GLuint GenTexture(void);
+	void DeleteTexture(const GLuint uiTextureID);
+	void TexImage2D(const GLint iLevel, const GLint iInternalFormat, const GLsizei iWidth, const GLsizei iHeight,
+					const GLenum eFormat, const GLenum eType, const void* pPixels);
+	void TexParameter(const GLenum eName, const GLint iValue);
+	void GenerateMipmap(void);
+	GLint GetMaxTextureSize(void);
+	GLuint GenFramebuffer(void);
+	void DeleteFramebuffer(const GLuint uiFramebuffer);
+	// Attach a texture as the colour buffer of the bound framebuffer, and return its status
+	GLenum AttachFramebufferTexture(const GLuint uiTextureID);
+
+	// Compile and link a program, and delete it
+	GLuint CreateProgram(const char* pcVertexCode, const char* pcFragmentCode, const char* pcGeometryCode);
+	void DeleteProgram(const GLuint uiProgram);
+	// Get the active uniforms of a linked program
+	void GetActiveUniforms(const GLuint uiProgram, std::vector<CRenderBackend::SUniformInfo>& uniforms);
+	// Upload a uniform of the bound program
+	void Uniform(const GLint iLocation, const GLenum eType, const void* pValue);
+
+	// Create and delete queries, e.g. for GL_TIME_ELAPSED
+	GLuint GenQuery(void);
+	void DeleteQuery(const GLuint uiQuery);
+	void BeginQuery(const GLenum eTarget, const GLuint uiQuery);
+	void EndQuery(const GLenum eTarget);
+	// Get the result of a query without waiting for it. Returns false if it is not available yet
+	bool GetQueryResult(const GLuint uiQuery, GLuint64& ullResult);
+
+	// Get the counters of the last completed frame
+	const SStats& GetLastFrameStats(void) const;
+	// Get the counters of the current frame so far
+	const SStats& GetCurrentFrameStats(void) const;
+	// Get the number of textures which were created and not deleted
+	unsigned int GetNumTextures(void) const;
+
+protected:
+	// Constructor
+	CRenderState(void);
+
+	// Destructor
+	virtual ~CRenderState(void);
+
+	// Count a call which was sent to GL or dropped
+	inline void Count(const bool bIssued)
+	{
+		if (bIssued)
+			sCurrentFrame.uiIssued++;
+		else
+			sCurrentFrame.uiSkipped++;
+	}
+
+	// The value of a shadowed state which is not known
+	static const GLuint UNKNOWN = 0xFFFFFFFF;
+
+	// The backend which the calls are sent to
+	CRenderBackend* cBackend;
+
+	// The shadowed state
+	GLuint uiProgram;
+	GLuint uiVAO;
+	GLenum eActiveUnit;
+	GLuint arrTextures[NUM_TEXTURE_UNITS];
+	GLuint uiBlend;
+	GLenum eBlendSrc;
+	GLenum eBlendDst;
+	GLuint uiScissorTest;
+	GLuint uiFramebuffer;
+
+	// The viewport and clear colour which were set last. These are only changed through this class,
+	// so they are kept when the shadowed state is forgotten
+	GLint arrViewport[4];
+	GLfloat arrClearColour[4];
+
+	// The counters for the current and the last frame
+	SStats sCurrentFrame;
+	SStats sLastFrame;
+	// The number of textures which were created and not deleted
+	unsigned int uiNumTextures;
+};
@@ -21,10 +21,31 @@
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <vector>
+#include <unordered_map>
+#include <cstring>
+
+// Include the render state, which sends the calls to the render backend
+#include "RenderState.h"
 
 class CShader
 {
 public:
+    // A typed handle to an active uniform. Fetch it once with getUniform() and keep it,
+    // instead of looking up the uniform by name on every draw.
+    template <typename T>
+    struct Uniform
+    {
+        const CShader* pShader;
+        int iSlot;
+
+        Uniform(void) : pShader(nullptr), iSlot(-1) {}
+        // True if this handle refers to an active uniform of matching type
+        bool IsValid(void) const { return (pShader != nullptr) && (iSlot >= 0); }
+        // True if this handle was fetched from _pShader, even if the uniform was not found
+        bool IsFor(const CShader* _pShader) const { return pShader == _pShader; }
+    };
+
     unsigned int ID;
     // constructor generates the shader on the fly
     // ------------------------------------------------------------------------
@@ -72,138 +93,202 @@ public:
                 << "STOPPING READING OF THESE FILES." << std::endl;
             return;
         }
-        const char* vShaderCode = vertexCode.c_str();
-        const char * fShaderCode = fragmentCode.c_str();
-        // 2. compile shaders
-        unsigned int vertex, fragment;
-        // vertex shader
-        vertex = glCreateShader(GL_VERTEX_SHADER);
-        glShaderSource(vertex, 1, &vShaderCode, NULL);
-        glCompileShader(vertex);
-        checkCompileErrors(vertex, "VERTEX");
-        // fragment Shader
-        fragment = glCreateShader(GL_FRAGMENT_SHADER);
-        glShaderSource(fragment, 1, &fShaderCode, NULL);
-        glCompileShader(fragment);
-        checkCompileErrors(fragment, "FRAGMENT");
-        // if geometry shader is given, compile geometry shader
-        unsigned int geometry;
-        if(geometryPath != nullptr)
-        {
-            const char * gShaderCode = geometryCode.c_str();
-            geometry = glCreateShader(GL_GEOMETRY_SHADER);
-            glShaderSource(geometry, 1, &gShaderCode, NULL);
-            glCompileShader(geometry);
-            checkCompileErrors(geometry, "GEOMETRY");
-        }
-        // shader Program
-        ID = glCreateProgram();
-        glAttachShader(ID, vertex);
-        glAttachShader(ID, fragment);
-        if(geometryPath != nullptr)
-            glAttachShader(ID, geometry);
-        glLinkProgram(ID);
-        checkCompileErrors(ID, "PROGRAM");
-        // delete the shaders as they're linked into our program now and no longer necessery
-        glDeleteShader(vertex);
-        glDeleteShader(fragment);
-        if(geometryPath != nullptr)
-            glDeleteShader(geometry);
-
+        // 2. compile and link the shaders
+        compile(vertexCode.c_str(), fragmentCode.c_str(), geometryPath != nullptr ? geometryCode.c_str() : nullptr);
+    }
+    // create a shader from source code which was already loaded, e.g. from the asset pack
+    // ------------------------------------------------------------------------
+    static CShader* CreateFromSource(const char* vShaderCode, const char* fShaderCode, const char* gShaderCode = nullptr)
+    {
+        CShader* cShader = new CShader();
+        cShader->compile(vShaderCode, fShaderCode, gShaderCode);
+        return cShader;
     }
+
     ~CShader(void)
     {
-        glDeleteProgram(ID);
+        CRenderState::GetInstance()->DeleteProgram(ID);
     }
     // activate the shader
     // ------------------------------------------------------------------------
     void use() 
     { 
-        glUseProgram(ID); 
+        CRenderState::GetInstance()->UseProgram(ID);
+    }
+    // get a typed handle to a uniform; an invalid handle is returned if it is not active
+    // or if its declared type does not match T
+    // ------------------------------------------------------------------------
+    template <typename T>
+    Uniform<T> getUniform(const std::string &name) const
+    {
+        Uniform<T> handle;
+        handle.pShader = this;
+        int iSlot = findSlot(name);
+        if (iSlot < 0)
+            return handle;
+        if (!isTypeCompatible(uniformSlots[iSlot].type, glTypeOf(T())))
+        {
+            std::cout << "CShader::getUniform() : Type mismatch for uniform " << name << std::endl;
+            return handle;
+        }
+        handle.iSlot = iSlot;
+        return handle;
+    }
+    // upload a value through a handle; skipped if the value is unchanged since the last upload
+    // ------------------------------------------------------------------------
+    template <typename T>
+    void set(const Uniform<T> &handle, const T &value) const
+    {
+        if ((handle.pShader != this) || (handle.iSlot < 0))
+            return;
+        setSlot(handle.iSlot, value);
     }
     // utility uniform functions
     // ------------------------------------------------------------------------
     void setBool(const std::string &name, bool value) const
     {         
-        glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value); 
+        setSlot(findSlot(name), (int)value);
     }
     // ------------------------------------------------------------------------
     void setInt(const std::string &name, int value) const
     { 
-        glUniform1i(glGetUniformLocation(ID, name.c_str()), value); 
+        setSlot(findSlot(name), value);
     }
     // ------------------------------------------------------------------------
     void setFloat(const std::string &name, float value) const
     { 
-        glUniform1f(glGetUniformLocation(ID, name.c_str()), value); 
+        setSlot(findSlot(name), value);
     }
     // ------------------------------------------------------------------------
     void setVec2(const std::string &name, const glm::vec2 &value) const
     { 
-        glUniform2fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]); 
+        setSlot(findSlot(name), value);
     }
     void setVec2(const std::string &name, float x, float y) const
     { 
-        glUniform2f(glGetUniformLocation(ID, name.c_str()), x, y); 
+        setSlot(findSlot(name), glm::vec2(x, y));
     }
     // ------------------------------------------------------------------------
     void setVec3(const std::string &name, const glm::vec3 &value) const
     { 
-        glUniform3fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]); 
+        setSlot(findSlot(name), value);
     }
     void setVec3(const std::string &name, float x, float y, float z) const
     { 
-        glUniform3f(glGetUniformLocation(ID, name.c_str()), x, y, z); 
+        setSlot(findSlot(name), glm::vec3(x, y, z));
     }
     // ------------------------------------------------------------------------
     void setVec4(const std::string &name, const glm::vec4 &value) const
     { 
-        glUniform4fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]); 
+        setSlot(findSlot(name), value);
     }
     void setVec4(const std::string &name, float x, float y, float z, float w) 
     { 
-        glUniform4f(glGetUniformLocation(ID, name.c_str()), x, y, z, w); 
+        setSlot(findSlot(name), glm::vec4(x, y, z, w));
     }
     // ------------------------------------------------------------------------
     void setMat2(const std::string &name, const glm::mat2 &mat) const
     {
-        glUniformMatrix2fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+        setSlot(findSlot(name), mat);
     }
     // ------------------------------------------------------------------------
     void setMat3(const std::string &name, const glm::mat3 &mat) const
     {
-        glUniformMatrix3fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+        setSlot(findSlot(name), mat);
     }
     // ------------------------------------------------------------------------
     void setMat4(const std::string &name, const glm::mat4 &mat) const
     {
-        glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+        setSlot(findSlot(name), mat);
     }
 
 private:
-    // utility function for checking shader compilation/linking errors.
+    // an active uniform reflected at link time, and the last value uploaded to it
+    struct UniformSlot
+    {
+        GLint location;
+        GLenum type;
+        bool bHasValue;
+        unsigned char lastValue[sizeof(glm::mat4)];
+    };
+    // the active uniforms of this program, and their slot index by name
+    mutable std::vector<UniformSlot> uniformSlots;
+    std::unordered_map<std::string, int> uniformIndex;
+
+    // an empty shader for CreateFromSource() to compile into
     // ------------------------------------------------------------------------
-    void checkCompileErrors(GLuint shader, std::string type)
+    CShader(void) : ID(0)
     {
-        GLint success;
-        GLchar infoLog[1024];
-        if(type != "PROGRAM")
-        {
-            glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-            if(!success)
-            {
-                glGetShaderInfoLog(shader, 1024, NULL, infoLog);
-                std::cout << "ERROR::SHADER_COMPILATION_ERROR of type: " << type << "\n" << infoLog << "\n -- --------------------------------------------------- -- " << std::endl;
-            }
-        }
-        else
+    }
+    // compile and link the shader sources into this program
+    // ------------------------------------------------------------------------
+    void compile(const char* vShaderCode, const char* fShaderCode, const char* gShaderCode)
+    {
+        ID = CRenderState::GetInstance()->CreateProgram(vShaderCode, fShaderCode, gShaderCode);
+
+        // 3. reflect the active uniforms so that the setters never query the driver by name
+        reflectUniforms();
+    }
+
+    // get the active uniforms of the linked program from the backend and store their locations
+    // ------------------------------------------------------------------------
+    void reflectUniforms(void)
+    {
+        std::vector<CRenderBackend::SUniformInfo> uniforms;
+        CRenderState::GetInstance()->GetActiveUniforms(ID, uniforms);
+        uniformSlots.reserve(uniforms.size());
+        for (unsigned int i = 0; i < uniforms.size(); i++)
         {
-            glGetProgramiv(shader, GL_LINK_STATUS, &success);
-            if(!success)
-            {
-                glGetProgramInfoLog(shader, 1024, NULL, infoLog);
-                std::cout << "ERROR::PROGRAM_LINKING_ERROR of type: " << type << "\n" << infoLog << "\n -- --------------------------------------------------- -- " << std::endl;
-            }
+            UniformSlot slot;
+            slot.location = uniforms[i].iLocation;
+            slot.type = uniforms[i].eType;
+            slot.bHasValue = false;
+            uniformIndex[uniforms[i].sName] = (int)uniformSlots.size();
+            uniformSlots.push_back(slot);
         }
     }
+    // ------------------------------------------------------------------------
+    int findSlot(const std::string &name) const
+    {
+        std::unordered_map<std::string, int>::const_iterator it = uniformIndex.find(name);
+        if (it == uniformIndex.end())
+            return -1;
+        return it->second;
+    }
+    // store the value in the slot and upload it, unless it is the same as the last upload
+    // ------------------------------------------------------------------------
+    template <typename T>
+    void setSlot(const int iSlot, const T &value) const
+    {
+        static_assert(sizeof(T) <= sizeof(glm::mat4), "Uniform value is larger than the cache");
+        if (iSlot < 0)
+            return;
+        UniformSlot &slot = uniformSlots[iSlot];
+        if (slot.bHasValue && (memcmp(slot.lastValue, &value, sizeof(T)) == 0))
+            return;
+        memcpy(slot.lastValue, &value, sizeof(T));
+        slot.bHasValue = true;
+        CRenderState::GetInstance()->Uniform(slot.location, glTypeOf(value), &value);
+    }
+    // ------------------------------------------------------------------------
+    static GLenum glTypeOf(int) { return GL_INT; }
+    static GLenum glTypeOf(float) { return GL_FLOAT; }
+    static GLenum glTypeOf(const glm::vec2 &) { return GL_FLOAT_VEC2; }
+    static GLenum glTypeOf(const glm::vec3 &) { return GL_FLOAT_VEC3; }
+    static GLenum glTypeOf(const glm::vec4 &) { return GL_FLOAT_VEC4; }
+    static GLenum glTypeOf(const glm::mat2 &) { return GL_FLOAT_MAT2; }
+    static GLenum glTypeOf(const glm::mat3 &) { return GL_FLOAT_MAT3; }
+    static GLenum glTypeOf(const glm::mat4 &) { return GL_FLOAT_MAT4; }
+    // ints are also used for bools and sampler units
+    // ------------------------------------------------------------------------
+    static bool isTypeCompatible(GLenum declared, GLenum requested)
+    {
+        if (declared == requested)
+            return true;
+        if (requested != GL_INT)
+            return false;
+        return (declared == GL_BOOL) || (declared == GL_SAMPLER_2D) ||
+            (declared == GL_SAMPLER_3D) || (declared == GL_SAMPLER_CUBE) ||
+            (declared == GL_SAMPLER_2D_ARRAY);
+    }
 };
@@ -7,6 +7,11 @@
 #include "ShaderManager.h"
 #include <stdexcept>      // std::invalid_argument
 
+// Include Render State
+#include "RenderState.h"
+// Include CAssetPack to load the cooked shader sources
+#include "..\System\AssetPack.h"
+
 /**
 @brief Constructor
 */
@@ -40,6 +45,8 @@ void CShaderManager::Exit(void)
 		it->second = nullptr;
 	}
 	shaderMap.clear();
+	activeShader = nullptr;
+	activeShaderName.clear();
 }
 
 /**
@@ -58,7 +65,27 @@ void CShaderManager::Add(	const std::string& _name,
 		return;
 	}
 
-	CShader* cNewShader = new CShader(vertexPath, fragmentPath);
+	// Compile the sources from the asset pack if they were cooked, instead of reading the files
+	CShader* cNewShader = nullptr;
+	const CAssetPack* cAssetPack = CAssetPack::GetInstance();
+	const CAssetPack::SEntry* pVertexEntry = cAssetPack->Find(vertexPath, CAssetPack::ASSET_TEXT);
+	const CAssetPack::SEntry* pFragmentEntry = cAssetPack->Find(fragmentPath, CAssetPack::ASSET_TEXT);
+	const CAssetPack::SEntry* pGeometryEntry = (geometryPath != nullptr) ? cAssetPack->Find(geometryPath, CAssetPack::ASSET_TEXT) : nullptr;
+	if ((pVertexEntry != nullptr) && (pFragmentEntry != nullptr) && ((geometryPath == nullptr) || (pGeometryEntry != nullptr)))
+	{
+		// The sources in the pack are not null-terminated
+		std::string vertexCode((const char*)cAssetPack->GetData(pVertexEntry), (size_t)pVertexEntry->ulSize);
+		std::string fragmentCode((const char*)cAssetPack->GetData(pFragmentEntry), (size_t)pFragmentEntry->ulSize);
+		std::string geometryCode;
+		if (pGeometryEntry != nullptr)
+			geometryCode.assign((const char*)cAssetPack->GetData(pGeometryEntry), (size_t)pGeometryEntry->ulSize);
+		cNewShader = CShader::CreateFromSource(vertexCode.c_str(), fragmentCode.c_str(),
+												(pGeometryEntry != nullptr) ? geometryCode.c_str() : nullptr);
+	}
+	else
+	{
+		cNewShader = new CShader(vertexPath, fragmentPath, geometryPath);
+	}
 
 	// Nothing wrong, add the scene to our map
 	shaderMap[_name] = cNewShader;
@@ -85,6 +112,11 @@ void CShaderManager::Remove(const std::string& _name)
 	}
 
 	// Delete and remove from our map
+	if (target == activeShader)
+	{
+		activeShader = nullptr;
+		activeShaderName.clear();
+	}
 	delete target;
 	shaderMap.erase(_name);
 }
@@ -94,20 +126,24 @@ void CShaderManager::Remove(const std::string& _name)
 */
 void CShaderManager::Use(const std::string& _name)
 {
-	try {
-		if (!Check(_name))
+	// Look up the map only if a different shader is requested
+	if ((activeShader == nullptr) || (_name != activeShaderName))
+	{
+		std::map<std::string, CShader*>::iterator it = shaderMap.find(_name);
+		if (it == shaderMap.end())
 		{
 			// Shader does not exist
-			throw std::exception("Shader does not exist");
+			std::cerr << "Shader does not exist: " << _name << std::endl;
+			return;
 		}
-	}
-	catch (const std::exception& e) {
-		std::cerr << e.what() << std::endl;
+
+		// if Shader exist, set the activeShader pointer to that Shader
+		activeShader = it->second;
+		activeShaderName = _name;
 	}
 
-	// if Shader exist, set the activeShader pointer to that Shader
-	activeShader = shaderMap[_name];
-	activeShader->use();
+	// The render state drops this if the program is already bound
+	CRenderState::GetInstance()->UseProgram(activeShader->ID);
 }
 
 /**
@@ -116,4 +152,16 @@ void CShaderManager::Use(const std::string& _name)
 bool CShaderManager::Check(const std::string& _name)
 {
 	return shaderMap.count(_name) != 0;
-}
\ No newline at end of file
+}
+
+/**
+@brief Get a Shader without making it active
+@return The Shader, or nullptr if it does not exist
+*/
+CShader* CShaderManager::Get(const std::string& _name)
+{
+	std::map<std::string, CShader*>::iterator it = shaderMap.find(_name);
+	if (it == shaderMap.end())
+		return nullptr;
+	return it->second;
+}
@@ -24,9 +24,12 @@ public:
 	void Remove(const std::string& _name);
 	void Use(const std::string& _name);
 	bool Check(const std::string& _name);
+	CShader* Get(const std::string& _name);
 
 	// The current active shader
 	CShader* activeShader;
+	// The name of the current active shader
+	std::string activeShaderName;
 
 protected:
 	// Constructor
@@ -0,0 +1,286 @@
+/**
+ CAssetPack
+ @brief A class to memory-map the cooked asset pack, which stores the images as decoded RGBA,
+		the maps as parsed tile values, and the shaders and the data files as text.
+		The assets are found through a table of contents which is sorted by their names,
+		so no file is opened or parsed for each asset.
+ */
+#include "AssetPack.h"
+
+#ifdef _WIN32
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <Windows.h>
+#else
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+#include <chrono>
+#include <cstring>
+#include <cctype>
+
+#include <iostream>
+using namespace std;
+
+/**
+ @brief Get the size of the pixels of an image entry, with all its mip levels
+ @param sEntry The entry of the image
+ @return The size in bytes, or 0 if its size or its number of mip levels is not valid
+ */
+static uint64_t GetImageSize(const CAssetPack::SEntry& sEntry)
+{
+	if ((sEntry.uiWidth == 0) || (sEntry.uiHeight == 0) || (sEntry.uiNumLevels == 0) || (sEntry.uiNumLevels > 32))
+		return 0;
+
+	uint64_t ulWidth = sEntry.uiWidth;
+	uint64_t ulHeight = sEntry.uiHeight;
+	uint64_t ulSize = 0;
+	for (uint32_t i = 0; i < sEntry.uiNumLevels; i++)
+	{
+		ulSize += ulWidth * ulHeight * 4;
+		ulWidth = (ulWidth > 1) ? ulWidth / 2 : 1;
+		ulHeight = (ulHeight > 1) ? ulHeight / 2 : 1;
+	}
+	return ulSize;
+}
+
+/**
+@brief Constructor
+*/
+CAssetPack::CAssetPack(void)
+	: pPackData(NULL)
+	, ulPackSize(0)
+	, pEntries(NULL)
+	, uiNumEntries(0)
+	, ulSourceTime(0)
+	, pFileHandle(NULL)
+	, pMappingHandle(NULL)
+	, iFileDescriptor(-1)
+{
+}
+
+/**
+@brief Destructor
+*/
+CAssetPack::~CAssetPack(void)
+{
+	Close();
+}
+
+/**
+ @brief Memory-map a pack and check its table of contents. Any pack which was opened before is closed first
+ @param sFilename The full path of the pack
+ @return true if the pack is opened, false if it does not exist or is not valid
+ */
+bool CAssetPack::Open(const std::string& sFilename)
+{
+	Close();
+
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+#ifdef _WIN32
+	HANDLE hFile = CreateFileA(sFilename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+								OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, NULL);
+	if (hFile == INVALID_HANDLE_VALUE)
+		return false;
+	pFileHandle = hFile;
+
+	LARGE_INTEGER fileSize;
+	if ((GetFileSizeEx(hFile, &fileSize) == FALSE) || (fileSize.QuadPart == 0))
+	{
+		Close();
+		return false;
+	}
+	ulPackSize = (uint64_t)fileSize.QuadPart;
+
+	HANDLE hMapping = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (hMapping == NULL)
+	{
+		Close();
+		return false;
+	}
+	pMappingHandle = hMapping;
+
+	pPackData = (const unsigned char*)MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+#else
+	iFileDescriptor = open(sFilename.c_str(), O_RDONLY);
+	if (iFileDescriptor < 0)
+		return false;
+
+	struct stat fileStat;
+	if ((fstat(iFileDescriptor, &fileStat) != 0) || (fileStat.st_size == 0))
+	{
+		Close();
+		return false;
+	}
+	ulPackSize = (uint64_t)fileStat.st_size;
+
+	void* pMapped = mmap(NULL, (size_t)ulPackSize, PROT_READ, MAP_PRIVATE, iFileDescriptor, 0);
+	pPackData = (pMapped == MAP_FAILED) ? NULL : (const unsigned char*)pMapped;
+#endif
+	if (pPackData == NULL)
+	{
+		cout << "CAssetPack::Open(): Unable to map " << sFilename << endl;
+		Close();
+		return false;
+	}
+
+	// Check the header and the table of contents, so that the assets can be read without any checks later
+	const SHeader* pHeader = (const SHeader*)pPackData;
+	if ((ulPackSize < sizeof(SHeader)) ||
+		(memcmp(pHeader->acMagic, "SPAK", 4) != 0) ||
+		(pHeader->uiVersion != uiVersion) ||
+		(ulPackSize < sizeof(SHeader) + (uint64_t)pHeader->uiNumEntries * sizeof(SEntry)))
+	{
+		cout << "CAssetPack::Open(): " << sFilename << " is not a valid asset pack. Cook it again." << endl;
+		Close();
+		return false;
+	}
+	pEntries = (const SEntry*)(pPackData + sizeof(SHeader));
+	for (uint32_t i = 0; i < pHeader->uiNumEntries; i++)
+	{
+		if ((pEntries[i].ulOffset > ulPackSize) || (pEntries[i].ulSize > ulPackSize - pEntries[i].ulOffset) ||
+			(pEntries[i].acName[sizeof(pEntries[i].acName) - 1] != '\0'))
+		{
+			cout << "CAssetPack::Open(): " << sFilename << " is truncated. Cook it again." << endl;
+			Close();
+			return false;
+		}
+		// The images are read level by level from their sizes, so the sizes must match the data.
+		// The maps are read tile by tile, so their tile values must fit in the data
+		if (((pEntries[i].uiType == ASSET_IMAGE) && (GetImageSize(pEntries[i]) != pEntries[i].ulSize)) ||
+			((pEntries[i].uiType == ASSET_MAP) &&
+			((uint64_t)pEntries[i].uiWidth * pEntries[i].uiHeight * sizeof(int32_t) > pEntries[i].ulSize)))
+		{
+			cout << "CAssetPack::Open(): The size of " << pEntries[i].acName << " in " << sFilename
+				<< " does not match its data. Cook it again." << endl;
+			Close();
+			return false;
+		}
+	}
+	uiNumEntries = pHeader->uiNumEntries;
+	ulSourceTime = pHeader->ulSourceTime;
+
+	std::chrono::duration<double, std::milli> openTime = std::chrono::steady_clock::now() - startTime;
+	cout << "CAssetPack::Open(): Mapped " << uiNumEntries << " assets from " << sFilename
+		<< " in " << openTime.count() << " ms" << endl;
+	return true;
+}
+
+/**
+ @brief Unmap the pack. The data of its assets must not be used after this
+ */
+void CAssetPack::Close(void)
+{
+#ifdef _WIN32
+	if (pPackData != NULL)
+		UnmapViewOfFile(pPackData);
+	if (pMappingHandle != NULL)
+		CloseHandle((HANDLE)pMappingHandle);
+	if (pFileHandle != NULL)
+		CloseHandle((HANDLE)pFileHandle);
+#else
+	if (pPackData != NULL)
+		munmap((void*)pPackData, (size_t)ulPackSize);
+	if (iFileDescriptor >= 0)
+		close(iFileDescriptor);
+#endif
+	pPackData = NULL;
+	ulPackSize = 0;
+	pEntries = NULL;
+	uiNumEntries = 0;
+	ulSourceTime = 0;
+	pFileHandle = NULL;
+	pMappingHandle = NULL;
+	iFileDescriptor = -1;
+}
+
+/**
+ @brief Check if a pack is opened
+ */
+bool CAssetPack::IsOpen(void) const
+{
+	return pPackData != NULL;
+}
+
+/**
+ @brief Find an asset by a binary search of the table of contents
+ @param sFilename The file name which the asset was cooked from, e.g. "Image/Scene2D_Health.tga"
+ @param eType The type of the asset
+ @return The entry of the asset, or NULL if it is not in the pack
+ */
+const CAssetPack::SEntry* CAssetPack::Find(const std::string& sFilename, const ASSET_TYPE eType) const
+{
+	if (uiNumEntries == 0)
+		return NULL;
+
+	std::string sName = NormaliseName(sFilename);
+	if (sName.size() >= sizeof(pEntries[0].acName))
+		return NULL;
+
+	uint32_t uiLow = 0;
+	uint32_t uiHigh = uiNumEntries;
+	while (uiLow < uiHigh)
+	{
+		uint32_t uiMid = uiLow + (uiHigh - uiLow) / 2;
+		int iCompare = strcmp(pEntries[uiMid].acName, sName.c_str());
+		if (iCompare == 0)
+			return (pEntries[uiMid].uiType == (uint32_t)eType) ? &pEntries[uiMid] : NULL;
+		if (iCompare < 0)
+			uiLow = uiMid + 1;
+		else
+			uiHigh = uiMid;
+	}
+	return NULL;
+}
+
+/**
+ @brief Get the data of an asset
+ @param pEntry The entry of the asset which was returned by Find()
+ @return The data, which stays valid until the pack is closed
+ */
+const unsigned char* CAssetPack::GetData(const SEntry* pEntry) const
+{
+	return pPackData + pEntry->ulOffset;
+}
+
+/**
+ @brief Get the newest modification time of the files which were cooked into the pack.
+		If a loose file is newer, the pack is stale
+ @return The time in seconds since 1970, or 0 if no pack is opened
+ */
+uint64_t CAssetPack::GetSourceTime(void) const
+{
+	return ulSourceTime;
+}
+
+/**
+ @brief Convert a file name to the name used in the table of contents. The slashes are
+		made forward slashes, repeated slashes and a leading "./" are removed, and the
+		letters are made lower case, as the file names are not case sensitive on Windows
+ @param sFilename The file name, relative to the folder which contains Image, Maps, Shader and Data
+ */
+std::string CAssetPack::NormaliseName(const std::string& sFilename)
+{
+	std::string sName;
+	sName.reserve(sFilename.size());
+	for (size_t i = 0; i < sFilename.size(); i++)
+	{
+		char c = sFilename[i];
+		if (c == '\\')
+			c = '/';
+		if ((c == '/') && ((sName.empty()) || (sName[sName.size() - 1] == '/')))
+			continue;
+		sName.push_back((char)tolower((unsigned char)c));
+	}
+	if (sName.compare(0, 2, "./") == 0)
+		sName.erase(0, 2);
+	return sName;
+}
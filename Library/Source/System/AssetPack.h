@@ -0,0 +1,97 @@
+/**
+ CAssetPack
+ @brief A class to memory-map the cooked asset pack, which stores the images as decoded RGBA,
+		the maps as parsed tile values, and the shaders and the data files as text.
+		The assets are found through a table of contents which is sorted by their names,
+		so no file is opened or parsed for each asset.
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+#include <string>
+#include <cstdint>
+
+class CAssetPack : public CSingletonTemplate<CAssetPack>
+{
+	friend CSingletonTemplate<CAssetPack>;
+public:
+	// The types of assets in the pack
+	enum ASSET_TYPE
+	{
+		ASSET_IMAGE = 0,	// RGBA pixels of each mip level, from the largest level
+		ASSET_MAP,			// The tile values row by row, followed by the column names separated by '\n'
+		ASSET_TEXT,			// The text of the file
+		NUM_ASSET_TYPES
+	};
+
+	// The flags of an image asset
+	enum IMAGE_FLAG
+	{
+		IMAGE_INVERTED = 1	// The rows are stored from the bottom, as loaded with bInvert = true
+	};
+
+	// The header at the start of the pack
+	struct SHeader
+	{
+		char acMagic[4];
+		uint32_t uiVersion;
+		uint32_t uiNumEntries;
+		uint32_t uiReserved;
+		uint64_t ulSourceTime;	// The newest modification time of the files which were cooked, in seconds since 1970
+	};
+
+	// An entry in the table of contents, which follows the header
+	struct SEntry
+	{
+		char acName[96];		// The normalised name of the asset, e.g. "image/scene2d_health.tga"
+		uint32_t uiType;		// ASSET_TYPE
+		uint32_t uiFlags;		// IMAGE_FLAG for images
+		uint32_t uiWidth;		// The width of an image, or the number of columns of a map
+		uint32_t uiHeight;		// The height of an image, or the number of rows of a map
+		uint32_t uiNumLevels;	// The number of mip levels of an image
+		uint32_t uiReserved;
+		uint64_t ulOffset;		// The offset of the data from the start of the pack
+		uint64_t ulSize;		// The size of the data in bytes
+	};
+
+	// The version of the pack layout. Increase this when SHeader or SEntry is changed
+	static const uint32_t uiVersion = 2;
+
+	// Memory-map a pack. Any pack which was opened before is closed first
+	bool Open(const std::string& sFilename);
+	// Unmap the pack
+	void Close(void);
+	// Check if a pack is opened
+	bool IsOpen(void) const;
+
+	// Find an asset by its file name, or return NULL if it is not in the pack
+	const SEntry* Find(const std::string& sFilename, const ASSET_TYPE eType) const;
+	// Get the data of an asset. It stays valid until the pack is closed
+	const unsigned char* GetData(const SEntry* pEntry) const;
+	// Get the newest modification time of the files which were cooked into the pack
+	uint64_t GetSourceTime(void) const;
+
+	// Convert a file name to the name used in the table of contents
+	static std::string NormaliseName(const std::string& sFilename);
+
+protected:
+	// Constructor
+	CAssetPack(void);
+
+	// Destructor
+	virtual ~CAssetPack(void);
+
+	// The mapped pack, and its table of contents inside it
+	const unsigned char* pPackData;
+	uint64_t ulPackSize;
+	const SEntry* pEntries;
+	uint32_t uiNumEntries;
+	uint64_t ulSourceTime;
+
+	// The handles of the mapped file
+	void* pFileHandle;
+	void* pMappingHandle;
+	int iFileDescriptor;
+};
@@ -0,0 +1,423 @@
+/**
+ CAssetPacker
+ @brief A class to cook the loose digital assets into an asset pack for CAssetPack.
+		The images are decoded into RGBA and inverted, with an optional mip chain,
+		the maps are parsed into tile values, and the shaders and the data files are stored as text.
+		Run the application with "--cook" (and "--mips" for the mip chains) to cook the pack.
+ */
+#include "AssetPacker.h"
+
+#ifdef _WIN32
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <Windows.h>
+#else
+	#include <dirent.h>
+	#include <sys/stat.h>
+#endif
+
+// Include CImageLoader to invert the images in the same way
+#include "ImageLoader.h"
+// STB Image. The implementation is in ImageLoader.cpp
+#include <includes/stb_image.h>
+// Include rapidcsv to parse the maps in the same way as CMap2D
+#include "rapidcsv.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include <iostream>
+using namespace std;
+
+/**
+ @brief Compare two files by the names which they have in the table of contents
+ */
+static bool CompareNormalisedNames(const std::string& sLeft, const std::string& sRight)
+{
+	return CAssetPack::NormaliseName(sLeft) < CAssetPack::NormaliseName(sRight);
+}
+
+/**
+ @brief Get the extension of a file in lower case, without the dot
+ */
+static std::string GetExtension(const std::string& sFilename)
+{
+	size_t uiDot = sFilename.find_last_of('.');
+	if ((uiDot == std::string::npos) || (sFilename.find_first_of("/\\", uiDot) != std::string::npos))
+		return "";
+	std::string sExtension = sFilename.substr(uiDot + 1);
+	std::transform(sExtension.begin(), sExtension.end(), sExtension.begin(), ::tolower);
+	return sExtension;
+}
+
+/**
+ @brief Cook the assets in the Image, Maps, Shader and Data folders under sRootPath into sPackFile.
+		The table of contents is sorted by the asset names, and each asset is aligned to 16 bytes.
+ @param sRootPath The folder which contains the Image, Maps, Shader and Data folders
+ @param sPackFile The full path of the pack to write
+ @param bMipMaps true to store a mip chain for each image, so that no mipmap is generated at runtime
+ @return true if the pack was written. The assets which could not be cooked are reported and left out
+ */
+bool CAssetPacker::Cook(const std::string& sRootPath, const std::string& sPackFile, const bool bMipMaps)
+{
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+	// Collect the files which can be cooked
+	std::vector<std::string> cookFiles;
+	std::vector<CAssetPack::ASSET_TYPE> cookTypes;
+	ListAssets(sRootPath, cookFiles, cookTypes);
+
+	std::ofstream packFile(sPackFile.c_str(), std::ios::binary | std::ios::trunc);
+	if (!packFile.is_open())
+	{
+		cout << "CAssetPacker::Cook(): Unable to create " << sPackFile << endl;
+		return false;
+	}
+
+	// Reserve the header and the table of contents, which are written after all the assets
+	CAssetPack::SHeader sHeader;
+	memset(&sHeader, 0, sizeof(sHeader));
+	memcpy(sHeader.acMagic, "SPAK", 4);
+	sHeader.uiVersion = CAssetPack::uiVersion;
+	std::vector<CAssetPack::SEntry> entries;
+	entries.reserve(cookFiles.size());
+	uint64_t ulOffset = sizeof(CAssetPack::SHeader) + cookFiles.size() * sizeof(CAssetPack::SEntry);
+	std::vector<char> padding((size_t)ulOffset, 0);
+	packFile.write(&padding[0], padding.size());
+
+	std::vector<unsigned char> data;
+	for (unsigned int i = 0; i < cookFiles.size(); i++)
+	{
+		CAssetPack::SEntry sEntry;
+		memset(&sEntry, 0, sizeof(sEntry));
+		strcpy(sEntry.acName, CAssetPack::NormaliseName(cookFiles[i]).c_str());
+		sEntry.uiType = cookTypes[i];
+
+		std::string sPath = sRootPath + "/" + cookFiles[i];
+		// The files which cannot be cooked are counted too, so that the pack is not stale when it is opened
+		sHeader.ulSourceTime = std::max(sHeader.ulSourceTime, GetModifiedTime(sPath));
+		data.clear();
+		bool bResult = false;
+		if (cookTypes[i] == CAssetPack::ASSET_IMAGE)
+			bResult = CookImage(sPath, bMipMaps, sEntry, data);
+		else if (cookTypes[i] == CAssetPack::ASSET_MAP)
+			bResult = CookMap(sPath, sEntry, data);
+		else
+			bResult = CookText(sPath, sEntry, data);
+		if (bResult == false)
+		{
+			cout << "CAssetPacker::Cook(): Unable to cook " << sPath << endl;
+			continue;
+		}
+
+		// Align the data to 16 bytes
+		uint64_t ulPadding = (16 - (ulOffset % 16)) % 16;
+		if (ulPadding > 0)
+		{
+			packFile.write(&padding[0], (std::streamsize)ulPadding);
+			ulOffset += ulPadding;
+		}
+
+		sEntry.ulOffset = ulOffset;
+		sEntry.ulSize = data.size();
+		if (!data.empty())
+			packFile.write((const char*)&data[0], (std::streamsize)data.size());
+		ulOffset += data.size();
+		entries.push_back(sEntry);
+	}
+
+	// Write the header and the table of contents. The entries of the assets which could
+	// not be cooked are left as zeros at the end, and are not counted in the header
+	sHeader.uiNumEntries = (uint32_t)entries.size();
+	packFile.seekp(0);
+	packFile.write((const char*)&sHeader, sizeof(sHeader));
+	if (!entries.empty())
+		packFile.write((const char*)&entries[0], entries.size() * sizeof(CAssetPack::SEntry));
+	packFile.close();
+	if (packFile.fail())
+	{
+		cout << "CAssetPacker::Cook(): Unable to write " << sPackFile << endl;
+		return false;
+	}
+
+	std::chrono::duration<double, std::milli> cookTime = std::chrono::steady_clock::now() - startTime;
+	cout << "CAssetPacker::Cook(): Cooked " << entries.size() << " of " << cookFiles.size() << " assets ("
+		<< ulOffset / 1024 << " KB) into " << sPackFile << " in " << cookTime.count() << " ms" << endl;
+	return true;
+}
+
+/**
+ @brief List the files in the Image, Maps, Shader and Data folders under sRootPath which can be cooked, sorted by their names
+ @param sRootPath The folder which contains the Image, Maps, Shader and Data folders
+ @param cookFiles The list to fill with the file names, relative to sRootPath
+ @param cookTypes The list to fill with the type which each file is cooked as
+ */
+void CAssetPacker::ListAssets(const std::string& sRootPath, std::vector<std::string>& cookFiles, std::vector<CAssetPack::ASSET_TYPE>& cookTypes)
+{
+	std::vector<std::string> files;
+	ListFiles(sRootPath, "Image", files);
+	ListFiles(sRootPath, "Maps", files);
+	ListFiles(sRootPath, "Shader", files);
+	ListFiles(sRootPath, "Data", files);
+	std::sort(files.begin(), files.end(), CompareNormalisedNames);
+
+	std::vector<std::string> imageExtensions;
+	imageExtensions.push_back("png");
+	imageExtensions.push_back("tga");
+	imageExtensions.push_back("jpg");
+	imageExtensions.push_back("jpeg");
+	imageExtensions.push_back("bmp");
+
+	for (unsigned int i = 0; i < files.size(); i++)
+	{
+		std::string sName = CAssetPack::NormaliseName(files[i]);
+		std::string sExtension = GetExtension(sName);
+		if (sName.size() >= sizeof(((CAssetPack::SEntry*)0)->acName))
+		{
+			cout << "CAssetPacker::ListAssets(): Skipping " << files[i] << " as its name is too long" << endl;
+			continue;
+		}
+		if ((!cookFiles.empty()) && (CAssetPack::NormaliseName(cookFiles.back()) == sName))
+		{
+			cout << "CAssetPacker::ListAssets(): Skipping " << files[i] << " as its name is used by " << cookFiles.back() << endl;
+			continue;
+		}
+
+		if ((sName.compare(0, 6, "image/") == 0) &&
+			(std::find(imageExtensions.begin(), imageExtensions.end(), sExtension) != imageExtensions.end()))
+		{
+			cookTypes.push_back(CAssetPack::ASSET_IMAGE);
+		}
+		else if ((sName.compare(0, 5, "maps/") == 0) && (sExtension == "csv"))
+		{
+			cookTypes.push_back(CAssetPack::ASSET_MAP);
+		}
+		else if ((sName.compare(0, 7, "shader/") == 0) || (sName.compare(0, 5, "data/") == 0))
+		{
+			cookTypes.push_back(CAssetPack::ASSET_TEXT);
+		}
+		else
+		{
+			continue;
+		}
+		cookFiles.push_back(files[i]);
+	}
+}
+
+/**
+ @brief Get the newest modification time of the files which are cooked. If it is newer than
+		CAssetPack::GetSourceTime() of a pack, the pack is stale and should be cooked again
+ @param sRootPath The folder which contains the Image, Maps, Shader and Data folders
+ @return The time in seconds since 1970, or 0 if there are no files
+ */
+uint64_t CAssetPacker::GetNewestSourceTime(const std::string& sRootPath)
+{
+	std::vector<std::string> cookFiles;
+	std::vector<CAssetPack::ASSET_TYPE> cookTypes;
+	ListAssets(sRootPath, cookFiles, cookTypes);
+
+	uint64_t ulNewestTime = 0;
+	for (unsigned int i = 0; i < cookFiles.size(); i++)
+		ulNewestTime = std::max(ulNewestTime, GetModifiedTime(sRootPath + "/" + cookFiles[i]));
+	return ulNewestTime;
+}
+
+/**
+ @brief Get the modification time of a file
+ @param sPath The full path of the file
+ @return The time in seconds since 1970, or 0 if the file does not exist
+ */
+uint64_t CAssetPacker::GetModifiedTime(const std::string& sPath)
+{
+#ifdef _WIN32
+	WIN32_FILE_ATTRIBUTE_DATA fileData;
+	if (GetFileAttributesExA(sPath.c_str(), GetFileExInfoStandard, &fileData) == FALSE)
+		return 0;
+	// The file time is in 100 ns from 1601
+	uint64_t ulFileTime = ((uint64_t)fileData.ftLastWriteTime.dwHighDateTime << 32) | fileData.ftLastWriteTime.dwLowDateTime;
+	const uint64_t ulEpochDifference = 116444736000000000ULL;
+	return (ulFileTime > ulEpochDifference) ? (ulFileTime - ulEpochDifference) / 10000000ULL : 0;
+#else
+	struct stat fileStat;
+	if (stat(sPath.c_str(), &fileStat) != 0)
+		return 0;
+	return (fileStat.st_mtime > 0) ? (uint64_t)fileStat.st_mtime : 0;
+#endif
+}
+
+/**
+ @brief List the files in a folder and its sub-folders
+ @param sRootPath The folder which the file names are relative to
+ @param sFolder The folder to list, relative to sRootPath
+ @param files The list to append the file names to, e.g. "Image/Scene2D/Tile.png"
+ */
+void CAssetPacker::ListFiles(const std::string& sRootPath, const std::string& sFolder, std::vector<std::string>& files)
+{
+#ifdef _WIN32
+	WIN32_FIND_DATAA findData;
+	HANDLE hFind = FindFirstFileA((sRootPath + "/" + sFolder + "/*").c_str(), &findData);
+	if (hFind == INVALID_HANDLE_VALUE)
+		return;
+	do
+	{
+		std::string sName = findData.cFileName;
+		if ((sName == ".") || (sName == ".."))
+			continue;
+		if (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+			ListFiles(sRootPath, sFolder + "/" + sName, files);
+		else
+			files.push_back(sFolder + "/" + sName);
+	} while (FindNextFileA(hFind, &findData));
+	FindClose(hFind);
+#else
+	DIR* pDir = opendir((sRootPath + "/" + sFolder).c_str());
+	if (pDir == NULL)
+		return;
+	struct dirent* pEntry;
+	while ((pEntry = readdir(pDir)) != NULL)
+	{
+		std::string sName = pEntry->d_name;
+		if ((sName == ".") || (sName == ".."))
+			continue;
+		struct stat fileStat;
+		if (stat((sRootPath + "/" + sFolder + "/" + sName).c_str(), &fileStat) != 0)
+			continue;
+		if (S_ISDIR(fileStat.st_mode))
+			ListFiles(sRootPath, sFolder + "/" + sName, files);
+		else
+			files.push_back(sFolder + "/" + sName);
+	}
+	closedir(pDir);
+#endif
+}
+
+/**
+ @brief Decode an image into RGBA rows from the bottom, as most images are loaded with bInvert = true.
+		Each mip level is box filtered from the level before it, down to 1 x 1
+ @param sPath The full path of the image
+ @param bMipMaps true to append the mip levels after the image
+ @param sEntry The entry to fill in the size of the image
+ @param data The cooked data
+ */
+bool CAssetPacker::CookImage(const std::string& sPath, const bool bMipMaps, CAssetPack::SEntry& sEntry, std::vector<unsigned char>& data)
+{
+	int iWidth = 0, iHeight = 0, iChannels = 0;
+	unsigned char* pPixels = stbi_load(sPath.c_str(), &iWidth, &iHeight, &iChannels, 4);
+	if (pPixels == NULL)
+		return false;
+	CImageLoader::FlipVertically(pPixels, iWidth, iHeight, 4);
+
+	sEntry.uiFlags = CAssetPack::IMAGE_INVERTED;
+	sEntry.uiWidth = iWidth;
+	sEntry.uiHeight = iHeight;
+	sEntry.uiNumLevels = 1;
+	data.assign(pPixels, pPixels + (size_t)iWidth * iHeight * 4);
+	stbi_image_free(pPixels);
+
+	size_t uiLevelOffset = 0;
+	while ((bMipMaps) && ((iWidth > 1) || (iHeight > 1)))
+	{
+		int iLevelWidth = (iWidth > 1) ? iWidth / 2 : 1;
+		int iLevelHeight = (iHeight > 1) ? iHeight / 2 : 1;
+		size_t uiNextOffset = data.size();
+		data.resize(uiNextOffset + (size_t)iLevelWidth * iLevelHeight * 4);
+
+		for (int y = 0; y < iLevelHeight; y++)
+		{
+			int y0 = y * 2;
+			int y1 = (y0 + 1 < iHeight) ? y0 + 1 : y0;
+			for (int x = 0; x < iLevelWidth; x++)
+			{
+				int x0 = x * 2;
+				int x1 = (x0 + 1 < iWidth) ? x0 + 1 : x0;
+				for (int c = 0; c < 4; c++)
+				{
+					unsigned int uiSum = data[uiLevelOffset + ((size_t)y0 * iWidth + x0) * 4 + c] +
+										data[uiLevelOffset + ((size_t)y0 * iWidth + x1) * 4 + c] +
+										data[uiLevelOffset + ((size_t)y1 * iWidth + x0) * 4 + c] +
+										data[uiLevelOffset + ((size_t)y1 * iWidth + x1) * 4 + c];
+					data[uiNextOffset + ((size_t)y * iLevelWidth + x) * 4 + c] = (unsigned char)((uiSum + 2) / 4);
+				}
+			}
+		}
+
+		uiLevelOffset = uiNextOffset;
+		iWidth = iLevelWidth;
+		iHeight = iLevelHeight;
+		sEntry.uiNumLevels++;
+	}
+	return true;
+}
+
+/**
+ @brief Parse a CSV map into its tile values row by row, followed by the column names separated by '\n',
+		so that CMap2D::SaveMap() can still write the same header
+ @param sPath The full path of the map
+ @param sEntry The entry to fill in the size of the map
+ @param data The cooked data
+ */
+bool CAssetPacker::CookMap(const std::string& sPath, CAssetPack::SEntry& sEntry, std::vector<unsigned char>& data)
+{
+	try
+	{
+		rapidcsv::Document doc(sPath);
+		const size_t uiNumColumns = doc.GetColumnCount();
+		const size_t uiNumRows = doc.GetRowCount();
+
+		std::vector<int32_t> values(uiNumColumns * uiNumRows);
+		for (size_t uiRow = 0; uiRow < uiNumRows; uiRow++)
+		{
+			std::vector<std::string> row = doc.GetRow<std::string>(uiRow);
+			for (size_t uiCol = 0; uiCol < uiNumColumns; uiCol++)
+				values[uiRow * uiNumColumns + uiCol] = (int32_t)stoi(row[uiCol]);
+		}
+
+		std::string sColumnNames;
+		std::vector<std::string> columnNames = doc.GetColumnNames();
+		for (size_t i = 0; i < columnNames.size(); i++)
+		{
+			if (i > 0)
+				sColumnNames += '\n';
+			sColumnNames += columnNames[i];
+		}
+
+		sEntry.uiWidth = (uint32_t)uiNumColumns;
+		sEntry.uiHeight = (uint32_t)uiNumRows;
+		data.resize(values.size() * sizeof(int32_t) + sColumnNames.size());
+		if (!values.empty())
+			memcpy(&data[0], &values[0], values.size() * sizeof(int32_t));
+		if (!sColumnNames.empty())
+			memcpy(&data[values.size() * sizeof(int32_t)], sColumnNames.c_str(), sColumnNames.size());
+	}
+	catch (const std::exception& e)
+	{
+		cout << "CAssetPacker::CookMap(): " << e.what() << endl;
+		return false;
+	}
+	return true;
+}
+
+/**
+ @brief Read a text file as it is
+ @param sPath The full path of the file
+ @param sEntry The entry of the file
+ @param data The text
+ */
+bool CAssetPacker::CookText(const std::string& sPath, CAssetPack::SEntry& sEntry, std::vector<unsigned char>& data)
+{
+	std::ifstream textFile(sPath.c_str(), std::ios::binary);
+	if (!textFile.is_open())
+		return false;
+	std::stringstream textStream;
+	textStream << textFile.rdbuf();
+	std::string sText = textStream.str();
+	data.assign(sText.begin(), sText.end());
+	return true;
+}
@@ -0,0 +1,39 @@
+/**
+ CAssetPacker
+ @brief A class to cook the loose digital assets into an asset pack for CAssetPack.
+		The images are decoded into RGBA and inverted, with an optional mip chain,
+		the maps are parsed into tile values, and the shaders and the data files are stored as text.
+		Run the application with "--cook" (and "--mips" for the mip chains) to cook the pack.
+ */
+#pragma once
+
+// Include CAssetPack for the layout of the pack
+#include "AssetPack.h"
+
+#include <string>
+#include <vector>
+
+class CAssetPacker
+{
+public:
+	// Cook the assets in the Image, Maps, Shader and Data folders under sRootPath into sPackFile
+	static bool Cook(const std::string& sRootPath, const std::string& sPackFile, const bool bMipMaps);
+
+	// Get the newest modification time of the files under sRootPath which are cooked, to check if a pack is stale
+	static uint64_t GetNewestSourceTime(const std::string& sRootPath);
+
+protected:
+	// List the files in a folder and its sub-folders, relative to sRootPath
+	static void ListFiles(const std::string& sRootPath, const std::string& sFolder, std::vector<std::string>& files);
+	// List the files under sRootPath which are cooked, and the types which they are cooked as
+	static void ListAssets(const std::string& sRootPath, std::vector<std::string>& cookFiles, std::vector<CAssetPack::ASSET_TYPE>& cookTypes);
+	// Get the modification time of a file in seconds since 1970, or 0 if it does not exist
+	static uint64_t GetModifiedTime(const std::string& sPath);
+
+	// Decode an image into RGBA rows from the bottom, and append its mip levels if bMipMaps is true
+	static bool CookImage(const std::string& sPath, const bool bMipMaps, CAssetPack::SEntry& sEntry, std::vector<unsigned char>& data);
+	// Parse a CSV map into its tile values and column names, in the same way as CMap2D::LoadMap()
+	static bool CookMap(const std::string& sPath, CAssetPack::SEntry& sEntry, std::vector<unsigned char>& data);
+	// Read a text file as it is
+	static bool CookText(const std::string& sPath, CAssetPack::SEntry& sEntry, std::vector<unsigned char>& data);
+};
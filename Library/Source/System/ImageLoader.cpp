@@ -22,10 +22,25 @@ using namespace std;
 #include <includes/stb_image.h>
 #include "filesystem.h"
 
+// Include Render State
+#include "..\RenderControl\RenderState.h"
+// Include CAssetPack to load the cooked images
+#include "AssetPack.h"
+// Include CProfiler for the profiler zones
+#include "..\TimeControl\Profiler.h"
+
+#include <fstream>
+#include <chrono>
+#include <cstring>
+
 /**
  @brief Constructor This constructor has protected access modifier as this class will be a Singleton
  */
 CImageLoader::CImageLoader(void)
+	: uiNumDecoding(0)
+	, bStopThreads(false)
+	, uiNumUploads(0)
+	, uiPixelBuffer(0)
 {
 }
 
@@ -34,6 +49,7 @@ CImageLoader::CImageLoader(void)
  */
 CImageLoader::~CImageLoader(void)
 {
+	Exit();
 }
 
 /**
@@ -44,6 +60,36 @@ bool CImageLoader::Init(void)
 	return false;
 }
 
+/**
+@brief Stop the decoding threads, free the images which were not uploaded and delete the pixel buffer
+*/
+void CImageLoader::Exit(void)
+{
+	{
+		std::lock_guard<std::mutex> lock(jobMutex);
+		bStopThreads = true;
+	}
+	jobCondition.notify_all();
+	for (unsigned int i = 0; i < decodeThreads.size(); i++)
+		decodeThreads[i].join();
+	decodeThreads.clear();
+	bStopThreads = false;
+
+	for (unsigned int i = 0; i < uploadJobs.size(); i++)
+	{
+		if (uploadJobs[i].pData)
+			stbi_image_free(uploadJobs[i].pData);
+	}
+	uploadJobs.clear();
+	decodeJobs.clear();
+
+	if (uiPixelBuffer != 0)
+	{
+		CRenderState::GetInstance()->DeleteBuffer(uiPixelBuffer);
+		uiPixelBuffer = 0;
+	}
+}
+
 /**
  @brief Load an image and return as unsigned char*
  @param filename A const char* storing the name of the image file
@@ -54,35 +100,44 @@ bool CImageLoader::Init(void)
  */
 unsigned char * CImageLoader::Load(const char* filename, int& width, int& height, int& nrChannels, const bool bInvert)
 {
-	// tell stb_image.h to flip loaded texture's on the y-axis.
-	stbi_set_flip_vertically_on_load(bInvert);
-
 	// load image, create texture and generate mipmaps
 	unsigned char *data = stbi_load(FileSystem::getPath(filename).c_str(),
 									&width, &height, &nrChannels, 0);
 
+	// flip the loaded texture on the y-axis.
+	if ((data != NULL) && (bInvert))
+		FlipVertically(data, width, height, nrChannels);
+
 	// Return the data but you must remember to free up the memory of the file data read in
 	return data;
 }
 
 /**
  @brief Load an image into the graphics card and return its ID.
+		An image which was loaded before returns the same ID.
  @param filename A const char* storing the name of the image file
  @param bInvert A const bool
  */
 unsigned int CImageLoader::LoadTextureGetID(const char* filename,  const bool bInvert)
 {
+	// Reuse the texture if this image was loaded before
+	std::map<std::pair<std::string, bool>, unsigned int>::iterator it = textureMap.find(std::make_pair(std::string(filename), bInvert));
+	if (it != textureMap.end())
+		return it->second;
+
+	// Upload the cooked image directly from the asset pack, as it needs no decoding
+	GLuint image_texture = LoadTextureFromPack(filename, bInvert);
+	if (image_texture != 0)
+	{
+		textureMap[std::make_pair(std::string(filename), bInvert)] = image_texture;
+		return image_texture;
+	}
+
 	// Load from file
 	int image_width = 0;
 	int image_height = 0;
 	int nrChannels = 0;
-
-	// tell stb_image.h to flip loaded texture's on the y-axis.
-	stbi_set_flip_vertically_on_load(bInvert);
-
-	// load image, create texture and generate mipmaps
-	unsigned char* data = stbi_load(FileSystem::getPath(filename).c_str(),
-		&image_width, &image_height, &nrChannels, 0);
+	unsigned char* data = Load(filename, image_width, image_height, nrChannels, bInvert);
 
 	if (data == NULL)
 	{
@@ -91,32 +146,341 @@ unsigned int CImageLoader::LoadTextureGetID(const char* filename,  const bool bI
 	}
 
 	// Create a OpenGL texture identifier
-	GLuint image_texture;
-	glGenTextures(1, &image_texture);
-	glBindTexture(GL_TEXTURE_2D, image_texture);
+	image_texture = CreateTexture();
+
+	// Upload pixels into texture
+	UploadTexture(image_texture, image_width, image_height, nrChannels, data);
+	stbi_image_free(data);
+
+	textureMap[std::make_pair(std::string(filename), bInvert)] = image_texture;
+	return image_texture;
+}
+
+/**
+ @brief Decode an image on a worker thread and return its Texture ID at once.
+		The texture is a transparent placeholder until Update() uploads the image into it.
+		An image which was loaded before returns the same ID.
+ @param filename A const char* storing the name of the image file
+ @param bInvert A const bool
+ @return The Texture ID, or 0 if the file cannot be opened
+ */
+unsigned int CImageLoader::LoadTextureAsync(const char* filename, const bool bInvert)
+{
+	// Reuse the texture if this image was loaded before
+	std::map<std::pair<std::string, bool>, unsigned int>::iterator it = textureMap.find(std::make_pair(std::string(filename), bInvert));
+	if (it != textureMap.end())
+		return it->second;
+
+	// Upload the cooked image directly from the asset pack, as it needs no decoding
+	GLuint image_texture = LoadTextureFromPack(filename, bInvert);
+	if (image_texture != 0)
+	{
+		textureMap[std::make_pair(std::string(filename), bInvert)] = image_texture;
+		return image_texture;
+	}
+
+	// Check that the file exists, so that the caller can still handle a missing file at once
+	std::string sPath = FileSystem::getPath(filename);
+	if (!std::ifstream(sPath.c_str()).good())
+	{
+		cout << "CImageLoader::LoadTextureAsync(): Unable to load " << sPath.c_str() << endl;
+		return 0;
+	}
+
+	// Create the texture with a 1 x 1 transparent placeholder
+	image_texture = CreateTexture();
+	const unsigned char placeholder[4] = { 0, 0, 0, 0 };
+	UploadTexture(image_texture, 1, 1, 4, placeholder);
+
+	// Start the decoding threads on the first call. Leave a core for the OpenGL thread
+	if (decodeThreads.empty())
+	{
+		unsigned int uiNumThreads = std::thread::hardware_concurrency();
+		uiNumThreads = (uiNumThreads > 2) ? uiNumThreads - 1 : 1;
+		for (unsigned int i = 0; i < uiNumThreads; i++)
+			decodeThreads.push_back(std::thread(&CImageLoader::DecodeThread, this));
+	}
+
+	SImageJob sJob;
+	sJob.uiTextureID = image_texture;
+	sJob.sPath = sPath;
+	sJob.bInvert = bInvert;
+	sJob.pData = NULL;
+	sJob.iWidth = 0;
+	sJob.iHeight = 0;
+	sJob.iChannels = 0;
+	{
+		std::lock_guard<std::mutex> lock(jobMutex);
+		decodeJobs.push_back(sJob);
+	}
+	jobCondition.notify_one();
+
+	textureMap[std::make_pair(std::string(filename), bInvert)] = image_texture;
+	return image_texture;
+}
+
+/**
+ @brief Upload the decoded images until the time budget is used up. At least one image is
+		uploaded per call, so that the loading always progresses
+ @param dTimeBudget The time in seconds which can be spent on uploading in this frame
+ */
+void CImageLoader::Update(const double dTimeBudget)
+{
+	PROFILE_FUNCTION();
+
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	while (true)
+	{
+		SImageJob sJob;
+		{
+			std::lock_guard<std::mutex> lock(jobMutex);
+			if (uploadJobs.empty())
+				return;
+			sJob = uploadJobs.front();
+			uploadJobs.pop_front();
+		}
+
+		UploadJob(sJob);
+
+		std::chrono::duration<double> elapsedTime = std::chrono::steady_clock::now() - startTime;
+		if (elapsedTime.count() >= dTimeBudget)
+			return;
+	}
+}
+
+/**
+ @brief Get the number of images which are still being decoded or waiting to be uploaded
+ */
+unsigned int CImageLoader::GetNumPendingLoads(void) const
+{
+	std::lock_guard<std::mutex> lock(jobMutex);
+	return decodeJobs.size() + uiNumDecoding + uploadJobs.size();
+}
+
+/**
+ @brief Get the number of images which Update() has uploaded, so that anything which drew the
+		placeholders, e.g. a cache, can tell that it has to be drawn again
+ */
+unsigned int CImageLoader::GetNumUploads(void) const
+{
+	return uiNumUploads;
+}
+
+/**
+ @brief Flip an image vertically in place. stbi_set_flip_vertically_on_load() is a global setting
+		which is not safe to change while the decoding threads are loading, so the images are flipped here
+ @param pData The pixels of the image
+ @param iWidth The width of the image
+ @param iHeight The height of the image
+ @param iChannels The number of channels in the image
+ */
+void CImageLoader::FlipVertically(unsigned char* pData, const int iWidth, const int iHeight, const int iChannels)
+{
+	const size_t rowSize = (size_t)iWidth * iChannels;
+	std::vector<unsigned char> row(rowSize);
+	for (int iRow = 0; iRow < iHeight / 2; iRow++)
+	{
+		unsigned char* pTop = pData + iRow * rowSize;
+		unsigned char* pBottom = pData + (iHeight - iRow - 1) * rowSize;
+		memcpy(&row[0], pTop, rowSize);
+		memcpy(pTop, pBottom, rowSize);
+		memcpy(pBottom, &row[0], rowSize);
+	}
+}
+
+/**
+ @brief Create a texture with the filtering parameters used for all images
+ @return The new Texture ID, which is bound to the active texture unit
+ */
+GLuint CImageLoader::CreateTexture(void)
+{
+	CRenderState* cRenderState = CRenderState::GetInstance();
+	GLuint image_texture = cRenderState->GenTexture();
+	cRenderState->BindTexture2D(image_texture);
 
 	// Setup filtering parameters for display
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE); // This is required on WebGL for non power-of-two textures
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE); // Same
+	cRenderState->TexParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	cRenderState->TexParameter(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	cRenderState->TexParameter(GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE); // This is required on WebGL for non power-of-two textures
+	cRenderState->TexParameter(GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE); // Same
+
+	return image_texture;
+}
+
+/**
+ @brief Upload pixels into a texture and generate its mipmaps
+ @param uiTextureID The texture to upload into
+ @param iWidth The width of the image
+ @param iHeight The height of the image
+ @param iChannels The number of channels in the image
+ @param pPixels The pixels, or an offset into the bound pixel unpack buffer
+ */
+void CImageLoader::UploadTexture(const GLuint uiTextureID, const int iWidth, const int iHeight, const int iChannels, const void* pPixels)
+{
+	CRenderState::GetInstance()->BindTexture2D(uiTextureID);
 
 	// Upload pixels into texture
+	UploadTextureLevel(0, iWidth, iHeight, iChannels, pPixels);
+
+	// Generate mipmaps
+	CRenderState::GetInstance()->GenerateMipmap();
+}
+
+/**
+ @brief Upload pixels into a mip level of the bound texture
+ @param iLevel The mip level, where 0 is the full size image
+ @param iWidth The width of the mip level
+ @param iHeight The height of the mip level
+ @param iChannels The number of channels in the image
+ @param pPixels The pixels, or an offset into the bound pixel unpack buffer
+ */
+void CImageLoader::UploadTextureLevel(const int iLevel, const int iWidth, const int iHeight, const int iChannels, const void* pPixels)
+{
+	CRenderState* cRenderState = CRenderState::GetInstance();
 #if defined(GL_UNPACK_ROW_LENGTH) && !defined(__EMSCRIPTEN__)
-	glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+	cRenderState->PixelStore(GL_UNPACK_ROW_LENGTH, 0);
 #endif
-	if (nrChannels == 1)
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE, image_width, image_height, 0, GL_LUMINANCE, GL_UNSIGNED_BYTE, data);
-	else if (nrChannels == 3)
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, image_width, image_height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
-	else if (nrChannels == 4)
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, image_width, image_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-	
-	// Generate mipmaps
-	glGenerateMipmap(GL_TEXTURE_2D);
-//	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, image_width, image_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-	stbi_image_free(data);
+	// The rows of stb_image are tightly packed, which is not 4-byte aligned for some RGB widths
+	cRenderState->PixelStore(GL_UNPACK_ALIGNMENT, 1);
+	if (iChannels == 1)
+		cRenderState->TexImage2D(iLevel, GL_LUMINANCE, iWidth, iHeight, GL_LUMINANCE, GL_UNSIGNED_BYTE, pPixels);
+	else if (iChannels == 3)
+		cRenderState->TexImage2D(iLevel, GL_RGB, iWidth, iHeight, GL_RGB, GL_UNSIGNED_BYTE, pPixels);
+	else if (iChannels == 4)
+		cRenderState->TexImage2D(iLevel, GL_RGBA, iWidth, iHeight, GL_RGBA, GL_UNSIGNED_BYTE, pPixels);
+	cRenderState->PixelStore(GL_UNPACK_ALIGNMENT, 4);
+}
+
+/**
+ @brief Upload an image from the asset pack. The pixels are read straight from the mapped pack,
+		and the mip levels are uploaded if they were cooked, instead of generating them
+ @param filename A const char* storing the name of the image file
+ @param bInvert A const bool
+ @return The Texture ID, or 0 if no asset pack is opened or the image is not in it
+ */
+unsigned int CImageLoader::LoadTextureFromPack(const char* filename, const bool bInvert)
+{
+	const CAssetPack* cAssetPack = CAssetPack::GetInstance();
+	const CAssetPack::SEntry* pEntry = cAssetPack->Find(filename, CAssetPack::ASSET_IMAGE);
+	if (pEntry == NULL)
+		return 0;
+
+	GLuint image_texture = CreateTexture();
+
+	const unsigned char* pPixels = cAssetPack->GetData(pEntry);
+	const bool bInverted = (pEntry->uiFlags & CAssetPack::IMAGE_INVERTED) != 0;
+	std::vector<unsigned char> flipped;
+	int iWidth = (int)pEntry->uiWidth;
+	int iHeight = (int)pEntry->uiHeight;
+	for (unsigned int uiLevel = 0; uiLevel < pEntry->uiNumLevels; uiLevel++)
+	{
+		const size_t uiLevelSize = (size_t)iWidth * iHeight * 4;
+		const unsigned char* pLevel = pPixels;
+		// The image was cooked for the other orientation, so flip a copy of it
+		if (bInverted != bInvert)
+		{
+			flipped.assign(pPixels, pPixels + uiLevelSize);
+			FlipVertically(&flipped[0], iWidth, iHeight, 4);
+			pLevel = &flipped[0];
+		}
+		UploadTextureLevel(uiLevel, iWidth, iHeight, 4, pLevel);
+
+		pPixels += uiLevelSize;
+		iWidth = (iWidth > 1) ? iWidth / 2 : 1;
+		iHeight = (iHeight > 1) ? iHeight / 2 : 1;
+	}
+
+	// Generate the mipmaps if they were not cooked
+	if (pEntry->uiNumLevels <= 1)
+		CRenderState::GetInstance()->GenerateMipmap();
 
 	return image_texture;
 }
 
+/**
+ @brief Upload a decoded image into its texture through the pixel buffer
+ @param sJob The decoded image. Its pixels are freed here
+ */
+void CImageLoader::UploadJob(SImageJob& sJob)
+{
+	if (sJob.pData == NULL)
+	{
+		// The texture keeps the placeholder
+		cout << "CImageLoader::UploadJob(): Unable to load " << sJob.sPath.c_str() << endl;
+		return;
+	}
+
+	CRenderState* cRenderState = CRenderState::GetInstance();
+	GLsizeiptr iSize = (GLsizeiptr)sJob.iWidth * sJob.iHeight * sJob.iChannels;
+	if (uiPixelBuffer == 0)
+		uiPixelBuffer = cRenderState->GenBuffer();
+	cRenderState->BindBuffer(GL_PIXEL_UNPACK_BUFFER, uiPixelBuffer);
+	// Orphan the previous storage, so that the driver does not wait for the previous upload to finish
+	cRenderState->BufferData(GL_PIXEL_UNPACK_BUFFER, iSize, NULL, GL_STREAM_DRAW);
+	void* pMapped = cRenderState->MapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, iSize, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+	bool bMapped = false;
+	if (pMapped != NULL)
+	{
+		memcpy(pMapped, sJob.pData, (size_t)iSize);
+		// The contents are lost if the buffer was corrupted while it was mapped
+		bMapped = cRenderState->UnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+	}
+
+	if (bMapped)
+	{
+		// The pixels are read from offset 0 of the bound pixel buffer
+		UploadTexture(sJob.uiTextureID, sJob.iWidth, sJob.iHeight, sJob.iChannels, (const void*)0);
+		cRenderState->BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	}
+	else
+	{
+		// Upload from client memory instead, just like LoadTextureGetID()
+		cRenderState->BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		UploadTexture(sJob.uiTextureID, sJob.iWidth, sJob.iHeight, sJob.iChannels, sJob.pData);
+	}
+
+	stbi_image_free(sJob.pData);
+	sJob.pData = NULL;
+	uiNumUploads++;
+}
+
+/**
+ @brief The loop of the decoding threads. It decodes the images in the order which they were requested
+ */
+void CImageLoader::DecodeThread(void)
+{
+	CProfiler::GetInstance()->SetThreadName("Image Decoder");
+	while (true)
+	{
+		SImageJob sJob;
+		{
+			std::unique_lock<std::mutex> lock(jobMutex);
+			while ((!bStopThreads) && (decodeJobs.empty()))
+				jobCondition.wait(lock);
+			if (bStopThreads)
+				return;
+			sJob = decodeJobs.front();
+			decodeJobs.pop_front();
+			uiNumDecoding++;
+		}
+
+		{
+			PROFILE_SCOPE("CImageLoader::DecodeImage");
+			sJob.pData = stbi_load(sJob.sPath.c_str(), &sJob.iWidth, &sJob.iHeight, &sJob.iChannels, 0);
+			if ((sJob.pData != NULL) && (sJob.bInvert))
+				FlipVertically(sJob.pData, sJob.iWidth, sJob.iHeight, sJob.iChannels);
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(jobMutex);
+			uiNumDecoding--;
+			if (bStopThreads)
+			{
+				if (sJob.pData)
+					stbi_image_free(sJob.pData);
+				return;
+			}
+			uploadJobs.push_back(sJob);
+		}
+	}
+}
@@ -15,6 +15,14 @@
 #define GLEW_STATIC
 #endif
 
+#include <string>
+#include <map>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
 class CImageLoader : public CSingletonTemplate<CImageLoader>
 {
 	friend CSingletonTemplate<CImageLoader>;
@@ -22,6 +30,9 @@ public:
 	// Init
 	bool Init(void);
 
+	// Stop the decoding threads and delete the pixel buffer. This must be called while the OpenGL context exists
+	void Exit(void);
+
 	// Load an image and return as unsigned char*
 	unsigned char * Load(	const char* filename, 
 							int& width, int& height, 
@@ -29,11 +40,70 @@ public:
 
 	// Load an image and return as a Texture ID
 	unsigned int LoadTextureGetID(const char* filename, const bool bInvert);
+
+	// Decode an image on a worker thread and return a Texture ID at once.
+	// The texture is a transparent placeholder until Update() uploads the image into it
+	unsigned int LoadTextureAsync(const char* filename, const bool bInvert);
+
+	// Upload the decoded images until the time budget is used up. Call this once per frame on the OpenGL thread
+	void Update(const double dTimeBudget);
+
+	// Get the number of images which are still being decoded or waiting to be uploaded
+	unsigned int GetNumPendingLoads(void) const;
+
+	// Get the number of images which Update() has uploaded. It changes whenever a placeholder is replaced
+	unsigned int GetNumUploads(void) const;
+
+	// Flip an image vertically in place
+	static void FlipVertically(unsigned char* pData, const int iWidth, const int iHeight, const int iChannels);
+
 protected:
+	// An image which is decoded on a worker thread and uploaded on the OpenGL thread
+	struct SImageJob
+	{
+		unsigned int uiTextureID;
+		std::string sPath;
+		bool bInvert;
+		unsigned char* pData;
+		int iWidth;
+		int iHeight;
+		int iChannels;
+	};
+
 	// Constructor
 	CImageLoader(void);
 
 	// Destructor
 	virtual ~CImageLoader(void);
+
+	// Create a texture with the filtering parameters used for all images
+	GLuint CreateTexture(void);
+	// Upload pixels into a texture and generate its mipmaps
+	void UploadTexture(const GLuint uiTextureID, const int iWidth, const int iHeight, const int iChannels, const void* pPixels);
+	// Upload pixels into a mip level of the bound texture
+	void UploadTextureLevel(const int iLevel, const int iWidth, const int iHeight, const int iChannels, const void* pPixels);
+	// Upload an image from the asset pack, or return 0 if it is not in the pack
+	unsigned int LoadTextureFromPack(const char* filename, const bool bInvert);
+	// Upload a decoded image through the pixel buffer
+	void UploadJob(SImageJob& sJob);
+	// The loop of the decoding threads
+	void DecodeThread(void);
+
+	// The textures which were loaded, with their file names and whether they were inverted
+	std::map<std::pair<std::string, bool>, unsigned int> textureMap;
+
+	// The decoding threads, and the jobs waiting to be decoded and uploaded
+	std::vector<std::thread> decodeThreads;
+	std::deque<SImageJob> decodeJobs;
+	std::deque<SImageJob> uploadJobs;
+	unsigned int uiNumDecoding;
+	mutable std::mutex jobMutex;
+	std::condition_variable jobCondition;
+	bool bStopThreads;
+	// The number of images which were uploaded by UploadJob()
+	unsigned int uiNumUploads;
+
+	// The pixel buffer which the decoded images are copied into for uploading
+	GLuint uiPixelBuffer;
 };
 
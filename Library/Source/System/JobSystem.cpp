@@ -0,0 +1,380 @@
+/**
+ CJobSystem
+ @brief A class to run jobs on a pool of worker threads, with work stealing.
+		Each thread has its own queue of jobs. A thread runs the newest job of its own queue first,
+		and when its queue is empty, it steals the oldest job from the queue of another thread.
+		A job can have a parent, which is only finished when all its children are finished,
+		and continuations, which are run when it is finished. Wait() runs the queued jobs
+		while it waits, so the main thread is one of the threads which run the jobs.
+		ParallelFor() splits a range of indices into jobs, which split themselves again when
+		they are run, so that a thief takes a large part of the range.
+		Only the main thread and the worker threads can create, run and wait for jobs.
+ */
+#include "JobSystem.h"
+
+// Include CProfiler to name the worker threads
+#include "../TimeControl/Profiler.h"
+
+#include <iostream>
+#include <algorithm>
+using namespace std;
+
+// The index of the calling thread in threadData. The main thread is 0
+static thread_local unsigned int uiCurrentThreadIndex = 0;
+
+// The number of times an idle worker looks for a job before it sleeps
+static const unsigned int NUM_IDLE_SPINS = 64;
+
+/**
+@brief Constructor. The main thread can run jobs without any worker threads until Init() is called
+*/
+CJobSystem::CJobSystem(void)
+	: uiNumQueued(0)
+	, uiNumSleeping(0)
+	, bStopThreads(false)
+{
+	Init(0);
+}
+
+/**
+@brief Destructor
+*/
+CJobSystem::~CJobSystem(void)
+{
+	Exit();
+}
+
+/**
+@brief Start the worker threads. The workers which were started before are stopped first
+@param iNumWorkers The number of worker threads, or one for each core but one if it is negative
+@return true if the threads were started
+*/
+bool CJobSystem::Init(const int iNumWorkers)
+{
+	Exit();
+
+	unsigned int uiNumWorkers = 0;
+	if (iNumWorkers >= 0)
+	{
+		uiNumWorkers = (unsigned int)iNumWorkers;
+	}
+	else
+	{
+		// Leave a core for the main thread, which runs jobs in Wait()
+		unsigned int uiNumCores = std::thread::hardware_concurrency();
+		uiNumWorkers = (uiNumCores > 1) ? uiNumCores - 1 : 0;
+	}
+
+	for (unsigned int i = 0; i < uiNumWorkers + 1; i++)
+	{
+		SThreadData* pThreadData = new SThreadData();
+		pThreadData->pJobPool = new SJob[NUM_JOBS];
+		// The jobs which were not created yet are finished, so that CreateJob() can take them
+		for (unsigned int j = 0; j < NUM_JOBS; j++)
+			pThreadData->pJobPool[j].iUnfinished.store(0, std::memory_order_relaxed);
+		pThreadData->uiNumCreated = 0;
+		threadData.push_back(pThreadData);
+	}
+
+	bStopThreads = false;
+	for (unsigned int i = 0; i < uiNumWorkers; i++)
+		workerThreads.push_back(std::thread(&CJobSystem::WorkerThread, this, i + 1));
+
+	return true;
+}
+
+/**
+@brief Stop the worker threads and delete the jobs. The jobs which were not run are dropped
+*/
+void CJobSystem::Exit(void)
+{
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		bStopThreads = true;
+	}
+	sleepCondition.notify_all();
+	for (unsigned int i = 0; i < workerThreads.size(); i++)
+		workerThreads[i].join();
+	workerThreads.clear();
+
+	for (unsigned int i = 0; i < threadData.size(); i++)
+	{
+		delete[] threadData[i]->pJobPool;
+		delete threadData[i];
+	}
+	threadData.clear();
+	uiNumQueued = 0;
+}
+
+/**
+@brief Get the number of threads which run the jobs, including the main thread
+*/
+unsigned int CJobSystem::GetNumThreads(void) const
+{
+	return threadData.size();
+}
+
+/**
+@brief Get the index of the calling thread. The main thread is 0, and the worker threads are from 1
+*/
+unsigned int CJobSystem::GetThreadIndex(void)
+{
+	return uiCurrentThreadIndex;
+}
+
+/**
+@brief Create a job from the jobs of the calling thread. The jobs are reused in turn, so if the job
+		which was created NUM_JOBS jobs ago is not finished, the queued jobs are run until it is
+@param fnJob The function of the job. It can be empty, e.g. for a job which only waits for its children
+@param pParent The parent of the job, or NULL. The parent is not finished until this job is
+@return The job
+*/
+CJobSystem::SJob* CJobSystem::CreateJob(const JobFunction& fnJob, SJob* pParent)
+{
+	SThreadData* pThreadData = threadData[uiCurrentThreadIndex];
+	SJob* pJob = &pThreadData->pJobPool[pThreadData->uiNumCreated % NUM_JOBS];
+	pThreadData->uiNumCreated++;
+
+	// NUM_JOBS jobs of this thread are unfinished, so run the queued jobs until the oldest of them is finished
+	if (!IsFinished(pJob))
+		Wait(pJob);
+
+	pJob->fnJob = fnJob;
+	pJob->pParent = pParent;
+	pJob->iUnfinished.store(1, std::memory_order_relaxed);
+	pJob->uiNumContinuations.store(0, std::memory_order_relaxed);
+	if (pParent)
+		pParent->iUnfinished.fetch_add(1, std::memory_order_relaxed);
+	return pJob;
+}
+
+/**
+@brief Run a job after another job is finished. It must be added before the other job is run,
+		and it must not be run in any other way. For a job which depends on several jobs,
+		make them the children of a job and add the continuation to that job
+@param pJob The job which is run first
+@param pContinuation The job which is run after it
+@return true if the continuation was added, false if the job has MAX_CONTINUATIONS already
+*/
+bool CJobSystem::AddContinuation(SJob* pJob, SJob* pContinuation)
+{
+	unsigned int uiIndex = pJob->uiNumContinuations.fetch_add(1, std::memory_order_relaxed);
+	if (uiIndex >= MAX_CONTINUATIONS)
+	{
+		pJob->uiNumContinuations.fetch_sub(1, std::memory_order_relaxed);
+		cout << "CJobSystem::AddContinuation(): A job has " << MAX_CONTINUATIONS << " continuations already" << endl;
+		return false;
+	}
+	pJob->arrContinuations[uiIndex] = pContinuation;
+	return true;
+}
+
+/**
+@brief Queue a job on the calling thread. Another thread can steal it if this thread is busy
+@param pJob The job
+*/
+void CJobSystem::Run(SJob* pJob)
+{
+	SThreadData* pThreadData = threadData[uiCurrentThreadIndex];
+	{
+		std::lock_guard<std::mutex> lock(pThreadData->jobsMutex);
+		pThreadData->jobs.push_back(pJob);
+	}
+	uiNumQueued.fetch_add(1);
+
+	// Wake up a worker if any are sleeping. The sleeping workers are counted before they check for
+	// the queued jobs, so a worker which is about to sleep either sees this job or is woken up
+	if (uiNumSleeping.load() > 0)
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		sleepCondition.notify_one();
+	}
+}
+
+/**
+@brief Run the queued jobs, of this thread first, until a job is finished
+@param pJob The job
+*/
+void CJobSystem::Wait(const SJob* pJob)
+{
+	while (!IsFinished(pJob))
+	{
+		SJob* pNextJob = GetJob();
+		if (pNextJob)
+			Execute(pNextJob);
+		else
+			std::this_thread::yield();
+	}
+}
+
+/**
+@brief Check if a job and all its children are finished
+@param pJob The job
+*/
+bool CJobSystem::IsFinished(const SJob* pJob) const
+{
+	return (pJob->iUnfinished.load(std::memory_order_acquire) <= 0);
+}
+
+/**
+@brief Call a function for parts of a range of indices on all the threads, and return when all of them are done
+@param uiCount The number of indices in the range, from 0
+@param uiGrainSize The smallest number of indices in a part. A part which takes about
+		a few microseconds keeps the cost of the jobs small
+@param fnRange The function which is called with the first index and the index after the last one of a part
+*/
+void CJobSystem::ParallelFor(const unsigned int uiCount, const unsigned int uiGrainSize, const RangeFunction& fnRange)
+{
+	if (uiCount == 0)
+		return;
+
+	unsigned int uiGrain = (uiGrainSize > 0) ? uiGrainSize : 1;
+	if ((uiCount <= uiGrain) || (threadData.size() == 1))
+	{
+		// Do not pay for the jobs if the range is not split
+		fnRange(0, uiCount);
+		return;
+	}
+
+	SJob* pJob = CreateRangeJob(0, uiCount, uiGrain, fnRange, NULL);
+	Run(pJob);
+	Wait(pJob);
+}
+
+/**
+@brief Take the newest job from the queue of the calling thread. If it is empty,
+		steal the oldest job from the queue of another thread
+@return The job, or NULL if all the queues are empty
+*/
+CJobSystem::SJob* CJobSystem::GetJob(void)
+{
+	if (uiNumQueued.load(std::memory_order_relaxed) == 0)
+		return NULL;
+
+	unsigned int uiNumThreads = threadData.size();
+	for (unsigned int i = 0; i < uiNumThreads; i++)
+	{
+		unsigned int uiThreadIndex = (uiCurrentThreadIndex + i) % uiNumThreads;
+		SThreadData* pThreadData = threadData[uiThreadIndex];
+		std::lock_guard<std::mutex> lock(pThreadData->jobsMutex);
+		if (pThreadData->jobs.empty())
+			continue;
+
+		SJob* pJob = NULL;
+		if (i == 0)
+		{
+			pJob = pThreadData->jobs.back();
+			pThreadData->jobs.pop_back();
+		}
+		else
+		{
+			pJob = pThreadData->jobs.front();
+			pThreadData->jobs.pop_front();
+		}
+		uiNumQueued.fetch_sub(1);
+		return pJob;
+	}
+	return NULL;
+}
+
+/**
+@brief Run a job and finish it
+@param pJob The job
+*/
+void CJobSystem::Execute(SJob* pJob)
+{
+	if (pJob->fnJob)
+		pJob->fnJob();
+	Finish(pJob);
+}
+
+/**
+@brief Finish a job. If it was its last part to finish, its continuations are queued
+		and its parent is finished
+@param pJob The job
+*/
+void CJobSystem::Finish(SJob* pJob)
+{
+	// Read everything before the job is seen as finished, as another thread can then reuse it
+	SJob* pParent = pJob->pParent;
+	SJob* arrContinuations[MAX_CONTINUATIONS];
+	unsigned int uiNumContinuations = std::min(pJob->uiNumContinuations.load(std::memory_order_relaxed), MAX_CONTINUATIONS);
+	for (unsigned int i = 0; i < uiNumContinuations; i++)
+		arrContinuations[i] = pJob->arrContinuations[i];
+
+	if (pJob->iUnfinished.fetch_sub(1, std::memory_order_acq_rel) != 1)
+		return;
+
+	for (unsigned int i = 0; i < uiNumContinuations; i++)
+		Run(arrContinuations[i]);
+
+	if (pParent)
+		Finish(pParent);
+}
+
+/**
+@brief Create a job which calls a function for a part of a range. When it is run, it queues
+		jobs for the upper halves of its range until the rest is no larger than the grain size
+@param uiBegin The first index of the range
+@param uiEnd The index after the last one of the range
+@param uiGrainSize The largest range which is not split
+@param fnRange The function. It must stay valid until the jobs are finished
+@param pParent The parent of the job, or NULL
+@return The job
+*/
+CJobSystem::SJob* CJobSystem::CreateRangeJob(	const unsigned int uiBegin, const unsigned int uiEnd, const unsigned int uiGrainSize,
+												const RangeFunction& fnRange, SJob* pParent)
+{
+	SJob* pJob = CreateJob(JobFunction(), pParent);
+	const RangeFunction* pfnRange = &fnRange;
+	pJob->fnJob = [this, pJob, uiBegin, uiEnd, uiGrainSize, pfnRange]()
+	{
+		unsigned int uiSplitEnd = uiEnd;
+		while (uiSplitEnd - uiBegin > uiGrainSize)
+		{
+			unsigned int uiMiddle = uiBegin + (uiSplitEnd - uiBegin) / 2;
+			Run(CreateRangeJob(uiMiddle, uiSplitEnd, uiGrainSize, *pfnRange, pJob));
+			uiSplitEnd = uiMiddle;
+		}
+		(*pfnRange)(uiBegin, uiSplitEnd);
+	};
+	return pJob;
+}
+
+/**
+@brief The loop of the worker threads. A worker runs the jobs until there are none,
+		and then sleeps until a job is queued
+@param uiThreadIndex The index of the worker in threadData
+*/
+void CJobSystem::WorkerThread(const unsigned int uiThreadIndex)
+{
+	uiCurrentThreadIndex = uiThreadIndex;
+	CProfiler::GetInstance()->SetThreadName("Job Worker " + std::to_string(uiThreadIndex));
+
+	unsigned int uiNumIdleSpins = 0;
+	while (!bStopThreads.load(std::memory_order_relaxed))
+	{
+		SJob* pJob = GetJob();
+		if (pJob)
+		{
+			Execute(pJob);
+			uiNumIdleSpins = 0;
+			continue;
+		}
+
+		// Look for a job a few more times before sleeping, as waking up takes a long time
+		if (uiNumIdleSpins < NUM_IDLE_SPINS)
+		{
+			uiNumIdleSpins++;
+			std::this_thread::yield();
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		uiNumSleeping.fetch_add(1);
+		while ((!bStopThreads) && (uiNumQueued.load() == 0))
+			sleepCondition.wait(lock);
+		uiNumSleeping.fetch_sub(1);
+		uiNumIdleSpins = 0;
+	}
+}
@@ -0,0 +1,124 @@
+/**
+ CJobSystem
+ @brief A class to run jobs on a pool of worker threads, with work stealing.
+		Each thread has its own queue of jobs. A thread runs the newest job of its own queue first,
+		and when its queue is empty, it steals the oldest job from the queue of another thread.
+		A job can have a parent, which is only finished when all its children are finished,
+		and continuations, which are run when it is finished. Wait() runs the queued jobs
+		while it waits, so the main thread is one of the threads which run the jobs.
+		ParallelFor() splits a range of indices into jobs, which split themselves again when
+		they are run, so that a thief takes a large part of the range.
+		Only the main thread and the worker threads can create, run and wait for jobs.
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+class CJobSystem : public CSingletonTemplate<CJobSystem>
+{
+	friend CSingletonTemplate<CJobSystem>;
+public:
+	// The number of jobs of each thread. The jobs are reused in turn, so at most this number of the
+	// jobs which a thread created can be unfinished at a time. When a thread creates a job while its
+	// oldest job is unfinished, it runs the queued jobs until that job is finished, so the oldest job
+	// must not wait for the jobs which are created after it. ParallelFor() creates about 2 * uiCount / uiGrainSize
+	// jobs, which are spread over the threads
+	static const unsigned int NUM_JOBS = 4096;
+	// The number of continuations of a job
+	static const unsigned int MAX_CONTINUATIONS = 8;
+
+	// The function of a job, and the function of ParallelFor() which is called for a part of the range
+	typedef std::function<void(void)> JobFunction;
+	typedef std::function<void(const unsigned int uiBegin, const unsigned int uiEnd)> RangeFunction;
+
+	// A job. It is finished when its function and all its children have finished
+	struct SJob
+	{
+		JobFunction fnJob;
+		SJob* pParent;
+		// 1 for the job itself, and 1 for each unfinished child
+		std::atomic<int> iUnfinished;
+		// The jobs which are run when this job is finished
+		SJob* arrContinuations[MAX_CONTINUATIONS];
+		std::atomic<unsigned int> uiNumContinuations;
+	};
+
+	// Start a number of worker threads, or one for each core but one if it is negative
+	bool Init(const int iNumWorkers = -1);
+
+	// Stop the worker threads. The jobs which were not run are dropped
+	void Exit(void);
+
+	// Get the number of threads which run the jobs, including the main thread
+	unsigned int GetNumThreads(void) const;
+
+	// Get the index of the calling thread. The main thread is 0
+	static unsigned int GetThreadIndex(void);
+
+	// Create a job. If it has a parent, the parent is not finished until this job is
+	SJob* CreateJob(const JobFunction& fnJob, SJob* pParent = NULL);
+
+	// Run a job after another job is finished. Add it before the other job is run, and do not run it yourself
+	bool AddContinuation(SJob* pJob, SJob* pContinuation);
+
+	// Queue a job on the calling thread
+	void Run(SJob* pJob);
+
+	// Run the queued jobs until a job is finished
+	void Wait(const SJob* pJob);
+
+	// Check if a job is finished
+	bool IsFinished(const SJob* pJob) const;
+
+	// Call a function for parts of a range of indices on all the threads, and return when all of them are done.
+	// A part has at least uiGrainSize indices, unless the range is smaller
+	void ParallelFor(const unsigned int uiCount, const unsigned int uiGrainSize, const RangeFunction& fnRange);
+
+protected:
+	// The queue and the jobs of a thread
+	struct SThreadData
+	{
+		std::deque<SJob*> jobs;
+		std::mutex jobsMutex;
+		SJob* pJobPool;
+		unsigned int uiNumCreated;
+	};
+
+	// The data of each thread. The main thread is at 0, and the worker threads after it
+	std::vector<SThreadData*> threadData;
+	std::vector<std::thread> workerThreads;
+
+	// The number of jobs in all the queues, so that the idle workers know when to wake up
+	std::atomic<unsigned int> uiNumQueued;
+	std::atomic<unsigned int> uiNumSleeping;
+	std::mutex sleepMutex;
+	std::condition_variable sleepCondition;
+	std::atomic<bool> bStopThreads;
+
+	// Constructor
+	CJobSystem(void);
+
+	// Destructor
+	virtual ~CJobSystem(void);
+
+	// Take a job from the queue of the calling thread, or steal one from another thread
+	SJob* GetJob(void);
+	// Run a job and finish it
+	void Execute(SJob* pJob);
+	// Finish a job: queue its continuations and finish its parent if it was the last child
+	void Finish(SJob* pJob);
+	// Create a job which calls a function for a part of a range, after it queues jobs for the rest of it
+	SJob* CreateRangeJob(const unsigned int uiBegin, const unsigned int uiEnd, const unsigned int uiGrainSize,
+						const RangeFunction& fnRange, SJob* pParent);
+	// The loop of the worker threads
+	void WorkerThread(const unsigned int uiThreadIndex);
+};
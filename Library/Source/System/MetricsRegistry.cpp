@@ -0,0 +1,407 @@
+/**
+ CMetricsRegistry
+ @brief A class to keep the counters, gauges and histograms which the subsystems update every frame,
+		e.g. the path finding calls, the live enemies or the draw calls.
+		A counter is added to during a frame, a gauge is set to a value, and a histogram
+		counts its values in power-of-two buckets. They can be updated from any thread without a lock.
+		The values of the last interval are shown in an ImGui panel, and they can be written
+		to a CSV file, or to a JSON file with one object per line, at the end of every interval.
+ */
+#include "MetricsRegistry.h"
+
+// Include IMGUI
+#include "../GUI/imgui.h"
+
+#include <iostream>
+#include <cfloat>
+using namespace std;
+
+/**
+@brief Constructor
+*/
+CMetricsRegistry::CMetricsRegistry(void)
+	: uiNumMetrics(0)
+	, dInterval(1.0)
+	, dIntervalTime(0.0)
+	, uiIntervalFrames(0)
+	, uiLastIntervalFrames(0)
+	, dTotalTime(0.0)
+	, ullTotalFrames(0)
+	, bDumpJSON(false)
+	, uiNumHeaderMetrics(0)
+	, bPanelVisible(false)
+{
+}
+
+/**
+@brief Destructor
+*/
+CMetricsRegistry::~CMetricsRegistry(void)
+{
+	StopDump();
+}
+
+/**
+@brief Add a counter, which is added to during a frame
+@param sName The name of the counter
+@return The ID of the counter. If a metric with this name was added already, its ID is returned
+*/
+unsigned int CMetricsRegistry::AddCounter(const std::string& sName)
+{
+	return AddMetric(sName, METRIC_COUNTER);
+}
+
+/**
+@brief Add a gauge, which is set to a value
+@param sName The name of the gauge
+@return The ID of the gauge. If a metric with this name was added already, its ID is returned
+*/
+unsigned int CMetricsRegistry::AddGauge(const std::string& sName)
+{
+	return AddMetric(sName, METRIC_GAUGE);
+}
+
+/**
+@brief Add a histogram, which counts its values in power-of-two buckets
+@param sName The name of the histogram
+@return The ID of the histogram. If a metric with this name was added already, its ID is returned
+*/
+unsigned int CMetricsRegistry::AddHistogram(const std::string& sName)
+{
+	return AddMetric(sName, METRIC_HISTOGRAM);
+}
+
+/**
+@brief Add a metric of a type. This must be called on the main thread
+@param sName The name of the metric
+@param eType The type of the metric
+@return The ID of the metric, or INVALID_METRIC if there is no space for it
+*/
+unsigned int CMetricsRegistry::AddMetric(const std::string& sName, const METRIC_TYPE eType)
+{
+	for (unsigned int i = 0; i < uiNumMetrics; i++)
+	{
+		if (arrMetrics[i].sName == sName)
+			return i;
+	}
+	if (uiNumMetrics >= MAX_METRICS)
+	{
+		cout << "CMetricsRegistry::AddMetric(): Unable to add " << sName << " as there are " << MAX_METRICS << " metrics" << endl;
+		return INVALID_METRIC;
+	}
+
+	SMetric& sMetric = arrMetrics[uiNumMetrics];
+	sMetric.sName = sName;
+	sMetric.eType = eType;
+	sMetric.ullFrameValue = 0;
+	sMetric.llGaugeValue = 0;
+	sMetric.ullCount = 0;
+	sMetric.ullSum = 0;
+	sMetric.ullMax = 0;
+	sMetric.ullLastFrame = 0;
+	sMetric.ullIntervalValue = 0;
+	sMetric.ullTotal = 0;
+	sMetric.llIntervalMax = 0;
+	sMetric.ullLastInterval = 0;
+	sMetric.llLastIntervalMax = 0;
+	sMetric.dLastMean = 0.0;
+	sMetric.ullLastMax = 0;
+	for (unsigned int i = 0; i < NUM_BUCKETS; i++)
+	{
+		sMetric.arrBuckets[i] = 0;
+		sMetric.arrLastBuckets[i] = 0;
+	}
+	return uiNumMetrics++;
+}
+
+/**
+@brief Add a value to a histogram
+@param uiMetric The ID of the histogram
+@param ullValue The value
+*/
+void CMetricsRegistry::Observe(const unsigned int uiMetric, const unsigned long long ullValue)
+{
+	if (uiMetric >= MAX_METRICS)
+		return;
+	SMetric& sMetric = arrMetrics[uiMetric];
+
+	// Find the bucket of the value, which is the number of bits which it needs
+	unsigned int uiBucket = 0;
+	unsigned long long ullBits = ullValue;
+	while ((ullBits != 0) && (uiBucket < NUM_BUCKETS - 1))
+	{
+		ullBits >>= 1;
+		uiBucket++;
+	}
+
+	sMetric.ullCount.fetch_add(1, std::memory_order_relaxed);
+	sMetric.ullSum.fetch_add(ullValue, std::memory_order_relaxed);
+	sMetric.arrBuckets[uiBucket].fetch_add(1, std::memory_order_relaxed);
+	unsigned long long ullMax = sMetric.ullMax.load(std::memory_order_relaxed);
+	while ((ullValue > ullMax) && (!sMetric.ullMax.compare_exchange_weak(ullMax, ullValue, std::memory_order_relaxed)))
+	{
+	}
+}
+
+/**
+@brief End a frame. The counters of this frame are added to their totals, and the values of
+		the interval are stored for the panel, and written to the dump file, once it is over
+@param dFrameTime The time of this frame in seconds
+*/
+void CMetricsRegistry::EndFrame(const double dFrameTime)
+{
+	for (unsigned int i = 0; i < uiNumMetrics; i++)
+	{
+		SMetric& sMetric = arrMetrics[i];
+		if (sMetric.eType == METRIC_COUNTER)
+		{
+			sMetric.ullLastFrame = sMetric.ullFrameValue.exchange(0, std::memory_order_relaxed);
+			sMetric.ullIntervalValue += sMetric.ullLastFrame;
+			sMetric.ullTotal += sMetric.ullLastFrame;
+		}
+		else if (sMetric.eType == METRIC_GAUGE)
+		{
+			long long llValue = sMetric.llGaugeValue.load(std::memory_order_relaxed);
+			if ((uiIntervalFrames == 0) || (llValue > sMetric.llIntervalMax))
+				sMetric.llIntervalMax = llValue;
+		}
+	}
+
+	uiIntervalFrames++;
+	dIntervalTime += dFrameTime;
+	dTotalTime += dFrameTime;
+	ullTotalFrames++;
+	if (dIntervalTime >= dInterval)
+		EndInterval();
+}
+
+/**
+@brief Store the values of the interval which is over, write them to the dump file, and start a new one
+*/
+void CMetricsRegistry::EndInterval(void)
+{
+	for (unsigned int i = 0; i < uiNumMetrics; i++)
+	{
+		SMetric& sMetric = arrMetrics[i];
+		if (sMetric.eType == METRIC_COUNTER)
+		{
+			sMetric.ullLastInterval = sMetric.ullIntervalValue;
+			sMetric.ullIntervalValue = 0;
+		}
+		else if (sMetric.eType == METRIC_GAUGE)
+		{
+			sMetric.llLastIntervalMax = sMetric.llIntervalMax;
+		}
+		else
+		{
+			sMetric.ullLastInterval = sMetric.ullCount.exchange(0, std::memory_order_relaxed);
+			unsigned long long ullSum = sMetric.ullSum.exchange(0, std::memory_order_relaxed);
+			sMetric.dLastMean = (sMetric.ullLastInterval > 0) ? (double)ullSum / sMetric.ullLastInterval : 0.0;
+			sMetric.ullLastMax = sMetric.ullMax.exchange(0, std::memory_order_relaxed);
+			for (unsigned int j = 0; j < NUM_BUCKETS; j++)
+				sMetric.arrLastBuckets[j] = sMetric.arrBuckets[j].exchange(0, std::memory_order_relaxed);
+		}
+	}
+	uiLastIntervalFrames = uiIntervalFrames;
+	uiIntervalFrames = 0;
+	dIntervalTime = 0.0;
+
+	if (dumpFile.is_open())
+	{
+		if (bDumpJSON)
+			WriteJSON();
+		else
+			WriteCSV();
+		dumpFile.flush();
+	}
+}
+
+/**
+@brief Set the length of an interval
+@param dInterval The length in seconds
+*/
+void CMetricsRegistry::SetInterval(const double dInterval)
+{
+	if (dInterval > 0.0)
+		this->dInterval = dInterval;
+}
+
+/**
+@brief Start writing the metrics at the end of every interval
+@param sFile The file path. A file which ends with ".json" is written as one JSON object per line,
+		and any other file is written as CSV
+@return true if the file was opened, otherwise false
+*/
+bool CMetricsRegistry::StartDump(const std::string& sFile)
+{
+	StopDump();
+	dumpFile.open(sFile, std::ios::out | std::ios::trunc);
+	if (!dumpFile.is_open())
+	{
+		cout << "CMetricsRegistry::StartDump(): Unable to open " << sFile << endl;
+		return false;
+	}
+	bDumpJSON = (sFile.size() >= 5) && (sFile.compare(sFile.size() - 5, 5, ".json") == 0);
+	uiNumHeaderMetrics = 0;
+	cout << "CMetricsRegistry::StartDump(): Writing the metrics to " << sFile << " every " << dInterval << " s" << endl;
+	return true;
+}
+
+/**
+@brief Stop writing the metrics, and close the dump file
+*/
+void CMetricsRegistry::StopDump(void)
+{
+	if (dumpFile.is_open())
+		dumpFile.close();
+}
+
+/**
+@brief Write the values of the last interval as a line of a CSV file. Counters are written as
+		their amount in the interval, gauges as their value, and histograms as their count, mean and max.
+		A header is written before the first line, and again whenever a metric was added
+*/
+void CMetricsRegistry::WriteCSV(void)
+{
+	if (uiNumHeaderMetrics != uiNumMetrics)
+	{
+		dumpFile << "time,frames";
+		for (unsigned int i = 0; i < uiNumMetrics; i++)
+		{
+			const SMetric& sMetric = arrMetrics[i];
+			if (sMetric.eType == METRIC_HISTOGRAM)
+				dumpFile << "," << sMetric.sName << " count," << sMetric.sName << " mean," << sMetric.sName << " max";
+			else
+				dumpFile << "," << sMetric.sName;
+		}
+		dumpFile << "\n";
+		uiNumHeaderMetrics = uiNumMetrics;
+	}
+
+	dumpFile << dTotalTime << "," << ullTotalFrames;
+	for (unsigned int i = 0; i < uiNumMetrics; i++)
+	{
+		const SMetric& sMetric = arrMetrics[i];
+		if (sMetric.eType == METRIC_COUNTER)
+			dumpFile << "," << sMetric.ullLastInterval;
+		else if (sMetric.eType == METRIC_GAUGE)
+			dumpFile << "," << sMetric.llGaugeValue.load(std::memory_order_relaxed);
+		else
+			dumpFile << "," << sMetric.ullLastInterval << "," << sMetric.dLastMean << "," << sMetric.ullLastMax;
+	}
+	dumpFile << "\n";
+}
+
+/**
+@brief Write the values of the last interval as a JSON object on one line
+*/
+void CMetricsRegistry::WriteJSON(void)
+{
+	dumpFile << "{\"time\":" << dTotalTime << ",\"frames\":" << ullTotalFrames
+		<< ",\"interval_frames\":" << uiLastIntervalFrames << ",\"metrics\":{";
+	for (unsigned int i = 0; i < uiNumMetrics; i++)
+	{
+		const SMetric& sMetric = arrMetrics[i];
+		if (i > 0)
+			dumpFile << ",";
+		// The names are chosen in the code, so they do not need to be escaped
+		dumpFile << "\"" << sMetric.sName << "\":{";
+		if (sMetric.eType == METRIC_COUNTER)
+		{
+			dumpFile << "\"type\":\"counter\",\"interval\":" << sMetric.ullLastInterval
+				<< ",\"total\":" << sMetric.ullTotal;
+		}
+		else if (sMetric.eType == METRIC_GAUGE)
+		{
+			dumpFile << "\"type\":\"gauge\",\"value\":" << sMetric.llGaugeValue.load(std::memory_order_relaxed)
+				<< ",\"max\":" << sMetric.llLastIntervalMax;
+		}
+		else
+		{
+			dumpFile << "\"type\":\"histogram\",\"count\":" << sMetric.ullLastInterval
+				<< ",\"mean\":" << sMetric.dLastMean << ",\"max\":" << sMetric.ullLastMax << ",\"buckets\":[";
+			// Only write the buckets up to the last one which is not empty
+			unsigned int uiNumBuckets = NUM_BUCKETS;
+			while ((uiNumBuckets > 0) && (sMetric.arrLastBuckets[uiNumBuckets - 1] == 0))
+				uiNumBuckets--;
+			for (unsigned int j = 0; j < uiNumBuckets; j++)
+				dumpFile << ((j > 0) ? "," : "") << sMetric.arrLastBuckets[j];
+			dumpFile << "]";
+		}
+		dumpFile << "}";
+	}
+	dumpFile << "}}\n";
+}
+
+/**
+@brief Show or hide the panel
+*/
+void CMetricsRegistry::SetPanelVisible(const bool bVisible)
+{
+	bPanelVisible = bVisible;
+}
+
+/**
+@brief Check if the panel is visible
+*/
+bool CMetricsRegistry::IsPanelVisible(void) const
+{
+	return bPanelVisible;
+}
+
+/**
+@brief Add the panel to the current ImGui frame, if it is visible
+*/
+void CMetricsRegistry::RenderPanel(void)
+{
+	if (bPanelVisible == false)
+		return;
+
+	ImGuiWindowFlags windowFlags = ImGuiWindowFlags_AlwaysAutoResize |
+		ImGuiWindowFlags_NoFocusOnAppearing |
+		ImGuiWindowFlags_NoNav;
+	ImGui::SetNextWindowPos(ImVec2(10.0f, 300.0f), ImGuiCond_FirstUseEver);
+	ImGui::SetNextWindowBgAlpha(0.75f);
+	if (ImGui::Begin("Metrics", &bPanelVisible, windowFlags))
+	{
+		ImGui::Text("Last %u frames%s", uiLastIntervalFrames, dumpFile.is_open() ? " (writing to file)" : "");
+		ImGui::Separator();
+		for (unsigned int i = 0; i < uiNumMetrics; i++)
+		{
+			const SMetric& sMetric = arrMetrics[i];
+			if (sMetric.eType == METRIC_COUNTER)
+			{
+				ImGui::Text("%-28s frame %6llu  avg %8.1f  total %llu", sMetric.sName.c_str(), sMetric.ullLastFrame,
+					(uiLastIntervalFrames > 0) ? (double)sMetric.ullLastInterval / uiLastIntervalFrames : 0.0,
+					sMetric.ullTotal);
+			}
+			else if (sMetric.eType == METRIC_GAUGE)
+			{
+				ImGui::Text("%-28s value %6lld  max %8lld", sMetric.sName.c_str(),
+					sMetric.llGaugeValue.load(std::memory_order_relaxed), sMetric.llLastIntervalMax);
+			}
+			else
+			{
+				ImGui::Text("%-28s count %6llu  mean %7.1f  max %llu", sMetric.sName.c_str(),
+					sMetric.ullLastInterval, sMetric.dLastMean, sMetric.ullLastMax);
+				// Draw the buckets up to the last one which is not empty
+				float arrBuckets[NUM_BUCKETS];
+				int iNumBuckets = 0;
+				for (unsigned int j = 0; j < NUM_BUCKETS; j++)
+				{
+					arrBuckets[j] = (float)sMetric.arrLastBuckets[j];
+					if (sMetric.arrLastBuckets[j] > 0)
+						iNumBuckets = (int)j + 1;
+				}
+				if (iNumBuckets > 0)
+				{
+					ImGui::PushID((int)i);
+					ImGui::PlotHistogram("##buckets", arrBuckets, iNumBuckets, 0, "power-of-two buckets",
+						0.0f, FLT_MAX, ImVec2(220.0f, 40.0f));
+					ImGui::PopID();
+				}
+			}
+		}
+	}
+	ImGui::End();
+}
@@ -0,0 +1,147 @@
+/**
+ CMetricsRegistry
+ @brief A class to keep the counters, gauges and histograms which the subsystems update every frame,
+		e.g. the path finding calls, the live enemies or the draw calls.
+		A counter is added to during a frame, a gauge is set to a value, and a histogram
+		counts its values in power-of-two buckets. They can be updated from any thread without a lock.
+		The values of the last interval are shown in an ImGui panel, and they can be written
+		to a CSV file, or to a JSON file with one object per line, at the end of every interval.
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+#include <string>
+#include <atomic>
+#include <fstream>
+
+class CMetricsRegistry : public CSingletonTemplate<CMetricsRegistry>
+{
+	friend CSingletonTemplate<CMetricsRegistry>;
+public:
+	// The types of the metrics
+	enum METRIC_TYPE
+	{
+		METRIC_COUNTER = 0,
+		METRIC_GAUGE,
+		METRIC_HISTOGRAM,
+		NUM_METRIC_TYPES
+	};
+
+	// The maximum number of metrics
+	static const unsigned int MAX_METRICS = 64;
+	// The number of buckets of a histogram. Bucket 0 counts the value 0, and bucket i counts [2^(i-1), 2^i)
+	static const unsigned int NUM_BUCKETS = 32;
+	// The ID which is returned when there is no space for a metric. Updating it does nothing
+	static const unsigned int INVALID_METRIC = MAX_METRICS;
+
+	// Add a metric and return its ID. If a metric with this name was added already, its ID is returned
+	unsigned int AddCounter(const std::string& sName);
+	unsigned int AddGauge(const std::string& sName);
+	unsigned int AddHistogram(const std::string& sName);
+
+	// Add to a counter
+	inline void Add(const unsigned int uiMetric, const unsigned long long ullAmount = 1)
+	{
+		if (uiMetric < MAX_METRICS)
+			arrMetrics[uiMetric].ullFrameValue.fetch_add(ullAmount, std::memory_order_relaxed);
+	}
+	// Set a gauge
+	inline void Set(const unsigned int uiMetric, const long long llValue)
+	{
+		if (uiMetric < MAX_METRICS)
+			arrMetrics[uiMetric].llGaugeValue.store(llValue, std::memory_order_relaxed);
+	}
+	// Add a value to a histogram
+	void Observe(const unsigned int uiMetric, const unsigned long long ullValue);
+
+	// End a frame. The counters of this frame are added to their totals, and the values of
+	// the interval are stored for the panel, and written to the dump file, once it is over
+	void EndFrame(const double dFrameTime);
+
+	// Set the length of an interval in seconds
+	void SetInterval(const double dInterval);
+
+	// Start writing the metrics at the end of every interval. A file which ends with ".json" is written
+	// as one JSON object per line, and any other file is written as CSV
+	bool StartDump(const std::string& sFile);
+	// Stop writing the metrics, and close the dump file
+	void StopDump(void);
+
+	// Show or hide the panel
+	void SetPanelVisible(const bool bVisible);
+	bool IsPanelVisible(void) const;
+	// Add the panel to the current ImGui frame, if it is visible
+	void RenderPanel(void);
+
+protected:
+	// A metric. The atomic values are updated during the interval, and the other values
+	// are only changed by EndFrame() on the main thread
+	struct SMetric
+	{
+		std::string sName;
+		METRIC_TYPE eType;
+
+		// Counter: the amount of the current frame
+		std::atomic<unsigned long long> ullFrameValue;
+		// Gauge: the current value
+		std::atomic<long long> llGaugeValue;
+		// Histogram: the values of the current interval
+		std::atomic<unsigned long long> ullCount;
+		std::atomic<unsigned long long> ullSum;
+		std::atomic<unsigned long long> ullMax;
+		std::atomic<unsigned long long> arrBuckets[NUM_BUCKETS];
+
+		// Counter: the amount of the last frame, of the current interval and since the start
+		unsigned long long ullLastFrame;
+		unsigned long long ullIntervalValue;
+		unsigned long long ullTotal;
+		// Gauge: the maximum value of the current interval
+		long long llIntervalMax;
+
+		// The values of the last interval which was completed
+		unsigned long long ullLastInterval;		// Counter: the amount. Histogram: the number of values
+		long long llLastIntervalMax;			// Gauge: the maximum value
+		double dLastMean;						// Histogram: the mean value
+		unsigned long long ullLastMax;			// Histogram: the maximum value
+		unsigned long long arrLastBuckets[NUM_BUCKETS];
+	};
+
+	// Constructor
+	CMetricsRegistry(void);
+
+	// Destructor
+	virtual ~CMetricsRegistry(void);
+
+	// Add a metric of a type, and return its ID
+	unsigned int AddMetric(const std::string& sName, const METRIC_TYPE eType);
+
+	// Store the values of the interval which is over, and start a new one
+	void EndInterval(void);
+
+	// Write the values of the last interval to the dump file
+	void WriteCSV(void);
+	void WriteJSON(void);
+
+	SMetric arrMetrics[MAX_METRICS];
+	unsigned int uiNumMetrics;
+
+	// The length of an interval in seconds, and the time and number of frames of the current interval
+	double dInterval;
+	double dIntervalTime;
+	unsigned int uiIntervalFrames;
+	// The number of frames of the last interval which was completed
+	unsigned int uiLastIntervalFrames;
+	// The time and number of frames since the start
+	double dTotalTime;
+	unsigned long long ullTotalFrames;
+
+	// The file which the intervals are written to
+	std::ofstream dumpFile;
+	bool bDumpJSON;
+	// The number of metrics in the last CSV header, so that a new header is written if a metric is added
+	unsigned int uiNumHeaderMetrics;
+
+	bool bPanelVisible;
+};
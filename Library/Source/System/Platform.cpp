@@ -0,0 +1,163 @@
+/**
+ CPlatform
+ @brief A class which hides the operating system's clock and sleep from the rest of the Library.
+		The time is read from std::chrono::steady_clock, which is monotonic on every platform.
+		A sleep can wake up late, by up to a scheduler tick, so SleepUntil() sleeps until
+		shortly before the time and then spins for the rest of it. On Windows, Init() raises
+		the timer resolution to 1 ms and the sleeps use a high resolution waitable timer where
+		it is available. On other platforms, the sleeps use clock_nanosleep().
+ */
+#include "Platform.h"
+
+#ifdef _WIN32
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <Windows.h>
+	#include <timeapi.h>
+	// Older SDKs do not define the flag for the high resolution waitable timer of Windows 10
+	#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+		#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+	#endif
+#else
+	#include <time.h>
+	#include <errno.h>
+#endif
+
+#include <thread>
+#include <algorithm>
+
+CPlatform::CClock::time_point CPlatform::startTime = CPlatform::CClock::now();
+unsigned int CPlatform::uiTimerResolution = 0;
+
+#ifdef _WIN32
+/**
+ @brief A waitable timer for the sleeps of a thread. A timer cannot be waited on by two threads
+		at once, so each thread has its own, which is closed when the thread ends
+ */
+struct SWaitableTimer
+{
+	HANDLE hTimer;
+
+	SWaitableTimer(void)
+	{
+		// The high resolution timer is not affected by the timer resolution, but it needs Windows 10.
+		// If it is not available, a normal timer is used
+		hTimer = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+		if (hTimer == NULL)
+			hTimer = CreateWaitableTimerExW(NULL, NULL, 0, TIMER_ALL_ACCESS);
+	}
+
+	~SWaitableTimer(void)
+	{
+		if (hTimer != NULL)
+			CloseHandle(hTimer);
+	}
+};
+#endif
+
+/**
+ @brief Raise the timer resolution of the operating system to 1 ms, so that a sleep wakes up
+		close to its time. Call Destroy() when it is not needed anymore
+ */
+void CPlatform::Init(void)
+{
+#ifdef _WIN32
+	if (uiTimerResolution != 0)
+		return;
+
+	TIMECAPS tc;
+	if (timeGetDevCaps(&tc, sizeof(TIMECAPS)) == MMSYSERR_NOERROR)
+	{
+		uiTimerResolution = std::min(std::max(tc.wPeriodMin, 1u), tc.wPeriodMax);
+		if (timeBeginPeriod(uiTimerResolution) != TIMERR_NOERROR)
+			uiTimerResolution = 0;
+	}
+#endif
+}
+
+/**
+ @brief Restore the timer resolution of the operating system
+ */
+void CPlatform::Destroy(void)
+{
+#ifdef _WIN32
+	if (uiTimerResolution != 0)
+	{
+		timeEndPeriod(uiTimerResolution);
+		uiTimerResolution = 0;
+	}
+#endif
+}
+
+/**
+ @brief Get the current time
+ */
+CPlatform::CClock::time_point CPlatform::Now(void)
+{
+	return CClock::now();
+}
+
+/**
+ @brief Get the time in seconds since the clock was first used
+ */
+double CPlatform::GetTime(void)
+{
+	return std::chrono::duration<double>(CClock::now() - startTime).count();
+}
+
+/**
+ @brief Sleep for a time. The sleep can end late, by up to a scheduler tick
+ @param dTime The time in seconds
+ */
+void CPlatform::Sleep(const double dTime)
+{
+	if (dTime <= 0.0)
+		return;
+
+#ifdef _WIN32
+	static thread_local SWaitableTimer sWaitableTimer;
+	if (sWaitableTimer.hTimer != NULL)
+	{
+		// A negative due time is relative, in units of 100 nanoseconds
+		LARGE_INTEGER dueTime;
+		dueTime.QuadPart = -(LONGLONG)(dTime * 10000000.0);
+		if ((dueTime.QuadPart < 0)
+			&& (SetWaitableTimer(sWaitableTimer.hTimer, &dueTime, 0, NULL, NULL, FALSE) != 0))
+		{
+			WaitForSingleObject(sWaitableTimer.hTimer, INFINITE);
+			return;
+		}
+	}
+	::Sleep((DWORD)(dTime * 1000.0));
+#else
+	struct timespec sTime;
+	clock_gettime(CLOCK_MONOTONIC, &sTime);
+	long long llNanoseconds = sTime.tv_nsec + (long long)(dTime * 1000000000.0);
+	sTime.tv_sec += (time_t)(llNanoseconds / 1000000000);
+	sTime.tv_nsec = (long)(llNanoseconds % 1000000000);
+	// Sleep until an absolute time, so that a signal which wakes it up does not make it sleep longer
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &sTime, NULL) == EINTR)
+	{
+	}
+#endif
+}
+
+/**
+ @brief Sleep until shortly before a time, as a sleep can wake up late, and then spin until it
+ @param time The time to wait until
+ @param spinTime The time before the time to stop sleeping and start spinning.
+		It should be longer than a sleep can wake up late
+ */
+void CPlatform::SleepUntil(const CClock::time_point& time, const CClock::duration& spinTime)
+{
+	CClock::time_point now = CClock::now();
+	if (time - now > spinTime)
+		Sleep(std::chrono::duration<double>(time - now - spinTime).count());
+
+	while (CClock::now() < time)
+		std::this_thread::yield();
+}
@@ -0,0 +1,40 @@
+/**
+ CPlatform
+ @brief A class which hides the operating system's clock and sleep from the rest of the Library.
+		The time is read from std::chrono::steady_clock, which is monotonic on every platform.
+		A sleep can wake up late, by up to a scheduler tick, so SleepUntil() sleeps until
+		shortly before the time and then spins for the rest of it. On Windows, Init() raises
+		the timer resolution to 1 ms and the sleeps use a high resolution waitable timer where
+		it is available. On other platforms, the sleeps use clock_nanosleep().
+ */
+#pragma once
+
+#include <chrono>
+
+class CPlatform
+{
+public:
+	// The clock of the Library
+	typedef std::chrono::steady_clock CClock;
+
+	// Raise the timer resolution of the operating system. Call Destroy() when it is not needed anymore
+	static void Init(void);
+	// Restore the timer resolution of the operating system
+	static void Destroy(void);
+
+	// Get the current time
+	static CClock::time_point Now(void);
+	// Get the time in seconds since the clock was first used
+	static double GetTime(void);
+
+	// Sleep for a time in seconds. The sleep can end late, by up to a scheduler tick
+	static void Sleep(const double dTime);
+	// Sleep until shortly before a time, and then spin until it
+	static void SleepUntil(const CClock::time_point& time, const CClock::duration& spinTime);
+
+protected:
+	// The time when the clock was first used
+	static CClock::time_point startTime;
+	// The timer resolution which Init() set in milliseconds, or 0 if it was not set
+	static unsigned int uiTimerResolution;
+};
@@ -0,0 +1,76 @@
+/**
+ CRandom
+ @brief A class to generate pseudo-random numbers with PCG32, which is small, fast and has
+		good statistics. A generator is seeded with a seed and a stream, and generators with
+		the same seed but different streams give independent sequences. Unlike rand(), each
+		generator has its own state, so it gives the same sequence on any platform and does
+		not share its state with other threads. A generator must only be used by one thread at a time.
+ */
+#include "Random.h"
+
+/**
+ @brief Constructor
+ @param ullSeed The seed
+ @param ullStream The stream
+ */
+CRandom::CRandom(const unsigned long long ullSeed, const unsigned long long ullStream)
+	: ullState(0)
+	, ullIncrement(1)
+{
+	Seed(ullSeed, ullStream);
+}
+
+/**
+ @brief Seed the generator, as PCG32 does it
+ @param ullSeed The seed
+ @param ullStream The stream. Only its lower 63 bits are used
+ */
+void CRandom::Seed(const unsigned long long ullSeed, const unsigned long long ullStream)
+{
+	ullState = 0;
+	ullIncrement = (ullStream << 1) | 1;
+	Next();
+	ullState += ullSeed;
+	Next();
+}
+
+/**
+ @brief Get the next number. The state is advanced by a linear congruential step, and the old state
+		is mixed by a xorshift and a random rotation
+ */
+unsigned int CRandom::Next(void)
+{
+	unsigned long long ullOldState = ullState;
+	ullState = ullOldState * 6364136223846793005ULL + ullIncrement;
+	unsigned int uiXorShifted = (unsigned int)(((ullOldState >> 18) ^ ullOldState) >> 27);
+	unsigned int uiRotation = (unsigned int)(ullOldState >> 59);
+	return (uiXorShifted >> uiRotation) | (uiXorShifted << ((0u - uiRotation) & 31));
+}
+
+/**
+ @brief Get a number from 0 to iRange - 1. The numbers below 2^32 % iRange are skipped, so that
+		every number in the range is as likely
+ @param iRange The number of values
+ */
+int CRandom::Int(const int iRange)
+{
+	if (iRange <= 0)
+		return 0;
+
+	unsigned int uiRange = (unsigned int)iRange;
+	unsigned int uiThreshold = (0u - uiRange) % uiRange;
+	for (;;)
+	{
+		unsigned int uiValue = Next();
+		if (uiValue >= uiThreshold)
+			return (int)(uiValue % uiRange);
+	}
+}
+
+/**
+ @brief Get a number from 0 to 1, not including 1, from the upper 24 bits of the next number
+ */
+float CRandom::Float(void)
+{
+	return (float)(Next() >> 8) * (1.0f / 16777216.0f);
+}
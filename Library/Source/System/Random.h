@@ -0,0 +1,33 @@
+/**
+ CRandom
+ @brief A class to generate pseudo-random numbers with PCG32, which is small, fast and has
+		good statistics. A generator is seeded with a seed and a stream, and generators with
+		the same seed but different streams give independent sequences. Unlike rand(), each
+		generator has its own state, so it gives the same sequence on any platform and does
+		not share its state with other threads. A generator must only be used by one thread at a time.
+ */
+#pragma once
+
+class CRandom
+{
+public:
+	// Constructor
+	CRandom(const unsigned long long ullSeed = 0, const unsigned long long ullStream = 0);
+
+	// Seed the generator. The same seed and stream always give the same numbers
+	void Seed(const unsigned long long ullSeed, const unsigned long long ullStream = 0);
+
+	// Get the next number, from 0 to 2^32 - 1
+	unsigned int Next(void);
+
+	// Get a number from 0 to iRange - 1 without the bias of rand() % iRange, or 0 if iRange is not positive
+	int Int(const int iRange);
+
+	// Get a number from 0 to 1, not including 1
+	float Float(void);
+
+protected:
+	unsigned long long ullState;
+	// The increment of the generator, which selects its stream. It is always odd
+	unsigned long long ullIncrement;
+};
@@ -0,0 +1,101 @@
+/**
+ CRandomService
+ @brief A class which gives the subsystems their random number generators, all seeded from the
+		seed of the run. Each subsystem has its own stream, found by its name, so a change to
+		the randomness of one subsystem does not change the numbers of the others.
+		An object which is updated on any thread, such as a turret which thinks in a job,
+		creates its own stream instead, so its numbers do not depend on which thread runs it.
+		Two runs with the same seed and the same inputs then have the same simulation.
+		The streams are only created and seeded on the main thread.
+ */
+#include "RandomService.h"
+
+/**
+ @brief Constructor
+ */
+CRandomService::CRandomService(void)
+	: uiSeed(0)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CRandomService::~CRandomService(void)
+{
+	for (std::map<std::string, CRandom*>::iterator it = streams.begin(); it != streams.end(); ++it)
+		delete it->second;
+	streams.clear();
+}
+
+/**
+ @brief Set the seed of the run. The streams of the subsystems are seeded again, so that they start
+		from the beginning, and the objects' streams are counted from the first again
+ @param uiSeed The seed
+ */
+void CRandomService::SetSeed(const unsigned int uiSeed)
+{
+	this->uiSeed = uiSeed;
+	for (std::map<std::string, CRandom*>::iterator it = streams.begin(); it != streams.end(); ++it)
+		SeedStream(*it->second, it->first, 0);
+	numObjectStreams.clear();
+}
+
+/**
+ @brief Get the seed of the run
+ */
+unsigned int CRandomService::GetSeed(void) const
+{
+	return uiSeed;
+}
+
+/**
+ @brief Get the stream of a subsystem. It is created on the first call
+ @param sName The name of the subsystem
+ @return The stream. It is valid until this class is destroyed
+ */
+CRandom* CRandomService::GetStream(const std::string& sName)
+{
+	std::map<std::string, CRandom*>::iterator it = streams.find(sName);
+	if (it != streams.end())
+		return it->second;
+
+	CRandom* cRandom = new CRandom();
+	SeedStream(*cRandom, sName, 0);
+	streams[sName] = cRandom;
+	return cRandom;
+}
+
+/**
+ @brief Create a stream for an object of a subsystem, e.g. a turret. The objects of a subsystem
+		get its streams in the order which they are created, after the subsystem's own stream
+ @param sName The name of the subsystem
+ @return The stream
+ */
+CRandom CRandomService::CreateStream(const std::string& sName)
+{
+	unsigned int& uiNumStreams = numObjectStreams[sName];
+	uiNumStreams++;
+
+	CRandom cRandom;
+	SeedStream(cRandom, sName, uiNumStreams);
+	return cRandom;
+}
+
+/**
+ @brief Seed a generator. The name is hashed with FNV-1a, so that each subsystem has its own seed,
+		and the index selects the stream
+ @param cRandom The generator
+ @param sName The name of the subsystem
+ @param uiIndex The index of the stream
+ */
+void CRandomService::SeedStream(CRandom& cRandom, const std::string& sName, const unsigned int uiIndex) const
+{
+	unsigned long long ullHash = 14695981039346656037ULL;
+	for (unsigned int i = 0; i < sName.size(); i++)
+	{
+		ullHash ^= (unsigned char)sName[i];
+		ullHash *= 1099511628211ULL;
+	}
+	cRandom.Seed(ullHash ^ uiSeed, uiIndex);
+}
@@ -0,0 +1,53 @@
+/**
+ CRandomService
+ @brief A class which gives the subsystems their random number generators, all seeded from the
+		seed of the run. Each subsystem has its own stream, found by its name, so a change to
+		the randomness of one subsystem does not change the numbers of the others.
+		An object which is updated on any thread, such as a turret which thinks in a job,
+		creates its own stream instead, so its numbers do not depend on which thread runs it.
+		Two runs with the same seed and the same inputs then have the same simulation.
+		The streams are only created and seeded on the main thread.
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+// Include CRandom
+#include "Random.h"
+
+#include <string>
+#include <map>
+
+class CRandomService : public CSingletonTemplate<CRandomService>
+{
+	friend CSingletonTemplate<CRandomService>;
+public:
+	// Set the seed of the run. The streams of the subsystems are seeded again, and the objects' streams start again
+	void SetSeed(const unsigned int uiSeed);
+	// Get the seed of the run
+	unsigned int GetSeed(void) const;
+
+	// Get the stream of a subsystem. It is created on the first call
+	CRandom* GetStream(const std::string& sName);
+
+	// Create a stream for an object of a subsystem. Each call for a name gives the next of its streams
+	CRandom CreateStream(const std::string& sName);
+
+protected:
+	// The seed of the run
+	unsigned int uiSeed;
+
+	// The streams of the subsystems
+	std::map<std::string, CRandom*> streams;
+	// The number of streams which were created for the objects of each subsystem
+	std::map<std::string, unsigned int> numObjectStreams;
+
+	// Constructor
+	CRandomService(void);
+
+	// Destructor
+	virtual ~CRandomService(void);
+
+	// Seed a generator from the seed of the run, the name of its subsystem and its index
+	void SeedStream(CRandom& cRandom, const std::string& sName, const unsigned int uiIndex) const;
+};
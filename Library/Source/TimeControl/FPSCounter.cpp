@@ -1,11 +1,20 @@
 /**
  CFPSCounter
- @brief A class to calculate the Frames-Per-Second
+ @brief A class to calculate the Frames-Per-Second.
+		It also keeps the times of the last frames for their percentiles, and flags
+		a frame as a hitch if it takes longer than a multiple of the target frame time
  By: Toh Da Jun
  Date: Mar 2020
  */
 #include "FPSCounter.h"
+
+// Include CFrameTimer to find the zone which took the most time in a hitch
+#include "FrameTimer.h"
+// Include CMetricsRegistry to count the hitches
+#include "../System/MetricsRegistry.h"
+
 #include <iostream>
+#include <algorithm>
 using namespace std;
 
 CFPSCounter::CFPSCounter()
@@ -13,7 +22,13 @@ CFPSCounter::CFPSCounter()
 	, nFrames(0)
 	, iFrameRate(0)
 	, dFrameTime(0.0)
+	, uiNextFrameTime(0)
+	, uiNumFrameTimes(0)
+	, ullFrame(0)
+	, dHitchThreshold(0.0)
+	, uiNumHitches(0)
 {
+	uiMetricHitches = CMetricsRegistry::GetInstance()->AddCounter("Hitches");
 	Init();
 }
 
@@ -30,6 +45,12 @@ void CFPSCounter::Init(void)
 	nFrames = 0;
 	iFrameRate = 0;
 	dFrameTime = 60;
+
+	uiNextFrameTime = 0;
+	uiNumFrameTimes = 0;
+	ullFrame = 0;
+	hitches.clear();
+	uiNumHitches = 0;
 }
 
 // Update the class instance
@@ -41,6 +62,18 @@ void CFPSCounter::Update(const double deltaTime)
 	// Update the frame count
 	nFrames++;
 
+	// Store the frame time, replacing the oldest one if the ring buffer is full
+	double dFrameTimeMS = deltaTime * 1000.0;
+	arrFrameTimes[uiNextFrameTime] = dFrameTimeMS;
+	uiNextFrameTime = (uiNextFrameTime + 1) % NUM_FRAME_TIMES;
+	if (uiNumFrameTimes < NUM_FRAME_TIMES)
+		uiNumFrameTimes++;
+	ullFrame++;
+
+	// Flag the frame if it took too long
+	if ((dHitchThreshold > 0.0) && (dFrameTimeMS > dHitchThreshold))
+		AddHitch(dFrameTimeMS);
+
 	if (dElapsedTime >= 1.0){ // If last update was more than 1 sec ago...
 		// Calculate the current frame rate
 		dFrameTime = 1000.0 / double(nFrames);
@@ -71,3 +104,78 @@ double CFPSCounter::GetFrameTime(void) const
 {
 	return dFrameTime;
 }
+
+// Set the target frame time in milliseconds, and the multiple of it which a frame is flagged as a hitch above
+void CFPSCounter::SetHitchThreshold(const double dTargetFrameTime, const double dMultiplier)
+{
+	dHitchThreshold = dTargetFrameTime * dMultiplier;
+}
+
+// Get the percentiles of the last frame times
+CFPSCounter::SFrameTimeStats CFPSCounter::GetFrameTimeStats(void) const
+{
+	SFrameTimeStats sStats = { 0.0, 0.0, 0.0, 0.0, uiNumFrameTimes };
+	if (uiNumFrameTimes == 0)
+		return sStats;
+
+	// Sort a copy of the frame times, and take the nearest rank of each percentile
+	std::vector<double> frameTimes(arrFrameTimes, arrFrameTimes + uiNumFrameTimes);
+	std::sort(frameTimes.begin(), frameTimes.end());
+	sStats.dP50 = frameTimes[(uiNumFrameTimes - 1) * 50 / 100];
+	sStats.dP95 = frameTimes[(uiNumFrameTimes - 1) * 95 / 100];
+	sStats.dP99 = frameTimes[(uiNumFrameTimes - 1) * 99 / 100];
+	sStats.dMax = frameTimes[uiNumFrameTimes - 1];
+	return sStats;
+}
+
+// Get the last hitches, from the oldest to the newest
+const std::vector<CFPSCounter::SHitch>& CFPSCounter::GetHitches(void) const
+{
+	return hitches;
+}
+
+// Get the number of hitches since Init()
+unsigned int CFPSCounter::GetNumHitches(void) const
+{
+	return uiNumHitches;
+}
+
+// Print the percentiles of the frame times and the number of hitches
+void CFPSCounter::PrintFrameTimeStats(void) const
+{
+	SFrameTimeStats sStats = GetFrameTimeStats();
+	cout << "CFPSCounter: Last " << sStats.uiNumFrames << " frames: p50 " << sStats.dP50
+		<< " ms, p95 " << sStats.dP95 << " ms, p99 " << sStats.dP99 << " ms, max " << sStats.dMax
+		<< " ms, " << uiNumHitches << " hitches over " << dHitchThreshold << " ms" << endl;
+}
+
+// Store a hitch and the zone which took the most time in it.
+// This is called at the end of the frame, before the frame timer stores the times of its zones
+void CFPSCounter::AddHitch(const double dFrameTimeMS)
+{
+	SHitch sHitch;
+	sHitch.ullFrame = ullFrame;
+	sHitch.dFrameTime = dFrameTimeMS;
+	sHitch.dZoneTime = 0.0;
+
+	CFrameTimer* cFrameTimer = CFrameTimer::GetInstance();
+	for (unsigned int i = 0; i < cFrameTimer->GetNumZones(); i++)
+	{
+		if (cFrameTimer->GetZoneFrameTime(i) > sHitch.dZoneTime)
+		{
+			sHitch.sZone = cFrameTimer->GetZoneName(i);
+			sHitch.dZoneTime = cFrameTimer->GetZoneFrameTime(i);
+		}
+	}
+
+	if (hitches.size() >= NUM_HITCHES)
+		hitches.erase(hitches.begin());
+	hitches.push_back(sHitch);
+	uiNumHitches++;
+	CMetricsRegistry::GetInstance()->Add(uiMetricHitches);
+
+	cout << "CFPSCounter: Hitch of " << dFrameTimeMS << " ms in frame " << ullFrame;
+	if (!sHitch.sZone.empty())
+		cout << ", mostly in " << sHitch.sZone << " (" << sHitch.dZoneTime << " ms)";
+	cout << endl;
+}
@@ -1,6 +1,8 @@
 /**
  CFPSCounter
- @brief A class to calculate the Frames-Per-Second
+ @brief A class to calculate the Frames-Per-Second.
+		It also keeps the times of the last frames for their percentiles, and flags
+		a frame as a hitch if it takes longer than a multiple of the target frame time
  By: Toh Da Jun
  Date: Mar 2020
  */
@@ -10,12 +12,37 @@
 #include "../DesignPatterns/SingletonTemplate.h"
 
 #include <string>
+#include <vector>
 
 class CFPSCounter : public CSingletonTemplate<CFPSCounter>
 {
 	friend CSingletonTemplate<CFPSCounter>;
 
 public:
+	// The number of frame times which are kept for the percentiles
+	static const unsigned int NUM_FRAME_TIMES = 600;
+	// The number of hitches which are kept
+	static const unsigned int NUM_HITCHES = 32;
+
+	// The percentiles of the frame times, in milliseconds
+	struct SFrameTimeStats
+	{
+		double dP50;
+		double dP95;
+		double dP99;
+		double dMax;
+		unsigned int uiNumFrames;
+	};
+
+	// A frame which took longer than the hitch threshold
+	struct SHitch
+	{
+		unsigned long long ullFrame;
+		double dFrameTime;			// The time of the frame in milliseconds
+		std::string sZone;			// The frame timer zone which took the most time in the frame, if any
+		double dZoneTime;			// The time of that zone in milliseconds
+	};
+
 	// Destructor
 	virtual ~CFPSCounter(void);
 
@@ -34,6 +61,19 @@ public:
 	// Get the current frame time
 	double GetFrameTime(void) const;
 
+	// Set the target frame time in milliseconds, and the multiple of it which a frame is flagged as a hitch above
+	void SetHitchThreshold(const double dTargetFrameTime, const double dMultiplier);
+
+	// Get the percentiles of the last frame times
+	SFrameTimeStats GetFrameTimeStats(void) const;
+
+	// Get the last hitches, from the oldest to the newest, and the number of hitches since Init()
+	const std::vector<SHitch>& GetHitches(void) const;
+	unsigned int GetNumHitches(void) const;
+
+	// Print the percentiles of the frame times and the number of hitches
+	void PrintFrameTimeStats(void) const;
+
 protected:
 	// Count the elapsed time since the last reset
 	double dElapsedTime;
@@ -44,6 +84,22 @@ protected:
 	// Count the elapsed time since the last reset
 	double dFrameTime;
 
+	// The last frame times in milliseconds, and the index which the next one is stored at
+	double arrFrameTimes[NUM_FRAME_TIMES];
+	unsigned int uiNextFrameTime;
+	unsigned int uiNumFrameTimes;
+	unsigned long long ullFrame;
+
+	// A frame which takes longer than dHitchThreshold milliseconds is a hitch
+	double dHitchThreshold;
+	std::vector<SHitch> hitches;
+	unsigned int uiNumHitches;
+	// The metric of the hitches
+	unsigned int uiMetricHitches;
+
 	// Constructor
 	CFPSCounter(void);
+
+	// Store a hitch and the zone which took the most time in it
+	void AddHitch(const double dFrameTimeMS);
 };
@@ -0,0 +1,169 @@
+/**
+ CFixedTimeStep
+ @brief A class to update the simulation in ticks of a fixed time, whatever the frame rate.
+		The time of each frame is added to an accumulator, and a tick is run for every
+		time step in it. The time which is left over is used to draw the entities between
+		their positions of the last two ticks, so that the movement is smooth at any frame rate.
+		A frame runs at most a number of ticks, so that a long frame slows the game down
+		instead of making the next frame longer too.
+		The time of a frame can be scaled to fast-forward the simulation, which runs more ticks
+		in a frame. At the max time scale, a frame runs ticks until a budget of real time is used.
+		The achieved time scale is measured against the real time every second.
+ */
+#include "FixedTimeStep.h"
+
+/**
+@brief Constructor
+*/
+CFixedTimeStep::CFixedTimeStep(void)
+	: dTimeStep(1.0 / 30.0)
+	, uiMaxSteps(1)
+	, dAccumulator(0.0)
+	, ullNumSteps(0)
+	, dTimeScale(1.0)
+	, dMaxScaleBudget(0.025)
+	, dMeasuredRealTime(0.0)
+	, dMeasuredSimTime(0.0)
+	, dAchievedTimeScale(1.0)
+{
+}
+
+/**
+@brief Destructor
+*/
+CFixedTimeStep::~CFixedTimeStep(void)
+{
+}
+
+/**
+@brief Initialise the class instance
+@param dTimeStep The time of a tick in seconds
+@param uiMaxSteps The most ticks which are run in a frame
+*/
+void CFixedTimeStep::Init(const double dTimeStep, const unsigned int uiMaxSteps)
+{
+	this->dTimeStep = dTimeStep;
+	this->uiMaxSteps = (uiMaxSteps > 0) ? uiMaxSteps : 1;
+	dAccumulator = 0.0;
+	ullNumSteps = 0;
+	dMeasuredRealTime = 0.0;
+	dMeasuredSimTime = 0.0;
+	dAchievedTimeScale = dTimeScale;
+}
+
+/**
+@brief Add the time of a frame
+@param dElapsedTime The time of the frame in seconds
+*/
+void CFixedTimeStep::AddTime(const double dElapsedTime)
+{
+	// Measure the simulated time against the real time over a second
+	dMeasuredRealTime += dElapsedTime;
+	if (dMeasuredRealTime >= 1.0)
+	{
+		dAchievedTimeScale = dMeasuredSimTime / dMeasuredRealTime;
+		dMeasuredRealTime = 0.0;
+		dMeasuredSimTime = 0.0;
+	}
+
+	if (dTimeScale <= 0.0)
+	{
+		// Run as many ticks as the budget of this frame allows
+		dAccumulator = 0.0;
+		stepDeadline = CPlatform::Now() + std::chrono::duration_cast<CPlatform::CClock::duration>(
+			std::chrono::duration<double>(dMaxScaleBudget));
+		return;
+	}
+
+	dAccumulator += dElapsedTime * dTimeScale;
+
+	// Drop the time which is more than the ticks of a frame, so that the game slows down after
+	// a long frame instead of running so many ticks that the next frame is long too.
+	// A faster time scale runs more ticks in a frame
+	double dMaxTime = dTimeStep * uiMaxSteps * (dTimeScale > 1.0 ? dTimeScale : 1.0);
+	if (dAccumulator > dMaxTime)
+		dAccumulator = dMaxTime;
+}
+
+/**
+@brief Take a tick from the accumulator
+@return true if a tick is due, otherwise false
+*/
+bool CFixedTimeStep::Step(void)
+{
+	if (dTimeScale <= 0.0)
+	{
+		if (CPlatform::Now() >= stepDeadline)
+			return false;
+	}
+	else
+	{
+		if (dAccumulator < dTimeStep)
+			return false;
+		dAccumulator -= dTimeStep;
+	}
+
+	ullNumSteps++;
+	dMeasuredSimTime += dTimeStep;
+	return true;
+}
+
+/**
+@brief Get the time of a tick in seconds
+*/
+double CFixedTimeStep::GetTimeStep(void) const
+{
+	return dTimeStep;
+}
+
+/**
+@brief Get how far the frame is from the last tick to the next one, from 0 to 1
+*/
+float CFixedTimeStep::GetInterpolation(void) const
+{
+	return (float)(dAccumulator / dTimeStep);
+}
+
+/**
+@brief Get the number of ticks since Init()
+*/
+unsigned long long CFixedTimeStep::GetNumSteps(void) const
+{
+	return ullNumSteps;
+}
+
+/**
+@brief Set the time scale. The time of each frame is multiplied by it, so that more ticks are run in a frame
+@param dTimeScale The time scale, e.g. 2 to run the simulation twice as fast, or 0 for the max time scale,
+		which runs ticks until the budget of the frame is used
+*/
+void CFixedTimeStep::SetTimeScale(const double dTimeScale)
+{
+	this->dTimeScale = (dTimeScale > 0.0) ? dTimeScale : 0.0;
+	dAccumulator = 0.0;
+}
+
+/**
+@brief Get the time scale. 0 is the max time scale
+*/
+double CFixedTimeStep::GetTimeScale(void) const
+{
+	return dTimeScale;
+}
+
+/**
+@brief Set the real time which a frame spends on ticks at the max time scale
+@param dMaxScaleBudget The time in seconds. It should leave enough of the frame time to draw the frame
+*/
+void CFixedTimeStep::SetMaxScaleBudget(const double dMaxScaleBudget)
+{
+	this->dMaxScaleBudget = dMaxScaleBudget;
+}
+
+/**
+@brief Get the simulated time over the real time of the last second, to compare it with the time scale
+*/
+double CFixedTimeStep::GetAchievedTimeScale(void) const
+{
+	return dAchievedTimeScale;
+}
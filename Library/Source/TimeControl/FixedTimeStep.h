@@ -0,0 +1,78 @@
+/**
+ CFixedTimeStep
+ @brief A class to update the simulation in ticks of a fixed time, whatever the frame rate.
+		The time of each frame is added to an accumulator, and a tick is run for every
+		time step in it. The time which is left over is used to draw the entities between
+		their positions of the last two ticks, so that the movement is smooth at any frame rate.
+		A frame runs at most a number of ticks, so that a long frame slows the game down
+		instead of making the next frame longer too.
+		The time of a frame can be scaled to fast-forward the simulation, which runs more ticks
+		in a frame. At the max time scale, a frame runs ticks until a budget of real time is used.
+		The achieved time scale is measured against the real time every second.
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+// Include CPlatform for the clock
+#include "../System/Platform.h"
+
+class CFixedTimeStep : public CSingletonTemplate<CFixedTimeStep>
+{
+	friend CSingletonTemplate<CFixedTimeStep>;
+public:
+	// Initialise the class instance with the time of a tick in seconds, and the most ticks in a frame
+	void Init(const double dTimeStep, const unsigned int uiMaxSteps);
+
+	// Add the time of a frame in seconds. The time of more than uiMaxSteps ticks is dropped
+	void AddTime(const double dElapsedTime);
+
+	// Take a tick from the accumulator. Returns false if no tick is due
+	bool Step(void);
+
+	// Get the time of a tick in seconds
+	double GetTimeStep(void) const;
+
+	// Get how far the frame is from the last tick to the next one, from 0 to 1
+	float GetInterpolation(void) const;
+
+	// Get the number of ticks since Init()
+	unsigned long long GetNumSteps(void) const;
+
+	// Set the time scale, which the time of a frame is multiplied by. 0 is the max time scale
+	void SetTimeScale(const double dTimeScale);
+	// Get the time scale. 0 is the max time scale
+	double GetTimeScale(void) const;
+	// Set the real time in seconds which a frame spends on ticks at the max time scale
+	void SetMaxScaleBudget(const double dMaxScaleBudget);
+	// Get the simulated time over the real time of the last second
+	double GetAchievedTimeScale(void) const;
+
+protected:
+	// The time of a tick in seconds, and the most ticks in a frame
+	double dTimeStep;
+	unsigned int uiMaxSteps;
+
+	// The time which has not been simulated yet
+	double dAccumulator;
+
+	// The number of ticks since Init()
+	unsigned long long ullNumSteps;
+
+	// The time scale, or 0 for the max time scale, and the real time of a frame's ticks at the max time scale
+	double dTimeScale;
+	double dMaxScaleBudget;
+	// The time when a frame stops running ticks at the max time scale
+	CPlatform::CClock::time_point stepDeadline;
+
+	// The real time and the simulated time of the current second, and the achieved time scale of the last second
+	double dMeasuredRealTime;
+	double dMeasuredSimTime;
+	double dAchievedTimeScale;
+
+	// Constructor
+	CFixedTimeStep(void);
+
+	// Destructor
+	virtual ~CFixedTimeStep(void);
+};
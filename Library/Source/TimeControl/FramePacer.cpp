@@ -0,0 +1,182 @@
+/**
+ CFramePacer
+ @brief A class to start the frames at a steady rate.
+		The frames are scheduled at fixed times, so that a late frame does not delay the next ones.
+		It sleeps until shortly before the next frame is due, as a sleep can wake up late,
+		and then spins until it is due. With vsync, buffer swaps pace the frames instead, and
+		without a target rate, the frames are not paced. The difference between the measured
+		and the target frame time is reported as the pacing error.
+ */
+#include "FramePacer.h"
+
+// Include CMetricsRegistry to add the pacing error to the metrics
+#include "../System/MetricsRegistry.h"
+
+#include <cmath>
+#include <iostream>
+using namespace std;
+
+/**
+@brief Constructor
+*/
+CFramePacer::CFramePacer(void)
+	: eMode(PACING_UNCAPPED)
+	, targetFrameTime(CClock::duration::zero())
+	, spinTime(std::chrono::duration_cast<CClock::duration>(std::chrono::microseconds(2000)))
+{
+	sLastStats.dMeanFrameTime = 0.0;
+	sLastStats.dMeanError = 0.0;
+	sLastStats.dMaxError = 0.0;
+	sLastStats.uiNumFrames = 0;
+	uiMetricPacingError = CMetricsRegistry::GetInstance()->AddHistogram("Pacing Error (us)");
+	Start();
+}
+
+/**
+@brief Destructor
+*/
+CFramePacer::~CFramePacer(void)
+{
+}
+
+/**
+@brief Set the mode and the target frame rate
+@param eMode The mode
+@param dFrameRate The target frame rate. With vsync, this is the refresh rate of the monitor,
+		which is only used to measure the pacing error. A rate of 0 is uncapped
+*/
+void CFramePacer::SetTargetRate(const PACING_MODE eMode, const double dFrameRate)
+{
+	this->eMode = eMode;
+	if ((eMode == PACING_UNCAPPED) || (dFrameRate <= 0.0))
+	{
+		if (eMode == PACING_TARGET_RATE)
+			this->eMode = PACING_UNCAPPED;
+		targetFrameTime = CClock::duration::zero();
+	}
+	else
+	{
+		targetFrameTime = std::chrono::duration_cast<CClock::duration>(std::chrono::duration<double>(1.0 / dFrameRate));
+	}
+	Start();
+}
+
+/**
+@brief Get the mode
+*/
+CFramePacer::PACING_MODE CFramePacer::GetMode(void) const
+{
+	return eMode;
+}
+
+/**
+@brief Get the target frame time in seconds, or 0 if it is uncapped
+*/
+double CFramePacer::GetTargetFrameTime(void) const
+{
+	return std::chrono::duration<double>(targetFrameTime).count();
+}
+
+/**
+@brief Set how long before a frame is due to stop sleeping and start spinning.
+		It should be longer than a sleep can wake up late
+@param dSpinTime The time in seconds
+*/
+void CFramePacer::SetSpinTime(const double dSpinTime)
+{
+	spinTime = std::chrono::duration_cast<CClock::duration>(std::chrono::duration<double>(dSpinTime));
+}
+
+/**
+@brief Start pacing from now, and measure the pacing again
+*/
+void CFramePacer::Start(void)
+{
+	lastFrameTime = CClock::now();
+	nextFrameTime = lastFrameTime + targetFrameTime;
+	dStatsTime = 0.0;
+	dSumFrameTime = 0.0;
+	dSumError = 0.0;
+	dMaxError = 0.0;
+	uiNumFrames = 0;
+}
+
+/**
+@brief Wait until the next frame is due
+@return The time since the last frame started in seconds
+*/
+double CFramePacer::WaitForNextFrame(void)
+{
+	if (eMode == PACING_TARGET_RATE)
+	{
+		// Sleep until shortly before the frame is due, and spin for the rest of the time
+		CPlatform::SleepUntil(nextFrameTime, spinTime);
+	}
+
+	CClock::time_point now = CClock::now();
+	double dFrameTime = std::chrono::duration<double>(now - lastFrameTime).count();
+	lastFrameTime = now;
+
+	if (eMode == PACING_TARGET_RATE)
+	{
+		// Schedule the next frame a frame after this one was due, so that the rate does not drift.
+		// If this frame is more than a frame late, then start the schedule again from now
+		nextFrameTime += targetFrameTime;
+		if (nextFrameTime < now)
+			nextFrameTime = now + targetFrameTime;
+	}
+
+	AddFrame(dFrameTime);
+	return dFrameTime;
+}
+
+/**
+@brief Add a frame to the pacing of this second, and store the pacing once a second is over
+@param dFrameTime The time of the frame in seconds
+*/
+void CFramePacer::AddFrame(const double dFrameTime)
+{
+	dSumFrameTime += dFrameTime;
+	uiNumFrames++;
+	if (targetFrameTime != CClock::duration::zero())
+	{
+		double dError = fabs(dFrameTime - GetTargetFrameTime());
+		dSumError += dError;
+		if (dError > dMaxError)
+			dMaxError = dError;
+		CMetricsRegistry::GetInstance()->Observe(uiMetricPacingError, (unsigned long long)(dError * 1000000.0));
+	}
+
+	dStatsTime += dFrameTime;
+	if (dStatsTime >= 1.0)
+	{
+		sLastStats.dMeanFrameTime = dSumFrameTime / uiNumFrames * 1000.0;
+		sLastStats.dMeanError = dSumError / uiNumFrames * 1000.0;
+		sLastStats.dMaxError = dMaxError * 1000.0;
+		sLastStats.uiNumFrames = uiNumFrames;
+		dStatsTime = 0.0;
+		dSumFrameTime = 0.0;
+		dSumError = 0.0;
+		dMaxError = 0.0;
+		uiNumFrames = 0;
+	}
+}
+
+/**
+@brief Get the pacing of the last second
+*/
+const CFramePacer::SPacingStats& CFramePacer::GetPacingStats(void) const
+{
+	return sLastStats;
+}
+
+/**
+@brief Print the pacing of the last second
+*/
+void CFramePacer::PrintPacingStats(void) const
+{
+	static const char* arrModeNames[NUM_PACING_MODES] = { "target rate", "vsync", "uncapped" };
+	cout << "CFramePacer: " << arrModeNames[eMode] << ", target " << GetTargetFrameTime() * 1000.0
+		<< " ms, last " << sLastStats.uiNumFrames << " frames: mean " << sLastStats.dMeanFrameTime
+		<< " ms, pacing error mean " << sLastStats.dMeanError << " ms, max " << sLastStats.dMaxError << " ms" << endl;
+}
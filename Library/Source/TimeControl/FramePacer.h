@@ -0,0 +1,91 @@
+/**
+ CFramePacer
+ @brief A class to start the frames at a steady rate.
+		The frames are scheduled at fixed times, so that a late frame does not delay the next ones.
+		It sleeps until shortly before the next frame is due, as a sleep can wake up late,
+		and then spins until it is due. With vsync, buffer swaps pace the frames instead, and
+		without a target rate, the frames are not paced. The difference between the measured
+		and the target frame time is reported as the pacing error.
+ */
+#pragma once
+
+// Include CPlatform for the clock and the sleep
+#include "../System/Platform.h"
+
+class CFramePacer
+{
+public:
+	// The modes of pacing the frames
+	enum PACING_MODE
+	{
+		PACING_TARGET_RATE = 0,	// Sleep and spin until the next frame is due
+		PACING_VSYNC,			// The buffer swap waits for the vertical sync, so only measure the frames
+		PACING_UNCAPPED,		// Start the next frame at once
+		NUM_PACING_MODES
+	};
+
+	// The pacing of the frames of the last second, in milliseconds
+	struct SPacingStats
+	{
+		double dMeanFrameTime;
+		double dMeanError;		// The mean of the absolute differences from the target frame time
+		double dMaxError;
+		unsigned int uiNumFrames;
+	};
+
+	// Constructor
+	CFramePacer(void);
+
+	// Destructor
+	~CFramePacer(void);
+
+	// Set the mode and the target frame rate. With vsync, the rate is the refresh rate of the monitor.
+	// A rate of 0 is uncapped
+	void SetTargetRate(const PACING_MODE eMode, const double dFrameRate);
+	// Get the mode
+	PACING_MODE GetMode(void) const;
+	// Get the target frame time in seconds, or 0 if it is uncapped
+	double GetTargetFrameTime(void) const;
+
+	// Set how long before a frame is due to stop sleeping and start spinning, in seconds
+	void SetSpinTime(const double dSpinTime);
+
+	// Start pacing from now, and measure the pacing again
+	void Start(void);
+
+	// Wait until the next frame is due, and return the time since the last frame started in seconds
+	double WaitForNextFrame(void);
+
+	// Get the pacing of the last second
+	const SPacingStats& GetPacingStats(void) const;
+
+	// Print the pacing of the last second
+	void PrintPacingStats(void) const;
+
+protected:
+	typedef CPlatform::CClock CClock;
+
+	PACING_MODE eMode;
+	// The target frame time, or zero if it is uncapped
+	CClock::duration targetFrameTime;
+	// The time before a frame is due when the spinning starts
+	CClock::duration spinTime;
+
+	// The time when the last frame started, and when the next frame is due
+	CClock::time_point lastFrameTime;
+	CClock::time_point nextFrameTime;
+
+	// The sums of the current second, and the pacing of the last second
+	double dStatsTime;
+	double dSumFrameTime;
+	double dSumError;
+	double dMaxError;
+	unsigned int uiNumFrames;
+	SPacingStats sLastStats;
+
+	// The metric of the pacing error
+	unsigned int uiMetricPacingError;
+
+	// Add a frame to the pacing of this second
+	void AddFrame(const double dFrameTime);
+};
@@ -0,0 +1,392 @@
+/**
+ CFrameTimer
+ @brief A class to measure how long each part of a frame takes, on the CPU and on the GPU.
+		A zone is timed between BeginZone() and EndZone(), and its time is added up over a frame.
+		The GPU time is measured with GL_TIME_ELAPSED queries, which are read back a few frames
+		later when they are available, so that the CPU never waits for the GPU.
+		The times of the last frames are shown in an ImGui overlay with graphs and min/avg/max.
+ */
+#include "FrameTimer.h"
+
+// Include CRenderState for the GPU queries
+#include "../RenderControl/RenderState.h"
+
+// Include IMGUI
+#include "../GUI/imgui.h"
+
+#include <iostream>
+#include <cstdio>
+using namespace std;
+
+/**
+@brief Constructor
+*/
+CFrameTimer::CHistory::CHistory(void)
+	: uiNext(0)
+	, uiCount(0)
+{
+	for (unsigned int i = 0; i < NUM_HISTORY; i++)
+		arrTimes[i] = 0.0f;
+}
+
+/**
+@brief Add the time of a frame, replacing the oldest one if the history is full
+@param fTime The time in milliseconds
+*/
+void CFrameTimer::CHistory::Add(const float fTime)
+{
+	arrTimes[uiNext] = fTime;
+	uiNext = (uiNext + 1) % NUM_HISTORY;
+	if (uiCount < NUM_HISTORY)
+		uiCount++;
+}
+
+/**
+@brief Get the minimum time over the history
+*/
+float CFrameTimer::CHistory::GetMin(void) const
+{
+	if (uiCount == 0)
+		return 0.0f;
+	float fMin = arrTimes[0];
+	for (unsigned int i = 1; i < uiCount; i++)
+	{
+		if (arrTimes[i] < fMin)
+			fMin = arrTimes[i];
+	}
+	return fMin;
+}
+
+/**
+@brief Get the average time over the history
+*/
+float CFrameTimer::CHistory::GetAverage(void) const
+{
+	if (uiCount == 0)
+		return 0.0f;
+	float fTotal = 0.0f;
+	for (unsigned int i = 0; i < uiCount; i++)
+		fTotal += arrTimes[i];
+	return fTotal / uiCount;
+}
+
+/**
+@brief Get the maximum time over the history
+*/
+float CFrameTimer::CHistory::GetMax(void) const
+{
+	float fMax = 0.0f;
+	for (unsigned int i = 0; i < uiCount; i++)
+	{
+		if (arrTimes[i] > fMax)
+			fMax = arrTimes[i];
+	}
+	return fMax;
+}
+
+/**
+@brief Get the time of the last frame
+*/
+float CFrameTimer::CHistory::GetLast(void) const
+{
+	if (uiCount == 0)
+		return 0.0f;
+	return arrTimes[(uiNext + NUM_HISTORY - 1) % NUM_HISTORY];
+}
+
+/**
+@brief Constructor
+*/
+CFrameTimer::CFrameTimer(void)
+	: uiFrame(0)
+	, frameStartTime(CClock::now())
+	, bGPUZoneActive(false)
+	, bOverlayVisible(false)
+{
+}
+
+/**
+@brief Destructor
+*/
+CFrameTimer::~CFrameTimer(void)
+{
+	for (unsigned int i = 0; i < zones.size(); i++)
+	{
+		for (unsigned int j = 0; j < NUM_QUERY_FRAMES; j++)
+		{
+			if (zones[i].arrQueries[j] != 0)
+				CRenderState::GetInstance()->DeleteQuery(zones[i].arrQueries[j]);
+		}
+	}
+	zones.clear();
+}
+
+/**
+@brief Add a zone and return its ID
+@param sName The name of the zone, which is shown in the overlay
+@param bGPU true to measure the GPU time of the zone too
+@return The ID of the zone. If a zone with this name was added already, its ID is returned
+*/
+unsigned int CFrameTimer::AddZone(const std::string& sName, const bool bGPU)
+{
+	for (unsigned int i = 0; i < zones.size(); i++)
+	{
+		if (zones[i].sName == sName)
+			return i;
+	}
+
+	SZone sZone;
+	sZone.sName = sName;
+	sZone.bGPU = bGPU;
+	sZone.dFrameTime = 0.0;
+	sZone.bStarted = false;
+	for (unsigned int i = 0; i < NUM_QUERY_FRAMES; i++)
+	{
+		// The queries are created when they are first used
+		sZone.arrQueries[i] = 0;
+		sZone.arrPending[i] = false;
+	}
+	sZone.bQueried = false;
+	sZone.bQueryActive = false;
+	zones.push_back(sZone);
+	return zones.size() - 1;
+}
+
+/**
+@brief Start a new frame: store the times of the last frame and read back the GPU queries which are ready
+*/
+void CFrameTimer::BeginFrame(void)
+{
+	CClock::time_point now = CClock::now();
+	if (uiFrame > 0)
+	{
+		cFrameHistory.Add((float)(std::chrono::duration<double>(now - frameStartTime).count() * 1000.0));
+		for (unsigned int i = 0; i < zones.size(); i++)
+			zones[i].cCPUHistory.Add((float)(zones[i].dFrameTime * 1000.0));
+	}
+	frameStartTime = now;
+	uiFrame++;
+
+	for (unsigned int i = 0; i < zones.size(); i++)
+	{
+		SZone& sZone = zones[i];
+		if (sZone.bStarted)
+		{
+			cout << "CFrameTimer::BeginFrame(): Zone " << sZone.sName << " was not ended" << endl;
+			EndZone(i);
+		}
+		sZone.dFrameTime = 0.0;
+		sZone.bQueried = false;
+		if (sZone.bGPU)
+			ReadQueries(sZone);
+	}
+}
+
+/**
+@brief Start timing a zone
+@param uiZone The ID of the zone
+*/
+void CFrameTimer::BeginZone(const unsigned int uiZone)
+{
+	if (uiZone >= zones.size())
+		return;
+	SZone& sZone = zones[uiZone];
+	if (sZone.bStarted)
+		return;
+	sZone.bStarted = true;
+
+	// Only one query is started for a zone in a frame, and only if its query from
+	// NUM_QUERY_FRAMES frames ago was read back, so that the CPU does not wait for it
+	unsigned int uiSlot = uiFrame % NUM_QUERY_FRAMES;
+	if ((sZone.bGPU) && (sZone.bQueried == false) && (bGPUZoneActive == false) && (sZone.arrPending[uiSlot] == false))
+	{
+		CRenderState* cRenderState = CRenderState::GetInstance();
+		if (sZone.arrQueries[uiSlot] == 0)
+			sZone.arrQueries[uiSlot] = cRenderState->GenQuery();
+		cRenderState->BeginQuery(GL_TIME_ELAPSED, sZone.arrQueries[uiSlot]);
+		sZone.arrPending[uiSlot] = true;
+		sZone.bQueried = true;
+		sZone.bQueryActive = true;
+		bGPUZoneActive = true;
+	}
+
+	sZone.startTime = CClock::now();
+}
+
+/**
+@brief End timing a zone, and add its time to the time of this frame
+@param uiZone The ID of the zone
+*/
+void CFrameTimer::EndZone(const unsigned int uiZone)
+{
+	if (uiZone >= zones.size())
+		return;
+	SZone& sZone = zones[uiZone];
+	if (sZone.bStarted == false)
+		return;
+
+	sZone.dFrameTime += std::chrono::duration<double>(CClock::now() - sZone.startTime).count();
+	sZone.bStarted = false;
+
+	if (sZone.bQueryActive)
+	{
+		CRenderState::GetInstance()->EndQuery(GL_TIME_ELAPSED);
+		sZone.bQueryActive = false;
+		bGPUZoneActive = false;
+	}
+}
+
+/**
+@brief Read back the GPU queries of a zone which are ready, from the oldest to the newest.
+		A query which is not ready is left for a later frame
+@param sZone The zone
+*/
+void CFrameTimer::ReadQueries(SZone& sZone)
+{
+	CRenderState* cRenderState = CRenderState::GetInstance();
+	for (unsigned int i = 0; i < NUM_QUERY_FRAMES; i++)
+	{
+		unsigned int uiSlot = (uiFrame + i) % NUM_QUERY_FRAMES;
+		if (sZone.arrPending[uiSlot] == false)
+			continue;
+
+		GLuint64 ullTime = 0;
+		if (cRenderState->GetQueryResult(sZone.arrQueries[uiSlot], ullTime) == false)
+			break;
+		sZone.cGPUHistory.Add((float)(ullTime / 1000000.0));
+		sZone.arrPending[uiSlot] = false;
+	}
+}
+
+/**
+@brief Get the CPU times of a zone
+@param uiZone The ID of the zone, which must be valid
+*/
+const CFrameTimer::CHistory& CFrameTimer::GetCPUHistory(const unsigned int uiZone) const
+{
+	return zones[uiZone].cCPUHistory;
+}
+
+/**
+@brief Get the GPU times of a zone. It is empty if the zone is not timed on the GPU
+@param uiZone The ID of the zone, which must be valid
+*/
+const CFrameTimer::CHistory& CFrameTimer::GetGPUHistory(const unsigned int uiZone) const
+{
+	return zones[uiZone].cGPUHistory;
+}
+
+/**
+@brief Get the CPU times of the whole frame
+*/
+const CFrameTimer::CHistory& CFrameTimer::GetFrameHistory(void) const
+{
+	return cFrameHistory;
+}
+
+/**
+@brief Get the number of zones
+*/
+unsigned int CFrameTimer::GetNumZones(void) const
+{
+	return zones.size();
+}
+
+/**
+@brief Get the name of a zone
+@param uiZone The ID of the zone, which must be valid
+*/
+const std::string& CFrameTimer::GetZoneName(const unsigned int uiZone) const
+{
+	return zones[uiZone].sName;
+}
+
+/**
+@brief Get the CPU time of a zone in the current frame so far, in milliseconds
+@param uiZone The ID of the zone, which must be valid
+*/
+float CFrameTimer::GetZoneFrameTime(const unsigned int uiZone) const
+{
+	return (float)(zones[uiZone].dFrameTime * 1000.0);
+}
+
+/**
+@brief Show or hide the overlay
+*/
+void CFrameTimer::SetOverlayVisible(const bool bVisible)
+{
+	bOverlayVisible = bVisible;
+}
+
+/**
+@brief Check if the overlay is visible
+*/
+bool CFrameTimer::IsOverlayVisible(void) const
+{
+	return bOverlayVisible;
+}
+
+/**
+@brief Add the overlay to the current ImGui frame, if it is visible
+*/
+void CFrameTimer::RenderOverlay(void)
+{
+	if (bOverlayVisible == false)
+		return;
+
+	ImGuiWindowFlags windowFlags = ImGuiWindowFlags_AlwaysAutoResize |
+		ImGuiWindowFlags_NoFocusOnAppearing |
+		ImGuiWindowFlags_NoNav;
+	ImGui::SetNextWindowPos(ImVec2(10.0f, 10.0f), ImGuiCond_FirstUseEver);
+	ImGui::SetNextWindowBgAlpha(0.75f);
+	if (ImGui::Begin("Frame Timing", &bOverlayVisible, windowFlags))
+	{
+		ImGui::Text("Frame: %.2f ms (%.0f FPS)", cFrameHistory.GetAverage(),
+			(cFrameHistory.GetAverage() > 0.0f) ? 1000.0f / cFrameHistory.GetAverage() : 0.0f);
+		// All the graphs of a frame share the same scale, so that they can be compared
+		float fScaleMax = cFrameHistory.GetMax();
+		RenderHistory("Frame", cFrameHistory, fScaleMax);
+
+		ImGui::Separator();
+		ImGui::Text("%-16s %-30s %s", "Zone", "CPU min / avg / max (ms)", "GPU min / avg / max (ms)");
+		for (unsigned int i = 0; i < zones.size(); i++)
+		{
+			const SZone& sZone = zones[i];
+			ImGui::PushID((int)i);
+			ImGui::Text("%-16s %6.2f / %6.2f / %6.2f", sZone.sName.c_str(),
+				sZone.cCPUHistory.GetMin(), sZone.cCPUHistory.GetAverage(), sZone.cCPUHistory.GetMax());
+			if (sZone.bGPU)
+			{
+				ImGui::SameLine();
+				ImGui::Text("     %6.2f / %6.2f / %6.2f",
+					sZone.cGPUHistory.GetMin(), sZone.cGPUHistory.GetAverage(), sZone.cGPUHistory.GetMax());
+			}
+			RenderHistory("CPU", sZone.cCPUHistory, fScaleMax);
+			if (sZone.bGPU)
+			{
+				ImGui::SameLine();
+				RenderHistory("GPU", sZone.cGPUHistory, fScaleMax);
+			}
+			ImGui::PopID();
+		}
+	}
+	ImGui::End();
+}
+
+/**
+@brief Draw the graph of a history, from the oldest to the newest time
+@param pcLabel The label of the graph
+@param cHistory The history
+@param fScaleMax The time at the top of the graph
+*/
+void CFrameTimer::RenderHistory(const char* pcLabel, const CHistory& cHistory, const float fScaleMax)
+{
+	char acLabel[32], acOverlay[32];
+	// The label is hidden, and only used as the ID of the graph
+	snprintf(acLabel, sizeof(acLabel), "##%s", pcLabel);
+	snprintf(acOverlay, sizeof(acOverlay), "%s %.2f ms", pcLabel, cHistory.GetLast());
+	// The oldest time is at uiNext once the history is full
+	int iOffset = (cHistory.uiCount < NUM_HISTORY) ? 0 : (int)cHistory.uiNext;
+	ImGui::PlotLines(acLabel, cHistory.arrTimes, (int)cHistory.uiCount, iOffset, acOverlay,
+		0.0f, (fScaleMax > 0.0f) ? fScaleMax : 1.0f, ImVec2(220.0f, 40.0f));
+}
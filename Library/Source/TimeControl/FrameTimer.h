@@ -0,0 +1,127 @@
+/**
+ CFrameTimer
+ @brief A class to measure how long each part of a frame takes, on the CPU and on the GPU.
+		A zone is timed between BeginZone() and EndZone(), and its time is added up over a frame.
+		The GPU time is measured with GL_TIME_ELAPSED queries, which are read back a few frames
+		later when they are available, so that the CPU never waits for the GPU.
+		The times of the last frames are shown in an ImGui overlay with graphs and min/avg/max.
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+// Include GLEW
+#ifndef GLEW_STATIC
+#include <GL/glew.h>
+#define GLEW_STATIC
+#endif
+
+#include <string>
+#include <vector>
+
+// Include CPlatform for the clock
+#include "../System/Platform.h"
+
+class CFrameTimer : public CSingletonTemplate<CFrameTimer>
+{
+	friend CSingletonTemplate<CFrameTimer>;
+public:
+	// The number of frames which are kept for the graphs and min/avg/max
+	static const unsigned int NUM_HISTORY = 240;
+	// The number of frames which a GPU query has to be read back in before it is reused
+	static const unsigned int NUM_QUERY_FRAMES = 4;
+
+	// The times of the last frames of a zone, in milliseconds
+	class CHistory
+	{
+	public:
+		CHistory(void);
+		// Add the time of a frame, replacing the oldest one if the history is full
+		void Add(const float fTime);
+		// Get the minimum, average and maximum over the history
+		float GetMin(void) const;
+		float GetAverage(void) const;
+		float GetMax(void) const;
+		// Get the time of the last frame
+		float GetLast(void) const;
+
+		float arrTimes[NUM_HISTORY];
+		// The index which the next time is stored at, which is also the oldest time when it is full
+		unsigned int uiNext;
+		unsigned int uiCount;
+	};
+
+	// Add a zone and return its ID. If a zone with this name was added already, its ID is returned.
+	// Set bGPU to true to measure its GPU time too
+	unsigned int AddZone(const std::string& sName, const bool bGPU);
+
+	// Start a new frame: store the times of the last frame and read back the GPU queries which are ready
+	void BeginFrame(void);
+
+	// Start and end timing a zone. A zone can be timed more than once in a frame, and the times are added up.
+	// Only the first time of a GPU zone in a frame is measured on the GPU, and GPU zones cannot be nested
+	void BeginZone(const unsigned int uiZone);
+	void EndZone(const unsigned int uiZone);
+
+	// Show or hide the overlay
+	void SetOverlayVisible(const bool bVisible);
+	bool IsOverlayVisible(void) const;
+	// Add the overlay to the current ImGui frame, if it is visible
+	void RenderOverlay(void);
+
+	// Get the CPU and GPU times of a zone, and the CPU time of the whole frame
+	const CHistory& GetCPUHistory(const unsigned int uiZone) const;
+	const CHistory& GetGPUHistory(const unsigned int uiZone) const;
+	const CHistory& GetFrameHistory(void) const;
+
+	// Get the number of zones, and the name of a zone
+	unsigned int GetNumZones(void) const;
+	const std::string& GetZoneName(const unsigned int uiZone) const;
+	// Get the CPU time of a zone in the current frame so far, in milliseconds
+	float GetZoneFrameTime(const unsigned int uiZone) const;
+
+protected:
+	typedef CPlatform::CClock CClock;
+
+	// A part of a frame which is timed
+	struct SZone
+	{
+		std::string sName;
+		bool bGPU;
+		// The time when the zone was started, and the time of this frame so far in seconds
+		CClock::time_point startTime;
+		double dFrameTime;
+		bool bStarted;
+		// The GPU queries, one for each of the last NUM_QUERY_FRAMES frames
+		GLuint arrQueries[NUM_QUERY_FRAMES];
+		bool arrPending[NUM_QUERY_FRAMES];
+		// True if this zone started its query in this frame
+		bool bQueried;
+		bool bQueryActive;
+		CHistory cCPUHistory;
+		CHistory cGPUHistory;
+	};
+
+	// Constructor
+	CFrameTimer(void);
+
+	// Destructor
+	virtual ~CFrameTimer(void);
+
+	// Read back the GPU queries of a zone which are ready, from the oldest to the newest
+	void ReadQueries(SZone& sZone);
+
+	// Draw the graph and min/avg/max of a history
+	void RenderHistory(const char* pcLabel, const CHistory& cHistory, const float fScaleMax);
+
+	std::vector<SZone> zones;
+	// The number of frames which were started
+	unsigned int uiFrame;
+	// The time when the current frame started
+	CClock::time_point frameStartTime;
+	CHistory cFrameHistory;
+	// True if a GPU zone is being timed, as GL_TIME_ELAPSED queries cannot be nested
+	bool bGPUZoneActive;
+	bool bOverlayVisible;
+};
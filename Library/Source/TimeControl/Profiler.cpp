@@ -0,0 +1,210 @@
+/**
+ CProfiler
+ @brief A class to record the CPU time of scoped zones on every thread, and to write them
+		to a Chrome trace (JSON) which can be opened in chrome://tracing or ui.perfetto.dev.
+		A zone is recorded with PROFILE_SCOPE("Name") or PROFILE_FUNCTION() at the start of a scope.
+		Each thread records into its own ring buffer without any lock, so only the last
+		NUM_EVENTS zones of each thread are kept. When the profiler is not recording, a zone
+		only checks a flag. Define PROFILER_DISABLED to compile the zones out completely.
+ */
+#include "Profiler.h"
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+using namespace std;
+
+std::atomic<bool> CProfiler::bRecording(false);
+CPlatform::CClock::time_point CProfiler::startTime = CPlatform::CClock::now();
+std::atomic<unsigned int> CProfiler::uiGeneration(0);
+
+/**
+@brief Constructor
+*/
+CProfiler::CProfiler(void)
+{
+}
+
+/**
+@brief Destructor
+*/
+CProfiler::~CProfiler(void)
+{
+	bRecording = false;
+	uiGeneration++;
+
+	std::lock_guard<std::mutex> lock(threadBuffersMutex);
+	for (unsigned int i = 0; i < threadBuffers.size(); i++)
+		delete threadBuffers[i];
+	threadBuffers.clear();
+}
+
+/**
+@brief Start recording. The zones which were recorded before are discarded
+*/
+void CProfiler::Start(void)
+{
+	{
+		std::lock_guard<std::mutex> lock(threadBuffersMutex);
+		for (unsigned int i = 0; i < threadBuffers.size(); i++)
+			threadBuffers[i]->ullStartIndex = threadBuffers[i]->ullWriteIndex.load();
+	}
+	bRecording = true;
+	cout << "CProfiler::Start(): Recording the profiler zones" << endl;
+}
+
+/**
+@brief Stop recording. The recorded zones are kept until they are written or recording starts again
+*/
+void CProfiler::Stop(void)
+{
+	bRecording = false;
+}
+
+/**
+@brief Record a zone of the calling thread
+@param pcName The name of the zone, which must stay valid until it is written, e.g. a string literal
+@param ullStart The time when the zone started, from GetTime()
+@param ullEnd The time when the zone ended, from GetTime()
+*/
+void CProfiler::Record(const char* pcName, const unsigned long long ullStart, const unsigned long long ullEnd)
+{
+	SThreadBuffer* pBuffer = GetThreadBuffer();
+	unsigned long long ullIndex = pBuffer->ullWriteIndex.load(std::memory_order_relaxed);
+	SEvent& sEvent = pBuffer->arrEvents[ullIndex % NUM_EVENTS];
+	sEvent.pcName = pcName;
+	sEvent.ullStart = ullStart;
+	sEvent.ullEnd = ullEnd;
+	// Publish the event after it is written
+	pBuffer->ullWriteIndex.store(ullIndex + 1, std::memory_order_release);
+}
+
+/**
+@brief Set the name of the calling thread, which is shown in the trace
+@param sName The name of the thread
+*/
+void CProfiler::SetThreadName(const std::string& sName)
+{
+	SThreadBuffer* pBuffer = GetThreadBuffer();
+	std::lock_guard<std::mutex> lock(threadBuffersMutex);
+	pBuffer->sThreadName = sName;
+}
+
+/**
+@brief Get the ring buffer of the calling thread, and create it on the first call.
+		Only the first call of each thread takes the lock
+*/
+CProfiler::SThreadBuffer* CProfiler::GetThreadBuffer(void)
+{
+	static thread_local SThreadBuffer* pThreadBuffer = NULL;
+	static thread_local unsigned int uiThreadGeneration = 0;
+
+	unsigned int uiCurrentGeneration = uiGeneration.load(std::memory_order_relaxed);
+	if ((pThreadBuffer == NULL) || (uiThreadGeneration != uiCurrentGeneration))
+	{
+		SThreadBuffer* pBuffer = new SThreadBuffer();
+		pBuffer->ullWriteIndex = 0;
+		pBuffer->ullStartIndex = 0;
+
+		std::lock_guard<std::mutex> lock(threadBuffersMutex);
+		pBuffer->uiThreadID = (unsigned int)threadBuffers.size() + 1;
+		threadBuffers.push_back(pBuffer);
+		pThreadBuffer = pBuffer;
+		uiThreadGeneration = uiCurrentGeneration;
+	}
+	return pThreadBuffer;
+}
+
+/**
+@brief Write the recorded zones of all the threads to a Chrome trace file.
+		This can be called while the other threads are recording, and the zones
+		which they overwrote while they were copied are left out
+@param sFile The file path of the trace
+@return true if the trace was written, otherwise false
+*/
+bool CProfiler::WriteChromeTrace(const std::string& sFile)
+{
+	std::ofstream file(sFile);
+	if (!file.is_open())
+	{
+		cout << "CProfiler::WriteChromeTrace(): Unable to open " << sFile << endl;
+		return false;
+	}
+
+	// The times are written in microseconds with nanosecond precision
+	file << std::fixed << std::setprecision(3);
+	file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+	unsigned int uiNumEvents = 0;
+	bool bFirst = true;
+	std::vector<SEvent> events;
+
+	std::lock_guard<std::mutex> lock(threadBuffersMutex);
+	for (unsigned int i = 0; i < threadBuffers.size(); i++)
+	{
+		SThreadBuffer* pBuffer = threadBuffers[i];
+
+		// Copy the events which are in the ring buffer
+		unsigned long long ullEnd = pBuffer->ullWriteIndex.load(std::memory_order_acquire);
+		unsigned long long ullBegin = pBuffer->ullStartIndex.load();
+		if (ullEnd - ullBegin > NUM_EVENTS)
+			ullBegin = ullEnd - NUM_EVENTS;
+		events.clear();
+		for (unsigned long long j = ullBegin; j < ullEnd; j++)
+			events.push_back(pBuffer->arrEvents[j % NUM_EVENTS]);
+
+		// Leave out the events which the thread overwrote while they were copied
+		unsigned long long ullNewEnd = pBuffer->ullWriteIndex.load(std::memory_order_acquire);
+		unsigned int uiFirstValid = 0;
+		if (ullNewEnd - ullBegin > NUM_EVENTS)
+			uiFirstValid = (unsigned int)std::min<unsigned long long>(ullNewEnd - ullBegin - NUM_EVENTS, events.size());
+
+		if (!bFirst)
+			file << ",";
+		bFirst = false;
+		file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << pBuffer->uiThreadID << ",\"args\":{\"name\":";
+		if (pBuffer->sThreadName.empty())
+			file << "\"Thread " << pBuffer->uiThreadID << "\"";
+		else
+			WriteJSONString(file, pBuffer->sThreadName.c_str());
+		file << "}}";
+
+		for (unsigned int j = uiFirstValid; j < events.size(); j++)
+		{
+			const SEvent& sEvent = events[j];
+			file << ",\n{\"name\":";
+			WriteJSONString(file, sEvent.pcName);
+			file << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << pBuffer->uiThreadID
+				<< ",\"ts\":" << sEvent.ullStart / 1000.0
+				<< ",\"dur\":" << (sEvent.ullEnd - sEvent.ullStart) / 1000.0 << "}";
+			uiNumEvents++;
+		}
+	}
+	file << "\n]}\n";
+	file.close();
+
+	cout << "CProfiler::WriteChromeTrace(): Wrote " << uiNumEvents << " zones of "
+		<< threadBuffers.size() << " threads to " << sFile << endl;
+	return true;
+}
+
+/**
+@brief Write a string to a JSON file with its special characters escaped
+@param os The stream to write to
+@param pcString The string
+*/
+void CProfiler::WriteJSONString(std::ostream& os, const char* pcString)
+{
+	os << "\"";
+	for (const char* pc = pcString; *pc != '\0'; pc++)
+	{
+		if ((*pc == '"') || (*pc == '\\'))
+			os << '\\' << *pc;
+		else if ((unsigned char)*pc < 0x20)
+			os << ' ';
+		else
+			os << *pc;
+	}
+	os << "\"";
+}
@@ -0,0 +1,142 @@
+/**
+ CProfiler
+ @brief A class to record the CPU time of scoped zones on every thread, and to write them
+		to a Chrome trace (JSON) which can be opened in chrome://tracing or ui.perfetto.dev.
+		A zone is recorded with PROFILE_SCOPE("Name") or PROFILE_FUNCTION() at the start of a scope.
+		Each thread records into its own ring buffer without any lock, so only the last
+		NUM_EVENTS zones of each thread are kept. When the profiler is not recording, a zone
+		only checks a flag. Define PROFILER_DISABLED to compile the zones out completely.
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+// Include CPlatform for the clock
+#include "../System/Platform.h"
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <ostream>
+
+class CProfiler : public CSingletonTemplate<CProfiler>
+{
+	friend CSingletonTemplate<CProfiler>;
+public:
+	// The number of zones which are kept for each thread
+	static const unsigned int NUM_EVENTS = 65536;
+
+	// Start recording. The zones which were recorded before are discarded
+	void Start(void);
+	// Stop recording. The recorded zones are kept until they are written or recording starts again
+	void Stop(void);
+	// Check if the zones are being recorded
+	static inline bool IsRecording(void)
+	{
+		return bRecording.load(std::memory_order_relaxed);
+	}
+
+	// Get the time since the profiler was created, in nanoseconds
+	static inline unsigned long long GetTime(void)
+	{
+		return (unsigned long long)std::chrono::duration_cast<std::chrono::nanoseconds>(
+			CPlatform::CClock::now() - startTime).count();
+	}
+
+	// Record a zone of the calling thread. The name must stay valid until it is written, e.g. a string literal
+	void Record(const char* pcName, const unsigned long long ullStart, const unsigned long long ullEnd);
+
+	// Set the name of the calling thread, which is shown in the trace
+	void SetThreadName(const std::string& sName);
+
+	// Write the recorded zones of all the threads to a Chrome trace file
+	bool WriteChromeTrace(const std::string& sFile);
+
+protected:
+	// A zone which was recorded
+	struct SEvent
+	{
+		const char* pcName;
+		unsigned long long ullStart;
+		unsigned long long ullEnd;
+	};
+
+	// The ring buffer of a thread. Only its thread writes the events, and the write index
+	// is published after an event is written, so that it can be read without a lock
+	struct SThreadBuffer
+	{
+		SEvent arrEvents[NUM_EVENTS];
+		std::atomic<unsigned long long> ullWriteIndex;
+		// The index before which the events were discarded by Start()
+		std::atomic<unsigned long long> ullStartIndex;
+		unsigned int uiThreadID;
+		std::string sThreadName;
+	};
+
+	// Constructor
+	CProfiler(void);
+
+	// Destructor
+	virtual ~CProfiler(void);
+
+	// Get the ring buffer of the calling thread, and create it on the first call
+	SThreadBuffer* GetThreadBuffer(void);
+
+	// Write a string to a JSON file with its special characters escaped
+	static void WriteJSONString(std::ostream& os, const char* pcString);
+
+	// The ring buffers of all the threads which have recorded a zone. They are only
+	// deleted with the profiler, so that the zones of a thread which ended can still be written
+	std::vector<SThreadBuffer*> threadBuffers;
+	std::mutex threadBuffersMutex;
+
+	static std::atomic<bool> bRecording;
+	// The time which the zones are measured from
+	static CPlatform::CClock::time_point startTime;
+	// Incremented when the profiler is destroyed, so that the threads do not use their old ring buffers
+	static std::atomic<unsigned int> uiGeneration;
+};
+
+/**
+ CProfileScope
+ @brief Records a zone from its construction to its destruction, if the profiler is recording
+ */
+class CProfileScope
+{
+public:
+	inline CProfileScope(const char* pcName)
+		: pcName(pcName)
+		, ullStart(0)
+		, bRecording(CProfiler::IsRecording())
+	{
+		if (bRecording)
+			ullStart = CProfiler::GetTime();
+	}
+
+	inline ~CProfileScope(void)
+	{
+		if (bRecording)
+			CProfiler::GetInstance()->Record(pcName, ullStart, CProfiler::GetTime());
+	}
+
+protected:
+	const char* pcName;
+	unsigned long long ullStart;
+	bool bRecording;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#ifndef PROFILER_DISABLED
+// Record a zone with a name from here to the end of this scope
+#define PROFILE_SCOPE(name) CProfileScope PROFILE_CONCAT(cProfileScope, __LINE__)(name)
+// Record a zone with the name of this function from here to the end of this scope
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__FUNCTION__)
+#else
+#define PROFILE_SCOPE(name)
+#define PROFILE_FUNCTION()
+#endif
@@ -6,24 +6,12 @@
  */
 #include "StopWatch.h"
 
-#define TARGET_RESOLUTION 1         // 1-millisecond target resolution
-
 /**
 @brief Constructor
 */
 CStopWatch::CStopWatch(void)
 {
-	QueryPerformanceFrequency(&frequency);
-
-	TIMECAPS tc;
-
-	if (timeGetDevCaps(&tc, sizeof(TIMECAPS)) != TIMERR_NOERROR)
-	{
-		// Error; application can't continue.
-	}
-
-	wTimerRes = min(max(tc.wPeriodMin, TARGET_RESOLUTION), tc.wPeriodMax);
-	timeBeginPeriod(wTimerRes);
+	StartTimer();
 }
 
 /**
@@ -37,9 +25,9 @@ CStopWatch::~CStopWatch(void)
 /**
 @brief Initialise this class instance
 */
-void Init(void)
+void CStopWatch::Init(void)
 {
-
+	StartTimer();
 }
 
 /**
@@ -47,16 +35,15 @@ void Init(void)
 */ 
 void CStopWatch::StartTimer(void)
 {
-	QueryPerformanceCounter(&prevTime);
+	prevTime = CPlatform::Now();
 }
 
 
 /**
- @brief Stop timer
+ @brief Stop timer. The timer resolution is raised once by CPlatform::Init(), so there is nothing to release
  */
 void CStopWatch::StopTimer(void)
 {
-	timeEndPeriod(wTimerRes);
 }
 
 /**
@@ -64,11 +51,10 @@ void CStopWatch::StopTimer(void)
  */ 
 double CStopWatch::GetElapsedTime(void)
 {
-	LARGE_INTEGER time;
-	QueryPerformanceCounter(&currTime);
-	time.QuadPart = currTime.QuadPart - prevTime.QuadPart;
+	currTime = CPlatform::Now();
+	double dTime = std::chrono::duration<double>(currTime - prevTime).count();
 	prevTime = currTime;
-	return LIToSecs(time);
+	return dTime;
 }
 
 /**
@@ -76,25 +62,6 @@ double CStopWatch::GetElapsedTime(void)
  */
 void CStopWatch::WaitUntil(const long long llTime)
 {
-	LARGE_INTEGER nowTime;
-	LONGLONG timeElapsed;
-	while (true)
-	{
-		QueryPerformanceCounter(&nowTime);
-		timeElapsed = ((nowTime.QuadPart - prevTime.QuadPart) * 1000 / frequency.QuadPart);
-		if (timeElapsed > llTime)
-			return;
-		else if (llTime - timeElapsed > 1)
-			Sleep(1);
-	}
-}
-
-/**
- @brief Convert from Large Integer to seconds in double
- @param L A LARGE_INTEGER & containing the time value
- @return The time in seconds unit and in double data type
- */
-double CStopWatch::LIToSecs(LARGE_INTEGER & L)
-{
-	return ((double)L.QuadPart / (double)frequency.QuadPart);
+	// Sleep until a millisecond before the time, and spin for the rest of it
+	CPlatform::SleepUntil(prevTime + std::chrono::milliseconds(llTime), std::chrono::milliseconds(1));
 }
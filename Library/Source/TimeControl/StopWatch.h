@@ -6,7 +6,8 @@
  */
 #pragma once
 
-#include <windows.h>
+// Include CPlatform for the clock and the sleep
+#include "../System/Platform.h"
 
 class CStopWatch
 {
@@ -33,10 +34,5 @@ public:
 	void WaitUntil(const long long llTime);
 
 protected:
-	LARGE_INTEGER frequency;
-	LARGE_INTEGER prevTime, currTime;
-	UINT     wTimerRes;
-
-	// Convert from Large Integer to seconds in double
-	double LIToSecs(LARGE_INTEGER & L);
+	CPlatform::CClock::time_point prevTime, currTime;
 };